@@ -829,6 +829,23 @@ enum MDBX_constants {
 #endif /* Windows */
 #endif /* MDBX_LOCK_SUFFIX */
 
+#ifndef MDBX_WARMUP_SUFFIX
+/** \brief The suffix of the warm-up profile file, which is appended to
+ * the name of the data file.
+ * \see mdbx_env_warmup_save() \see MDBX_warmup_profile */
+#if !(defined(_WIN32) || defined(_WIN64))
+#define MDBX_WARMUP_SUFFIX "-warm"
+#else
+#define MDBX_WARMUP_SUFFIX_W L"-warm"
+#define MDBX_WARMUP_SUFFIX_A "-warm"
+#ifdef UNICODE
+#define MDBX_WARMUP_SUFFIX MDBX_WARMUP_SUFFIX_W
+#else
+#define MDBX_WARMUP_SUFFIX MDBX_WARMUP_SUFFIX_A
+#endif /* UNICODE */
+#endif /* Windows */
+#endif /* MDBX_WARMUP_SUFFIX */
+
 /* DEBUG & LOGGING ************************************************************/
 
 /** \addtogroup c_debug
@@ -1666,7 +1683,8 @@ typedef enum MDBX_put_flags {
    * Don't split full pages, continue on a new instead. */
   MDBX_APPENDDUP = UINT32_C(0x40000),
 
-  /** Only for \ref MDBX_DUPFIXED.
+  /** Only for \ref MDBX_DUPFIXED, or for \ref MDBX_DUPSORT with an array
+   * of \ref MDBX_val given.
    * Store multiple data items in one call. */
   MDBX_MULTIPLE = UINT32_C(0x80000)
 } MDBX_put_flags_t;
@@ -2418,7 +2436,191 @@ typedef enum MDBX_option {
   /** \brief Задаёт в % ограничение резервирования места на вложенных страницах.
    *
    * min 0, max 100% (65535), default = 4.2% (2753) */
-  MDBX_opt_subpage_reserve_limit
+  MDBX_opt_subpage_reserve_limit,
+
+  /** \brief Задаёт размер окна упреждающего чтения в страницах при
+   * последовательном просмотре данных курсорами.
+   *
+   * Когда курсор несколько раз подряд переходит на соседнюю листовую страницу
+   * в одном направлении, номера следующих листовых страниц берутся из
+   * родительской страницы и для них операционной системе дается подсказка
+   * о скорой потребности (`MADV_WILLNEED`, `posix_fadvise()` и т.п.).
+   * Аналогично подсказка дается для страниц с большими значениями.
+   * Это позволяет уменьшить задержки от синхронной подкачки страниц при
+   * просмотре диапазонов "холодных" данных, когда обычное упреждающее чтение
+   * отключено (см \ref MDBX_NORDAHEAD) либо неэффективно из-за фрагментации.
+   *
+   * Статистика доступна в \ref MDBX_envinfo::mi_prefetch_stat.
+   *
+   * min 0 (выключено), max 1024, default = 0 */
+  MDBX_opt_prefetch_window,
+
+  /** \brief Управляет выделением памяти для грязных страниц из блоков
+   * (slab) по 2 МиБ, которые повторно используются между транзакциями.
+   *
+   * По-умолчанию теневые копии изменяемых страниц выделяются посредством
+   * `malloc()` с небольшим резервом (см \ref MDBX_opt_dp_reserve_limit).
+   * При значении 1 одиночные страницы выделяются из блоков по 2 МиБ,
+   * для которых запрашивается использование Transparent Huge Pages.
+   * При значении 2 сначала пробуются явные большие страницы (`MAP_HUGETLB`
+   * в Linux, `MEM_LARGE_PAGES` в Windows), а при их недоступности
+   * используется поведение как для 1. Пустые блоки удерживаются для
+   * повторного использования пока их емкость не превышает
+   * \ref MDBX_opt_dp_reserve_limit, но не менее одного блока.
+   * Многостраничные буферы для больших значений всегда выделяются
+   * посредством `malloc()`.
+   *
+   * Объем используемой памяти доступен в \ref MDBX_envinfo::mi_dp_slab.
+   *
+   * min 0 (выключено), max 2, default = 0 */
+  MDBX_opt_dp_slab,
+
+  /** \brief Задаёт политику выбора грязных страниц для выталкивания на диск
+   * при превышении \ref MDBX_opt_txn_dp_limit.
+   *
+   * При значении 0 выталкиваются страницы, к которым дольше всего не было
+   * обращений (LRU), с поправкой на размер. Если транзакция циклически
+   * изменяет объем данных больше лимита грязных страниц, то такая политика
+   * приводит к выталкиванию страниц, которые тут же требуются снова.
+   *
+   * При значении 1 дополнительно учитывается частота обращений подобно
+   * 2Q/CLOCK-Pro: страницы без повторных обращений в транзакции вытесняются
+   * в первую очередь, а страницы возвращенные из вытесненных считаются
+   * "горячими". Счетчики обращений уменьшаются вдвое при каждом выталкивании.
+   *
+   * Количество вытолкнутых и возвращенных страниц в транзакции доступно
+   * в \ref MDBX_commit_latency::spill.
+   *
+   * min 0 (LRU), max 1 (LRU с учетом частоты обращений), default = 0 */
+  MDBX_opt_spill_policy,
+
+  /** \brief Управляет использованием Transparent Huge Pages для отображения
+   * файла БД в память.
+   *
+   * По-умолчанию для отображения БД запрашивается отказ от больших страниц
+   * (`MADV_NOHUGEPAGE`). Однако, для больших и преимущественно читаемых БД,
+   * полностью умещающихся в ОЗУ, при случайном доступе преобладают промахи
+   * TLB, которые многократно сокращаются при использовании страниц по 2 МиБ.
+   * При значении 1 начало отображения выравнивается на 2 МиБ (вместе со
+   * смещениями в файле) и запрашивается использование больших страниц
+   * (`MADV_HUGEPAGE`), а фактическое их использование определяется ядром ОС
+   * и файловой системой.
+   *
+   * Большие страницы используются только в режиме без \ref MDBX_WRITEMAP
+   * либо в режиме только чтения, так как при записи через отображение
+   * изменение одной страницы БД пометит грязной всю большую страницу, что
+   * приведет к многократному увеличению объема записи на диск. Без
+   * \ref MDBX_WRITEMAP изменения записываются постранично вне отображения.
+   *
+   * Опция может быть изменена только до открытия БД. Объем отображения,
+   * для которого запрошены большие страницы, и объем фактически размещенный
+   * в больших страницах доступны в \ref MDBX_envinfo::mi_dxb_hugepages.
+   *
+   * min 0 (выключено), max 1, default = 0 */
+  MDBX_opt_dxb_hugepages,
+
+  /** \brief Задает порог фонового резервирования места в файле БД,
+   * в страницах.
+   *
+   * При увеличении файла БД внутри транзакции выполняется выделение места
+   * в файловой системе, что при большом шаге приращения может задерживать
+   * фиксацию транзакций на сотни миллисекунд. При ненулевом значении, после
+   * фиксации транзакции, оставляющей в текущем размере файла менее заданного
+   * количества свободных страниц, вспомогательный поток заранее резервирует
+   * место под следующий шаг приращения (без изменения размера файла), и
+   * последующее увеличение файла сводится к изменению его размера.
+   * Длительность увеличения файла внутри транзакций доступна
+   * в \ref MDBX_commit_stat::resize.
+   *
+   * Поддерживается только в Linux, на других платформах попытка установить
+   * ненулевое значение вернет \ref MDBX_ENOSYS.
+   *
+   * min 0 (выключено), max 0x7FFFffff, default = 0 */
+  MDBX_opt_dxb_preallocate,
+
+  /** \brief Управляет записью изменений при фиксации транзакций в обход
+   * страничного кэша ОС (`O_DIRECT`).
+   *
+   * В режиме без \ref MDBX_WRITEMAP страницы записываются в файл БД
+   * посредством `pwrite()` и сначала попадают в страничный кэш ОС, откуда
+   * сбрасываются на диск при фиксации либо фоновым потоком ядра. При больших
+   * транзакциях это приводит к двойной буферизации и непредсказуемой
+   * длительности фиксации. При значении 1 для записи при фиксации открывается
+   * дополнительный дескриптор файла с флагом `O_DIRECT`, а данные передаются
+   * устройству напрямую через выровненный промежуточный буфер. При
+   * использовании \ref MDBX_opt_dp_slab грязные страницы выравниваются на
+   * границу системной страницы и записываются без копирования. Отображение
+   * БД для чтения остается согласованным, так как ядро ОС сбрасывает
+   * закэшированные страницы, перекрываемые прямой записью. Для больших БД
+   * такой режим уместно сочетать с \ref MDBX_NORDAHEAD.
+   *
+   * Опция игнорируется в режимах \ref MDBX_WRITEMAP и \ref MDBX_RDONLY, а
+   * также если размер страницы БД меньше размера системной страницы либо
+   * файловая система не поддерживает `O_DIRECT`. Опция может быть изменена
+   * только до открытия БД, на платформах без `O_DIRECT` попытка установить
+   * ненулевое значение вернет \ref MDBX_ENOSYS.
+   *
+   * min 0 (выключено), max 1, default = 0 */
+  MDBX_opt_dxb_direct_write,
+
+  /** \brief Управляет фиксацией транзакций с однократным сбросом на диск.
+   *
+   * Для устойчивой фиксации транзакции требуются два упорядоченных сброса
+   * на диск: сначала страниц с данными, затем мета-страницы. При значении 1
+   * в мета-страницу вместе с новой мета-информацией записывается опись
+   * записанных транзакцией страниц и их контрольная сумма, после чего
+   * данные и мета-страница сбрасываются на диск однократно. Мета-страница
+   * при этом записывается со слабой сигнатурой, а устойчивая сигнатура
+   * записывается после сброса и попадает на диск при следующей фиксации
+   * либо при закрытии БД. При открытии БД после сбоя страницы последней
+   * слабой фиксации проверяются по её описи: при совпадении фиксация
+   * становится устойчивой, иначе выполняется откат к предыдущей устойчивой
+   * точке фиксации, т.е. прерванная фиксация отбрасывается целиком.
+   *
+   * Опись вмещается в мета-страницу только при небольшом количестве
+   * непрерывных интервалов записанных страниц (около 500 при размере
+   * страницы 4 КиБ), поэтому однократный сброс применяется к небольшим
+   * транзакциям, для которых сокращение задержки фиксации наиболее заметно,
+   * а большие транзакции фиксируются обычным образом. Также однократный
+   * сброс не применяется в режимах \ref MDBX_WRITEMAP, \ref MDBX_SAFE_NOSYNC
+   * и \ref MDBX_NOMETASYNC, либо при наличии не сброшенных на диск данных
+   * предыдущих транзакций.
+   *
+   * Проверка описи выполняется при открытии БД независимо от значения
+   * опции. Версии libmdbx без поддержки этой опции опись игнорируют и после
+   * сбоя откатывают такую фиксацию как любую слабую, т.е. без повреждения БД,
+   * но с потерей последней фиксации. На платформе
+   * Windows попытка установить ненулевое значение вернет \ref MDBX_ENOSYS.
+   *
+   * min 0 (выключено), max 1, default = 0 */
+  MDBX_opt_single_flush,
+
+  /** \brief Управляет упаковкой последовательностей смежных страниц в записях GC.
+   *
+   * Освобождаемые и возвращаемые в GC страницы хранятся в записях, ключами
+   * которых являются номера транзакций, а значениями списки номеров страниц.
+   * При освобождении или возврате миллионов страниц такие списки занимают
+   * множество больших записей, на резервирование и заполнение которых при
+   * фиксации транзакции уходит основное время обновления GC. При значении 1
+   * каждая последовательность из трёх и более смежных страниц записывается
+   * парой из номера первой страницы и длины, поэтому размер записей GC, их
+   * количество и итерации обновления GC пропорциональны количеству таких
+   * непрерывных интервалов (экстентов), а не количеству страниц. Списки
+   * страниц внутри транзакции при этом остаются прежними, а упакованные
+   * записи распаковываются при переработке GC.
+   *
+   * Записи в обоих форматах читаются независимо от значения опции, поэтому
+   * опцию можно изменять в любой момент. При первой пишущей транзакции после
+   * включения опции все мета-страницы помечаются новой версией формата БД,
+   * и лишь затем в GC помещаются упакованные записи. Такую БД версии libmdbx
+   * без поддержки этой опции (включая утилиту `mdbx_chk`) отказываются
+   * открывать, возвращая \ref MDBX_VERSION_MISMATCH. Пометка сохраняется и
+   * после выключения опции, так как в GC могут оставаться упакованные записи,
+   * а снять её можно только копированием БД с компактификацией, см.
+   * \ref MDBX_CP_COMPACT.
+   *
+   * min 0 (выключено), max 1, default = 0 */
+  MDBX_opt_gc_extents
 } MDBX_option_t;
 
 /** \brief Sets the value of a extra runtime options for an environment.
@@ -2487,6 +2689,16 @@ LIBMDBX_API int mdbx_env_get_option(const MDBX_env *env, const MDBX_option_t opt
  * page size) then \ref mdbx_env_open() will return \ref MDBX_INCOMPATIBLE
  * error.
  *
+ * \note On Linux the data file could be a raw block device (or a symlink to it),
+ *       e.g. a directory with the `mdbx.dat` symlink to a dedicated device,
+ *       while the lock file is created as usual beside the given pathname.
+ *       In such case the database geometry is fixed by the device capacity,
+ *       i.e. the database is never grown nor shrunk and the parameters given
+ *       by \ref mdbx_env_set_geometry() are ignored except the page size.
+ *       A blank (zeroed) device is treated as an empty file, so a new database
+ *       is created on it if the `mode` is non-zero. On other OSes an attempt
+ *       to open a block device fails with \ref MDBX_ENOSYS.
+ *
  * \param [in] mode   The UNIX permissions to set on created files.
  *                    Zero value means to open existing, but do not create.
  *
@@ -2529,6 +2741,32 @@ LIBMDBX_API int mdbx_env_openW(MDBX_env *env, const wchar_t *pathname, MDBX_env_
 #define mdbx_env_openT(env, pathname, flags, mode) mdbx_env_open(env, pathname, flags, mode)
 #endif /* Windows */
 
+/** \brief Open an anonymous in-memory environment.
+ * \ingroup c_opening
+ *
+ * The database and lock files are created as anonymous memory files
+ * (i.e. by `memfd_create()`), which exist only within the current process and
+ * vanish when the environment is closed. Thus the environment provides an
+ * ordered in-memory key-value storage with the same API and MVCC semantics,
+ * but without any files in a filesystem and without any syncing to disk.
+ *
+ * The environment is opened with \ref MDBX_EXCLUSIVE and
+ * \ref MDBX_UTTERLY_NOSYNC, and \ref mdbx_env_sync() does nothing for it.
+ * Geometry and other options should be set beforehand as for
+ * \ref mdbx_env_open(), the \ref mdbx_env_get_path() returns an empty string.
+ *
+ * \param [in] env    An environment handle returned by \ref mdbx_env_create().
+ * \param [in] flags  Special options for this environment, the same as for
+ *                    \ref mdbx_env_open() except \ref MDBX_RDONLY and
+ *                    \ref MDBX_ACCEDE.
+ *
+ * \returns A non-zero error value on failure and 0 on success,
+ *          some possible errors are:
+ * \retval MDBX_ENOSYS  Anonymous memory files are not supported
+ *                      by the platform.
+ * \retval MDBX_EINVAL  An invalid or unsuitable flags was specified. */
+LIBMDBX_API int mdbx_env_open_anonymous(MDBX_env *env, MDBX_env_flags_t flags);
+
 /** \brief Deletion modes for \ref mdbx_env_delete().
  * \ingroup c_extra
  * \see mdbx_env_delete() */
@@ -2760,6 +2998,53 @@ LIBMDBX_API int mdbx_env_copy2fd(MDBX_env *env, mdbx_filehandle_t fd, MDBX_copy_
  * \returns A non-zero error value on failure and 0 on success. */
 LIBMDBX_API int mdbx_txn_copy2fd(MDBX_txn *txn, mdbx_filehandle_t fd, MDBX_copy_flags_t flags);
 
+/** \brief Performs a bounded step of online defragmentation.
+ * \ingroup c_extra
+ *
+ * Unlike the \ref mdbx_env_copy() with \ref MDBX_CP_COMPACT this function
+ * compacts the database in place, by ordinary write transactions, i.e.
+ * without blocking readers. Each call runs a write transaction which
+ * relocates up to `budget` pages in use from the tail of the database, i.e.
+ * beyond the size of the fully compacted database, into the free pages with
+ * the lowest numbers. The leaf pages are visited in the order of keys, so the
+ * relocated leaves of a table are laid out sequentially. The pages freed from
+ * the tail are returned to the unallocated space by subsequent calls, once
+ * they are not used by readers, after which the database file is shrunk
+ * according to the \ref mdbx_env_set_geometry() "shrink threshold". The pages
+ * freed by a transaction become reusable only after a subsequent write
+ * transaction is committed, while the function doesn't commit transactions
+ * without changes for that. So the completion of defragmentation requires
+ * other write transactions, either of the application or of the next calls.
+ *
+ * Therefore this function should be called repeatedly, for instance
+ * periodically in the background, until the \ref MDBX_RESULT_TRUE is
+ * returned. All named tables are opened by the function, so the
+ * \ref MDBX_opt_max_db should allow that, otherwise the tables which could
+ * not be opened are skipped.
+ *
+ * \note Long-lived read transactions prevent both reuse of the free pages
+ *       for relocation and returning the tail pages to the unallocated space.
+ *       See long-lived transactions under \ref restrictions section.
+ *
+ * \param [in] env     An environment handle returned by mdbx_env_create().
+ *                     It must have already been opened successfully.
+ * \param [in] budget  The maximum number of pages to relocate by this call,
+ *                     which must be greater than zero.
+ *
+ * \returns A non-zero error value on failure and 0 on success, i.e. when
+ *          some pages were relocated or returned to the unallocated space, or
+ *          the freed tail pages are waiting for a commit of a write
+ *          transaction, some possible errors are:
+ * \retval MDBX_RESULT_TRUE      Nothing was relocated or is pending, i.e.
+ *                               either the database is already compact or
+ *                               there are no free pages to relocate into at
+ *                               the moment, e.g. because of readers.
+ * \retval MDBX_EINVAL           The `budget` is zero.
+ * \retval MDBX_EACCESS          The environment is opened in read-only mode.
+ * \retval MDBX_TXN_OVERLAPPING  The calling thread already has
+ *                               a transaction. */
+LIBMDBX_API int mdbx_env_defrag(MDBX_env *env, size_t budget);
+
 /** \brief Statistics for a table in the environment
  * \ingroup c_statinfo
  * \see mdbx_env_stat_ex() \see mdbx_dbi_stat() */
@@ -2824,6 +3109,10 @@ struct MDBX_envinfo {
   uint64_t mi_recent_txnid;             /**< ID of the last committed transaction */
   uint64_t mi_latter_reader_txnid;      /**< ID of the last reader transaction */
   uint64_t mi_self_latter_reader_txnid; /**< ID of the last reader transaction of this/current process */
+  /** IDs of transactions and signatures of the three meta-pages.
+   * \details A signature is zero for a meta-page which is not used,
+   * one for a weak (non-steady) commit, which is not flushed to disk yet,
+   * otherwise the commit is steady. */
   uint64_t mi_meta_txnid[3], mi_meta_sign[3];
   uint32_t mi_maxreaders;   /**< Total reader slots in the environment */
   uint32_t mi_numreaders;   /**< Max reader slots used in the environment */
@@ -2890,6 +3179,80 @@ struct MDBX_envinfo {
   struct {
     uint64_t x, y;
   } mi_dxbid;
+
+  /** Statistics of prefetching pages for sequential scans by cursors
+   * within the current process, see \ref MDBX_opt_prefetch_window.
+   * \details This and the following fields are absent in the structure of
+   * previous versions, therefore \ref mdbx_env_info_ex() also accepts
+   * a shorter size, down to `offsetof(MDBX_envinfo, mi_prefetch_stat)`. */
+  struct {
+    uint64_t issued; /**< Quantity of pages which prefetch was requested for */
+    uint64_t hits;   /**< Quantity of leaf pages reached by sequential scans after prefetch */
+    uint64_t misses; /**< Quantity of leaf pages reached by sequential scans without prefetch */
+  } mi_prefetch_stat;
+
+  /** Statistics of cursor repositioning by a finger search within the current
+   * process, i.e. when a searched key is out of the current leaf page and the
+   * search starts from the nearest suitable page of the cursor stack instead
+   * of the root. */
+  struct {
+    uint64_t searches;     /**< Number of finger searches */
+    uint64_t levels_saved; /**< Total number of tree levels not passed
+                                in comparison to a search from the root */
+  } mi_finger_stat;
+
+  /** Statistics of \ref mdbx_cache_get() within the current process. */
+  struct {
+    uint64_t hits;          /**< Lookups answered by a cache entry
+                                 without searching the tree */
+    uint64_t misses;        /**< Lookups with an empty or inapplicable entry */
+    uint64_t invalidations; /**< Lookups with an entry which becomes outdated
+                                 since the table was changed */
+  } mi_cache_stat;
+
+  /** Statistics of searching sequences of free pages within the GC-reclaimed
+   * list during allocation of multi-page (large/overflow) values by write
+   * transactions within the current process. */
+  struct {
+    uint64_t searches; /**< Number of searches for a sequence of pages */
+    uint64_t steps;    /**< Total number of list items or index probes
+                            examined by the searches */
+    uint64_t rebuilds; /**< Number of rebuilds of the length-ordered index
+                            of sequences used for long lists */
+    uint64_t growths;  /**< Number of multi-page allocations served from the
+                            unallocated tail or by growth of the datafile
+                            since no suitable sequence was found */
+  } mi_gc_seq_stat;
+
+  /** Current memory usage of the slab for dirty pages within the current
+   * process, see \ref MDBX_opt_dp_slab. */
+  struct {
+    uint64_t bytes;   /**< Size of memory mapped for the slab chunks */
+    uint64_t chunks;  /**< Number of the slab chunks */
+    uint64_t used;    /**< Number of pages allocated from the slab */
+    uint64_t hugetlb; /**< Number of the slab chunks backed by explicit
+                           huge pages (`MAP_HUGETLB` or `MEM_LARGE_PAGES`) */
+  } mi_dp_slab;
+
+  /** Usage of huge pages by the mapping of the database within the current
+   * process, see \ref MDBX_opt_dxb_hugepages. */
+  struct {
+    uint64_t advised;  /**< Size of the mapping for which huge pages are
+                            requested, or zero if they are not used */
+    uint64_t resident; /**< Size of the mapping currently backed by huge
+                            pages, i.e. mapped by a single TLB entry per 2 MiB
+                            (Linux only, is taken from `/proc/self/smaps`
+                            at most once per second) */
+  } mi_dxb_hugepages;
+
+  /** Statistics of writes through the file descriptor opened with `O_DSYNC`
+   * within the current process, see \ref MDBX_opt_writethrough_threshold.
+   * \details Each such write is completed by flushing the data to disk,
+   * but it is not counted as an explicit fsync-operation within
+   * \ref mi_pgop_stat. */
+  struct {
+    uint64_t writes; /**< Number of write operations (not a pages) */
+  } mi_dsync_stat;
 };
 #ifndef __cplusplus
 /** \ingroup c_statinfo */
@@ -3262,6 +3625,31 @@ typedef enum MDBX_warmup_flags {
 
   /** Release the lock that was performed before by \ref MDBX_warmup_lock. */
   MDBX_warmup_release = 16,
+
+  /** Interleave the database pages between NUMA nodes while peeking ones
+   * by \ref MDBX_warmup_force. The pages are peeked in 2 MiB stripes
+   * round-robin by threads pinned to CPUs of each NUMA node, so as the OS
+   * kernel places every loaded page in memory of the node which touches it
+   * first. Therefore the pages are distributed evenly over all nodes instead
+   * of memory of the single node where the calling thread is running.
+   * \note Has effect only on Linux with conjunction to \ref MDBX_warmup_force
+   * option and only for pages which are not yet in the page cache. Otherwise,
+   * including a system with the single NUMA node, the pages are peeked by the
+   * calling thread. */
+  MDBX_warmup_numa = 32,
+
+  /** Replay the profile saved before by \ref mdbx_env_warmup_save() instead
+   * of handling the whole allocated portion of the database. The OS kernel is
+   * asked to asynchronously prefetch only the pages which were resident in
+   * memory at the time the profile was saved, so a lot of read requests are
+   * issued at once, and with \ref MDBX_warmup_force such pages are also
+   * peeked to be loaded. This way the working set is restored quickly after
+   * a restart without reading the rest of the database.
+   * \note Has effect only on POSIX systems which provide `mincore()`,
+   * otherwise \ref MDBX_ENOSYS is returned. If the profile file is absent,
+   * then \ref MDBX_ENOFILE is returned, and \ref MDBX_INVALID for a profile
+   * of other database. */
+  MDBX_warmup_profile = 64,
 } MDBX_warmup_flags_t;
 DEFINE_ENUM_FLAG_OPERATORS(MDBX_warmup_flags)
 
@@ -3286,7 +3674,8 @@ DEFINE_ENUM_FLAG_OPERATORS(MDBX_warmup_flags)
  * \param [in] timeout_seconds_16dot16  Optional timeout which checking only
  *                              during explicitly peeking database pages
  *                              for loading ones if the \ref MDBX_warmup_force
- *                              option was specified.
+ *                              option was specified, or while replaying
+ *                              a profile with \ref MDBX_warmup_profile.
  *
  * \returns A non-zero error value on failure and 0 on success.
  * Some possible errors are:
@@ -3299,6 +3688,112 @@ DEFINE_ENUM_FLAG_OPERATORS(MDBX_warmup_flags)
 LIBMDBX_API int mdbx_env_warmup(const MDBX_env *env, const MDBX_txn *txn, MDBX_warmup_flags_t flags,
                                 unsigned timeout_seconds_16dot16);
 
+/** \brief Saves a profile of the database pages resident in memory,
+ * to be replayed later by \ref mdbx_env_warmup() with
+ * \ref MDBX_warmup_profile.
+ * \ingroup c_settings
+ *
+ * The residency of pages is sampled by `mincore()` and saved as a compact
+ * list of page extents into the file next to the database, i.e. the name of
+ * the data file with \ref MDBX_WARMUP_SUFFIX appended. The previous profile
+ * is atomically replaced. It is reasonable to save the profile periodically
+ * or before a planned shutdown, once the working set is in memory.
+ *
+ * \param [in] env   An environment handle returned
+ *                   by \ref mdbx_env_create().
+ *
+ * \returns A non-zero error value on failure and 0 on success.
+ * Some possible errors are:
+ *
+ * \retval MDBX_ENOSYS   The system does not provide `mincore()`. */
+LIBMDBX_API int mdbx_env_warmup_save(const MDBX_env *env);
+
+/** \brief Options of warming up a table along its b-tree structure.
+ * \ingroup c_settings
+ * \see mdbx_dbi_warmup() */
+typedef enum MDBX_warmup_tree_flags {
+  /** By default only the branch pages are loaded, which are needed to look up
+   * any key, while the leaf pages are left as is. */
+  MDBX_warmup_tree_branches = 0,
+
+  /** Load the leaf pages in addition to the branch ones. */
+  MDBX_warmup_tree_leaves = 1,
+
+  /** Load the large/overflow pages of long values.
+   * \note The leaf pages referencing such values are also loaded. */
+  MDBX_warmup_tree_large = 2,
+
+  /** Descend into the nested b-trees of multi-values of tables with
+   * \ref MDBX_DUPSORT, loading ones in the same way.
+   * \note The leaf pages referencing the nested b-trees are also loaded,
+   * while the leaves of the nested b-trees are loaded only with
+   * \ref MDBX_warmup_tree_leaves. */
+  MDBX_warmup_tree_nested = 4,
+
+  /** Descend into all named tables, which are referenced by the main table.
+   * \note Has effect only for the main table, i.e. the DBI-handle returned
+   * by \ref mdbx_dbi_open() for `NULL` name. So the whole database may be
+   * warmed up by a single call. */
+  MDBX_warmup_tree_tables = 8,
+} MDBX_warmup_tree_flags_t;
+DEFINE_ENUM_FLAG_OPERATORS(MDBX_warmup_tree_flags)
+
+/** \brief A callback function to report the progress of
+ * \ref mdbx_dbi_warmup().
+ * \ingroup c_settings
+ *
+ * The callback is called after every thousand or so of loaded pages and once
+ * at the end, in the latter case the `pending` is zero. The calls are
+ * serialized, but may be made from any of the warming up threads.
+ *
+ * \param [in] ctx      A pointer to the context passed to
+ *                      \ref mdbx_dbi_warmup().
+ * \param [in] loaded   The number of database pages loaded so far.
+ * \param [in] pending  The number of pages which are known but not loaded yet,
+ *                      i.e. a lower bound of the remaining work.
+ *
+ * \returns Zero to continue, otherwise the warming up will be stopped and
+ * the returned value will be returned from \ref mdbx_dbi_warmup(). */
+typedef int(MDBX_warmup_progress_func)(void *ctx, size_t loaded, size_t pending) MDBX_CXX17_NOEXCEPT;
+
+/** \brief Warms up a table by loading its pages into memory
+ * along the b-tree structure.
+ * \ingroup c_settings
+ *
+ * Unlike \ref mdbx_env_warmup(), which handles the allocated portion of the
+ * database as a flat range including unused pages, this function walks the
+ * b-tree of the table top-down from the root and loads only the pages
+ * selected by `flags` and `levels`. For instance, the branch pages of all
+ * tables may be loaded first, since ones are needed for any lookup, and the
+ * leaf pages of the hot tables after that.
+ *
+ * The pages are loaded by `threads` concurrently, so as a storage device
+ * receives many read requests at once that is needed to reach its
+ * throughput, especially for NVMe.
+ *
+ * \param [in] txn       A transaction handle returned
+ *                       by \ref mdbx_txn_begin().
+ * \param [in] dbi       A table handle returned by \ref mdbx_dbi_open().
+ * \param [in] flags     The \ref MDBX_warmup_tree_flags_t,
+ *                       bitwise OR'ed together.
+ * \param [in] levels    The number of the b-tree levels from the root to be
+ *                       loaded, for the nested b-trees and the named tables
+ *                       levels are counted from their own roots.
+ *                       Zero means all levels.
+ * \param [in] threads   The number of threads to load pages, including the
+ *                       calling one. Additional threads are used only for
+ *                       read-only transactions. Larger values are clamped
+ *                       to 64, that could be changed by the
+ *                       `MDBX_WARMUP_THREADS_MAX` build option.
+ * \param [in] progress  An optional callback function to report progress
+ *                       and to stop the warming up.
+ * \param [in] ctx       A context pointer passed to the `progress`.
+ *
+ * \returns A non-zero error value on failure and 0 on success,
+ * or the non-zero value returned by the `progress` callback. */
+LIBMDBX_API int mdbx_dbi_warmup(const MDBX_txn *txn, MDBX_dbi dbi, MDBX_warmup_tree_flags_t flags, unsigned levels,
+                                unsigned threads, MDBX_warmup_progress_func *progress, void *ctx);
+
 /** \brief Set environment flags.
  * \ingroup c_settings
  *
@@ -3563,6 +4058,8 @@ LIBMDBX_API int mdbx_env_get_fd(const MDBX_env *env, mdbx_filehandle_t *fd);
  *                        geometry, but there read transaction(s) is running
  *                        and no corresponding thread(s) could be suspended
  *                        since the \ref MDBX_NOSTICKYTHREADS mode is used.
+ *                        Also for a database placed on a raw block device,
+ *                        since its geometry is fixed by the device capacity.
  * \retval MDBX_EACCESS   The environment opened in read-only.
  * \retval MDBX_MAP_FULL  Specified size smaller than the space already
  *                        consumed by the environment.
@@ -4191,6 +4688,59 @@ typedef struct MDBX_commit_latency MDBX_commit_latency;
  * \warning This function may be changed in future releases. */
 LIBMDBX_API int mdbx_txn_commit_ex(MDBX_txn *txn, MDBX_commit_latency *latency);
 
+/** \brief Статистика фиксации пишущей транзакции, включая вложенные транзакции.
+ * \ingroup c_statinfo
+ * \details Размер структуры передаётся в \ref mdbx_txn_commit_ex2(), что
+ * позволяет расширять её добавлением полей в конец без нарушения ABI,
+ * в отличие от \ref MDBX_commit_latency.
+ * \see mdbx_txn_commit_ex2() */
+struct MDBX_commit_stat {
+  /** \brief Статистика выталкивания грязных страниц на диск в транзакции,
+   * см \ref MDBX_opt_spill_policy.
+   * \details Отношение `unspilled / spilled` показывает долю напрасно
+   * вытолкнутых страниц, к которым пришлось вернуться. */
+  struct {
+    /** \brief Количество вытолкнутых страниц. */
+    uint32_t spilled;
+    /** \brief Количество возвращенных страниц, ранее вытолкнутых. */
+    uint32_t unspilled;
+    /** \brief Количество выполненных выталкиваний. */
+    uint32_t rounds;
+  } spill;
+
+  /** \brief Задержки увеличения файла БД в транзакции,
+   * см \ref MDBX_opt_dxb_preallocate. */
+  struct {
+    /** \brief Суммарное время увеличения файла и переотображения
+     * в 1/65536 долях секунды. */
+    uint32_t time;
+    /** \brief Количество увеличений файла. */
+    uint32_t count;
+  } resize;
+};
+#ifndef __cplusplus
+/** \ingroup c_statinfo */
+typedef struct MDBX_commit_stat MDBX_commit_stat;
+#endif
+
+/** \brief Commit all the operations of a transaction into the database and
+ * collect latency information and statistics.
+ * \see mdbx_txn_commit_ex()
+ * \ingroup c_transactions
+ *
+ * \param [in] txn      A transaction handle returned by \ref mdbx_txn_begin().
+ * \param [out] latency The optional address of an \ref MDBX_commit_latency
+ *                      structure to return the latency information.
+ * \param [out] stat    The optional address of an \ref MDBX_commit_stat
+ *                      structure to return the statistics of the transaction.
+ * \param [in] bytes    The size of \ref MDBX_commit_stat.
+ *
+ * \returns The same as \ref mdbx_txn_commit(), and also \ref MDBX_EINVAL
+ *          if the given size is not acceptable, in which case
+ *          the transaction is not committed nor aborted. */
+LIBMDBX_API int mdbx_txn_commit_ex2(MDBX_txn *txn, MDBX_commit_latency *latency, MDBX_commit_stat *stat,
+                                    size_t bytes);
+
 /** \brief Commit all the operations of a transaction into the database.
  * \ingroup c_transactions
  *
@@ -4282,6 +4832,71 @@ LIBMDBX_API int mdbx_txn_abort(MDBX_txn *txn);
  * \returns A non-zero error value on failure and 0 on success. */
 LIBMDBX_API int mdbx_txn_break(MDBX_txn *txn);
 
+/** \brief Creates a savepoint within a write transaction.
+ * \ingroup c_transactions
+ *
+ * A savepoint is a lightweight alternative to a nested transaction used
+ * purely as a rollback point. Instead of cloning the state of the transaction,
+ * only table records are saved and then an undo log of newly allocated pages
+ * and previous images of changed dirty pages is maintained. So the cost is
+ * nearly zero unless \ref mdbx_txn_rollback_to() is called.
+ *
+ * Savepoints are nested, i.e. each next one gets the number one greater than
+ * the previous, and all of them are released on transaction commit or abort.
+ * While savepoints are active:
+ *  - nested transactions cannot be started;
+ *  - tables cannot be deleted by \ref mdbx_drop() nor renamed;
+ *  - pages which were in use before a savepoint are not reused within the
+ *    transaction until it ends.
+ *
+ * \param [in] txn         A write transaction handle returned
+ *                         by \ref mdbx_txn_begin().
+ * \param [out] savepoint  Address where the savepoint number (starting
+ *                         from 1) will be stored.
+ *
+ * \see mdbx_txn_rollback_to() \see mdbx_txn_release_savepoint()
+ * \returns A non-zero error value on failure and 0 on success. */
+LIBMDBX_API int mdbx_txn_savepoint(MDBX_txn *txn, size_t *savepoint);
+
+/** \brief Rolls back a write transaction to the given savepoint.
+ * \ingroup c_transactions
+ *
+ * All changes made after the savepoint are discarded, the savepoint itself
+ * remains active while all subsequent ones are released. The rollback is
+ * allowed even if the transaction was marked as failed since the savepoint
+ * by a recoverable error, i.e. \ref MDBX_MAP_FULL, \ref MDBX_TXN_FULL or
+ * \ref MDBX_KEYEXIST, and clears such state. After any other error the
+ * transaction remains failed and the rollback returns \ref MDBX_BAD_TXN.
+ *
+ * All cursors of the transaction become unpositioned, handles of tables
+ * created after the savepoint are closed, growth of the database file
+ * is not undone.
+ *
+ * \param [in] txn        A write transaction handle returned
+ *                        by \ref mdbx_txn_begin().
+ * \param [in] savepoint  A savepoint number returned
+ *                        by \ref mdbx_txn_savepoint().
+ *
+ * \returns A non-zero error value on failure and 0 on success,
+ *          some possible errors are:
+ * \retval MDBX_EINVAL   An invalid or already released savepoint.
+ * \retval MDBX_BAD_TXN  Transaction is already finished or never began,
+ *                       was failed by an unrecoverable error, or the undo
+ *                       log was broken by an earlier error. */
+LIBMDBX_API int mdbx_txn_rollback_to(MDBX_txn *txn, size_t savepoint);
+
+/** \brief Releases the savepoint and all subsequent ones while keeping
+ * the changes made after them.
+ * \ingroup c_transactions
+ *
+ * \param [in] txn        A write transaction handle returned
+ *                        by \ref mdbx_txn_begin().
+ * \param [in] savepoint  A savepoint number returned
+ *                        by \ref mdbx_txn_savepoint().
+ *
+ * \returns A non-zero error value on failure and 0 on success. */
+LIBMDBX_API int mdbx_txn_release_savepoint(MDBX_txn *txn, size_t savepoint);
+
 /** \brief Reset a read-only transaction.
  * \ingroup c_transactions
  *
@@ -4939,6 +5554,64 @@ LIBMDBX_API int mdbx_get_ex(const MDBX_txn *txn, MDBX_dbi dbi, MDBX_val *key, MD
  * \retval MDBX_EINVAL        An invalid parameter was specified. */
 LIBMDBX_API int mdbx_get_equal_or_great(const MDBX_txn *txn, MDBX_dbi dbi, MDBX_val *key, MDBX_val *data);
 
+/** \brief An entry of the lookup cache for \ref mdbx_cache_get().
+ * \ingroup c_crud
+ *
+ * The entry remembers a location of the value of a some key within the
+ * database together with the state of the table, in which the value was
+ * found. So the entry is associated with a particular key and a particular
+ * table by a caller, and must be used only for them.
+ *
+ * The fields are internal and should not be used directly. An entry should be
+ * initialized by \ref mdbx_cache_init() or simply zeroed before the first use.
+ * The entry is updated by \ref mdbx_cache_get() without any synchronization,
+ * therefore should not be used by several threads concurrently. */
+typedef struct MDBX_cache_entry {
+  uint64_t trunk_txnid; /**< Modification txnid of the table, zero for an empty entry */
+  uint32_t root;        /**< Root page of the table */
+  uint32_t length;      /**< Length of the value, `UINT32_MAX` for the absent key */
+  size_t offset;        /**< Offset of the value within the database */
+} MDBX_cache_entry_t;
+
+/** \brief Initializes an entry of the lookup cache.
+ * \ingroup c_crud
+ * \see mdbx_cache_get() */
+LIBMDBX_API void mdbx_cache_init(MDBX_cache_entry_t *entry);
+
+/** \brief Get an item from a table using a lookup cache entry.
+ * \ingroup c_crud
+ *
+ * This function does the same as \ref mdbx_get(), but checks the given cache
+ * entry firstly. If the table was not changed since the entry was filled in,
+ * then the result is returned from the entry without searching the tree.
+ * Otherwise the regular search is performed and the entry is updated.
+ * The entry is valid for any transactions (both older and newer) in which
+ * the table is in the same state, but is not used for a table modified
+ * within a current write transaction.
+ *
+ * The absence of the key is cached as well. The statistics of hits, misses
+ * and invalidations is available in \ref MDBX_envinfo::mi_cache_stat.
+ *
+ * \note Similar to \ref mdbx_get(), the memory pointed to by the returned
+ * value is owned by the database and it is valid only until a subsequent
+ * update operation, or the end of the transaction.
+ *
+ * \param [in] txn        A transaction handle returned by \ref mdbx_txn_begin().
+ * \param [in] dbi        A table handle returned by \ref mdbx_dbi_open().
+ * \param [in] key        The key to search for in the table.
+ * \param [out] data      The data corresponding to the key.
+ * \param [in,out] entry  The cache entry associated with the given key and
+ *                        table, see \ref MDBX_cache_entry_t.
+ *
+ * \returns A non-zero error value on failure and 0 on success,
+ *          some possible errors are:
+ * \retval MDBX_THREAD_MISMATCH  Given transaction is not owned
+ *                               by current thread.
+ * \retval MDBX_NOTFOUND  The key was not in the table.
+ * \retval MDBX_EINVAL    An invalid parameter was specified. */
+LIBMDBX_API int mdbx_cache_get(const MDBX_txn *txn, MDBX_dbi dbi, const MDBX_val *key, MDBX_val *data,
+                               MDBX_cache_entry_t *entry);
+
 /** \brief Store items into a table.
  * \ingroup c_crud
  *
@@ -4996,8 +5669,8 @@ LIBMDBX_API int mdbx_get_equal_or_great(const MDBX_txn *txn, MDBX_dbi dbi, MDBX_
  *  - \ref MDBX_MULTIPLE
  *      Store multiple contiguous data elements in a single request. This flag
  *      may only be specified if the table was opened with
- *      \ref MDBX_DUPFIXED. With combination the \ref MDBX_ALLDUPS
- *      will replace all multi-values.
+ *      \ref MDBX_DUPFIXED or \ref MDBX_DUPSORT (see below). With combination
+ *      the \ref MDBX_ALLDUPS will replace all multi-values.
  *      The data argument must be an array of two \ref MDBX_val. The `iov_len`
  *      of the first \ref MDBX_val must be the size of a single data element.
  *      The `iov_base` of the first \ref MDBX_val must point to the beginning
@@ -5007,6 +5680,15 @@ LIBMDBX_API int mdbx_get_equal_or_great(const MDBX_txn *txn, MDBX_dbi dbi, MDBX_
  *      number of data elements to store. On return this field will be set to
  *      the count of the number of elements actually written. The `iov_base` of
  *      the second \ref MDBX_val is unused.
+ *      For tables opened with \ref MDBX_DUPSORT but without
+ *      \ref MDBX_DUPFIXED the values of arbitrary size could be stored
+ *      in a single request too. In such case the `iov_len` of the first
+ *      \ref MDBX_val must be zero, and its `iov_base` must point to an array
+ *      of \ref MDBX_val with the data elements. The table is searched for
+ *      the key only once, then the elements are added to the nested
+ *      sub-page/sub-tree. Sorted elements are added faster, and
+ *      \ref MDBX_APPENDDUP could be used if all of them are greater than
+ *      the existing ones.
  *
  * \see \ref c_crud_hints "Quick reference for Insert/Update/Delete operations"
  *
@@ -5073,6 +5755,69 @@ LIBMDBX_API int mdbx_replace_ex(MDBX_txn *txn, MDBX_dbi dbi, const MDBX_val *key
                                 MDBX_val *old_data, MDBX_put_flags_t flags, MDBX_preserve_func preserver,
                                 void *preserver_context);
 
+/** \brief A callback function for in-place read-modify-write
+ * by \ref mdbx_update().
+ * \ingroup c_crud
+ *
+ * \param [in] context     A context pointer passed to \ref mdbx_update().
+ * \param [in] key         The key of the item being updated.
+ * \param [in,out] value   For an existing item it points to the current value
+ *                         placed in a modifiable (dirty) page, so the value
+ *                         could be changed in place by writing within
+ *                         `value->iov_len` bytes at `value->iov_base`.
+ *                         For an absent item it is set to `{NULL, 0}`.
+ *                         To store a value of another size or to insert
+ *                         a new item the callback should point it to
+ *                         the new data placed outside the current value.
+ * \param [in] exists      True if an item with the given key exists.
+ *
+ * \returns The callback should return:
+ * \retval MDBX_SUCCESS      to keep the value changed in place,
+ *                           or to store the new value given by `value`.
+ * \retval MDBX_RESULT_TRUE  to delete the item, or do nothing
+ *                           if it is absent.
+ * \retval OTHER             any other value is returned by \ref mdbx_update()
+ *                           to the caller without making any further changes,
+ *                           so the value should not be changed in place
+ *                           in such case. */
+typedef int(MDBX_update_func)(void *context, const MDBX_val *key, MDBX_val *value,
+                              bool exists) MDBX_CXX17_NOEXCEPT;
+
+/** \brief Updates an item in a table in place with a read-modify-write
+ * callback.
+ * \ingroup c_crud
+ *
+ * This function is a merge-operator like alternative to the pair of
+ * \ref mdbx_get() and \ref mdbx_put() or to the \ref mdbx_replace() for
+ * counters and small structures. The table is searched only once, then
+ * the pages containing an existing item are touched (i.e. made dirty)
+ * and the callback is given a pointer to the value inside the modifiable
+ * page, so neither the second search nor copying through user buffers are
+ * required unless the size of the value is changed.
+ *
+ * \note The callback must not use the transaction, in particular it must not
+ * perform any operations with the table being updated.
+ *
+ * \param [in] txn      A write transaction handle returned
+ *                      by \ref mdbx_txn_begin().
+ * \param [in] dbi      A table handle returned by \ref mdbx_dbi_open().
+ *                      Tables with \ref MDBX_DUPSORT flag are not supported.
+ * \param [in] key      The key of the item to update.
+ * \param [in] updater  The callback function, see \ref MDBX_update_func.
+ * \param [in] context  An arbitrary context pointer for the callback.
+ *
+ * \returns A non-zero error value on failure and 0 on success,
+ *          some possible errors are:
+ * \retval MDBX_INCOMPATIBLE  The table was created with \ref MDBX_DUPSORT.
+ * \retval MDBX_MAP_FULL      The database is full,
+ *                            see \ref mdbx_env_set_mapsize().
+ * \retval MDBX_TXN_FULL      The transaction has too many dirty pages.
+ * \retval MDBX_EACCES        An attempt was made to write
+ *                            in a read-only transaction.
+ * \retval MDBX_EINVAL        An invalid parameter was specified. */
+LIBMDBX_API int mdbx_update(MDBX_txn *txn, MDBX_dbi dbi, const MDBX_val *key, MDBX_update_func *updater,
+                            void *context);
+
 /** \brief Delete items from a table.
  * \ingroup c_crud
  *
@@ -5697,6 +6442,142 @@ LIBMDBX_API int mdbx_cursor_scan_from(MDBX_cursor *cursor, MDBX_predicate_func *
 LIBMDBX_API int mdbx_cursor_get_batch(MDBX_cursor *cursor, size_t *count, MDBX_val *pairs, size_t limit,
                                       MDBX_cursor_op op);
 
+/** \brief Modes of merging the sorted lists of multi-values by
+ * \ref mdbx_cursor_merge_batch().
+ * \ingroup c_crud */
+typedef enum MDBX_merge_mode {
+  /** Only the values present in all lists, i.e. the intersection. */
+  MDBX_MERGE_INTERSECTION = 0,
+
+  /** The values present in any of lists without repetitions, i.e. the union. */
+  MDBX_MERGE_UNION = 1
+} MDBX_merge_mode_t;
+
+/** \brief Merges the sorted lists of multi-values by several cursors
+ * and retrieves the results in batches.
+ * \ingroup c_crud
+ *
+ * This function is intended for intersection or union of posting lists of an
+ * inverted index stored in \ref MDBX_DUPSORT tables (in particular with
+ * \ref MDBX_DUPFIXED and/or \ref MDBX_INTEGERDUP), where each list is the
+ * multi-values of a some key. Before the first call, each cursor should be
+ * positioned to the key of its list, for instance by \ref MDBX_SET.
+ * The values are merged starting from the current positions of cursors.
+ *
+ * The cursors skip the mismatched values by galloping forward like the
+ * \ref MDBX_TO_EXACT_KEY_VALUE_GREATER_OR_EQUAL, but without re-searching a
+ * key, and for \ref MDBX_DUPFIXED pages the search is performed directly
+ * within the page's array of fixed-size values, which is vectorized for
+ * \ref MDBX_INTEGERDUP.
+ *
+ * \note The memory pointed to by the returned values is owned by the
+ * database, as described for \ref mdbx_cursor_get_batch().
+ *
+ * \param [in] cursors        The array of cursors handles, each of which must
+ *                            be bound to the same transaction and to a table
+ *                            with \ref MDBX_DUPSORT and the same order of
+ *                            multi-values.
+ * \param [in] cursors_count  The number of cursors.
+ * \param [in] mode           The mode of merge \ref MDBX_merge_mode_t.
+ * \param [out] count         The number of values returned.
+ * \param [in,out] values     A pointer to the array of values.
+ * \param [in] limit          The size of values buffer as the number of items.
+ * \param [in] after          The last value of the previous batch to continue
+ *                            merging, or `NULL` to start from the current
+ *                            positions of cursors.
+ *
+ * \returns A non-zero error value on failure and 0 on success,
+ *          some possible errors are:
+ * \retval MDBX_RESULT_TRUE      The returned chunk is the last one,
+ *                               and there are no values left.
+ * \retval MDBX_ENODATA          Some of cursors is not positioned.
+ * \retval MDBX_INCOMPATIBLE     Some of cursors is not for a \ref MDBX_DUPSORT
+ *                               table, or the multi-values are ordered
+ *                               differently.
+ * \retval MDBX_EINVAL           An invalid parameter was specified. */
+LIBMDBX_API int mdbx_cursor_merge_batch(MDBX_cursor *const *cursors, size_t cursors_count, MDBX_merge_mode_t mode,
+                                        size_t *count, MDBX_val *values, size_t limit, const MDBX_val *after);
+
+/** \brief Encodings of the 4- or 8-byte numbers aggregated by
+ * \ref mdbx_cursor_aggregate().
+ * \ingroup c_crud */
+typedef enum MDBX_aggregate_encoding {
+  /** Unsigned integers in the native byte order, i.e. as is. */
+  MDBX_AGGREGATE_UNSIGNED = 0,
+
+  /** Signed integers encoded by \ref mdbx_key_from_int64() or
+   * \ref mdbx_key_from_int32(). */
+  MDBX_AGGREGATE_SIGNED = 1,
+
+  /** IEEE-754 floating-point numbers encoded by \ref mdbx_key_from_double(),
+   * \ref mdbx_key_from_float() or \ref mdbx_key_from_jsonInteger(). */
+  MDBX_AGGREGATE_FLOATING = 2
+} MDBX_aggregate_encoding_t;
+
+/** \brief A number of the aggregate, which member is used depends on the
+ * \ref MDBX_aggregate_encoding_t.
+ * \ingroup c_crud */
+typedef union MDBX_aggregate_value {
+  uint64_t u; /**< For \ref MDBX_AGGREGATE_UNSIGNED */
+  int64_t i;  /**< For \ref MDBX_AGGREGATE_SIGNED */
+  double f;   /**< For \ref MDBX_AGGREGATE_FLOATING */
+} MDBX_aggregate_value_t;
+
+/** \brief The results of \ref mdbx_cursor_aggregate().
+ * \ingroup c_crud */
+typedef struct MDBX_aggregate {
+  uint64_t count;             /**< The number of aggregated items */
+  MDBX_aggregate_value_t sum; /**< The sum, integers wrap around modulo 2^64 */
+  MDBX_aggregate_value_t min; /**< The least item, if `count > 0` */
+  MDBX_aggregate_value_t max; /**< The greatest item, if `count > 0` */
+
+  /** The optional histogram provided by the caller, i.e. an array of
+   * `histogram_size` counters for the equal-width buckets from
+   * `histogram_lower` (inclusive) to `histogram_upper` (exclusive).
+   * The items out of these bounds are not counted. */
+  uint64_t *histogram;
+  size_t histogram_size;                  /**< Zero for no histogram */
+  MDBX_aggregate_value_t histogram_lower; /**< The lower bound of histogram */
+  MDBX_aggregate_value_t histogram_upper; /**< The upper bound of histogram */
+} MDBX_aggregate_t;
+
+/** \brief Aggregates a range of numbers, i.e. computes the count, sum,
+ * minimum, maximum and optionally a histogram.
+ * \ingroup c_crud
+ *
+ * For a table with \ref MDBX_DUPSORT the multi-values of the current key
+ * are aggregated, so the table must be with \ref MDBX_INTEGERDUP and the
+ * cursor must be positioned. Otherwise, the keys of the table are aggregated,
+ * so the table must be with \ref MDBX_INTEGERKEY. In both cases the items
+ * must be ordered by the builtin comparator.
+ *
+ * The items are processed directly within the pages, without retrieving each
+ * of them as \ref MDBX_val. For \ref MDBX_DUPFIXED pages the loops over the
+ * page's array of fixed-size items are vectorized by compiler.
+ *
+ * \param [in] cursor     A cursor handle returned by \ref mdbx_cursor_open().
+ * \param [in] encoding   The encoding of numbers \ref MDBX_aggregate_encoding_t.
+ * \param [in] from       The lower bound (inclusive) of the range in the
+ *                        encoded form as stored in the table, or `NULL` to
+ *                        start from the first item.
+ * \param [in] to         The upper bound (exclusive) of the range in the
+ *                        encoded form as stored in the table, or `NULL` to
+ *                        continue up to the last item.
+ * \param [in,out] result The results, including the histogram settings.
+ *
+ * On success the cursor is positioned at the first item not less than `to`,
+ * or at the end of keys or multi-values if there is no such item.
+ *
+ * \returns A non-zero error value on failure and 0 on success,
+ *          some possible errors are:
+ * \retval MDBX_ENODATA       The cursor of \ref MDBX_DUPSORT table
+ *                            is not positioned.
+ * \retval MDBX_INCOMPATIBLE  The table is not suitable for aggregation.
+ * \retval MDBX_BAD_VALSIZE   The size of bounds mismatch the items.
+ * \retval MDBX_EINVAL        An invalid parameter was specified. */
+LIBMDBX_API int mdbx_cursor_aggregate(MDBX_cursor *cursor, MDBX_aggregate_encoding_t encoding, const MDBX_val *from,
+                                      const MDBX_val *to, MDBX_aggregate_t *result);
+
 /** \brief Store by cursor.
  * \ingroup c_crud
  *
@@ -5751,8 +6632,8 @@ LIBMDBX_API int mdbx_cursor_get_batch(MDBX_cursor *cursor, size_t *count, MDBX_v
  *  - \ref MDBX_MULTIPLE
  *      Store multiple contiguous data elements in a single request. This flag
  *      may only be specified if the table was opened with
- *      \ref MDBX_DUPFIXED. With combination the \ref MDBX_ALLDUPS
- *      will replace all multi-values.
+ *      \ref MDBX_DUPFIXED or \ref MDBX_DUPSORT (see below). With combination
+ *      the \ref MDBX_ALLDUPS will replace all multi-values.
  *      The data argument must be an array of two \ref MDBX_val. The `iov_len`
  *      of the first \ref MDBX_val must be the size of a single data element.
  *      The `iov_base` of the first \ref MDBX_val must point to the beginning
@@ -5762,6 +6643,15 @@ LIBMDBX_API int mdbx_cursor_get_batch(MDBX_cursor *cursor, size_t *count, MDBX_v
  *      number of data elements to store. On return this field will be set to
  *      the count of the number of elements actually written. The `iov_base` of
  *      the second \ref MDBX_val is unused.
+ *      For tables opened with \ref MDBX_DUPSORT but without
+ *      \ref MDBX_DUPFIXED the values of arbitrary size could be stored
+ *      in a single request too. In such case the `iov_len` of the first
+ *      \ref MDBX_val must be zero, and its `iov_base` must point to an array
+ *      of \ref MDBX_val with the data elements. The table is searched for
+ *      the key only once, then the elements are added to the nested
+ *      sub-page/sub-tree. Sorted elements are added faster, and
+ *      \ref MDBX_APPENDDUP could be used if all of them are greater than
+ *      the existing ones.
  *
  * \see \ref c_crud_hints "Quick reference for Insert/Update/Delete operations"
  *
@@ -6021,6 +6911,49 @@ LIBMDBX_API int mdbx_estimate_range(const MDBX_txn *txn, MDBX_dbi dbi, const MDB
  * \ingroup c_rqest */
 #define MDBX_EPSILON ((MDBX_val *)((ptrdiff_t)-1))
 
+/** \brief Splits a key range of a table into roughly equal-sized parts.
+ * \ingroup c_rqest
+ *
+ * The function picks up to `parts-1` boundary keys so that the given key
+ * range is divided into consecutive sub-ranges with approximately the same
+ * number of items. The boundaries are taken from separators of branch pages
+ * (or leaf page keys for a small range) at the b-tree level where the range
+ * spans enough entries, therefore only a few pages are read regardless of the
+ * table size. The results are intended to feed parallel workers with
+ * independent scans, exports, checks, etc.
+ *
+ * The `i`-th partition spans keys from `boundaries[i-1]` inclusive to
+ * `boundaries[i]` exclusive, where the first partition starts at `begin_key`
+ * and the last one ends at `end_key`. The boundary keys point to the database
+ * pages, i.e. are valid only until the end of the transaction or a change
+ * in the table, like results of \ref mdbx_get().
+ *
+ * Please see notes on accuracy of the result in the details
+ * of \ref c_rqest section.
+ *
+ * \param [in] txn         A transaction handle returned
+ *                         by \ref mdbx_txn_begin().
+ * \param [in] dbi         A table handle returned by \ref mdbx_dbi_open().
+ * \param [in] begin_key   The key of range beginning or NULL for explicit
+ *                         FIRST.
+ * \param [in] end_key     The key of range ending or NULL for explicit LAST.
+ * \param [in] parts       The desired number of partitions, at least 1.
+ * \param [out] boundaries An array of at least `parts-1` items to store
+ *                         the boundary keys, could be NULL if `parts == 1`.
+ * \param [out] estimated_items  An optional array of at least `parts` items
+ *                         to store estimated number of items
+ *                         for each partition.
+ * \param [out] count      The address to store the actual number
+ *                         of partitions, which could be less than
+ *                         requested for a small range.
+ *
+ * \returns A non-zero error value on failure and 0 on success.
+ * \retval MDBX_EINVAL  An invalid parameters was specified, including
+ *                      `begin_key` great than `end_key`. */
+LIBMDBX_API int mdbx_dbi_partition(const MDBX_txn *txn, MDBX_dbi dbi, const MDBX_val *begin_key,
+                                   const MDBX_val *end_key, size_t parts, MDBX_val *boundaries,
+                                   ptrdiff_t *estimated_items, size_t *count);
+
 /** \brief Determines whether the given address is on a dirty database page of
  * the transaction or not.
  * \ingroup c_statinfo
@@ -6582,6 +7515,12 @@ typedef struct MDBX_chk_context {
   MDBX_txn *txn;
   MDBX_chk_scope_t *scope;
   uint8_t scope_nesting;
+  /** Количество потоков для параллельного обхода дерева страниц,
+   * значения 0 и 1 соответствуют обходу в текущем потоке.
+   * \note Обход выполняется параллельно только в режиме только-чтения.
+   * Вызовы функций обратного вызова при этом сериализуются, т.е. никогда не
+   * выполняются одновременно, но могут происходить из разных потоков. */
+  unsigned threads;
   struct {
     size_t total_payload_bytes;
     size_t table_total, table_processed;
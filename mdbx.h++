@@ -3506,6 +3506,22 @@ public:
     writethrough_threshold = MDBX_opt_writethrough_threshold,
     /// \copydoc MDBX_opt_prefault_write_enable
     prefault_write_enable = MDBX_opt_prefault_write_enable,
+    /// \copydoc MDBX_opt_prefetch_window
+    prefetch_window = MDBX_opt_prefetch_window,
+    /// \copydoc MDBX_opt_dp_slab
+    dp_slab = MDBX_opt_dp_slab,
+    /// \copydoc MDBX_opt_spill_policy
+    spill_policy = MDBX_opt_spill_policy,
+    /// \copydoc MDBX_opt_dxb_hugepages
+    dxb_hugepages = MDBX_opt_dxb_hugepages,
+    /// \copydoc MDBX_opt_dxb_preallocate
+    dxb_preallocate = MDBX_opt_dxb_preallocate,
+    /// \copydoc MDBX_opt_dxb_direct_write
+    dxb_direct_write = MDBX_opt_dxb_direct_write,
+    /// \copydoc MDBX_opt_single_flush
+    single_flush = MDBX_opt_single_flush,
+    /// \copydoc MDBX_opt_gc_extents
+    gc_extents = MDBX_opt_gc_extents,
   };
 
   /// \copybrief mdbx_env_set_option()
@@ -3530,6 +3546,13 @@ public:
   /// environment is busy by other thread or none of the thresholds are reached.
   bool poll_sync_to_disk() { return sync_to_disk(false, true); }
 
+  /// \brief Performs a bounded step of online defragmentation.
+  /// \return `True` if nothing was relocated or is pending, i.e. the database
+  /// is already compact or the relocation is not possible at the moment, or
+  /// `false` if the defragmentation should be continued by a next call.
+  /// \see ::mdbx_env_defrag()
+  inline bool defrag(size_t budget);
+
   /// \brief Close a key-value map (aka table) handle. Normally
   /// unnecessary.
   ///
@@ -3627,6 +3650,31 @@ public:
 
   /// \brief Tries to start write (read-write) transaction without blocking.
   inline txn_managed try_start_write();
+
+  /// \brief Splits the map into roughly equal-sized key ranges and runs
+  /// the callback for each of them on a pool of threads.
+  ///
+  /// The partitioning is performed by \ref txn::partition() inside a
+  /// short-lived read transaction, then the boundary keys are copied and each
+  /// worker thread processes the assigned ranges in its own read transaction,
+  /// i.e. the callback is invoked as
+  /// `callback(txn &txn, map_handle map, const txn::key_range &range, size_t index)`.
+  /// Therefore the calling thread should not have an active read transaction,
+  /// and the snapshots seen by workers may differ if the map is modified
+  /// concurrently. The first exception thrown by the callback is rethrown
+  /// after all threads are joined.
+  ///
+  /// \param [in] map      A map handle to scan.
+  /// \param [in] parts    The desired number of partitions.
+  /// \param [in] threads  The number of worker threads, zero for the number
+  ///                      of hardware threads.
+  /// \param [in] callback A callable to process a partition.
+  template <typename CALLABLE>
+  inline void for_each_partition(map_handle map, size_t parts, unsigned threads, CALLABLE callback) const;
+
+protected:
+  static void run_in_parallel(size_t tasks, unsigned threads, void (*worker)(void *context, size_t task),
+                              void *context);
 };
 
 /// \brief Managed database environment.
@@ -3796,6 +3844,16 @@ public:
   /// \brief Start nested write transaction.
   txn_managed start_nested();
 
+  /// \brief Creates a savepoint within write transaction.
+  /// \returns The savepoint number for \ref rollback_to().
+  inline size_t savepoint();
+
+  /// \brief Rolls back write transaction to the given savepoint.
+  inline void rollback_to(size_t savepoint);
+
+  /// \brief Releases the savepoint while keeping the changes made after it.
+  inline void release_savepoint(size_t savepoint);
+
   /// \brief Opens cursor for specified key-value map handle.
   inline cursor_managed open_cursor(map_handle map) const;
 
@@ -4050,10 +4108,38 @@ public:
     put_multiple_samelength(map, key, vector.data(), vector.size(), mode);
   }
 
+  /// \brief Puts multiple values of arbitrary lengths for the key
+  /// of a multimap with a single search for the key.
+  inline size_t put_multiple(map_handle map, const slice &key, const slice *values, size_t values_count,
+                             put_mode mode, bool allow_partial = false) {
+    static_assert(sizeof(slice) == sizeof(MDBX_val), "Must be layout compatible with MDBX_val!");
+    return put_multiple_samelength(map, key, 0, values, values_count, mode, allow_partial);
+  }
+  void put_multiple(map_handle map, const slice &key, const ::std::vector<slice> &values, put_mode mode) {
+    put_multiple(map, key, values.data(), values.size(), mode);
+  }
+
   inline ptrdiff_t estimate(map_handle map, const pair &from, const pair &to) const;
   inline ptrdiff_t estimate(map_handle map, const slice &from, const slice &to) const;
   inline ptrdiff_t estimate_from_first(map_handle map, const slice &to) const;
   inline ptrdiff_t estimate_to_last(map_handle map, const slice &from) const;
+
+  /// \brief A key range of a map produced by \ref partition().
+  struct key_range {
+    /// \brief The first key of the range inclusive,
+    /// or \ref slice::invalid() for the map beginning.
+    slice from;
+    /// \brief The last key of the range exclusive,
+    /// or \ref slice::invalid() for the map ending.
+    slice to;
+    /// \brief Estimated number of items in the range.
+    ptrdiff_t approximate_quantity;
+  };
+
+  /// \brief Splits a key range of the map into roughly equal-sized parts.
+  /// \see mdbx_dbi_partition()
+  ::std::vector<key_range> partition(map_handle map, size_t parts, const slice &from = slice::invalid(),
+                                     const slice &to = slice::invalid()) const;
 };
 
 /// \brief Managed database transaction.
@@ -4118,6 +4204,21 @@ public:
     commit(&result);
     return result;
   }
+
+  using commit_stat = MDBX_commit_stat;
+
+  /// \brief Commit all the operations of a transaction into the database
+  /// and collect latency information and statistics.
+  void commit(commit_latency *, commit_stat *);
+
+  /// \brief Commit all the operations of a transaction into the database
+  /// and return statistics.
+  /// \returns statistics of the transaction.
+  commit_stat commit_get_stat() {
+    commit_stat result;
+    commit(nullptr, &result);
+    return result;
+  }
 };
 
 /// \brief Unmanaged cursor.
@@ -4513,6 +4614,17 @@ public:
   void put_multiple_samelength(const slice &key, const ::std::vector<VALUE> &vector, put_mode mode) {
     put_multiple_samelength(key, vector.data(), vector.size(), mode);
   }
+
+  /// \brief Puts multiple values of arbitrary lengths for the key
+  /// of a multimap with a single search for the key.
+  inline size_t put_multiple(const slice &key, const slice *values, size_t values_count, put_mode mode,
+                             bool allow_partial = false) {
+    static_assert(sizeof(slice) == sizeof(MDBX_val), "Must be layout compatible with MDBX_val!");
+    return put_multiple_samelength(key, 0, values, values_count, mode, allow_partial);
+  }
+  void put_multiple(const slice &key, const ::std::vector<slice> &values, put_mode mode) {
+    put_multiple(key, values.data(), values.size(), mode);
+  }
 };
 
 /// \brief Managed cursor.
@@ -5443,6 +5555,18 @@ inline bool env::sync_to_disk(bool force, bool nonblock) {
   }
 }
 
+inline bool env::defrag(size_t budget) {
+  const int err = ::mdbx_env_defrag(handle_, budget);
+  switch (err) {
+  case MDBX_SUCCESS /* some pages relocated or pending */:
+    return false;
+  case MDBX_RESULT_TRUE /* nothing to relocate */:
+    return true;
+  default:
+    MDBX_CXX20_UNLIKELY error::throw_exception(err);
+  }
+}
+
 inline void env::close_map(const map_handle &handle) { error::success_or_throw(::mdbx_dbi_close(*this, handle.dbi)); }
 
 MDBX_CXX11_CONSTEXPR
@@ -5488,6 +5612,35 @@ inline env &env::set_HandleSlowReaders(MDBX_hsr_func *cb) {
 
 inline MDBX_hsr_func *env::get_HandleSlowReaders() const noexcept { return ::mdbx_env_get_hsr(handle_); }
 
+template <typename CALLABLE>
+inline void env::for_each_partition(map_handle map, size_t parts, unsigned threads, CALLABLE callback) const {
+  ::std::vector<txn::key_range> ranges;
+  ::std::vector<::std::string> boundaries;
+  {
+    auto txn = start_read();
+    ranges = txn.partition(map, parts);
+    boundaries.reserve(ranges.size());
+    for (const auto &range : ranges)
+      boundaries.emplace_back(range.from.is_valid() ? ::std::string(range.from.char_ptr(), range.from.length())
+                                                    : ::std::string());
+  }
+  for (size_t i = 1; i < ranges.size(); ++i)
+    ranges[i - 1].to = ranges[i].from = slice(boundaries[i]);
+
+  struct context {
+    const env &self;
+    map_handle map;
+    const ::std::vector<txn::key_range> &ranges;
+    CALLABLE &callback;
+    static void worker(void *ptr, size_t index) {
+      auto &ctx = *static_cast<context *>(ptr);
+      auto txn = ctx.self.start_read();
+      ctx.callback(static_cast<mdbx::txn &>(txn), ctx.map, ctx.ranges[index], index);
+    }
+  } ctx{*this, map, ranges, callback};
+  run_in_parallel(ranges.size(), threads, context::worker, &ctx);
+}
+
 inline txn_managed env::start_read() const {
   ::MDBX_txn *ptr;
   error::success_or_throw(::mdbx_txn_begin(handle_, nullptr, MDBX_TXN_RDONLY, &ptr));
@@ -5591,6 +5744,20 @@ inline bool txn::unpark_reading(bool restart_if_ousted) {
   return error::boolean_or_throw(::mdbx_txn_unpark(handle_, restart_if_ousted));
 }
 
+inline size_t txn::savepoint() {
+  size_t savepoint;
+  error::success_or_throw(::mdbx_txn_savepoint(handle_, &savepoint));
+  return savepoint;
+}
+
+inline void txn::rollback_to(size_t savepoint) {
+  error::success_or_throw(::mdbx_txn_rollback_to(handle_, savepoint));
+}
+
+inline void txn::release_savepoint(size_t savepoint) {
+  error::success_or_throw(::mdbx_txn_release_savepoint(handle_, savepoint));
+}
+
 inline txn::info txn::get_info(bool scan_reader_lock_table) const {
   txn::info r;
   error::success_or_throw(::mdbx_txn_info(handle_, &r, scan_reader_lock_table));
@@ -8,6 +8,7 @@
 #include "api-copy.c"
 #include "api-cursor.c"
 #include "api-dbi.c"
+#include "api-defrag.c"
 #include "api-env.c"
 #include "api-extra.c"
 #include "api-key-transform.c"
@@ -42,6 +43,7 @@
 #include "pnl.c"
 #include "refund.c"
 #include "rkl.c"
+#include "savepoint.c"
 #include "spill.c"
 #include "table.c"
 #include "tls.c"
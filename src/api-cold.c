@@ -132,12 +132,278 @@ static size_t estimate_rss(size_t database_bytes) {
   return database_bytes + database_bytes / 64 + (512 + MDBX_WORDBITS * 16) * MEGABYTE;
 }
 
+#if (defined(__linux__) || defined(__gnu_linux__)) && defined(CPU_SETSIZE) && defined(CPU_COUNT)
+#define WARMUP_NUMA 1
+#else
+#define WARMUP_NUMA 0
+#endif
+
+/* Диапазон прогрева: полосы по stripe байт, начинающиеся с first через каждые
+ * stride байт, в пределах [0, used_range) отображения БД. */
+typedef struct warmup {
+  const volatile uint8_t *base;
+  size_t used_range, first, stripe, stride;
+  uint64_t timeout_monotime;
+  bool oomsafe;
+#if WARMUP_NUMA
+  cpu_set_t cpus;
+  osal_thread_t thread;
+#endif /* WARMUP_NUMA */
+  int err;
+} warmup_t;
+
+static inline size_t warmup_next(const warmup_t *w, size_t offset) {
+  offset += globals.sys_pagesize;
+  if (w->stride > w->stripe && (offset - w->first) % w->stride == w->stripe)
+    offset += w->stride - w->stripe;
+  return offset;
+}
+
+static int warmup_touch(const warmup_t *w) {
+  const volatile uint8_t *const ptr = w->base;
+  size_t offset = w->first, unused = 42;
+  int rc = MDBX_SUCCESS;
+#if !(defined(_WIN32) || defined(_WIN64))
+  if (w->oomsafe) {
+    const int null_fd = open("/dev/null", O_WRONLY);
+    if (unlikely(null_fd < 0))
+      return errno;
+    struct iovec iov[MDBX_AUXILARY_IOV_MAX];
+    while (offset < w->used_range) {
+      unsigned i;
+      for (i = 0; i < MDBX_AUXILARY_IOV_MAX && offset < w->used_range; ++i) {
+        iov[i].iov_base = (void *)(ptr + offset);
+        iov[i].iov_len = 1;
+        offset = warmup_next(w, offset);
+      }
+      if (unlikely(writev(null_fd, iov, i) < 0)) {
+        rc = errno;
+        if (rc == EFAULT)
+          rc = ENOMEM;
+        break;
+      }
+      if (w->timeout_monotime && offset < w->used_range && osal_monotime() > w->timeout_monotime) {
+        rc = MDBX_RESULT_TRUE;
+        break;
+      }
+    }
+    close(null_fd);
+    return rc;
+  }
+#endif /* Windows */
+  while (offset < w->used_range) {
+    unused += ptr[offset];
+    offset = warmup_next(w, offset);
+    if (w->timeout_monotime && offset < w->used_range && osal_monotime() > w->timeout_monotime) {
+      rc = MDBX_RESULT_TRUE;
+      break;
+    }
+  }
+  (void)unused;
+  return rc;
+}
+
+#if WARMUP_NUMA
+/* Страницы файла размещаются ядром в памяти того NUMA-узла, на котором
+ * выполняется первое обращение к ним (политика mbind() для отображения
+ * файла на страничный кэш не распространяется). Поэтому для чередования
+ * страниц БД между узлами полосы по 2 мегабайта поочерёдно загружаются
+ * потоками, привязанными к процессорам каждого из узлов. */
+#define WARMUP_NUMA_NODES_MAX 64
+
+static unsigned warmup_numa_nodes(warmup_t *nodes) {
+  unsigned n = 0;
+  for (unsigned node = 0; node < 1024 && n < WARMUP_NUMA_NODES_MAX; ++node) {
+    char path[64], list[4096];
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", node);
+    FILE *const f = fopen(path, "r");
+    if (!f)
+      continue;
+    const bool ok = fgets(list, sizeof(list), f) != nullptr;
+    fclose(f);
+    if (!ok)
+      continue;
+
+    /* список процессоров вида "0-7,16-23" */
+    CPU_ZERO(&nodes[n].cpus);
+    for (char *scan = list; *scan >= '0' && *scan <= '9';) {
+      unsigned long first = strtoul(scan, &scan, 10), last = first;
+      if (*scan == '-')
+        last = strtoul(scan + 1, &scan, 10);
+      while (first <= last && first < CPU_SETSIZE)
+        CPU_SET(first++, &nodes[n].cpus);
+      if (*scan == ',')
+        ++scan;
+    }
+    /* узлы без процессоров (только с памятью) пропускаются */
+    if (CPU_COUNT(&nodes[n].cpus) > 0)
+      ++n;
+  }
+  return n;
+}
+
+static THREAD_RESULT THREAD_CALL warmup_numa_thread(void *arg) {
+  warmup_t *const w = arg;
+  if (sched_setaffinity(0, sizeof(w->cpus), &w->cpus))
+    WARNING("sched_setaffinity() error %d", errno);
+  w->err = warmup_touch(w);
+  return (THREAD_RESULT)0;
+}
+
+static int warmup_numa(const warmup_t *whole) {
+  warmup_t *const nodes = osal_calloc(WARMUP_NUMA_NODES_MAX, sizeof(warmup_t));
+  if (unlikely(!nodes))
+    return MDBX_ENOMEM;
+
+  int rc = MDBX_ENOSYS;
+  const unsigned n = warmup_numa_nodes(nodes);
+  if (n > 1) {
+    const size_t stripe = (globals.sys_pagesize > 2 * MEGABYTE) ? globals.sys_pagesize : 2 * MEGABYTE;
+    for (unsigned i = 0; i < n; ++i) {
+      const cpu_set_t cpus = nodes[i].cpus;
+      nodes[i] = *whole;
+      nodes[i].cpus = cpus;
+      nodes[i].first = stripe * i;
+      nodes[i].stripe = stripe;
+      nodes[i].stride = stripe * n;
+      nodes[i].err = osal_thread_create(&nodes[i].thread, warmup_numa_thread, &nodes[i]);
+      if (unlikely(nodes[i].err != MDBX_SUCCESS)) {
+        /* полоса узла загружается текущим потоком без привязки */
+        WARNING("thread-create error %d, the stripes of NUMA-node #%u will be touched by the caller", nodes[i].err,
+                i);
+        nodes[i].err = warmup_touch(&nodes[i]);
+        nodes[i].stripe = 0;
+      }
+    }
+
+    rc = MDBX_SUCCESS;
+    for (unsigned i = 0; i < n; ++i) {
+      if (nodes[i].stripe) {
+        int err = osal_thread_join(nodes[i].thread);
+        if (unlikely(err != MDBX_SUCCESS))
+          nodes[i].err = err;
+      }
+      if (nodes[i].err != MDBX_SUCCESS && (rc == MDBX_SUCCESS || rc == MDBX_RESULT_TRUE))
+        rc = nodes[i].err;
+    }
+  } else
+    NOTICE("%s", "no multiple NUMA-nodes with CPUs, the warmup will be performed by a single thread");
+
+  osal_free(nodes);
+  return rc;
+}
+#endif /* WARMUP_NUMA */
+
+#if MDBX_USE_MINCORE
+/* Профиль прогрева: заголовок и упорядоченный список экстентов страниц БД,
+ * которые находились в ОЗУ в момент сохранения профиля. */
+#define WARMUP_PROFILE_MAGIC UINT64_C(0x4D5241572058424D) /* "MBX WARM" */
+
+typedef struct warmup_profile_header {
+  uint64_t magic;
+  uint32_t pagesize, extents;
+} warmup_profile_header_t;
+
+typedef struct warmup_extent {
+  pgno_t begin, end;
+} warmup_extent_t;
+
+static char *warmup_profile_pathname(const MDBX_env *env, const char *suffix) {
+  static const char profile_suffix[] = MDBX_WARMUP_SUFFIX;
+  const size_t dxb_len = strlen(env->pathname.dxb), suffix_len = strlen(suffix);
+  char *const pathname = osal_malloc(dxb_len + sizeof(profile_suffix) + suffix_len);
+  if (likely(pathname)) {
+    memcpy(pathname, env->pathname.dxb, dxb_len);
+    memcpy(pathname + dxb_len, profile_suffix, sizeof(profile_suffix) - 1);
+    memcpy(pathname + dxb_len + sizeof(profile_suffix) - 1, suffix, suffix_len + 1);
+  }
+  return pathname;
+}
+
+static int warmup_profile_replay(const MDBX_env *env, const warmup_t *whole, const bool force) {
+  if (unlikely(env->anonymous))
+    /* у анонимной БД нет файла, рядом с которым мог быть сохранен профиль */
+    return MDBX_ENOFILE;
+  char *const pathname = warmup_profile_pathname(env, "");
+  if (unlikely(!pathname))
+    return MDBX_ENOMEM;
+  const int fd = open(pathname, O_RDONLY | O_CLOEXEC);
+  osal_free(pathname);
+  if (fd < 0)
+    return (errno == ENOENT) ? MDBX_ENOFILE : errno;
+
+  warmup_extent_t *extents = nullptr;
+  warmup_profile_header_t header;
+  struct stat st;
+  int rc = osal_pread(fd, &header, sizeof(header), 0);
+  if (rc == MDBX_SUCCESS && fstat(fd, &st))
+    rc = errno;
+  if (rc == MDBX_SUCCESS) {
+    /* профиль другой БД либо поврежденный */
+    if (header.magic != WARMUP_PROFILE_MAGIC || header.pagesize != env->ps ||
+        (uint64_t)st.st_size != sizeof(header) + sizeof(warmup_extent_t) * (uint64_t)header.extents)
+      rc = MDBX_INVALID;
+    else if (header.extents) {
+      extents = osal_malloc(sizeof(warmup_extent_t) * header.extents);
+      rc = extents ? osal_pread(fd, extents, sizeof(warmup_extent_t) * header.extents, sizeof(header)) : MDBX_ENOMEM;
+    }
+  }
+  close(fd);
+
+  /* сначала запрашивается асинхронное чтение всех экстентов, так что ядро
+   * ОС формирует множество одновременных запросов к накопителю */
+  const size_t used_range = whole->used_range;
+  for (size_t i = 0; rc == MDBX_SUCCESS && i < header.extents; ++i) {
+    const size_t offset = pgno2bytes(env, extents[i].begin);
+    if (offset >= used_range || extents[i].end <= extents[i].begin)
+      continue;
+    const size_t end = pgno2bytes(env, extents[i].end), length = ((end < used_range) ? end : used_range) - offset;
+    void *const ptr = ptr_disp(env->dxb_mmap.base, offset);
+#if defined(F_RDADVISE)
+    struct radvisory hint;
+    hint.ra_offset = offset;
+    hint.ra_count = unlikely(length > INT_MAX && sizeof(length) > sizeof(hint.ra_count)) ? INT_MAX : (int)length;
+    (void)/* Ignore ENOTTY for DB on the ram-disk and so on */ fcntl(env->lazy_fd, F_RDADVISE, &hint);
+    (void)ptr;
+#elif defined(MADV_WILLNEED)
+    rc = madvise(ptr, length, MADV_WILLNEED) ? ignore_enosys_and_eagain(errno) : MDBX_SUCCESS;
+#elif defined(POSIX_MADV_WILLNEED)
+    rc = ignore_enosys(posix_madvise(ptr, length, POSIX_MADV_WILLNEED));
+#elif defined(POSIX_FADV_WILLNEED)
+    rc = ignore_enosys(posix_fadvise(env->lazy_fd, offset, length, POSIX_FADV_WILLNEED));
+    (void)ptr;
+#else
+    (void)ptr;
+#endif
+    if (rc == MDBX_RESULT_TRUE)
+      rc = MDBX_SUCCESS;
+    if (whole->timeout_monotime && i + 1 < header.extents && osal_monotime() > whole->timeout_monotime)
+      rc = MDBX_RESULT_TRUE;
+  }
+
+  /* затем страницы экстентов загружаются принудительно, если требуется */
+  for (size_t i = 0; force && rc == MDBX_SUCCESS && i < header.extents; ++i) {
+    const size_t offset = pgno2bytes(env, extents[i].begin);
+    if (offset >= used_range || extents[i].end <= extents[i].begin)
+      continue;
+    const size_t end = pgno2bytes(env, extents[i].end);
+    warmup_t extent = *whole;
+    extent.base = ptr_disp(env->dxb_mmap.base, offset);
+    extent.used_range = extent.stripe = extent.stride = ((end < used_range) ? end : used_range) - offset;
+    rc = warmup_touch(&extent);
+  }
+
+  osal_free(extents);
+  return rc;
+}
+#endif /* MDBX_USE_MINCORE */
+
 __cold int mdbx_env_warmup(const MDBX_env *env, const MDBX_txn *txn, MDBX_warmup_flags_t flags,
                            unsigned timeout_seconds_16dot16) {
   if (unlikely(env == nullptr && txn == nullptr))
     return LOG_IFERR(MDBX_EINVAL);
   if (unlikely(flags > (MDBX_warmup_force | MDBX_warmup_oomsafe | MDBX_warmup_lock | MDBX_warmup_touchlimit |
-                        MDBX_warmup_release)))
+                        MDBX_warmup_release | MDBX_warmup_numa | MDBX_warmup_profile)))
     return LOG_IFERR(MDBX_EINVAL);
 
   if (txn) {
@@ -155,7 +421,7 @@ __cold int mdbx_env_warmup(const MDBX_env *env, const MDBX_txn *txn, MDBX_warmup
     env = txn->env;
   }
 
-  const uint64_t timeout_monotime = (timeout_seconds_16dot16 && (flags & MDBX_warmup_force))
+  const uint64_t timeout_monotime = (timeout_seconds_16dot16 && (flags & (MDBX_warmup_force | MDBX_warmup_profile)))
                                         ? osal_monotime() + osal_16dot16_to_monotime(timeout_seconds_16dot16)
                                         : 0;
 
@@ -235,60 +501,31 @@ __cold int mdbx_env_warmup(const MDBX_env *env, const MDBX_txn *txn, MDBX_warmup
   }
 #endif /* MLOCK_ONFAULT */
 
-  int err = MDBX_ENOSYS;
-  err = dxb_set_readahead(env, used_pgno, true, true);
-  if (err != MDBX_SUCCESS && rc == MDBX_SUCCESS)
-    rc = err;
-
-  if ((flags & MDBX_warmup_force) != 0 && (rc == MDBX_SUCCESS || rc == MDBX_ENOSYS)) {
-    const volatile uint8_t *ptr = env->dxb_mmap.base;
-    size_t offset = 0, unused = 42;
-#if !(defined(_WIN32) || defined(_WIN64))
-    if (flags & MDBX_warmup_oomsafe) {
-      const int null_fd = open("/dev/null", O_WRONLY);
-      if (unlikely(null_fd < 0))
-        rc = errno;
-      else {
-        struct iovec iov[MDBX_AUXILARY_IOV_MAX];
-        for (;;) {
-          unsigned i;
-          for (i = 0; i < MDBX_AUXILARY_IOV_MAX && offset < used_range; ++i) {
-            iov[i].iov_base = (void *)(ptr + offset);
-            iov[i].iov_len = 1;
-            offset += globals.sys_pagesize;
-          }
-          if (unlikely(writev(null_fd, iov, i) < 0)) {
-            rc = errno;
-            if (rc == EFAULT)
-              rc = ENOMEM;
-            break;
-          }
-          if (offset >= used_range) {
-            rc = MDBX_SUCCESS;
-            break;
-          }
-          if (timeout_seconds_16dot16 && osal_monotime() > timeout_monotime) {
-            rc = MDBX_RESULT_TRUE;
-            break;
-          }
-        }
-        close(null_fd);
-      }
-    } else
-#endif /* Windows */
-      for (;;) {
-        unused += ptr[offset];
-        offset += globals.sys_pagesize;
-        if (offset >= used_range) {
-          rc = MDBX_SUCCESS;
-          break;
-        }
-        if (timeout_seconds_16dot16 && osal_monotime() > timeout_monotime) {
-          rc = MDBX_RESULT_TRUE;
-          break;
-        }
-      }
-    (void)unused;
+  const warmup_t whole = {.base = env->dxb_mmap.base,
+                          .used_range = used_range,
+                          .first = 0,
+                          .stripe = used_range,
+                          .stride = used_range,
+                          .timeout_monotime = timeout_monotime,
+                          .oomsafe = (flags & MDBX_warmup_oomsafe) != 0};
+  if (flags & MDBX_warmup_profile) {
+#if MDBX_USE_MINCORE
+    if (rc == MDBX_SUCCESS || rc == MDBX_ENOSYS)
+      rc = warmup_profile_replay(env, &whole, (flags & MDBX_warmup_force) != 0);
+#else
+    rc = MDBX_ENOSYS;
+#endif /* MDBX_USE_MINCORE */
+  } else {
+    int err = dxb_set_readahead(env, used_pgno, true, true);
+    if (err != MDBX_SUCCESS && rc == MDBX_SUCCESS)
+      rc = err;
+
+    if ((flags & MDBX_warmup_force) != 0 && (rc == MDBX_SUCCESS || rc == MDBX_ENOSYS)) {
+#if WARMUP_NUMA
+      if ((flags & MDBX_warmup_numa) == 0 || (rc = warmup_numa(&whole)) == MDBX_ENOSYS)
+#endif /* WARMUP_NUMA */
+        rc = warmup_touch(&whole);
+    }
   }
 
   if ((flags & MDBX_warmup_lock) != 0 && (rc == MDBX_SUCCESS || rc == MDBX_ENOSYS) &&
@@ -317,6 +554,329 @@ __cold int mdbx_env_warmup(const MDBX_env *env, const MDBX_txn *txn, MDBX_warmup
   return LOG_IFERR(rc);
 }
 
+__cold int mdbx_env_warmup_save(const MDBX_env *env) {
+  int rc = check_env(env, true);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return LOG_IFERR(rc);
+  if (unlikely(env->anonymous))
+    return LOG_IFERR(MDBX_EINVAL);
+
+#if MDBX_USE_MINCORE
+  const troika_t troika = meta_tap(env);
+  size_t used_range = pgno_ceil2sp_bytes(env, meta_recent(env, &troika).ptr_v->geometry.first_unallocated);
+  used_range = (used_range < env->dxb_mmap.current) ? used_range : env->dxb_mmap.current;
+  const pgno_t used_pgno = bytes2pgno(env, used_range);
+
+  /* резидентность запрашивается порциями, чтобы ограничить размер вектора */
+  const size_t chunk = 65536;
+  uint8_t *const vector = osal_malloc(chunk);
+  if (unlikely(!vector))
+    return LOG_IFERR(MDBX_ENOMEM);
+  warmup_extent_t *extents = nullptr;
+  size_t count = 0, allocated = 0;
+  for (size_t offset = 0; offset < used_range && rc == MDBX_SUCCESS;) {
+    const size_t limit = chunk << globals.sys_pagesize_ln2;
+    const size_t length = (used_range - offset < limit) ? used_range - offset : limit;
+    if (unlikely(mincore(ptr_disp(env->dxb_mmap.base, offset), length, (void *)vector))) {
+      rc = errno;
+      break;
+    }
+    const size_t units = ceil_powerof2(length, globals.sys_pagesize) >> globals.sys_pagesize_ln2;
+    for (size_t i = 0; i < units; ++i) {
+      if ((vector[i] & 1) == 0)
+        continue;
+      const size_t bytes = offset + (i << globals.sys_pagesize_ln2);
+      const pgno_t begin = bytes2pgno(env, bytes);
+      pgno_t end = bytes2pgno(env, bytes + globals.sys_pagesize + env->ps - 1);
+      end = (end < used_pgno) ? end : used_pgno;
+      if (count && extents[count - 1].end >= begin) {
+        extents[count - 1].end = (extents[count - 1].end > end) ? extents[count - 1].end : end;
+        continue;
+      }
+      if (unlikely(count == allocated)) {
+        allocated = allocated ? allocated * 2 : 1024;
+        warmup_extent_t *const grown = osal_realloc(extents, sizeof(warmup_extent_t) * allocated);
+        if (unlikely(!grown)) {
+          rc = MDBX_ENOMEM;
+          break;
+        }
+        extents = grown;
+      }
+      extents[count].begin = begin;
+      extents[count].end = end;
+      count += 1;
+    }
+    offset += length;
+  }
+  osal_free(vector);
+
+  /* профиль записывается во временный файл и затем атомарно подменяется */
+  char *const pathname = warmup_profile_pathname(env, ""), *const tmp = warmup_profile_pathname(env, ".tmp");
+  if (rc == MDBX_SUCCESS && unlikely(!pathname || !tmp))
+    rc = MDBX_ENOMEM;
+  if (rc == MDBX_SUCCESS) {
+    struct stat st;
+    const mode_t mode = fstat(env->lazy_fd, &st) ? 0644 : (st.st_mode & 0666);
+    const int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, mode);
+    if (fd < 0)
+      rc = errno;
+    else {
+      const warmup_profile_header_t header = {
+          .magic = WARMUP_PROFILE_MAGIC, .pagesize = (uint32_t)env->ps, .extents = (uint32_t)count};
+      rc = osal_write(fd, &header, sizeof(header));
+      if (rc == MDBX_SUCCESS && count)
+        rc = osal_write(fd, extents, sizeof(warmup_extent_t) * count);
+      /* иначе после сбоя профиль может оказаться подмененным пустым файлом */
+      if (rc == MDBX_SUCCESS)
+        rc = osal_fsync(fd, MDBX_SYNC_DATA | MDBX_SYNC_SIZE);
+      if (close(fd) && rc == MDBX_SUCCESS)
+        rc = errno;
+      if (rc == MDBX_SUCCESS && rename(tmp, pathname))
+        rc = errno;
+      if (rc != MDBX_SUCCESS)
+        unlink(tmp);
+    }
+  }
+  osal_free(pathname);
+  osal_free(tmp);
+  osal_free(extents);
+  return LOG_IFERR(rc);
+#else
+  return LOG_IFERR(MDBX_ENOSYS);
+#endif /* MDBX_USE_MINCORE */
+}
+
+/*----------------------------------------------------------------------------*/
+
+/* Прогрев по структуре b-дерева.
+ *
+ * Страницы таблицы загружаются сверху вниз, начиная с корня, при этом
+ * дочерние страницы помещаются в общий стек заданий, который разбирают
+ * рабочие потоки. Так множество потоков одновременно обращаются к разным
+ * страницам, создавая достаточную очередь запросов ввода-вывода. Листовые
+ * страницы читаются только если это запрошено явно, либо требуется для
+ * поиска больших значений, вложенных деревьев или именованных таблиц. */
+enum warmup_tree_task_flags { wt_leaves = 1, wt_tables = 2 };
+
+typedef struct warmup_tree_task {
+  pgno_t pgno;
+  uint16_t level, height;
+  uint8_t flags;
+  txnid_t front;
+} warmup_tree_task_t;
+
+typedef struct warmup_tree {
+  osal_condpair_t condpair;
+  warmup_tree_task_t *stack;
+  size_t depth, allocated, running, pages, reported;
+  int err;
+  const MDBX_cursor *cursor;
+  MDBX_warmup_tree_flags_t flags;
+  unsigned levels;
+  MDBX_warmup_progress_func *progress;
+  void *progress_ctx;
+} warmup_tree_t;
+
+static int warmup_tree_push(warmup_tree_t *wt, const pgno_t pgno, const size_t level, const size_t height,
+                            const uint8_t flags, const txnid_t front) {
+  if (level >= height || (wt->levels && level >= wt->levels) || (level + 1 == height && !(flags & wt_leaves)))
+    return MDBX_SUCCESS;
+
+  if (unlikely(wt->depth == wt->allocated)) {
+    const size_t allocated = wt->allocated ? wt->allocated * 2 : 1024;
+    warmup_tree_task_t *const stack = osal_realloc(wt->stack, sizeof(warmup_tree_task_t) * allocated);
+    if (unlikely(!stack))
+      return MDBX_ENOMEM;
+    wt->stack = stack;
+    wt->allocated = allocated;
+  }
+  warmup_tree_task_t *const task = &wt->stack[wt->depth++];
+  task->pgno = pgno;
+  task->level = (uint16_t)level;
+  task->height = (uint16_t)height;
+  task->flags = flags;
+  task->front = front;
+  return MDBX_SUCCESS;
+}
+
+static void warmup_tree_touch(const MDBX_env *env, const page_t *mp, const size_t npages) {
+  const volatile uint8_t *const ptr = (const volatile uint8_t *)mp;
+  size_t unused = 42;
+  for (size_t offset = 0; offset < pgno2bytes(env, npages); offset += globals.sys_pagesize)
+    unused += ptr[offset];
+  (void)unused;
+}
+
+/* Загружает страницу задания и большие значения из неё, вне блокировки. */
+static int warmup_tree_load(warmup_tree_t *wt, const warmup_tree_task_t *task, page_t **mp, size_t *pages) {
+  const MDBX_env *const env = wt->cursor->txn->env;
+  int err = page_get(wt->cursor, task->pgno, mp, task->front);
+  if (unlikely(err != MDBX_SUCCESS))
+    return err;
+  warmup_tree_touch(env, *mp, 1);
+  *pages = 1;
+
+  if ((wt->flags & MDBX_warmup_tree_large) && is_leaf(*mp) && !is_dupfix_leaf(*mp))
+    for (size_t i = 0; i < page_numkeys(*mp); ++i) {
+      const node_t *const node = page_node(*mp, i);
+      if (node_flags(node) & N_BIG) {
+        const pgr_t lp = page_get_large(wt->cursor, node_largedata_pgno(node), (*mp)->txnid);
+        if (unlikely(lp.err != MDBX_SUCCESS))
+          return lp.err;
+        warmup_tree_touch(env, lp.page, lp.page->pages);
+        *pages += lp.page->pages;
+      }
+    }
+  return MDBX_SUCCESS;
+}
+
+/* Помещает в стек дочерние страницы, корни вложенных деревьев и таблиц. */
+static int warmup_tree_expand(warmup_tree_t *wt, const warmup_tree_task_t *task, const page_t *mp) {
+  const MDBX_txn *const txn = wt->cursor->txn;
+  const size_t nkeys = page_numkeys(mp);
+  int err = MDBX_SUCCESS;
+  if (is_branch(mp)) {
+    /* в обратном порядке, чтобы страницы извлекались по возрастанию ключей */
+    for (size_t i = nkeys; i-- > 0 && err == MDBX_SUCCESS;)
+      err = warmup_tree_push(wt, node_pgno(page_node(mp, i)), task->level + 1, task->height, task->flags, mp->txnid);
+  } else if (!is_dupfix_leaf(mp)) {
+    for (size_t i = nkeys; i-- > 0 && err == MDBX_SUCCESS;) {
+      const node_t *const node = page_node(mp, i);
+      if ((node_flags(node) & N_TREE) == 0 || unlikely(node_ds(node) != sizeof(tree_t)))
+        continue;
+      tree_t aligned;
+      memcpy(&aligned, node_data(node), sizeof(aligned));
+      if (node_flags(node) & N_DUP) {
+        if (wt->flags & MDBX_warmup_tree_nested)
+          err = warmup_tree_push(wt, aligned.root, 0, aligned.height,
+                                 (wt->flags & MDBX_warmup_tree_leaves) ? wt_leaves : 0, mp->txnid);
+      } else if (task->flags & wt_tables)
+        err = warmup_tree_push(wt, aligned.root, 0, aligned.height,
+                               (wt->flags & (MDBX_warmup_tree_leaves | MDBX_warmup_tree_large | MDBX_warmup_tree_nested))
+                                   ? wt_leaves
+                                   : 0,
+                               aligned.mod_txnid ? aligned.mod_txnid : txn->txnid);
+    }
+  }
+  return err;
+}
+
+static THREAD_RESULT THREAD_CALL warmup_tree_worker(void *arg) {
+  warmup_tree_t *const wt = arg;
+  osal_condpair_lock(&wt->condpair);
+  while (wt->err == MDBX_SUCCESS) {
+    if (!wt->depth) {
+      if (!wt->running)
+        break;
+      osal_condpair_wait(&wt->condpair, false);
+      continue;
+    }
+    const warmup_tree_task_t task = wt->stack[--wt->depth];
+    wt->running += 1;
+    if (wt->depth)
+      /* будим по цепочке следующий ожидающий поток, если есть работа */
+      osal_condpair_signal(&wt->condpair, false);
+    osal_condpair_unlock(&wt->condpair);
+
+    page_t *mp = nullptr;
+    size_t pages = 0;
+    int err = warmup_tree_load(wt, &task, &mp, &pages);
+
+    osal_condpair_lock(&wt->condpair);
+    wt->running -= 1;
+    if (likely(err == MDBX_SUCCESS))
+      err = warmup_tree_expand(wt, &task, mp);
+    wt->pages += pages;
+    if (wt->progress && likely(err == MDBX_SUCCESS) && wt->pages - wt->reported >= 1024) {
+      wt->reported = wt->pages;
+      err = wt->progress(wt->progress_ctx, wt->pages, wt->depth);
+    }
+    if (unlikely(err != MDBX_SUCCESS) && wt->err == MDBX_SUCCESS)
+      wt->err = err;
+    osal_condpair_signal(&wt->condpair, false);
+  }
+  /* работы больше нет, будим следующий ожидающий поток по цепочке */
+  osal_condpair_signal(&wt->condpair, false);
+  osal_condpair_unlock(&wt->condpair);
+  return (THREAD_RESULT)0;
+}
+
+__cold int mdbx_dbi_warmup(const MDBX_txn *txn, MDBX_dbi dbi, MDBX_warmup_tree_flags_t flags, unsigned levels,
+                           unsigned threads, MDBX_warmup_progress_func *progress, void *ctx) {
+  int rc = check_txn(txn, MDBX_TXN_BLOCKED);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return LOG_IFERR(rc);
+
+  if (unlikely(flags > (MDBX_warmup_tree_leaves | MDBX_warmup_tree_large | MDBX_warmup_tree_nested |
+                        MDBX_warmup_tree_tables)))
+    return LOG_IFERR(MDBX_EINVAL);
+
+  rc = dbi_check(txn, dbi);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return LOG_IFERR(rc);
+
+  if (unlikely(txn->dbi_state[dbi] & DBI_STALE)) {
+    rc = tbl_refresh((MDBX_txn *)txn, dbi);
+    if (unlikely(rc != MDBX_SUCCESS))
+      return LOG_IFERR(rc);
+  }
+
+  cursor_couple_t couple;
+  rc = cursor_init(&couple.outer, txn, dbi);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return LOG_IFERR(rc);
+
+  warmup_tree_t wt = {
+      .cursor = &couple.outer, .flags = flags, .levels = levels, .progress = progress, .progress_ctx = ctx};
+  const tree_t *const tree = &txn->dbs[dbi];
+  const uint8_t root_flags =
+      ((flags & (MDBX_warmup_tree_leaves | MDBX_warmup_tree_large | MDBX_warmup_tree_nested)) ? wt_leaves : 0) |
+      ((dbi == MAIN_DBI && (flags & MDBX_warmup_tree_tables)) ? wt_leaves | wt_tables : 0);
+  if (tree->root != P_INVALID) {
+    /* в пишущей транзакции корень может быть грязной страницей */
+    rc = warmup_tree_push(&wt, tree->root, 0, tree->height, root_flags,
+                          (txn->flags & MDBX_TXN_RDONLY) ? (tree->mod_txnid ? tree->mod_txnid : txn->txnid)
+                                                         : txn->front_txnid);
+    if (unlikely(rc != MDBX_SUCCESS))
+      return LOG_IFERR(rc);
+  }
+
+  rc = osal_condpair_init(&wt.condpair);
+  if (unlikely(rc != MDBX_SUCCESS)) {
+    osal_free(wt.stack);
+    return LOG_IFERR(rc);
+  }
+
+  /* в пишущей транзакции поиск грязных страниц может изменять внутренние
+   * структуры, поэтому дополнительные потоки используются только для чтения */
+  osal_thread_t *thread = nullptr;
+  unsigned started = 0;
+  if (threads > MDBX_WARMUP_THREADS_MAX)
+    threads = MDBX_WARMUP_THREADS_MAX;
+  if (threads > 1 && (txn->flags & MDBX_TXN_RDONLY)) {
+    thread = osal_malloc(sizeof(osal_thread_t) * (threads - 1));
+    while (thread && started < threads - 1 && osal_thread_create(&thread[started], warmup_tree_worker, &wt) == 0)
+      started += 1;
+  }
+
+  /* текущий поток также участвует в прогреве */
+  warmup_tree_worker(&wt);
+  while (started > 0) {
+    int err = osal_thread_join(thread[--started]);
+    if (unlikely(err != MDBX_SUCCESS) && rc == MDBX_SUCCESS)
+      rc = err;
+  }
+
+  if (wt.err != MDBX_SUCCESS)
+    rc = wt.err;
+  else if (progress && rc == MDBX_SUCCESS)
+    rc = progress(ctx, wt.pages, 0);
+  osal_condpair_destroy(&wt.condpair);
+  osal_free(thread);
+  osal_free(wt.stack);
+  return LOG_IFERR(rc);
+}
+
 /*----------------------------------------------------------------------------*/
 
 __cold int mdbx_env_get_fd(const MDBX_env *env, mdbx_filehandle_t *arg) {
@@ -386,15 +386,16 @@ __cold static int copy_with_compacting(MDBX_env *env, MDBX_txn *txn, mdbx_fileha
     rc = outer_first(&couple.outer, &key, &data);
     while (rc == MDBX_SUCCESS) {
       const pnl_t pnl = data.iov_base;
-      if (unlikely(data.iov_len % sizeof(pgno_t) || data.iov_len < MDBX_PNL_SIZEOF(pnl))) {
+      if (unlikely(data.iov_len % sizeof(pgno_t) || data.iov_len < sizeof(pgno_t) ||
+                   data.iov_len < (pnl_packed_len(pnl) + 1) * sizeof(pgno_t))) {
         ERROR("%s/%d: %s %zu", "MDBX_CORRUPTED", MDBX_CORRUPTED, "invalid GC-record length", data.iov_len);
         return MDBX_CORRUPTED;
       }
-      if (unlikely(!pnl_check(pnl, txn->geo.first_unallocated))) {
+      if (unlikely(!pnl_packed_check(pnl, data.iov_len, txn->geo.first_unallocated))) {
         ERROR("%s/%d: %s", "MDBX_CORRUPTED", MDBX_CORRUPTED, "invalid GC-record content");
         return MDBX_CORRUPTED;
       }
-      gc_npages += pnl_size(pnl);
+      gc_npages += pnl_packed_npages(pnl);
       rc = outer_next(&couple.outer, &key, &data, MDBX_NEXT);
     }
     if (unlikely(rc != MDBX_NOTFOUND))
@@ -673,6 +673,492 @@ bailout:
 
 /*----------------------------------------------------------------------------*/
 
+/* Подсчитывает без ветвлений количество целых в окне меньших заданного,
+ * что для отсортированного окна дает позицию нижней границы. Такие циклы
+ * компиляторы векторизуют (SSE2/AVX2/NEON) прямо поверх page_dupfix_ptr(). */
+static size_t dupfix_count_below_u32(const uint8_t *ptr, size_t n, uint32_t bound) {
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i)
+    count += unaligned_peek_u32(1, ptr + i * sizeof(uint32_t)) < bound;
+  return count;
+}
+
+static size_t dupfix_count_below_u64(const uint8_t *ptr, size_t n, uint64_t bound) {
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i)
+    count += unaligned_peek_u64(1, ptr + i * sizeof(uint64_t)) < bound;
+  return count;
+}
+
+/* Галопирующий поиск на DUPFIXED-странице первого значения, которое больше
+ * (либо не меньше при !exclusive) границы. Значение в позиции lo должно быть
+ * "до" границы, а в позиции hi — "после". */
+static size_t dupfix_gallop(const MDBX_cursor *mc, const page_t *mp, size_t lo, size_t hi, const MDBX_val *bound,
+                            const bool exclusive) {
+  const size_t ksize = mc->subcur->nested_tree.dupfix_size;
+  const int after = exclusive ? 1 : 0;
+  for (size_t step = 1; lo + step < hi; step <<= 1) {
+    const MDBX_val probe = page_dupfix_key(mp, lo + step, ksize);
+    if (mc->clc->v.cmp(&probe, bound) >= after) {
+      hi = lo + step;
+      break;
+    }
+    lo += step;
+  }
+
+  const uint8_t *const window = page_dupfix_ptr(mp, lo + 1, ksize);
+  if ((mc->tree->flags & MDBX_INTEGERDUP) && mc->clc->v.cmp == builtin_datacmp(mc->tree->flags) &&
+      bound->iov_len == ksize) {
+    /* граница меньше значения в позиции hi, поэтому +1 не переполняется */
+    if (ksize == sizeof(uint32_t))
+      return lo + 1 + dupfix_count_below_u32(window, hi - lo - 1, unaligned_peek_u32(1, bound->iov_base) + after);
+    if (ksize == sizeof(uint64_t))
+      return lo + 1 + dupfix_count_below_u64(window, hi - lo - 1, unaligned_peek_u64(1, bound->iov_base) + after);
+  }
+
+  while (hi - lo > 1) {
+    const size_t middle = lo + (hi - lo) / 2;
+    const MDBX_val probe = page_dupfix_key(mp, middle, ksize);
+    if (mc->clc->v.cmp(&probe, bound) >= after)
+      hi = middle;
+    else
+      lo = middle;
+  }
+  return hi;
+}
+
+/* Возвращает текущее значение курсора, либо MDBX_NOTFOUND когда список
+ * значений текущего ключа исчерпан. */
+static int merge_current(MDBX_cursor *mc, MDBX_val *value) {
+  if (unlikely(!is_filled(mc)))
+    return MDBX_NOTFOUND;
+
+  if (inner_pointed(mc)) {
+    const MDBX_cursor *const mx = &mc->subcur->cursor;
+    if (!is_filled(mx))
+      return MDBX_NOTFOUND;
+    const page_t *const mp = mx->pg[mx->top];
+    *value = is_dupfix_leaf(mp) ? page_dupfix_key(mp, mx->ki[mx->top], mc->subcur->nested_tree.dupfix_size)
+                                : get_key(page_node(mp, mx->ki[mx->top]));
+    return MDBX_SUCCESS;
+  }
+
+  const page_t *const mp = mc->pg[mc->top];
+  return node_read(mc, page_node(mp, mc->ki[mc->top]), value, mp);
+}
+
+/* Продвигает курсор среди значений текущего ключа к первому значению, которое
+ * больше (либо не меньше при !exclusive) границы, т.е. выполняет действие
+ * аналогичное MDBX_TO_EXACT_KEY_VALUE_GREATER_OR_EQUAL, но без повторного
+ * поиска ключа, что позволяет вложенному курсору начинать поиск "от пальца".
+ * Для DUPFIXED поиск выполняется галопом прямо на текущей странице. */
+static int merge_seek(MDBX_cursor *mc, const MDBX_val *bound, const bool exclusive, MDBX_val *value) {
+  int err = merge_current(mc, value);
+  if (unlikely(err != MDBX_SUCCESS) || !bound)
+    return err;
+
+  int cmp = mc->clc->v.cmp(value, bound);
+  if (cmp > 0 || (cmp == 0 && !exclusive))
+    return MDBX_SUCCESS;
+  if (!inner_pointed(mc))
+    return MDBX_NOTFOUND;
+
+  MDBX_cursor *const mx = &mc->subcur->cursor;
+  if (cmp == 0)
+    return inner_next(mx, value);
+
+  const page_t *const mp = mx->pg[mx->top];
+  if (is_dupfix_leaf(mp)) {
+    const size_t nkeys = page_numkeys(mp);
+    const MDBX_val edge = page_dupfix_key(mp, nkeys - 1, mc->subcur->nested_tree.dupfix_size);
+    cmp = mc->clc->v.cmp(&edge, bound);
+    if (cmp > 0 || (cmp == 0 && !exclusive)) {
+      mx->ki[mx->top] = (indx_t)dupfix_gallop(mc, mp, mx->ki[mx->top], nkeys - 1, bound, exclusive);
+      return merge_current(mc, value);
+    }
+  }
+
+  MDBX_val target = *bound;
+  csr_t csr = cursor_seek(mx, &target, nullptr, MDBX_SET_RANGE);
+  if (unlikely(csr.err != MDBX_SUCCESS))
+    return csr.err;
+  return (exclusive && csr.exact) ? inner_next(mx, value) : merge_current(mc, value);
+}
+
+int mdbx_cursor_merge_batch(MDBX_cursor *const *cursors, size_t cursors_count, MDBX_merge_mode_t mode,
+                            size_t *count, MDBX_val *values, size_t limit, const MDBX_val *after) {
+  if (unlikely(!count))
+    return LOG_IFERR(MDBX_EINVAL);
+
+  *count = 0;
+  if (unlikely(!cursors || cursors_count < 1 || !values || limit < 1 ||
+               (mode != MDBX_MERGE_INTERSECTION && mode != MDBX_MERGE_UNION)))
+    return LOG_IFERR(MDBX_EINVAL);
+
+  for (size_t i = 0; i < cursors_count; ++i) {
+    MDBX_cursor *const mc = cursors[i];
+    int rc = cursor_check_ro(mc);
+    if (unlikely(rc != MDBX_SUCCESS))
+      return LOG_IFERR(rc);
+    if (unlikely(!mc->subcur))
+      return LOG_IFERR(MDBX_INCOMPATIBLE) /* must be a dupsort table */;
+    if (unlikely(mc->txn != cursors[0]->txn))
+      return LOG_IFERR(MDBX_EINVAL);
+    if (unlikely(mc->clc->v.cmp != cursors[0]->clc->v.cmp))
+      return LOG_IFERR(MDBX_INCOMPATIBLE) /* values must be ordered the same way */;
+    if (unlikely(!is_pointed(mc)))
+      return LOG_IFERR(MDBX_ENODATA);
+  }
+
+  /* граница копируется, так как может указывать внутрь массива результатов */
+  MDBX_val bound = after ? *after : (MDBX_val){nullptr, 0};
+  MDBX_cmp_func *const cmp = cursors[0]->clc->v.cmp;
+  size_t n = 0;
+  int rc;
+  if (mode == MDBX_MERGE_INTERSECTION) {
+    /* Кандидатом является значение "ведущего" курсора, остальные курсоры
+     * по кругу догоняют его галопом. Когда курсор перескакивает кандидата,
+     * то его значение становится новым кандидатом. */
+    MDBX_val candidate;
+    rc = merge_seek(cursors[0], after ? &bound : nullptr, true, &candidate);
+    size_t agreed = 1, i = 0;
+    while (rc == MDBX_SUCCESS) {
+      if (agreed == cursors_count) {
+        values[n] = candidate;
+        if (++n == limit)
+          break;
+        bound = candidate;
+        rc = merge_seek(cursors[i], &bound, true, &candidate);
+        agreed = 1;
+        continue;
+      }
+      i = (i + 1 < cursors_count) ? i + 1 : 0;
+      MDBX_val value;
+      rc = merge_seek(cursors[i], &candidate, false, &value);
+      if (likely(rc == MDBX_SUCCESS)) {
+        if (cmp(&value, &candidate) == 0)
+          agreed += 1;
+        else {
+          candidate = value;
+          agreed = 1;
+        }
+      }
+    }
+  } else {
+    do {
+      bool found = false;
+      MDBX_val least = {nullptr, 0};
+      for (size_t i = 0; i < cursors_count; ++i) {
+        MDBX_val value;
+        rc = merge_seek(cursors[i], (after || n) ? &bound : nullptr, true, &value);
+        if (rc == MDBX_NOTFOUND)
+          continue;
+        if (unlikely(rc != MDBX_SUCCESS))
+          goto bailout;
+        if (!found || cmp(&value, &least) < 0)
+          least = value;
+        found = true;
+      }
+      if (!found) {
+        rc = MDBX_NOTFOUND;
+        break;
+      }
+      rc = MDBX_SUCCESS;
+      values[n] = bound = least;
+    } while (++n < limit);
+  }
+
+  if (rc == MDBX_NOTFOUND)
+    rc = MDBX_RESULT_TRUE;
+bailout:
+  *count = n;
+  return LOG_IFERR(rc);
+}
+
+/*----------------------------------------------------------------------------*/
+
+typedef struct aggregator {
+  MDBX_aggregate_t *result;
+  MDBX_aggregate_encoding_t encoding;
+  size_t width;
+  double lower, scale;
+} aggregator_t;
+
+/* Декодирование ключей из mdbx_key_from_double() и mdbx_key_from_float()
+ * без ветвлений, эквивалентно key2double() и key2float(). */
+static inline double aggregate_key2double(const uint64_t key) {
+  union {
+    uint64_t u;
+    double f;
+  } casting;
+  const uint64_t mask = UINT64_C(0) - (key >> 63);
+  casting.u = key ^ (~mask | UINT64_C(0x8000000000000000));
+  return casting.f;
+}
+
+static inline float aggregate_key2float(const uint32_t key) {
+  union {
+    uint32_t u;
+    float f;
+  } casting;
+  const uint32_t mask = UINT32_C(0) - (key >> 31);
+  casting.u = key ^ (~mask | UINT32_C(0x80000000));
+  return casting.f;
+}
+
+/* Суммирование без ветвлений прямо поверх массива целых, аналогично
+ * dupfix_count_below_u32(), такие циклы компиляторы векторизуют. */
+static uint64_t aggregate_sum_u32(const uint8_t *ptr, size_t n) {
+  uint64_t sum = 0;
+  for (size_t i = 0; i < n; ++i)
+    sum += unaligned_peek_u32(1, ptr + i * sizeof(uint32_t));
+  return sum;
+}
+
+static uint64_t aggregate_sum_u64(const uint8_t *ptr, size_t n) {
+  uint64_t sum = 0;
+  for (size_t i = 0; i < n; ++i)
+    sum += unaligned_peek_u64(1, ptr + i * sizeof(uint64_t));
+  return sum;
+}
+
+/* Сложение с плавающей точкой не ассоциативно, поэтому компиляторы не
+ * векторизуют одну цепочку сумм. Четыре независимые частичные суммы
+ * векторизуются без изменения семантики (SLP), а декодирование ключей
+ * без ветвлений не мешает этому. */
+static double aggregate_sum_f32(const uint8_t *ptr, size_t n) {
+  double sum[4] = {0, 0, 0, 0};
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    for (size_t j = 0; j < 4; ++j)
+      sum[j] += aggregate_key2float(unaligned_peek_u32(1, ptr + (i + j) * sizeof(uint32_t)));
+  for (; i < n; ++i)
+    sum[i & 3] += aggregate_key2float(unaligned_peek_u32(1, ptr + i * sizeof(uint32_t)));
+  return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+static double aggregate_sum_f64(const uint8_t *ptr, size_t n) {
+  double sum[4] = {0, 0, 0, 0};
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    for (size_t j = 0; j < 4; ++j)
+      sum[j] += aggregate_key2double(unaligned_peek_u64(1, ptr + (i + j) * sizeof(uint64_t)));
+  for (; i < n; ++i)
+    sum[i & 3] += aggregate_key2double(unaligned_peek_u64(1, ptr + i * sizeof(uint64_t)));
+  return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+static inline uint64_t aggregate_raw(const aggregator_t *ag, const void *ptr) {
+  return (ag->width == sizeof(uint32_t)) ? unaligned_peek_u32(1, ptr) : unaligned_peek_u64(1, ptr);
+}
+
+static MDBX_aggregate_value_t aggregate_decode(const aggregator_t *ag, const void *ptr) {
+  MDBX_aggregate_value_t value;
+  const uint64_t raw = aggregate_raw(ag, ptr);
+  switch (ag->encoding) {
+  default:
+    value.u = raw;
+    break;
+  case MDBX_AGGREGATE_SIGNED:
+    value.i = (ag->width == sizeof(uint32_t)) ? (int64_t)raw - INT64_C(0x80000000)
+                                              : (int64_t)(raw - UINT64_C(0x8000000000000000));
+    break;
+  case MDBX_AGGREGATE_FLOATING:
+    value.f = (ag->width == sizeof(uint32_t)) ? aggregate_key2float((uint32_t)raw) : aggregate_key2double(raw);
+    break;
+  }
+  return value;
+}
+
+static inline double aggregate_as_double(MDBX_aggregate_encoding_t encoding, const MDBX_aggregate_value_t value) {
+  switch (encoding) {
+  default:
+    return (double)value.u;
+  case MDBX_AGGREGATE_SIGNED:
+    return (double)value.i;
+  case MDBX_AGGREGATE_FLOATING:
+    return value.f;
+  }
+}
+
+/* Агрегирует массив из n значений, упорядоченных по возрастанию, поэтому
+ * минимум и максимум берутся с краев. */
+static void aggregate_array(aggregator_t *ag, const uint8_t *ptr, size_t n) {
+  if (unlikely(n == 0))
+    return;
+
+  MDBX_aggregate_t *const r = ag->result;
+  if (r->count == 0)
+    r->min = aggregate_decode(ag, ptr);
+  r->max = aggregate_decode(ag, ptr + (n - 1) * ag->width);
+  r->count += n;
+
+  if (ag->encoding == MDBX_AGGREGATE_FLOATING)
+    r->sum.f += (ag->width == sizeof(uint32_t)) ? aggregate_sum_f32(ptr, n) : aggregate_sum_f64(ptr, n);
+  else {
+    uint64_t sum = (ag->width == sizeof(uint32_t)) ? aggregate_sum_u32(ptr, n) : aggregate_sum_u64(ptr, n);
+    if (ag->encoding == MDBX_AGGREGATE_SIGNED)
+      sum -= n * ((ag->width == sizeof(uint32_t)) ? UINT64_C(0x80000000) : UINT64_C(0x8000000000000000));
+    r->sum.u += sum;
+  }
+
+  if (r->histogram_size)
+    for (size_t i = 0; i < n; ++i) {
+      /* NaN и значения вне границ не попадают ни в одну корзину */
+      const double x = (aggregate_as_double(ag->encoding, aggregate_decode(ag, ptr + i * ag->width)) - ag->lower) *
+                       ag->scale;
+      if (x >= 0 && x < (double)r->histogram_size)
+        r->histogram[(size_t)x] += 1;
+    }
+}
+
+/* Агрегирует элементы [begin, end) листовой страницы. Ключи узлов в пределах
+ * страницы не образуют массив, поэтому собираются порциями в буфер. */
+static void aggregate_page(aggregator_t *ag, const page_t *mp, size_t begin, size_t end) {
+  if (is_dupfix_leaf(mp)) {
+    aggregate_array(ag, page_dupfix_ptr(mp, begin, ag->width), end - begin);
+    return;
+  }
+
+  uint64_t buffer[64];
+  while (begin < end) {
+    const size_t n = (end - begin < ARRAY_LENGTH(buffer)) ? end - begin : ARRAY_LENGTH(buffer);
+    for (size_t i = 0; i < n; ++i)
+      memcpy(ptr_disp(buffer, i * ag->width), node_key(page_node(mp, begin + i)), ag->width);
+    aggregate_array(ag, (const uint8_t *)buffer, n);
+    begin += n;
+  }
+}
+
+/* Позиция первого элемента страницы не меньшего границы. */
+static size_t aggregate_bound(const aggregator_t *ag, const page_t *mp, size_t lo, size_t hi, const uint64_t bound) {
+  if (is_dupfix_leaf(mp)) {
+    const uint8_t *const window = page_dupfix_ptr(mp, lo, ag->width);
+    return lo + ((ag->width == sizeof(uint32_t)) ? dupfix_count_below_u32(window, hi - lo, (uint32_t)bound)
+                                                 : dupfix_count_below_u64(window, hi - lo, bound));
+  }
+
+  while (lo < hi) {
+    const size_t middle = lo + (hi - lo) / 2;
+    if (aggregate_raw(ag, node_key(page_node(mp, middle))) < bound)
+      lo = middle + 1;
+    else
+      hi = middle;
+  }
+  return lo;
+}
+
+/* Агрегирует элементы от текущей позиции курсора до границы, переходя на
+ * соседние страницы. Курсор остается на первом элементе не меньшем границы,
+ * либо в состоянии EOF. */
+static int aggregate_pages(aggregator_t *ag, MDBX_cursor *mc, const MDBX_val *to) {
+  const uint64_t bound = to ? aggregate_raw(ag, to->iov_base) : 0;
+  for (;;) {
+    const page_t *mp = mc->pg[mc->top];
+    if (!MDBX_DISABLE_VALIDATION && unlikely(!check_leaf_type(mc, mp))) {
+      ERROR("unexpected leaf-page #%" PRIaPGNO " type 0x%x seen by cursor", mp->pgno, mp->flags);
+      return MDBX_CORRUPTED;
+    }
+
+    const size_t nkeys = page_numkeys(mp);
+    const size_t begin = mc->ki[mc->top];
+    size_t end = nkeys;
+    if (to) {
+      const size_t last = nkeys - 1;
+      const void *const edge = is_dupfix_leaf(mp) ? page_dupfix_ptr(mp, last, ag->width) : node_key(page_node(mp, last));
+      if (aggregate_raw(ag, edge) >= bound)
+        end = aggregate_bound(ag, mp, begin, nkeys, bound);
+    }
+
+    aggregate_page(ag, mp, begin, end);
+    if (end < nkeys) {
+      mc->ki[mc->top] = (indx_t)end;
+      return MDBX_SUCCESS;
+    }
+
+    int err = cursor_sibling_right(mc);
+    if (err != MDBX_SUCCESS)
+      return (err == MDBX_NOTFOUND) ? MDBX_SUCCESS : err;
+  }
+}
+
+int mdbx_cursor_aggregate(MDBX_cursor *mc, MDBX_aggregate_encoding_t encoding, const MDBX_val *from,
+                          const MDBX_val *to, MDBX_aggregate_t *result) {
+  if (unlikely(!result))
+    return LOG_IFERR(MDBX_EINVAL);
+
+  result->count = 0;
+  result->sum.u = result->min.u = result->max.u = 0;
+  if (unlikely(encoding != MDBX_AGGREGATE_UNSIGNED && encoding != MDBX_AGGREGATE_SIGNED &&
+               encoding != MDBX_AGGREGATE_FLOATING))
+    return LOG_IFERR(MDBX_EINVAL);
+
+  aggregator_t ag = {.result = result, .encoding = encoding};
+  if (result->histogram_size) {
+    if (unlikely(!result->histogram))
+      return LOG_IFERR(MDBX_EINVAL);
+    ag.lower = aggregate_as_double(encoding, result->histogram_lower);
+    const double width = aggregate_as_double(encoding, result->histogram_upper) - ag.lower;
+    if (unlikely(!(width > 0)))
+      return LOG_IFERR(MDBX_EINVAL);
+    ag.scale = (double)result->histogram_size / width;
+    memset(result->histogram, 0, result->histogram_size * sizeof(result->histogram[0]));
+  }
+
+  int rc = cursor_check_ro(mc);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return LOG_IFERR(rc);
+
+  /* Порядок элементов должен совпадать с порядком целых, т.е. ключей
+   * MDBX_INTEGERKEY либо значений MDBX_INTEGERDUP со встроенным компаратором. */
+  MDBX_cursor *target = mc;
+  if (mc->subcur) {
+    if (unlikely((mc->tree->flags & (MDBX_INTEGERDUP | MDBX_REVERSEDUP)) != MDBX_INTEGERDUP ||
+                 mc->clc->v.cmp != builtin_datacmp(mc->tree->flags)))
+      return LOG_IFERR(MDBX_INCOMPATIBLE);
+    if (unlikely(!is_filled(mc)))
+      return LOG_IFERR(MDBX_ENODATA);
+
+    if (!inner_pointed(mc)) {
+      /* единственное значение ключа размещено в узле */
+      MDBX_val value;
+      const page_t *const mp = mc->pg[mc->top];
+      rc = node_read(mc, page_node(mp, mc->ki[mc->top]), &value, mp);
+      if (unlikely(rc != MDBX_SUCCESS))
+        return LOG_IFERR(rc);
+      ag.width = value.iov_len;
+      if (unlikely((ag.width != 4 && ag.width != 8) || (from && from->iov_len != ag.width) ||
+                   (to && to->iov_len != ag.width)))
+        return LOG_IFERR(MDBX_BAD_VALSIZE);
+      const uint64_t raw = aggregate_raw(&ag, value.iov_base);
+      if ((!from || raw >= aggregate_raw(&ag, from->iov_base)) && (!to || raw < aggregate_raw(&ag, to->iov_base)))
+        aggregate_array(&ag, value.iov_base, 1);
+      return MDBX_SUCCESS;
+    }
+    target = &mc->subcur->cursor;
+  } else if (unlikely((mc->tree->flags & (MDBX_INTEGERKEY | MDBX_REVERSEKEY)) != MDBX_INTEGERKEY ||
+                      mc->clc->k.cmp != builtin_keycmp(mc->tree->flags)))
+    return LOG_IFERR(MDBX_INCOMPATIBLE);
+
+  if (from) {
+    MDBX_val bound = *from;
+    rc = cursor_seek(target, &bound, nullptr, MDBX_SET_RANGE).err;
+  } else
+    rc = (target == mc) ? outer_first(mc, nullptr, nullptr) : inner_first(target, nullptr);
+  if (rc == MDBX_NOTFOUND)
+    return MDBX_SUCCESS;
+  if (unlikely(rc != MDBX_SUCCESS))
+    return LOG_IFERR(rc);
+
+  const page_t *const mp = target->pg[target->top];
+  ag.width = is_dupfix_leaf(mp) ? target->tree->dupfix_size : node_ks(page_node(mp, target->ki[target->top]));
+  if (unlikely((ag.width != 4 && ag.width != 8) || (to && to->iov_len != ag.width)))
+    return LOG_IFERR(MDBX_BAD_VALSIZE);
+  return LOG_IFERR(aggregate_pages(&ag, target, to));
+}
+
+/*----------------------------------------------------------------------------*/
+
 int mdbx_cursor_set_userctx(MDBX_cursor *mc, void *ctx) {
   int rc = cursor_check(mc, 0);
   if (unlikely(rc != MDBX_SUCCESS))
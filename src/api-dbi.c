@@ -38,6 +38,9 @@ __cold int mdbx_drop(MDBX_txn *txn, MDBX_dbi dbi, bool del) {
   int rc = check_txn_rw(txn, MDBX_TXN_BLOCKED);
   if (unlikely(rc != MDBX_SUCCESS))
     return LOG_IFERR(rc);
+  if (unlikely(del && txn->wr.undo))
+    /* закрытие хендла не может быть отменено при откате к точке сохранения */
+    return LOG_IFERR(MDBX_BAD_TXN);
 
   cursor_couple_t cx;
   rc = cursor_init(&cx.outer, txn, dbi);
@@ -93,8 +96,7 @@ __cold int mdbx_drop(MDBX_txn *txn, MDBX_dbi dbi, bool del) {
     }
   }
 
-  txn->flags |= MDBX_TXN_ERROR;
-  return LOG_IFERR(rc);
+  return LOG_IFERR(txn_poison(txn, rc));
 }
 
 __cold int mdbx_dbi_rename(MDBX_txn *txn, MDBX_dbi dbi, const char *name_cstr) {
@@ -120,6 +122,9 @@ __cold int mdbx_dbi_rename2(MDBX_txn *txn, MDBX_dbi dbi, const MDBX_val *new_nam
 
   if (unlikely(dbi < CORE_DBS))
     return LOG_IFERR(MDBX_EINVAL);
+  if (unlikely(txn->wr.undo))
+    /* переименование хендла не может быть отменено при откате к точке сохранения */
+    return LOG_IFERR(MDBX_BAD_TXN);
   rc = dbi_check(txn, dbi);
   if (unlikely(rc != MDBX_SUCCESS))
     return LOG_IFERR(rc);
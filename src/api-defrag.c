@@ -0,0 +1,322 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+/// \author Леонид Юрьев aka Leonid Yuriev <leo@yuriev.ru> \date 2015-2025
+
+#include "internals.h"
+
+/* Инкрементальная дефрагментация.
+ *
+ * Порогом считается количество используемых страниц, т.е. размер БД после
+ * полного уплотнения. Все используемые страницы с номерами от порога и выше
+ * находятся в «хвосте» и перемещаются копированием-при-записи, точно также
+ * как при любом изменении. Для одиночных страниц аллокатор выбирает свободные
+ * страницы с наименьшими номерами, а листья обходятся в порядке ключей, поэтому
+ * перемещённые листья ложатся в порядке ключей. Освобождённые страницы хвоста
+ * попадают в GC, а после переработки возвращаются в нераспределённое
+ * пространство, которое затем может быть отдано системе штатным механизмом
+ * уменьшения размера БД. */
+
+typedef struct defrag_context {
+  MDBX_txn *txn;
+  pgno_t threshold;
+  bool exhausted /* ниже порога не осталось свободных страниц */;
+  size_t budget;
+  size_t relocated;
+} defrag_t;
+
+static int defrag_tree(defrag_t *ctx, MDBX_dbi dbi);
+
+/* Учитывает затронутые страницы и перемещённые из хвоста. Продвижением
+ * считаются только последние, что гарантирует завершение при невозможности
+ * дальнейшего уплотнения. */
+static void defrag_account(defrag_t *ctx, size_t npages, pgno_t from, pgno_t to) {
+  ctx->budget = (ctx->budget > npages) ? ctx->budget - npages : 0;
+  if (to >= ctx->threshold)
+    /* аллокатор выдал страницу из хвоста, перемещать далее некуда */
+    ctx->exhausted = true;
+  else if (from >= ctx->threshold)
+    ctx->relocated += npages;
+}
+
+/* Перемещает страницы пути курсора от корня до листа, если хотя-бы одна из них
+ * в хвосте, либо безусловно при необходимости изменения листа. */
+static int defrag_path(defrag_t *ctx, MDBX_cursor *mc, bool force) {
+  pgno_t before[CURSOR_STACK_SIZE];
+  bool touch = false;
+  for (intptr_t i = 0; i <= mc->top; ++i) {
+    before[i] = is_modifable(ctx->txn, mc->pg[i]) ? P_INVALID : mc->pg[i]->pgno;
+    touch |= before[i] != P_INVALID && (force || before[i] >= ctx->threshold);
+  }
+  if (!touch)
+    return MDBX_SUCCESS;
+
+  int err = cursor_touch(mc, nullptr, nullptr);
+  if (likely(err == MDBX_SUCCESS))
+    for (intptr_t i = 0; i <= mc->top; ++i)
+      if (before[i] != P_INVALID)
+        defrag_account(ctx, 1, before[i], mc->pg[i]->pgno);
+  return err;
+}
+
+static int defrag_large(defrag_t *ctx, MDBX_cursor *mc, size_t i) {
+  int err = defrag_path(ctx, mc, true);
+  if (unlikely(err != MDBX_SUCCESS))
+    return err;
+
+  page_t *const mp = mc->pg[mc->top];
+  node_t *const node = page_node(mp, i);
+  const pgr_t lp = page_get_large(mc, node_largedata_pgno(node), mp->txnid);
+  if (unlikely(lp.err != MDBX_SUCCESS))
+    return lp.err;
+  if (is_modifable(ctx->txn, lp.page))
+    return MDBX_SUCCESS;
+
+  const size_t npages = lp.page->pages;
+  const pgr_t np = page_new_large(mc, npages);
+  if (unlikely(np.err != MDBX_SUCCESS))
+    return np.err;
+  if (np.page->pgno >= ctx->threshold) {
+    /* ниже порога нет подходящей последовательности страниц */
+    ctx->budget = (ctx->budget > npages) ? ctx->budget - npages : 0;
+    return page_retire(mc, np.page);
+  }
+  memcpy(page2payload(np.page), page2payload(lp.page), node_ds(node));
+  poke_pgno(node_data(node), np.page->pgno);
+  defrag_account(ctx, npages, lp.page->pgno, np.page->pgno);
+  return page_retire(mc, lp.page);
+}
+
+static int defrag_nested(defrag_t *ctx, MDBX_cursor *mc, size_t i) {
+  if (!MDBX_DISABLE_VALIDATION && unlikely(node_ds(page_node(mc->pg[mc->top], i)) != sizeof(tree_t))) {
+    ERROR("%s/%d: %s %zu", "MDBX_CORRUPTED", MDBX_CORRUPTED, "invalid dupsort sub-tree node size",
+          node_ds(page_node(mc->pg[mc->top], i)));
+    return MDBX_CORRUPTED;
+  }
+
+  mc->ki[mc->top] = (indx_t)i;
+  int err = cursor_dupsort_setup(mc, page_node(mc->pg[mc->top], i), mc->pg[mc->top]);
+  if (unlikely(err != MDBX_SUCCESS))
+    return err;
+
+  MDBX_cursor *const mx = &mc->subcur->cursor;
+  err = inner_first(mx, nullptr);
+  while (err == MDBX_SUCCESS && ctx->budget && !ctx->exhausted) {
+    bool tail = false;
+    for (intptr_t n = 0; n <= mx->top; ++n)
+      tail |= mx->pg[n]->pgno >= ctx->threshold && !is_modifable(ctx->txn, mx->pg[n]);
+    if (tail) {
+      /* для обновления корня вложенного дерева лист должен быть изменяемым */
+      err = defrag_path(ctx, mc, true);
+      if (likely(err == MDBX_SUCCESS))
+        err = defrag_path(ctx, mx, false);
+      if (unlikely(err != MDBX_SUCCESS))
+        return err;
+      mc->subcur->nested_tree.mod_txnid = ctx->txn->txnid;
+      memcpy(node_data(page_node(mc->pg[mc->top], i)), &mc->subcur->nested_tree, sizeof(tree_t));
+    }
+    err = cursor_sibling_right(mx);
+  }
+  return (err == MDBX_NOTFOUND) ? MDBX_SUCCESS : err;
+}
+
+/* Проверяет открыт ли уже хендл таблицы, чтобы закрыть после обработки только открытые дефрагментацией. */
+static int defrag_handle_opened(MDBX_env *env, const MDBX_val *name, bool *opened) {
+  int err = osal_fastmutex_acquire(&env->dbi_lock);
+  if (unlikely(err != MDBX_SUCCESS))
+    return err;
+  *opened = false;
+  for (size_t slot = CORE_DBS; slot < env->n_dbi && !*opened; ++slot)
+    *opened = (env->dbs_flags[slot] & DB_VALID) && env->kvs[MAIN_DBI].clc.k.cmp(name, &env->kvs[slot].name) == 0;
+  ENSURE(env, osal_fastmutex_release(&env->dbi_lock) == MDBX_SUCCESS);
+  return MDBX_SUCCESS;
+}
+
+static int defrag_table(defrag_t *ctx, MDBX_cursor *mc, size_t i) {
+  const node_t *node = page_node(mc->pg[mc->top], i);
+  if (unlikely(node_ds(node) != sizeof(tree_t))) {
+    ERROR("%s/%d: %s %zu", "MDBX_CORRUPTED", MDBX_CORRUPTED, "invalid table node size", node_ds(node));
+    return MDBX_CORRUPTED;
+  }
+
+  MDBX_txn *const txn = ctx->txn;
+  MDBX_env *const env = txn->env;
+  const MDBX_val name = {node_key(node), node_ks(node)};
+  bool opened;
+  int err = defrag_handle_opened(env, &name, &opened);
+  if (unlikely(err != MDBX_SUCCESS))
+    return err;
+
+  MDBX_dbi dbi;
+  err = dbi_open(txn, &name, MDBX_DB_ACCEDE, &dbi, nullptr, nullptr);
+  if (unlikely(err == MDBX_DBS_FULL)) {
+    NOTICE("defrag: skip table '%.*s' since no free dbi-handles", (int)name.iov_len, (const char *)name.iov_base);
+    return MDBX_SUCCESS;
+  }
+  if (unlikely(err != MDBX_SUCCESS))
+    return err;
+  err = defrag_tree(ctx, dbi);
+  if (opened || unlikely(err != MDBX_SUCCESS))
+    return err;
+
+  /* Хендл открыт только для дефрагментации и закрывается, а изменённая
+   * запись таблицы сразу обновляется в MainDB, аналогично вложенным деревьям */
+  if (txn->dbi_state[dbi] & DBI_DIRTY) {
+    err = defrag_path(ctx, mc, true);
+    if (unlikely(err != MDBX_SUCCESS))
+      return err;
+    txn->dbs[dbi].mod_txnid = txn->txnid;
+    memcpy(node_data(page_node(mc->pg[mc->top], i)), &txn->dbs[dbi], sizeof(tree_t));
+  }
+  txn->dbi_state[dbi] = DBI_LINDO | DBI_OLDEN;
+  err = osal_fastmutex_acquire(&env->dbi_lock);
+  return likely(err == MDBX_SUCCESS) ? dbi_close_release(env, dbi) : err;
+}
+
+static int defrag_leaf(defrag_t *ctx, MDBX_cursor *mc) {
+  int err = defrag_path(ctx, mc, false);
+  if (unlikely(err != MDBX_SUCCESS) || is_dupfix_leaf(mc->pg[mc->top]))
+    return err;
+
+  for (size_t i = 0; i < page_numkeys(mc->pg[mc->top]) && ctx->budget && !ctx->exhausted; ++i) {
+    /* страница может быть перемещена на предыдущей итерации */
+    const node_t *const node = page_node(mc->pg[mc->top], i);
+    switch (node_flags(node)) {
+    case N_BIG:
+      if (node_largedata_pgno(node) >= ctx->threshold)
+        err = defrag_large(ctx, mc, i);
+      break;
+    case N_TREE | N_DUP:
+      err = defrag_nested(ctx, mc, i);
+      break;
+    case N_TREE:
+      if (cursor_is_main(mc))
+        err = defrag_table(ctx, mc, i);
+      break;
+    }
+    if (unlikely(err != MDBX_SUCCESS))
+      return err;
+  }
+  return MDBX_SUCCESS;
+}
+
+static int defrag_tree(defrag_t *ctx, MDBX_dbi dbi) {
+  cursor_couple_t cx;
+  int err = cursor_init(&cx.outer, ctx->txn, dbi);
+  if (unlikely(err != MDBX_SUCCESS))
+    return err;
+
+  MDBX_txn *const txn = ctx->txn;
+  cx.outer.next = txn->cursors[dbi];
+  txn->cursors[dbi] = &cx.outer;
+  err = outer_first(&cx.outer, nullptr, nullptr);
+  while (err == MDBX_SUCCESS && ctx->budget && !ctx->exhausted) {
+    err = defrag_leaf(ctx, &cx.outer);
+    if (likely(err == MDBX_SUCCESS))
+      err = cursor_sibling_right(&cx.outer);
+  }
+  txn->cursors[dbi] = cx.outer.next;
+  return (err == MDBX_NOTFOUND) ? MDBX_SUCCESS : err;
+}
+
+/* Проверяет наличие в GC страниц хвоста, которые пока не могут быть переработаны только из-за недавней фиксации
+ * транзакции, но не удерживаются читателями. Такие страницы станут доступными после очередной фиксации. */
+static int defrag_pending(MDBX_txn *txn, pgno_t threshold, bool *pending) {
+  MDBX_env *const env = txn->env;
+  txn_gc_detent(txn);
+  *pending = false;
+  if (env->gc.detent < txn->wr.troika.txnid[txn->wr.troika.prefer_steady])
+    /* переработка удерживается читателями */
+    return MDBX_SUCCESS;
+
+  cursor_couple_t cx;
+  int err = cursor_init(&cx.outer, txn, FREE_DBI);
+  if (unlikely(err != MDBX_SUCCESS))
+    return err;
+  txnid_t id = env->gc.detent;
+  MDBX_val key = {.iov_base = &id, .iov_len = sizeof(id)}, data;
+  err = cursor_ops(&cx.outer, &key, &data, MDBX_SET_RANGE);
+  while (err == MDBX_SUCCESS) {
+    const pgno_t *const pnl = data.iov_base;
+    if (unlikely(data.iov_len % sizeof(pgno_t) || data.iov_len < sizeof(pgno_t) ||
+                 data.iov_len < (pnl_packed_len(pnl) + 1) * sizeof(pgno_t))) {
+      ERROR("%s/%d: %s", "MDBX_CORRUPTED", MDBX_CORRUPTED, "invalid GC value-length");
+      return MDBX_CORRUPTED;
+    }
+    if (pnl_packed_len(pnl) && pnl_packed_most(pnl) >= threshold) {
+      *pending = true;
+      return MDBX_SUCCESS;
+    }
+    err = cursor_ops(&cx.outer, &key, &data, MDBX_NEXT);
+  }
+  return (err == MDBX_NOTFOUND) ? MDBX_SUCCESS : err;
+}
+
+static int defrag_step(MDBX_txn *txn, size_t budget) {
+  MDBX_stat st;
+  int err = mdbx_env_stat_ex(txn->env, txn, &st, sizeof(st));
+  if (unlikely(err != MDBX_SUCCESS))
+    return err;
+
+  /* При копировании-при-записи вместе с листом перемещаются вышестоящие branch-страницы, а при фиксации транзакции
+   * обновляется GC, при этом освобождаемые страницы становятся доступными только в следующих транзакциях. Поэтому
+   * для исключения бесконечного «перетасовывания» страниц около порога к нему добавляется запас на их количество. */
+  const tree_t *const gc = &txn->dbs[FREE_DBI];
+  const size_t reserve = st.ms_branch_pages + gc->branch_pages + gc->leaf_pages + gc->large_pages;
+  defrag_t ctx = {.txn = txn, .budget = budget};
+  ctx.threshold = (pgno_t)(NUM_METAS + st.ms_leaf_pages + st.ms_overflow_pages + reserve + reserve);
+
+  /* Переработка GC даёт свободные страницы ниже порога для перемещения, а
+   * свободные страницы в конце БД будут возвращены в нераспределённый хвост. */
+  const pgno_t first_unallocated = txn->geo.first_unallocated;
+  cursor_couple_t cx;
+  err = cursor_init(&cx.outer, txn, MAIN_DBI);
+  /* Объём переработки ограничивается бюджетом, как по количеству записей GC, так и по страницам. */
+  for (size_t n = 0; err == MDBX_SUCCESS && txn->geo.first_unallocated > ctx.threshold && n < budget &&
+                     gc_repnl_npages(txn) < budget;
+       ++n)
+    err = gc_alloc_ex(&cx.outer, 1, ALLOC_RESERVE | ALLOC_UNIMPORTANT).err;
+  if (unlikely(err != MDBX_SUCCESS && err != MDBX_NOTFOUND))
+    return err;
+
+  err = defrag_tree(&ctx, MAIN_DBI);
+  VERBOSE("defrag: threshold %" PRIaPGNO ", relocated %zu, first-unallocated %" PRIaPGNO "%s", ctx.threshold,
+          ctx.relocated, txn->geo.first_unallocated, ctx.exhausted ? ", exhausted" : "");
+  if (unlikely(err != MDBX_SUCCESS) || ctx.relocated)
+    return err;
+
+  /* Размер БД уменьшается при фиксации только если хвост не используется и предыдущим снимком,
+   * поэтому после возврата страниц требуется ещё одна фиксация. */
+  if (txn->geo.first_unallocated < first_unallocated)
+    return MDBX_SUCCESS;
+  bool pending = false;
+  if (txn->geo.first_unallocated > ctx.threshold) {
+    err = defrag_pending(txn, ctx.threshold, &pending);
+    if (unlikely(err != MDBX_SUCCESS))
+      return err;
+  }
+  /* Страницы хвоста станут доступными после фиксации любой последующей пишущей транзакции,
+   * но здесь фиксация без изменений не форсируется. */
+  return pending ? MDBX_SUCCESS : MDBX_RESULT_TRUE;
+}
+
+__cold int mdbx_env_defrag(MDBX_env *env, size_t budget) {
+  int rc = check_env(env, true);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return LOG_IFERR(rc);
+  if (unlikely(!budget))
+    return LOG_IFERR(MDBX_EINVAL);
+
+  MDBX_txn *txn;
+  rc = mdbx_txn_begin(env, nullptr, MDBX_TXN_READWRITE, &txn);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return LOG_IFERR(rc);
+
+  const int err = defrag_step(txn, budget);
+  if (unlikely(MDBX_IS_ERROR(err))) {
+    mdbx_txn_abort(txn);
+    return LOG_IFERR(err);
+  }
+  rc = mdbx_txn_commit(txn);
+  if (unlikely(MDBX_IS_ERROR(rc)))
+    return LOG_IFERR(rc);
+  return err;
+}
@@ -430,6 +430,52 @@ __cold int mdbx_env_deleteW(const wchar_t *pathname, MDBX_env_delete_mode_t mode
   return LOG_IFERR((err == MDBX_SUCCESS) ? rc : err);
 }
 
+#if defined(MFD_CLOEXEC)
+/* Для анонимной БД указанный путь пуст, а в качестве имен файлов используются
+ * только метки memfd, видимые в /proc/self/fd. */
+__cold static int env_anonymous_pathname(MDBX_env *env) {
+  static const char dxb_name[] = MDBX_DATANAME;
+  static const char lck_name[] = MDBX_LOCKNAME;
+  memset(&env->pathname, 0, sizeof(env->pathname));
+  env->pathname.buffer = osal_malloc(1 + sizeof(dxb_name) + sizeof(lck_name));
+  if (!env->pathname.buffer)
+    return MDBX_ENOMEM;
+
+  env->pathname.specified = env->pathname.buffer;
+  env->pathname.dxb = env->pathname.specified + 1;
+  env->pathname.lck = env->pathname.dxb + sizeof(dxb_name);
+  env->pathname.specified[0] = '\0';
+  memcpy(env->pathname.dxb, dxb_name + 1, sizeof(dxb_name) - 1);
+  memcpy(env->pathname.lck, lck_name + 1, sizeof(lck_name) - 1);
+  return MDBX_SUCCESS;
+}
+#endif /* MFD_CLOEXEC */
+
+__cold int mdbx_env_open_anonymous(MDBX_env *env, MDBX_env_flags_t flags) {
+  int rc = check_env(env, false);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return LOG_IFERR(rc);
+
+  if (unlikely(flags & (MDBX_RDONLY | MDBX_ACCEDE)))
+    return LOG_IFERR(MDBX_EINVAL);
+
+#if defined(MFD_CLOEXEC)
+  if (unlikely(env->lazy_fd != INVALID_HANDLE_VALUE || (env->flags & ENV_ACTIVE) != 0 || env->dxb_mmap.base))
+    return LOG_IFERR(MDBX_EPERM);
+
+  /* Данные существуют только в памяти и только в текущем процессе, поэтому
+   * нет смысла ни в сбросе на диск, ни в совместной работе с другими
+   * процессами. */
+  env->anonymous = true;
+  rc = mdbx_env_open(env, "", flags | MDBX_NOSUBDIR | MDBX_EXCLUSIVE | MDBX_UTTERLY_NOSYNC, S_IRUSR | S_IWUSR);
+  if (unlikely(rc != MDBX_SUCCESS))
+    env->anonymous = false;
+  return rc;
+#else
+  return LOG_IFERR(MDBX_ENOSYS);
+#endif /* MFD_CLOEXEC */
+}
+
 __cold int mdbx_env_open(MDBX_env *env, const char *pathname, MDBX_env_flags_t flags, mdbx_mode_t mode) {
 #if defined(_WIN32) || defined(_WIN64)
   wchar_t *pathnameW = nullptr;
@@ -485,7 +531,11 @@ __cold int mdbx_env_openW(MDBX_env *env, const wchar_t *pathname, MDBX_env_flags
   }
 
   env->flags = (flags & ~ENV_FATAL_ERROR);
+#if defined(MFD_CLOEXEC)
+  rc = env->anonymous ? env_anonymous_pathname(env) : env_handle_pathname(env, pathname, mode);
+#else
   rc = env_handle_pathname(env, pathname, mode);
+#endif /* MFD_CLOEXEC */
   if (unlikely(rc != MDBX_SUCCESS))
     goto bailout;
 
@@ -582,7 +632,6 @@ __cold int mdbx_env_resurrect_after_fork(MDBX_env *env) {
 #endif /* Windows */
 
 __cold int mdbx_env_close_ex(MDBX_env *env, bool dont_sync) {
-  page_t *dp;
   int rc = MDBX_SUCCESS;
 
   if (unlikely(!env))
@@ -651,13 +700,7 @@ __cold int mdbx_env_close_ex(MDBX_env *env, bool dont_sync) {
   lck_ipclock_destroy(&stub->wrt_lock);
 #endif /* MDBX_LOCKING */
 
-  while ((dp = env->shadow_reserve) != nullptr) {
-    MDBX_ASAN_UNPOISON_MEMORY_REGION(dp, env->ps);
-    VALGRIND_MAKE_MEM_DEFINED(&page_next(dp), sizeof(page_t *));
-    env->shadow_reserve = page_next(dp);
-    void *const ptr = ptr_disp(dp, -(ptrdiff_t)sizeof(size_t));
-    osal_free(ptr);
-  }
+  page_shadow_trim(env, true);
   VALGRIND_DESTROY_MEMPOOL(env);
   osal_free(env);
 
@@ -819,9 +862,33 @@ __must_check_result static int env_info_snap(const MDBX_env *env, const MDBX_txn
   out->mi_pgop_stat.mincore = atomic_load64(&lck->pgops.mincore, mo_Relaxed);
   out->mi_pgop_stat.msync = atomic_load64(&lck->pgops.msync, mo_Relaxed);
   out->mi_pgop_stat.fsync = atomic_load64(&lck->pgops.fsync, mo_Relaxed);
+  out->mi_prefetch_stat.issued = atomic_load64(&env->prefetch_stat.issued, mo_Relaxed);
+  out->mi_prefetch_stat.hits = atomic_load64(&env->prefetch_stat.hits, mo_Relaxed);
+  out->mi_prefetch_stat.misses = atomic_load64(&env->prefetch_stat.misses, mo_Relaxed);
+  out->mi_finger_stat.searches = atomic_load64(&env->finger_stat.searches, mo_Relaxed);
+  out->mi_finger_stat.levels_saved = atomic_load64(&env->finger_stat.levels_saved, mo_Relaxed);
+  out->mi_cache_stat.hits = atomic_load64(&env->cache_stat.hits, mo_Relaxed);
+  out->mi_cache_stat.misses = atomic_load64(&env->cache_stat.misses, mo_Relaxed);
+  out->mi_cache_stat.invalidations = atomic_load64(&env->cache_stat.invalidations, mo_Relaxed);
+  out->mi_gc_seq_stat.searches = atomic_load64(&env->gc_seq_stat.searches, mo_Relaxed);
+  out->mi_gc_seq_stat.steps = atomic_load64(&env->gc_seq_stat.steps, mo_Relaxed);
+  out->mi_gc_seq_stat.rebuilds = atomic_load64(&env->gc_seq_stat.rebuilds, mo_Relaxed);
+  out->mi_gc_seq_stat.growths = atomic_load64(&env->gc_seq_stat.growths, mo_Relaxed);
+  out->mi_dsync_stat.writes = atomic_load64(&env->dsync_stat.writes, mo_Relaxed);
 #else
   memset(&out->mi_pgop_stat, 0, sizeof(out->mi_pgop_stat));
+  memset(&out->mi_prefetch_stat, 0, sizeof(out->mi_prefetch_stat));
+  memset(&out->mi_finger_stat, 0, sizeof(out->mi_finger_stat));
+  memset(&out->mi_cache_stat, 0, sizeof(out->mi_cache_stat));
+  memset(&out->mi_gc_seq_stat, 0, sizeof(out->mi_gc_seq_stat));
+  memset(&out->mi_dsync_stat, 0, sizeof(out->mi_dsync_stat));
 #endif /* MDBX_ENABLE_PGOP_STAT*/
+  out->mi_dp_slab.bytes = atomic_load64(&env->shadow_slab.bytes, mo_Relaxed);
+  out->mi_dp_slab.chunks = atomic_load64(&env->shadow_slab.chunks, mo_Relaxed);
+  out->mi_dp_slab.used = atomic_load64(&env->shadow_slab.used, mo_Relaxed);
+  out->mi_dp_slab.hugetlb = atomic_load64(&env->shadow_slab.hugetlb, mo_Relaxed);
+  out->mi_dxb_hugepages.advised = 0;
+  out->mi_dxb_hugepages.resident = 0;
 
   txnid_t overall_latter_reader_txnid = out->mi_recent_txnid;
   txnid_t self_latter_reader_txnid = overall_latter_reader_txnid;
@@ -857,16 +924,28 @@ __cold int env_info(const MDBX_env *env, const MDBX_txn *txn, MDBX_envinfo *out,
     snap.mi_since_sync_seconds16dot16 = out->mi_since_sync_seconds16dot16;
     snap.mi_since_reader_check_seconds16dot16 = out->mi_since_reader_check_seconds16dot16;
     if (likely(memcmp(&snap, out, sizeof(MDBX_envinfo)) == 0))
-      return MDBX_SUCCESS;
+      break;
     memcpy(&snap, out, sizeof(MDBX_envinfo));
   }
+
+  /* чтение /proc/self/smaps относительно дорогое, поэтому выполняется
+   * однократно вне цикла получения согласованного снимка */
+  if (env->dxb_mmap.base && dxb_hugepages(env)) {
+    out->mi_dxb_hugepages.advised = env->dxb_mmap.limit;
+    out->mi_dxb_hugepages.resident = dxb_hugepages_resident(env);
+  }
+  return MDBX_SUCCESS;
 }
 
 __cold int mdbx_env_info_ex(const MDBX_env *env, const MDBX_txn *txn, MDBX_envinfo *arg, size_t bytes) {
   if (unlikely((env == nullptr && txn == nullptr) || arg == nullptr))
     return LOG_IFERR(MDBX_EINVAL);
 
-  if (unlikely(bytes != sizeof(MDBX_envinfo)))
+  /* the structure is extended by appending fields at the end,
+   * so a shorter size used by previous versions is acceptable */
+  const size_t size_before_prefetch_stat = offsetof(MDBX_envinfo, mi_prefetch_stat);
+  if (unlikely(bytes != sizeof(MDBX_envinfo)) &&
+      (bytes < size_before_prefetch_stat || bytes > sizeof(MDBX_envinfo) || bytes % sizeof(uint64_t)))
     return LOG_IFERR(MDBX_EINVAL);
 
   if (txn) {
@@ -885,6 +964,12 @@ __cold int mdbx_env_info_ex(const MDBX_env *env, const MDBX_txn *txn, MDBX_envin
   }
 
   troika_t troika;
+  if (unlikely(bytes != sizeof(MDBX_envinfo))) {
+    MDBX_envinfo snap;
+    int err = env_info(env, txn, &snap, &troika);
+    memcpy(arg, &snap, bytes);
+    return LOG_IFERR(err);
+  }
   return LOG_IFERR(env_info(env, txn, arg, &troika));
 }
 
@@ -986,6 +1071,9 @@ __cold int mdbx_env_set_geometry(MDBX_env *env, intptr_t size_lower, intptr_t si
     /* env already mapped */
     if (unlikely(env->flags & MDBX_RDONLY))
       return LOG_IFERR(MDBX_EACCESS);
+    if (unlikely(env->blockdev))
+      /* размер определяется ёмкостью блочного устройства */
+      return LOG_IFERR(MDBX_EPERM);
 
     if (!txn_owned) {
       int err = lck_txn_lock(env, false);
@@ -110,6 +110,46 @@ static uint8_t default_dp_loose_limit(const MDBX_env *env) {
   return 64;
 }
 
+static unsigned default_prefetch_window(const MDBX_env *env) {
+  (void)env;
+  return 0;
+}
+
+static uint8_t default_dp_slab(const MDBX_env *env) {
+  (void)env;
+  return 0;
+}
+
+static uint8_t default_spill_policy(const MDBX_env *env) {
+  (void)env;
+  return 0;
+}
+
+static uint8_t default_dxb_hugepages(const MDBX_env *env) {
+  (void)env;
+  return 0;
+}
+
+static pgno_t default_dxb_preallocate(const MDBX_env *env) {
+  (void)env;
+  return 0;
+}
+
+static uint8_t default_dxb_direct_write(const MDBX_env *env) {
+  (void)env;
+  return 0;
+}
+
+static uint8_t default_single_flush(const MDBX_env *env) {
+  (void)env;
+  return 0;
+}
+
+static uint8_t default_gc_extents(const MDBX_env *env) {
+  (void)env;
+  return 0;
+}
+
 void env_options_init(MDBX_env *env) {
   env->options.rp_augment_limit = default_rp_augment_limit(env);
   env->options.dp_reserve_limit = default_dp_reserve_limit(env);
@@ -135,6 +175,14 @@ void env_options_init(MDBX_env *env) {
   env->options.subpage.room_threshold = default_subpage_room_threshold(env);
   env->options.subpage.reserve_prereq = default_subpage_reserve_prereq(env);
   env->options.subpage.reserve_limit = default_subpage_reserve_limit(env);
+  env->options.prefetch_window = default_prefetch_window(env);
+  env->options.dp_slab = default_dp_slab(env);
+  env->options.spill_policy = default_spill_policy(env);
+  env->options.dxb_hugepages = default_dxb_hugepages(env);
+  env->options.dxb_preallocate = default_dxb_preallocate(env);
+  env->options.dxb_direct_write = default_dxb_direct_write(env);
+  env->options.single_flush = default_single_flush(env);
+  env->options.gc_extents = default_gc_extents(env);
 }
 
 void env_options_adjust_dp_limit(MDBX_env *env) {
@@ -261,16 +309,7 @@ __cold int mdbx_env_set_option(MDBX_env *env, const MDBX_option_t option, uint64
         should_unlock = true;
       }
       env->options.dp_reserve_limit = (unsigned)value;
-      while (env->shadow_reserve_len > env->options.dp_reserve_limit) {
-        eASSERT(env, env->shadow_reserve != nullptr);
-        page_t *dp = env->shadow_reserve;
-        MDBX_ASAN_UNPOISON_MEMORY_REGION(dp, env->ps);
-        VALGRIND_MAKE_MEM_DEFINED(&page_next(dp), sizeof(page_t *));
-        env->shadow_reserve = page_next(dp);
-        void *const ptr = ptr_disp(dp, -(ptrdiff_t)sizeof(size_t));
-        osal_free(ptr);
-        env->shadow_reserve_len -= 1;
-      }
+      page_shadow_trim(env, false);
     }
     break;
 
@@ -464,6 +503,95 @@ __cold int mdbx_env_set_option(MDBX_env *env, const MDBX_option_t option, uint64
     }
     break;
 
+  case MDBX_opt_prefetch_window:
+    if (value == /* default */ UINT64_MAX)
+      env->options.prefetch_window = default_prefetch_window(env);
+    else if (value > 1024)
+      err = MDBX_EINVAL;
+    else
+      env->options.prefetch_window = (unsigned)value;
+    break;
+
+  case MDBX_opt_dp_slab:
+    if (value == /* default */ UINT64_MAX)
+      value = default_dp_slab(env);
+    if (unlikely(value > 2))
+      return LOG_IFERR(MDBX_EINVAL);
+    if (env->options.dp_slab != (uint8_t)value) {
+      if (lock_needed) {
+        err = lck_txn_lock(env, false);
+        if (unlikely(err != MDBX_SUCCESS))
+          return LOG_IFERR(err);
+        should_unlock = true;
+      }
+      env->options.dp_slab = (uint8_t)value;
+      page_shadow_trim(env, false);
+    }
+    break;
+
+  case MDBX_opt_spill_policy:
+    if (value == /* default */ UINT64_MAX)
+      env->options.spill_policy = default_spill_policy(env);
+    else if (value > 1)
+      err = MDBX_EINVAL;
+    else
+      env->options.spill_policy = (uint8_t)value;
+    break;
+
+  case MDBX_opt_dxb_hugepages:
+    if (value == /* default */ UINT64_MAX)
+      value = default_dxb_hugepages(env);
+    if (unlikely(value > 1))
+      return LOG_IFERR(MDBX_EINVAL);
+    if (unlikely(env->dxb_mmap.base))
+      return LOG_IFERR(MDBX_EPERM);
+    env->options.dxb_hugepages = (uint8_t)value;
+    break;
+
+  case MDBX_opt_dxb_preallocate:
+    if (value == /* default */ UINT64_MAX)
+      value = default_dxb_preallocate(env);
+    if (unlikely(value > MAX_PAGENO))
+      return LOG_IFERR(MDBX_EINVAL);
+    if (!DXB_PREALLOCATE && value)
+      return LOG_IFERR(MDBX_ENOSYS);
+    env->options.dxb_preallocate = (pgno_t)value;
+    break;
+
+  case MDBX_opt_dxb_direct_write:
+    if (value == /* default */ UINT64_MAX)
+      value = default_dxb_direct_write(env);
+    if (unlikely(value > 1))
+      return LOG_IFERR(MDBX_EINVAL);
+#if defined(_WIN32) || defined(_WIN64) || !defined(O_DIRECT)
+    if (value)
+      return LOG_IFERR(MDBX_ENOSYS);
+#endif /* !O_DIRECT */
+    if (unlikely(env->dxb_mmap.base))
+      return LOG_IFERR(MDBX_EPERM);
+    env->options.dxb_direct_write = (uint8_t)value;
+    break;
+
+  case MDBX_opt_single_flush:
+    if (value == /* default */ UINT64_MAX)
+      value = default_single_flush(env);
+    if (unlikely(value > 1))
+      return LOG_IFERR(MDBX_EINVAL);
+#if defined(_WIN32) || defined(_WIN64)
+    if (value)
+      return LOG_IFERR(MDBX_ENOSYS);
+#endif /* Windows */
+    env->options.single_flush = (uint8_t)value;
+    break;
+
+  case MDBX_opt_gc_extents:
+    if (value == /* default */ UINT64_MAX)
+      value = default_gc_extents(env);
+    if (unlikely(value > 1))
+      return LOG_IFERR(MDBX_EINVAL);
+    env->options.gc_extents = (uint8_t)value;
+    break;
+
   default:
     return LOG_IFERR(MDBX_EINVAL);
   }
@@ -570,6 +698,38 @@ __cold int mdbx_env_get_option(const MDBX_env *env, const MDBX_option_t option,
     *pvalue = env->options.subpage.reserve_limit;
     break;
 
+  case MDBX_opt_prefetch_window:
+    *pvalue = env->options.prefetch_window;
+    break;
+
+  case MDBX_opt_dp_slab:
+    *pvalue = env->options.dp_slab;
+    break;
+
+  case MDBX_opt_spill_policy:
+    *pvalue = env->options.spill_policy;
+    break;
+
+  case MDBX_opt_dxb_hugepages:
+    *pvalue = env->options.dxb_hugepages;
+    break;
+
+  case MDBX_opt_dxb_preallocate:
+    *pvalue = env->options.dxb_preallocate;
+    break;
+
+  case MDBX_opt_dxb_direct_write:
+    *pvalue = env->options.dxb_direct_write;
+    break;
+
+  case MDBX_opt_single_flush:
+    *pvalue = env->options.single_flush;
+    break;
+
+  case MDBX_opt_gc_extents:
+    *pvalue = env->options.gc_extents;
+    break;
+
   default:
     return LOG_IFERR(MDBX_EINVAL);
   }
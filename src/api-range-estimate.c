@@ -363,3 +363,165 @@ __hot int mdbx_estimate_range(const MDBX_txn *txn, MDBX_dbi dbi, const MDBX_val
 
   return MDBX_SUCCESS;
 }
+
+/*------------------------------------------------------------------------------
+ * Range-Partitioning API */
+
+/* Ключ-разделитель для элемента на уровне level стека курсора.
+ * Для нулевого элемента branch-страницы ключ не хранится, поэтому
+ * разделителем является ближайший ненулевой элемент вверх по стеку. */
+static bool partition_separator(const MDBX_cursor *mc, intptr_t level, MDBX_val *key) {
+  while (mc->ki[level] == 0 && is_branch(mc->pg[level]))
+    if (--level < 0)
+      return false;
+  *key = get_key(page_node(mc->pg[level], mc->ki[level]));
+  return true;
+}
+
+/* Переход к следующему элементу на уровне mc->top, в том числе на соседнюю
+ * страницу того-же уровня через родительские branch-страницы. */
+static int partition_step(MDBX_cursor *mc) {
+  if (mc->ki[mc->top] + (size_t)1 < page_numkeys(mc->pg[mc->top])) {
+    mc->ki[mc->top] += 1;
+    return MDBX_SUCCESS;
+  }
+  return cursor_sibling_right(mc);
+}
+
+static inline bool partition_reached(const MDBX_cursor *mc, const MDBX_cursor *end) {
+  return mc->pg[mc->top] == end->pg[mc->top] && mc->ki[mc->top] >= end->ki[mc->top];
+}
+
+/* Выбирает до parts-1 ключей-разделителей, количество частей в *count. */
+static int partition_split(const MDBX_txn *txn, MDBX_dbi dbi, const MDBX_val *begin_key, const MDBX_val *end_key,
+                           size_t parts, MDBX_val *boundaries, size_t *count) {
+  *count = 1;
+  cursor_couple_t begin;
+  int rc = cursor_init(&begin.outer, txn, dbi);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return rc;
+
+  if (unlikely(begin_key && end_key && begin.outer.clc->k.cmp(begin_key, end_key) > 0))
+    return MDBX_EINVAL;
+  if (parts < 2 || begin.outer.tree->items == 0)
+    return MDBX_SUCCESS;
+
+  if (begin_key) {
+    MDBX_val proxy_key = *begin_key, proxy_data = {nullptr, 0};
+    rc = cursor_seek(&begin.outer, &proxy_key, &proxy_data, MDBX_SET_LOWERBOUND).err;
+  } else
+    rc = outer_first(&begin.outer, nullptr, nullptr);
+  if (unlikely(rc != MDBX_SUCCESS) && (rc != MDBX_NOTFOUND || !is_pointed(&begin.outer)))
+    return rc;
+
+  cursor_couple_t end;
+  rc = cursor_init(&end.outer, txn, dbi);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return rc;
+  if (end_key) {
+    MDBX_val proxy_key = *end_key, proxy_data = {nullptr, 0};
+    rc = cursor_seek(&end.outer, &proxy_key, &proxy_data, MDBX_SET_LOWERBOUND).err;
+  } else
+    rc = outer_last(&end.outer, nullptr, nullptr);
+  if (unlikely(rc != MDBX_SUCCESS) && (rc != MDBX_NOTFOUND || !is_pointed(&end.outer)))
+    return rc;
+
+  const tree_t *const tree = begin.outer.tree;
+  const intptr_t leaf_level = tree->height - 1;
+  cASSERT(&begin.outer, begin.outer.top == leaf_level && end.outer.top == leaf_level);
+
+  /* Находим уровень, на котором стеки курсоров расходятся. */
+  intptr_t level = 0;
+  while (begin.outer.ki[level] == end.outer.ki[level])
+    if (++level > leaf_level)
+      return MDBX_SUCCESS;
+  if (unlikely(begin.outer.ki[level] > end.outer.ki[level]))
+    return MDBX_SUCCESS;
+
+  /* Опускаемся до уровня, на котором в диапазон попадает достаточно элементов
+   * для равномерного разбиения, оценивая их количество по среднему ветвлению
+   * (аналогично estimate()), но с запасом для сглаживания заполнения страниц. */
+  const size_t branch_fanout = tree->branch_pages ? (tree->leaf_pages + tree->branch_pages - 1) / tree->branch_pages : 2;
+  const size_t leaf_fanout = tree->leaf_pages ? (size_t)(tree->items / tree->leaf_pages) : 2;
+  const size_t wanted = parts * 4;
+  size_t estimated = end.outer.ki[level] - begin.outer.ki[level] + (size_t)1;
+  while (estimated < wanted && level < leaf_level) {
+    level += 1;
+    const size_t fanout = (level < leaf_level) ? branch_fanout : leaf_fanout;
+    estimated *= (fanout > 2) ? fanout : 2;
+  }
+
+  /* Первый проход: подсчет элементов уровня внутри диапазона. */
+  cursor_couple_t scan;
+  rc = cursor_init(&scan.outer, txn, dbi);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return rc;
+  cursor_cpstk(&begin.outer, &scan.outer);
+  scan.outer.top = (int8_t)level;
+  size_t total = 1;
+  while (!partition_reached(&scan.outer, &end.outer)) {
+    rc = partition_step(&scan.outer);
+    if (unlikely(rc != MDBX_SUCCESS)) {
+      if (rc != MDBX_NOTFOUND)
+        return rc;
+      break;
+    }
+    total += 1;
+  }
+
+  /* Второй проход: выбор равноотстоящих разделителей. */
+  const size_t goal = (parts < total) ? parts : total;
+  cursor_cpstk(&begin.outer, &scan.outer);
+  scan.outer.top = (int8_t)level;
+  size_t n = 1;
+  for (size_t i = 0, k = 1; k < goal; ++k) {
+    const size_t target = k * total / goal;
+    while (i < target) {
+      rc = partition_step(&scan.outer);
+      if (unlikely(rc != MDBX_SUCCESS))
+        return (rc == MDBX_NOTFOUND) ? MDBX_PROBLEM : rc;
+      i += 1;
+    }
+    MDBX_val separator;
+    if (unlikely(!partition_separator(&scan.outer, level, &separator)))
+      continue;
+    if (end_key && begin.outer.clc->k.cmp(&separator, end_key) >= 0)
+      break;
+    if (n > 1 && begin.outer.clc->k.cmp(&separator, &boundaries[n - 2]) <= 0)
+      continue;
+    boundaries[n - 1] = separator;
+    *count = ++n;
+  }
+  return MDBX_SUCCESS;
+}
+
+__hot int mdbx_dbi_partition(const MDBX_txn *txn, MDBX_dbi dbi, const MDBX_val *begin_key, const MDBX_val *end_key,
+                             size_t parts, MDBX_val *boundaries, ptrdiff_t *estimated_items, size_t *count) {
+  if (unlikely(!count || parts < 1 || (parts > 1 && !boundaries)))
+    return LOG_IFERR(MDBX_EINVAL);
+
+  if (unlikely(begin_key == MDBX_EPSILON || end_key == MDBX_EPSILON))
+    return LOG_IFERR(MDBX_EINVAL);
+
+  *count = 0;
+  int rc = check_txn(txn, MDBX_TXN_BLOCKED);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return LOG_IFERR(rc);
+
+  size_t n;
+  rc = partition_split(txn, dbi, begin_key, end_key, parts, boundaries, &n);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return LOG_IFERR(rc);
+
+  if (estimated_items) {
+    for (size_t i = 0; i < n; ++i) {
+      const MDBX_val *const from = i ? &boundaries[i - 1] : begin_key;
+      const MDBX_val *const to = (i + 1 < n) ? &boundaries[i] : end_key;
+      rc = mdbx_estimate_range(txn, dbi, from, nullptr, to, nullptr, &estimated_items[i]);
+      if (unlikely(rc != MDBX_SUCCESS))
+        return LOG_IFERR(rc);
+    }
+  }
+  *count = n;
+  return MDBX_SUCCESS;
+}
@@ -135,6 +135,81 @@ int mdbx_get_ex(const MDBX_txn *txn, MDBX_dbi dbi, MDBX_val *key, MDBX_val *data
 
 /*----------------------------------------------------------------------------*/
 
+void mdbx_cache_init(MDBX_cache_entry_t *entry) {
+  if (likely(entry))
+    memset(entry, 0, sizeof(*entry));
+}
+
+int mdbx_cache_get(const MDBX_txn *txn, MDBX_dbi dbi, const MDBX_val *key, MDBX_val *data, MDBX_cache_entry_t *entry) {
+  DKBUF_DEBUG;
+  DEBUG("===> cache-get db %u key [%s]", dbi, DKEY_DEBUG(key));
+
+  if (unlikely(!key || !data || !entry))
+    return LOG_IFERR(MDBX_EINVAL);
+
+  int rc = check_txn(txn, MDBX_TXN_BLOCKED);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return LOG_IFERR(rc);
+
+  rc = dbi_check(txn, dbi);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return LOG_IFERR(rc);
+  if (unlikely(txn->dbi_state[dbi] & DBI_STALE)) {
+    rc = tbl_refresh_absent2baddbi((MDBX_txn *)txn, dbi);
+    if (unlikely(rc != MDBX_SUCCESS))
+      return LOG_IFERR(rc);
+  }
+
+  /* Запись кэша применима только пока дерево таблицы совпадает с одним из
+   * зафиксированных, т.е. не изменялось в текущей пишущей транзакции.
+   * Во вложенных транзакциях таблица может быть изменена родительской,
+   * без DBI_DIRTY и без изменения mod_txnid, поэтому кэш не используется. */
+  MDBX_env *const env = txn->env;
+  const tree_t *const tree = &txn->dbs[dbi];
+  const bool applicable = (txn->flags & MDBX_TXN_RDONLY) || (!txn->parent && !(txn->dbi_state[dbi] & DBI_DIRTY));
+  if (likely(applicable && entry->trunk_txnid)) {
+    if (likely(entry->trunk_txnid == tree->mod_txnid && entry->root == tree->root)) {
+#if MDBX_ENABLE_PGOP_STAT
+      env->cache_stat.hits.weak += 1;
+#endif /* MDBX_ENABLE_PGOP_STAT */
+      if (entry->length == UINT32_MAX)
+        return MDBX_NOTFOUND;
+      data->iov_base = ptr_disp(env->dxb_mmap.base, entry->offset);
+      data->iov_len = entry->length;
+      return MDBX_SUCCESS;
+    }
+#if MDBX_ENABLE_PGOP_STAT
+    env->cache_stat.invalidations.weak += 1;
+  } else {
+    env->cache_stat.misses.weak += 1;
+#endif /* MDBX_ENABLE_PGOP_STAT */
+  }
+
+  cursor_couple_t cx;
+  rc = cursor_init(&cx.outer, txn, dbi);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return LOG_IFERR(rc);
+
+  rc = cursor_seek(&cx.outer, (MDBX_val *)key, data, MDBX_SET).err;
+  if (applicable) {
+    entry->trunk_txnid = 0 /* tree->mod_txnid maybe zero in a legacy DB */;
+    if (rc == MDBX_NOTFOUND) {
+      entry->offset = 0;
+      entry->length = UINT32_MAX;
+      entry->trunk_txnid = tree->mod_txnid;
+    } else if (rc == MDBX_SUCCESS && ptr_dist(data->iov_base, env->dxb_mmap.base) >= 0 &&
+               (size_t)ptr_dist(data->iov_base, env->dxb_mmap.base) + data->iov_len <= env->dxb_mmap.current) {
+      entry->offset = (size_t)ptr_dist(data->iov_base, env->dxb_mmap.base);
+      entry->length = (uint32_t)data->iov_len;
+      entry->trunk_txnid = tree->mod_txnid;
+    }
+    entry->root = tree->root;
+  }
+  return LOG_IFERR(rc);
+}
+
+/*----------------------------------------------------------------------------*/
+
 int mdbx_canary_put(MDBX_txn *txn, const MDBX_canary *canary) {
   int rc = check_txn_rw(txn, MDBX_TXN_BLOCKED);
   if (unlikely(rc != MDBX_SUCCESS))
@@ -452,3 +527,61 @@ int mdbx_replace(MDBX_txn *txn, MDBX_dbi dbi, const MDBX_val *key, MDBX_val *new
                  MDBX_put_flags_t flags) {
   return mdbx_replace_ex(txn, dbi, key, new_data, old_data, flags, default_value_preserver, nullptr);
 }
+
+/* Чтение-изменение-запись за один поиск по дереву.
+ *
+ * Для существующей записи сначала выполняется резервирование места того-же
+ * размера посредством cursor_put(MDBX_CURRENT | MDBX_RESERVE), что обеспечивает
+ * изменяемость всех страниц на пути к записи (включая large/overflow-страницу),
+ * но без повторного поиска. Затем callback-функции передается указатель на
+ * значение внутри грязной страницы, в котором она может производить изменения
+ * на месте. Обычный путь обновления/вставки используется только при изменении
+ * размера значения или отсутствии записи. */
+int mdbx_update(MDBX_txn *txn, MDBX_dbi dbi, const MDBX_val *key, MDBX_update_func *updater, void *context) {
+  if (unlikely(!key || !updater))
+    return LOG_IFERR(MDBX_EINVAL);
+
+  if (unlikely(dbi <= FREE_DBI))
+    return LOG_IFERR(MDBX_BAD_DBI);
+
+  int rc = check_txn_rw(txn, MDBX_TXN_BLOCKED);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return LOG_IFERR(rc);
+
+  cursor_couple_t cx;
+  rc = cursor_init(&cx.outer, txn, dbi);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return LOG_IFERR(rc);
+  if (unlikely(cx.outer.tree->flags & MDBX_DUPSORT))
+    return LOG_IFERR(MDBX_INCOMPATIBLE);
+  cx.outer.next = txn->cursors[dbi];
+  txn->cursors[dbi] = &cx.outer;
+
+  MDBX_val present_key = *key, value, inplace = {nullptr, 0};
+  rc = cursor_seek(&cx.outer, &present_key, &value, MDBX_SET_KEY).err;
+  const bool exists = rc == MDBX_SUCCESS;
+  if (exists) {
+    const void *const origin = value.iov_base;
+    rc = cursor_put_checklen(&cx.outer, key, &value, MDBX_CURRENT | MDBX_RESERVE);
+    if (unlikely(rc != MDBX_SUCCESS))
+      goto bailout;
+    /* большое значение могло быть размещено на новой large-странице */
+    if (value.iov_base != origin)
+      memcpy(value.iov_base, origin, value.iov_len);
+    inplace = value;
+  } else if (unlikely(rc != MDBX_NOTFOUND))
+    goto bailout;
+  else
+    value = inplace;
+
+  rc = updater(context, key, &value, exists);
+  if (likely(rc == MDBX_SUCCESS)) {
+    if (!exists || value.iov_base != inplace.iov_base || value.iov_len != inplace.iov_len)
+      rc = cursor_put_checklen(&cx.outer, key, &value, exists ? MDBX_CURRENT : MDBX_NOOVERWRITE);
+  } else if (rc == MDBX_RESULT_TRUE)
+    rc = exists ? cursor_del(&cx.outer, 0) : MDBX_SUCCESS;
+
+bailout:
+  txn->cursors[dbi] = cx.outer.next;
+  return LOG_IFERR(rc);
+}
@@ -88,7 +88,7 @@ int mdbx_txn_break(MDBX_txn *txn) {
     int rc = check_txn(txn, 0);
     if (unlikely(rc != MDBX_SUCCESS))
       return LOG_IFERR(rc);
-    txn->flags |= MDBX_TXN_ERROR;
+    txn_poison(txn, MDBX_BAD_TXN);
     txn = txn->nested;
   } while (txn);
   return MDBX_SUCCESS;
@@ -114,6 +114,35 @@ int mdbx_txn_abort(MDBX_txn *txn) {
   return LOG_IFERR(txn_abort(txn));
 }
 
+int mdbx_txn_savepoint(MDBX_txn *txn, size_t *savepoint) {
+  if (unlikely(!savepoint))
+    return LOG_IFERR(MDBX_EINVAL);
+  *savepoint = 0;
+
+  int rc = check_txn_rw(txn, MDBX_TXN_BLOCKED);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return LOG_IFERR(rc);
+
+  return LOG_IFERR(savepoint_create(txn, savepoint));
+}
+
+int mdbx_txn_rollback_to(MDBX_txn *txn, size_t savepoint) {
+  /* откат допускается в том числе после ошибки внутри транзакции */
+  int rc = check_txn_rw(txn, MDBX_TXN_BLOCKED - MDBX_TXN_ERROR);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return LOG_IFERR(rc);
+
+  return LOG_IFERR(savepoint_rollback(txn, savepoint));
+}
+
+int mdbx_txn_release_savepoint(MDBX_txn *txn, size_t savepoint) {
+  int rc = check_txn_rw(txn, MDBX_TXN_BLOCKED - MDBX_TXN_ERROR);
+  if (unlikely(rc != MDBX_SUCCESS))
+    return LOG_IFERR(rc);
+
+  return LOG_IFERR(savepoint_release(txn, savepoint));
+}
+
 int mdbx_txn_park(MDBX_txn *txn, bool autounpark) {
   STATIC_ASSERT(MDBX_TXN_BLOCKED > MDBX_TXN_ERROR);
   int rc = check_txn(txn, MDBX_TXN_BLOCKED - MDBX_TXN_ERROR);
@@ -230,6 +259,10 @@ int mdbx_txn_begin_ex(MDBX_env *env, MDBX_txn *parent, MDBX_txn_flags_t flags, M
     }
     if (unlikely(parent->env != env))
       return LOG_IFERR(MDBX_BAD_TXN);
+    if (unlikely(parent->wr.undo)) {
+      ERROR("%s are incompatible with nested transactions", "savepoints");
+      return LOG_IFERR(MDBX_BAD_TXN);
+    }
 
     flags |= parent->flags & (txn_rw_begin_flags | MDBX_TXN_SPILLS | MDBX_NOSTICKYTHREADS | MDBX_WRITEMAP);
     rc = txn_nested_create(parent, flags);
@@ -312,6 +345,22 @@ static void latency_gcprof(MDBX_commit_latency *latency, const MDBX_txn *txn) {
   }
 }
 
+static void stat_spill(MDBX_commit_stat *stat, const MDBX_txn *txn) {
+  if (stat && (txn->flags & MDBX_TXN_RDONLY) == 0) {
+    stat->spill.spilled = txn->wr.spill_stat.spilled;
+    stat->spill.unspilled = txn->wr.spill_stat.unspilled;
+    stat->spill.rounds = txn->wr.spill_stat.rounds;
+  }
+}
+
+/* вызывается после фиксации, чтобы учесть увеличение файла при обновлении GC */
+static void stat_resize(MDBX_commit_stat *stat, const MDBX_txn *txn) {
+  if (stat && (txn->flags & MDBX_TXN_RDONLY) == 0) {
+    stat->resize.time = osal_monotime_to_16dot16_noUnderflow(txn->wr.resize_stat.time);
+    stat->resize.count = txn->wr.resize_stat.count;
+  }
+}
+
 static void latency_init(MDBX_commit_latency *latency, struct commit_timestamp *ts) {
   ts->start = 0;
   ts->gc_cpu = 0;
@@ -336,11 +385,13 @@ static void latency_done(MDBX_commit_latency *latency, struct commit_timestamp *
   }
 }
 
-int mdbx_txn_commit_ex(MDBX_txn *txn, MDBX_commit_latency *latency) {
+static int txn_commit(MDBX_txn *txn, MDBX_commit_latency *latency, MDBX_commit_stat *stat) {
   STATIC_ASSERT(MDBX_TXN_FINISHED == MDBX_TXN_BLOCKED - MDBX_TXN_HAS_CHILD - MDBX_TXN_ERROR - MDBX_TXN_PARKED);
 
   struct commit_timestamp ts;
   latency_init(latency, &ts);
+  if (stat)
+    memset(stat, 0, sizeof(*stat));
 
   int rc = check_txn(txn, MDBX_TXN_FINISHED);
   if (unlikely(rc != MDBX_SUCCESS)) {
@@ -371,8 +422,7 @@ int mdbx_txn_commit_ex(MDBX_txn *txn, MDBX_commit_latency *latency) {
 
 #if MDBX_TXN_CHECKOWNER
   if ((txn->flags & MDBX_NOSTICKYTHREADS) && txn == env->basal_txn && unlikely(txn->owner != osal_thread_self())) {
-    txn->flags |= MDBX_TXN_ERROR;
-    rc = MDBX_THREAD_MISMATCH;
+    rc = txn_poison(txn, MDBX_THREAD_MISMATCH);
     return LOG_IFERR(rc);
   }
 #endif /* MDBX_TXN_CHECKOWNER */
@@ -388,7 +438,7 @@ int mdbx_txn_commit_ex(MDBX_txn *txn, MDBX_commit_latency *latency) {
   }
 
   if (txn->nested) {
-    rc = mdbx_txn_commit_ex(txn->nested, nullptr);
+    rc = txn_commit(txn->nested, nullptr, nullptr);
     tASSERT(txn, txn->nested == nullptr);
     if (unlikely(rc != MDBX_SUCCESS))
       goto fail;
@@ -399,6 +449,10 @@ int mdbx_txn_commit_ex(MDBX_txn *txn, MDBX_commit_latency *latency) {
     return MDBX_EINVAL;
   }
 
+  if (txn->wr.undo)
+    /* точки сохранения фиксируются вместе с транзакцией */
+    savepoint_destroy(txn);
+
   if (txn->parent) {
     if (unlikely(txn->parent->nested != txn || txn->parent->env != env)) {
       ERROR("attempt to commit %s txn %p", "strange nested", (void *)txn);
@@ -406,12 +460,16 @@ int mdbx_txn_commit_ex(MDBX_txn *txn, MDBX_commit_latency *latency) {
     }
 
     latency_gcprof(latency, txn);
+    stat_spill(stat, txn);
+    stat_resize(stat, txn);
     rc = txn_nested_join(txn, latency ? &ts : nullptr);
     goto done;
   }
 
+  stat_spill(stat, txn);
   rc = txn_basal_commit(txn, latency ? &ts : nullptr);
   latency_gcprof(latency, txn);
+  stat_resize(stat, txn);
   int end = TXN_END_COMMITTED | TXN_END_UPDATE;
   if (unlikely(rc != MDBX_SUCCESS)) {
     end = TXN_END_ABORT;
@@ -429,6 +487,28 @@ done:
   return LOG_IFERR(rc);
 }
 
+int mdbx_txn_commit_ex(MDBX_txn *txn, MDBX_commit_latency *latency) { return txn_commit(txn, latency, nullptr); }
+
+int mdbx_txn_commit_ex2(MDBX_txn *txn, MDBX_commit_latency *latency, MDBX_commit_stat *stat, size_t bytes) {
+  if (!stat)
+    return txn_commit(txn, latency, nullptr);
+
+  /* the structure is extended by appending fields at the end,
+   * so a shorter size used by previous versions is acceptable */
+  const size_t size_before_resize = offsetof(MDBX_commit_stat, resize);
+  if (unlikely(bytes != sizeof(MDBX_commit_stat) &&
+               (bytes < size_before_resize || bytes > sizeof(MDBX_commit_stat) || bytes % sizeof(uint32_t))))
+    return LOG_IFERR(MDBX_EINVAL);
+
+  if (likely(bytes == sizeof(MDBX_commit_stat)))
+    return txn_commit(txn, latency, stat);
+
+  MDBX_commit_stat snap;
+  const int rc = txn_commit(txn, latency, &snap);
+  memcpy(stat, &snap, bytes);
+  return rc;
+}
+
 int mdbx_txn_info(const MDBX_txn *txn, MDBX_txn_info *info, bool scan_rlt) {
   int rc = check_txn(txn, MDBX_TXN_FINISHED);
   if (unlikely(rc != MDBX_SUCCESS))
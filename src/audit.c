@@ -28,7 +28,7 @@ __cold static int audit_ex_locked(MDBX_txn *txn, const size_t retired_stored, co
   const MDBX_env *const env = txn->env;
   tASSERT(txn, (txn->flags & MDBX_TXN_RDONLY) == 0);
   const size_t pending =
-      txn->wr.loose_count + pnl_size(txn->wr.repnl) + (pnl_size(txn->wr.retired_pages) - retired_stored);
+      txn->wr.loose_count + gc_repnl_npages(txn) + (pnl_size(txn->wr.retired_pages) - retired_stored);
 
   cursor_couple_t cx;
   int rc = cursor_init(&cx.outer, txn, FREE_DBI);
@@ -44,7 +44,7 @@ __cold static int audit_ex_locked(MDBX_txn *txn, const size_t retired_stored, co
       return MDBX_CORRUPTED;
     }
     const txnid_t id = unaligned_peek_u64(4, key.iov_base);
-    const size_t len = *(pgno_t *)data.iov_base;
+    const size_t len = pnl_packed_npages(data.iov_base);
     const bool acc = dont_filter_gc || !gc_is_reclaimed(txn, id);
     TRACE("%s id %" PRIaTXN " len %zu", acc ? "acc" : "skip", id, len);
     if (acc)
@@ -17,7 +17,6 @@ typedef struct MDBX_chk_internal {
   MDBX_chk_table_t table_gc, table_main;
   int16_t *pagemap;
   MDBX_chk_table_t *last_lookup;
-  const void *last_nested;
   MDBX_chk_scope_t scope_stack[12];
   MDBX_chk_table_t *table[MDBX_MAX_DBI + CORE_DBS];
 
@@ -767,15 +766,19 @@ __cold static int chk_pgvisitor(const size_t pgno, const unsigned npages, void *
     height -= usr->txn->dbs[MAIN_DBI].height;
   const tree_t *nested = tbl_info->nested;
   if (nested) {
-    if (tbl->flags & MDBX_DUPSORT)
+    if (tbl->flags & MDBX_DUPSORT) {
       height -= tbl_info->internal->height;
-    else {
+      /* высота вложенного дерева учитывается однократно по его корневой
+       * странице, так как при параллельном обходе страницы разных деревьев
+       * посещаются вперемешку */
+      if (!parent_pgno)
+        histogram_acc(nested->height, &tbl->histogram.nested_height);
+    } else {
       chk_object_issue(scope, "nested tree", pgno, "unexpected", "table %s flags 0x%x, deep %i",
                        chk_v2a(chk, &tbl->name), tbl->flags, deep);
       nested = nullptr;
     }
-  } else
-    chk->last_nested = nullptr;
+  }
 
   const char *pagetype_caption;
   bool branch = false;
@@ -835,10 +838,6 @@ __cold static int chk_pgvisitor(const size_t pgno, const unsigned npages, void *
       pagetype_caption = (pagetype == page_leaf) ? "nested-leaf" : "nested-leaf-dupfix";
       tbl->pages.nested_leaf += 1;
       density = &tbl->histogram.large_or_nested_density;
-      if (chk->last_nested != nested) {
-        histogram_acc(height, &tbl->histogram.nested_height);
-        chk->last_nested = nested;
-      }
       if (height != nested->height)
         chk_object_issue(scope, "page", pgno, "wrong nested-tree height", "actual %i != %i dupsort-node %s, parent %zu",
                          height, nested->height, chk_v2a(chk, &tbl->name), parent_pgno);
@@ -955,7 +954,7 @@ __cold static int chk_tree(MDBX_chk_scope_t *const scope) {
   /* always skip key ordering checking
    * to avoid MDBX_CORRUPTED in case custom comparators were used */
   usr->result.processed_pages = NUM_METAS;
-  int err = walk_pages(txn, chk_pgvisitor, scope, dont_check_keys_ordering);
+  int err = walk_pages(txn, chk_pgvisitor, scope, dont_check_keys_ordering, usr->threads);
   if (MDBX_IS_ERROR(err) && err != MDBX_EINTR)
     chk_error_rc(scope, err, "walk_pages");
 
@@ -1403,7 +1402,9 @@ __cold static int chk_handle_gc(MDBX_chk_scope_t *const scope, MDBX_chk_table_t
     else {
       if (data->iov_len < sizeof(pgno_t) || data->iov_len % sizeof(pgno_t))
         chk_object_issue(scope, "entry", txnid, "wrong idl size", "%" PRIuPTR, data->iov_len);
-      size_t number = (data->iov_len >= sizeof(pgno_t)) ? *iptr++ : 0;
+      const bool packed = data->iov_len >= sizeof(pgno_t) && pnl_is_packed(iptr);
+      size_t number = (data->iov_len >= sizeof(pgno_t)) ? pnl_packed_len(iptr) : 0;
+      iptr += 1;
       if (number > PAGELIST_LIMIT)
         chk_object_issue(scope, "entry", txnid, "wrong idl length", "%" PRIuPTR, number);
       else if ((number + 1) * sizeof(pgno_t) > data->iov_len) {
@@ -1418,6 +1419,21 @@ __cold static int chk_handle_gc(MDBX_chk_scope_t *const scope, MDBX_chk_table_t
                          "%" PRIuSIZE " < %" PRIuSIZE " (minor, not a trouble)", (number + 1) * sizeof(pgno_t),
                          data->iov_len);
 
+      /* упакованная запись (см. MDBX_opt_gc_extents) проверяется постранично после распаковки */
+      pgno_t *unpacked = nullptr;
+      if (packed && number) {
+        if (!pnl_packed_check(data->iov_base, data->iov_len, MAX_PAGENO + 1)) {
+          chk_object_issue(scope, "entry", txnid, "wrong packed idl", "%" PRIuSIZE " items", number);
+          number = 0;
+        } else {
+          unpacked = osal_malloc(pnl_packed_npages(data->iov_base) * sizeof(pgno_t));
+          if (unlikely(!unpacked))
+            return chk_error_rc(scope, MDBX_ENOMEM, "unpacking gc-record");
+          number = pnl_unpack(unpacked, data->iov_base);
+          iptr = unpacked;
+        }
+      }
+
       usr->result.gc_pages += number;
       if (chk->envinfo.mi_latter_reader_txnid > txnid)
         usr->result.reclaimable_pages += number;
@@ -1476,11 +1492,14 @@ __cold static int chk_handle_gc(MDBX_chk_scope_t *const scope, MDBX_chk_table_t
               line = chk_print(line, "%9" PRIuSIZE, pgno);
             chk_line_end(line);
             int err = chk_check_break(scope);
-            if (err)
+            if (err) {
+              osal_free(unpacked);
               return err;
+            }
           }
         }
       }
+      osal_free(unpacked);
     }
   }
   return chk_check_break(scope);
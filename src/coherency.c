@@ -35,7 +35,7 @@ static bool coherency_check(const MDBX_env *env, const txnid_t txnid, const vola
     ok = false;
   }
   if (unlikely(txnid < freedb_mod_txnid ||
-               (!freedb_mod_txnid && freedb_root && likely(magic_and_version == MDBX_DATA_MAGIC)))) {
+               (!freedb_mod_txnid && freedb_root && likely(meta_format_actual(magic_and_version))))) {
     if (report)
       WARNING(
           "catch invalid %s-db.mod_txnid %" PRIaTXN " for meta_txnid %" PRIaTXN " %s", "free", freedb_mod_txnid, txnid,
@@ -43,7 +43,7 @@ static bool coherency_check(const MDBX_env *env, const txnid_t txnid, const vola
     ok = false;
   }
   if (unlikely(txnid < maindb_mod_txnid ||
-               (!maindb_mod_txnid && maindb_root && likely(magic_and_version == MDBX_DATA_MAGIC)))) {
+               (!maindb_mod_txnid && maindb_root && likely(meta_format_actual(magic_and_version))))) {
     if (report)
       WARNING(
           "catch invalid %s-db.mod_txnid %" PRIaTXN " for meta_txnid %" PRIaTXN " %s", "main", maindb_mod_txnid, txnid,
@@ -124,7 +124,7 @@ __hot int coherency_fetch_head(MDBX_txn *txn, const meta_ptr_t head, uint64_t *t
 
   if (unlikely(txn->dbs[FREE_DBI].flags != MDBX_INTEGERKEY)) {
     if ((txn->dbs[FREE_DBI].flags & DB_PERSISTENT_FLAGS) != MDBX_INTEGERKEY ||
-        unaligned_peek_u64(4, &head.ptr_c->magic_and_version) == MDBX_DATA_MAGIC) {
+        meta_format_actual(unaligned_peek_u64(4, &head.ptr_c->magic_and_version))) {
       ERROR("unexpected/invalid db-flags 0x%x for %s", txn->dbs[FREE_DBI].flags, "GC/FreeDB");
       return MDBX_INCOMPATIBLE;
     }
@@ -168,7 +168,8 @@ __hot int cursor_touch(MDBX_cursor *const mc, const MDBX_val *key, const MDBX_va
       return err;
   }
 
-  if (likely(is_pointed(mc)) && ((mc->txn->flags & MDBX_TXN_SPILLS) || !is_modifable(mc->txn, mc->pg[mc->top]))) {
+  if (likely(is_pointed(mc)) &&
+      ((mc->txn->flags & MDBX_TXN_SPILLS) || !is_modifable(mc->txn, mc->pg[mc->top]) || mc->txn->wr.undo)) {
     const int8_t top = mc->top;
     mc->top = 0;
     do {
@@ -272,6 +273,7 @@ static __always_inline int couple_init(cursor_couple_t *couple, const MDBX_txn *
   couple->outer.clc = &kvx->clc;
   couple->outer.dbi_state = dbi_state;
   couple->outer.top_and_flags = z_fresh_mark;
+  couple->outer.scan = 0;
   STATIC_ASSERT((int)z_branch == P_BRANCH && (int)z_leaf == P_LEAF && (int)z_largepage == P_LARGE &&
                 (int)z_dupfix == P_DUPFIX);
   couple->outer.checking = (AUDIT_ENABLED() || (txn->env->flags & MDBX_VALIDATION)) ? z_pagecheck | z_leaf : z_leaf;
@@ -288,6 +290,7 @@ static __always_inline int couple_init(cursor_couple_t *couple, const MDBX_txn *
     tASSERT(txn, &mx->cursor.clc->k == &kvx->clc.v);
     mx->cursor.dbi_state = dbi_state;
     mx->cursor.top_and_flags = z_fresh_mark | z_inner;
+    mx->cursor.scan = 0;
     STATIC_ASSERT(MDBX_DUPFIXED * 2 == P_DUPFIX);
     mx->cursor.checking = couple->outer.checking + ((tree->flags & MDBX_DUPFIXED) << 1);
   }
@@ -313,9 +316,8 @@ int cursor_init(MDBX_cursor *mc, const MDBX_txn *txn, size_t dbi) {
 
 __cold static int unexpected_dupsort(MDBX_cursor *mc) {
   ERROR("unexpected dupsort-page/node for non-dupsort db/cursor (dbi %zu)", cursor_dbi(mc));
-  mc->txn->flags |= MDBX_TXN_ERROR;
   be_poor(mc);
-  return MDBX_CORRUPTED;
+  return txn_poison(mc->txn, MDBX_CORRUPTED);
 }
 
 int cursor_dupsort_setup(MDBX_cursor *mc, const node_t *node, const page_t *mp) {
@@ -446,10 +448,104 @@ static __always_inline int sibling(MDBX_cursor *mc, bool right) {
   return err;
 }
 
+/* Упреждающее чтение при последовательном просмотре.
+ *
+ * После нескольких последовательных переходов курсора на соседние листовые
+ * страницы в одном направлении, номера следующих страниц берутся из
+ * родительской branch-страницы и для них ОС дается подсказка о скорой
+ * потребности (MADV_WILLNEED и т.п.). Аналогично для страниц с большими
+ * значениями на вновь достигнутой листовой странице. Размер окна задается
+ * опцией MDBX_opt_prefetch_window. */
+#define PREFETCH_LEFT 0x80u
+#define PREFETCH_STREAK_MASK 0x7Fu
+
+static __noinline void cursor_prefetch(MDBX_cursor *mc, const bool right) {
+  const page_t *const leaf = mc->pg[mc->top];
+  if (!is_leaf(leaf) || unlikely(mc->top < 1))
+    return;
+
+  const unsigned direction = right ? 0 : PREFETCH_LEFT;
+  const unsigned streak = ((mc->scan & PREFETCH_LEFT) == direction) ? mc->scan & PREFETCH_STREAK_MASK : 0;
+  mc->scan = (uint8_t)(direction | ((streak < PREFETCH_STREAK_MASK) ? streak + 1 : streak));
+  if (streak < 1)
+    /* это первый переход, последовательный просмотр еще не обнаружен */
+    return;
+
+  const page_t *const branch = mc->pg[mc->top - 1];
+  const size_t nkeys = page_numkeys(branch);
+  const size_t ki = mc->ki[mc->top - 1];
+  /* переход на первую страницу под другой родительской страницей,
+   * для которой упреждающее чтение еще не выполнялось */
+  const bool boundary = right ? ki == 0 : ki + 1 == nkeys;
+  MDBX_env *const env = mc->txn->env;
+#if MDBX_ENABLE_PGOP_STAT
+  if (streak > 1 && !boundary)
+    env->prefetch_stat.hits.weak += 1;
+  else
+    env->prefetch_stat.misses.weak += 1;
+#endif /* MDBX_ENABLE_PGOP_STAT */
+
+  /* в начале серии или под новой родительской страницей подсказка дается
+   * для всего окна, а далее только для одной страницы на его краю */
+  const size_t window = env->options.prefetch_window;
+  size_t issued = 0, from = (streak == 1 || boundary) ? 1 : window;
+  pgno_t run_pgno = 0;
+  size_t run_len = 0;
+  for (; from <= window; ++from) {
+    const size_t i = right ? ki + from : ki - from;
+    if (right ? i >= nkeys : from > ki)
+      break;
+    const pgno_t pgno = node_pgno(page_node(branch, i));
+    if (run_len && pgno == (right ? run_pgno + run_len : run_pgno - 1)) {
+      run_pgno = right ? run_pgno : pgno;
+      run_len += 1;
+      continue;
+    }
+    if (run_len)
+      dxb_prefetch(env, run_pgno, run_len);
+    issued += run_len;
+    run_pgno = pgno;
+    run_len = 1;
+  }
+
+  if (!is_dupfix_leaf(leaf)) {
+    /* страницы с большими значениями на достигнутой листовой странице */
+    const size_t n = page_numkeys(leaf);
+    for (size_t i = 0; i < n; ++i) {
+      const node_t *const node = page_node(leaf, i);
+      if (node_flags(node) == N_BIG) {
+        const pgno_t pgno = node_largedata_pgno(node);
+        const size_t npages = largechunk_npages(env, node_ds(node));
+        if (run_len && pgno == run_pgno + run_len) {
+          run_len += npages;
+          continue;
+        }
+        if (run_len)
+          dxb_prefetch(env, run_pgno, run_len);
+        issued += run_len;
+        run_pgno = pgno;
+        run_len = npages;
+      }
+    }
+  }
+
+  if (run_len)
+    dxb_prefetch(env, run_pgno, run_len);
+  issued += run_len;
+#if MDBX_ENABLE_PGOP_STAT
+  env->prefetch_stat.issued.weak += issued;
+#else
+  (void)issued;
+#endif /* MDBX_ENABLE_PGOP_STAT */
+}
+
 __hot int cursor_sibling_left(MDBX_cursor *mc) {
   int err = sibling(mc, false);
-  if (likely(err != MDBX_NOTFOUND))
+  if (likely(err != MDBX_NOTFOUND)) {
+    if (unlikely(mc->txn->env->options.prefetch_window) && likely(err == MDBX_SUCCESS))
+      cursor_prefetch(mc, false);
     return err;
+  }
 
   cASSERT(mc, mc->top >= 0);
   size_t nkeys = page_numkeys(mc->pg[mc->top]);
@@ -460,8 +556,11 @@ __hot int cursor_sibling_left(MDBX_cursor *mc) {
 
 __hot int cursor_sibling_right(MDBX_cursor *mc) {
   int err = sibling(mc, true);
-  if (likely(err != MDBX_NOTFOUND))
+  if (likely(err != MDBX_NOTFOUND)) {
+    if (unlikely(mc->txn->env->options.prefetch_window) && likely(err == MDBX_SUCCESS))
+      cursor_prefetch(mc, true);
     return err;
+  }
 
   cASSERT(mc, mc->top >= 0);
   size_t nkeys = page_numkeys(mc->pg[mc->top]);
@@ -850,7 +949,8 @@ __hot int cursor_put(MDBX_cursor *mc, const MDBX_val *key, MDBX_val *data, unsig
   }
 
   mc->flags &= ~z_after_delete;
-  MDBX_val xdata, *ref_data = data;
+  MDBX_val xdata, *ref_data = data, batch_item;
+  const MDBX_val *batch_items = nullptr;
   size_t *batch_dupfix_done = nullptr, batch_dupfix_given = 0;
   if (unlikely(flags & MDBX_MULTIPLE)) {
     batch_dupfix_given = data[1].iov_len;
@@ -858,6 +958,12 @@ __hot int cursor_put(MDBX_cursor *mc, const MDBX_val *key, MDBX_val *data, unsig
       return /* nothing todo */ MDBX_SUCCESS;
     batch_dupfix_done = &data[1].iov_len;
     *batch_dupfix_done = 0;
+    if (data[0].iov_len == 0) {
+      /* пакет значений произвольного размера, см cursor_check_multiple() */
+      batch_items = data[0].iov_base;
+      batch_item = batch_items[0];
+      data = ref_data = &batch_item;
+    }
   }
 
   /* Cursor is positioned, check for room in the dirty list */
@@ -1001,12 +1107,21 @@ __hot int cursor_put(MDBX_cursor *mc, const MDBX_val *key, MDBX_val *data, unsig
             err = page_dirty(mc->txn, lp.page = np, ovpages);
             if (unlikely(err != MDBX_SUCCESS))
               return err;
+            if (unlikely(mc->txn->wr.undo)) {
+              err = savepoint_cloned(mc->txn, pgno, ovpages);
+              if (unlikely(err != MDBX_SUCCESS))
+                return err;
+            }
 
 #if MDBX_ENABLE_PGOP_STAT
             mc->txn->env->lck->pgops.clone.weak += ovpages;
 #endif /* MDBX_ENABLE_PGOP_STAT */
             cASSERT(mc, dpl_check(mc->txn));
           }
+        } else if (unlikely(mc->txn->wr.undo)) {
+          err = savepoint_touch(mc->txn, lp.page);
+          if (unlikely(err != MDBX_SUCCESS))
+            return err;
         }
         node_set_ds(node, data->iov_len);
         if (flags & MDBX_RESERVE)
@@ -1415,7 +1530,10 @@ insert_node:;
       batch_dupfix_continue:
         /* let caller know how many succeeded, if any */
         if ((*batch_dupfix_done += 1) < batch_dupfix_given) {
-          data[0].iov_base = ptr_disp(data[0].iov_base, data[0].iov_len);
+          if (batch_items)
+            batch_item = batch_items[*batch_dupfix_done];
+          else
+            data[0].iov_base = ptr_disp(data[0].iov_base, data[0].iov_len);
           insert_key = insert_data = false;
           old_singledup.iov_base = nullptr;
           sub_root = nullptr;
@@ -1434,17 +1552,32 @@ insert_node:;
       rc = MDBX_PROBLEM;
     }
   }
-  mc->txn->flags |= MDBX_TXN_ERROR;
-  return rc;
+  return txn_poison(mc->txn, rc);
 }
 
 int cursor_check_multiple(MDBX_cursor *mc, const MDBX_val *key, MDBX_val *data, unsigned flags) {
   (void)key;
   if (unlikely(flags & MDBX_RESERVE))
     return MDBX_EINVAL;
+  const size_t number = data[1].iov_len;
+  if (data->iov_len == 0) {
+    /* Массив MDBX_val со значениями произвольного размера. Размеры
+     * проверяются здесь, так как cursor_put_checklen() видит только data[0]. */
+    if (unlikely((mc->tree->flags & (MDBX_DUPSORT | MDBX_DUPFIXED | MDBX_INTEGERDUP)) != MDBX_DUPSORT))
+      return MDBX_INCOMPATIBLE;
+    const MDBX_val *const items = data->iov_base;
+    if (unlikely(number && !items))
+      return MDBX_EINVAL;
+    for (size_t i = 0; i < number; ++i) {
+      if (unlikely(items[i].iov_len > mc->clc->v.lmax || items[i].iov_len < mc->clc->v.lmin))
+        return MDBX_BAD_VALSIZE;
+      if (unlikely(!items[i].iov_base && items[i].iov_len))
+        return MDBX_EINVAL;
+    }
+    return MDBX_SUCCESS;
+  }
   if (unlikely(!(mc->tree->flags & MDBX_DUPFIXED)))
     return MDBX_INCOMPATIBLE;
-  const size_t number = data[1].iov_len;
   if (unlikely(number > MAX_MAPSIZE / 2 / (BRANCH_NODE_MAX(MDBX_MAX_PAGESIZE) - NODESIZE))) {
     /* checking for multiplication overflow */
     if (unlikely(number > MAX_MAPSIZE / 2 / data->iov_len))
@@ -1714,8 +1847,7 @@ del_key:
   return rc;
 
 fail:
-  mc->txn->flags |= MDBX_TXN_ERROR;
-  return rc;
+  return txn_poison(mc->txn, rc);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -1804,11 +1936,14 @@ __hot csr_t cursor_seek(MDBX_cursor *mc, MDBX_val *key, MDBX_val *data, MDBX_cur
         }
       }
 
-      /* Если в стеке курсора есть страницы справа, то продолжим искать там. */
+      /* Если в стеке курсора есть страницы справа, то продолжим искать там,
+       * поднимаясь по стеку только насколько требуется. */
       cASSERT(mc, mc->tree->height > mc->top);
       for (intptr_t i = 0; i < mc->top; i++)
-        if ((size_t)mc->ki[i] + 1 < page_numkeys(mc->pg[i]))
-          goto continue_other_pages;
+        if ((size_t)mc->ki[i] + 1 < page_numkeys(mc->pg[i])) {
+          ret.err = tree_search_finger(mc, &aligned.key, true);
+          goto continue_found_leaf;
+        }
 
       /* Ключ больше последнего. */
       mc->ki[mc->top] = (indx_t)nkeys;
@@ -1839,11 +1974,17 @@ __hot csr_t cursor_seek(MDBX_cursor *mc, MDBX_val *key, MDBX_val *data, MDBX_cur
       else
         goto target_not_found;
     }
+
+    /* Искомый ключ меньше первого на этой странице,
+     * поднимаемся по стеку курсора только насколько требуется. */
+    cASSERT(mc, !inner_pointed(mc));
+    ret.err = tree_search_finger(mc, &aligned.key, false);
+  } else {
+    cASSERT(mc, !inner_pointed(mc));
+    ret.err = tree_search(mc, &aligned.key, 0);
   }
-  cASSERT(mc, !inner_pointed(mc));
 
-continue_other_pages:
-  ret.err = tree_search(mc, &aligned.key, 0);
+continue_found_leaf:
   if (unlikely(ret.err != MDBX_SUCCESS))
     return ret;
 
@@ -272,8 +272,7 @@ MDBX_MAYBE_UNUSED static inline int __must_check_result cursor_push(MDBX_cursor
   TRACE("pushing page %" PRIaPGNO " on db %d cursor %p", mp->pgno, cursor_dbi_dbg(mc), __Wpedantic_format_voidptr(mc));
   if (unlikely(mc->top >= CURSOR_STACK_SIZE - 1)) {
     be_poor(mc);
-    mc->txn->flags |= MDBX_TXN_ERROR;
-    return MDBX_CURSOR_FULL;
+    return txn_poison(mc->txn, MDBX_CURSOR_FULL);
   }
   mc->top += 1;
   mc->pg[mc->top] = mp;
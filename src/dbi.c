@@ -307,8 +307,7 @@ int dbi_bind(MDBX_txn *txn, const size_t dbi, unsigned user_flags, MDBX_cmp_func
       txn->dbs[dbi].dupfix_size = 0;
       if (unlikely(tbl_setup(env, &env->kvs[dbi], &txn->dbs[dbi]))) {
         txn->dbi_state[dbi] = DBI_LINDO;
-        txn->flags |= MDBX_TXN_ERROR;
-        return MDBX_PROBLEM;
+        return txn_poison(txn, MDBX_PROBLEM);
       }
 
       env->dbs_flags[dbi] = db_flags | DB_VALID;
@@ -373,9 +372,8 @@ static int dbi_open_locked(MDBX_txn *txn, cursor_couple_t *maindb_cx, unsigned u
     rc = tbl_setup(env, &env->kvs[MAIN_DBI], &txn->dbs[MAIN_DBI]);
     if (unlikely(rc != MDBX_SUCCESS)) {
       txn->dbi_state[MAIN_DBI] = DBI_LINDO;
-      txn->flags |= MDBX_TXN_ERROR;
       env->flags |= ENV_FATAL_ERROR;
-      return rc;
+      return txn_poison(txn, rc);
     }
     env->dbs_flags[MAIN_DBI] = main_flags | DB_VALID;
     txn->dbi_seqs[MAIN_DBI] = atomic_store32(&env->dbi_seqs[MAIN_DBI], seq, mo_AcquireRelease);
@@ -698,7 +696,7 @@ __cold struct dbi_rename_result dbi_rename_locked(MDBX_txn *txn, MDBX_dbi dbi, M
       pair.defer = env->kvs[dbi].name.iov_base;
       env->kvs[dbi].name = new_name;
     } else
-      txn->flags |= MDBX_TXN_ERROR;
+      txn_poison(txn, pair.err);
   }
 
   txn->cursors[MAIN_DBI] = cx.outer.next;
@@ -29,6 +29,7 @@ static inline size_t dpl_bytes2size(const ptrdiff_t bytes) {
 
 void dpl_free(MDBX_txn *txn) {
   if (likely(txn->wr.dirtylist)) {
+    osal_free(txn->wr.dirtylist->hash);
     osal_free(txn->wr.dirtylist);
     txn->wr.dirtylist = nullptr;
   }
@@ -46,6 +47,11 @@ dpl_t *dpl_reserve(MDBX_txn *txn, size_t size) {
 #endif /* osal_malloc_usable_size */
     dl->detent = dpl_bytes2size(bytes);
     tASSERT(txn, txn->wr.dirtylist == nullptr || dl->length <= dl->detent);
+    if (!txn->wr.dirtylist) {
+      dl->hash = nullptr;
+      dl->hash_mask = 0;
+      dl->hash_valid = false;
+    }
     txn->wr.dirtylist = dl;
   }
   return dl;
@@ -175,6 +181,107 @@ __hot __noinline size_t dpl_search(const MDBX_txn *txn, pgno_t pgno) {
   return dp_bsearch(dl->items + 1, dl->sorted, pgno) - dl->items;
 }
 
+/*------------------------------------------------------------------------------
+ * Хеш-индекс грязных страниц.
+ *
+ * В транзакциях с огромным количеством грязных страниц (массовая загрузка
+ * данных) поиск страницы по номеру в dpl_search() вынуждает пересортировывать
+ * список при каждом росте не-сортированного хвоста, а бинарный поиск по
+ * многомегабайтному массиву стоит O(log N) промахов кэша на каждое обращение
+ * к странице. Поэтому при длине списка от MDBX_DPL_HASH_THRESHOLD для поиска
+ * используется хеш-таблица с открытой адресацией и линейным пробированием,
+ * а упорядоченность самого списка требуется только для операций слияния,
+ * вытеснения и записи страниц при фиксации транзакции.
+ *
+ * Индекс поддерживается в dpl_append() и dpl_remove_ex(), а при прочих
+ * изменениях списка сбрасывается в dpl_setlen() и лениво перестраивается
+ * при следующем поиске. При нехватке памяти индекс просто не используется. */
+
+#ifndef MDBX_DPL_HASH_THRESHOLD
+#define MDBX_DPL_HASH_THRESHOLD 4096
+#endif /* MDBX_DPL_HASH_THRESHOLD, 0 = disabled */
+
+static inline size_t dpl_hash_slot(const dpl_t *dl, pgno_t pgno) {
+  return (size_t)((pgno * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & dl->hash_mask;
+}
+
+static void dpl_hash_put(dpl_t *dl, const dp_t dp) {
+  size_t i = dpl_hash_slot(dl, dp.pgno);
+  while (dl->hash[i].pgno) {
+    assert(dl->hash[i].pgno != dp.pgno);
+    i = (i + 1) & dl->hash_mask;
+  }
+  dl->hash[i] = dp;
+}
+
+static void dpl_hash_del(dpl_t *dl, pgno_t pgno) {
+  size_t i = dpl_hash_slot(dl, pgno);
+  while (dl->hash[i].pgno != pgno) {
+    assert(dl->hash[i].pgno != 0);
+    i = (i + 1) & dl->hash_mask;
+  }
+  /* сдвигаем назад последующие элементы цепочки, вместо пометки удаления */
+  for (size_t j = i;;) {
+    j = (j + 1) & dl->hash_mask;
+    if (!dl->hash[j].pgno)
+      break;
+    const size_t home = dpl_hash_slot(dl, dl->hash[j].pgno);
+    if (((j - home) & dl->hash_mask) >= ((j - i) & dl->hash_mask)) {
+      dl->hash[i] = dl->hash[j];
+      i = j;
+    }
+  }
+  dl->hash[i].pgno = 0;
+}
+
+static bool dpl_hash_rebuild(dpl_t *dl) {
+  size_t capacity = dl->hash ? (size_t)dl->hash_mask + 1 : 0;
+  /* заполнение не более 1/2, с запасом для последующего роста списка */
+  if (capacity < dl->length * 2 + 2 || capacity > dl->length * 16 + 4096) {
+    osal_free(dl->hash);
+    dl->hash = nullptr;
+    dl->hash_mask = 0;
+    dl->hash_valid = false;
+    if (unlikely(dl->length > UINT32_MAX / 8))
+      return false;
+    for (capacity = 1024; capacity < dl->length * 4; capacity <<= 1)
+      ;
+    dl->hash = osal_malloc(capacity * sizeof(dp_t));
+    if (unlikely(!dl->hash))
+      return false;
+    dl->hash_mask = (uint32_t)capacity - 1;
+  }
+
+  memset(dl->hash, 0, capacity * sizeof(dp_t));
+  for (size_t i = 1; i <= dl->length; ++i)
+    dpl_hash_put(dl, dl->items[i]);
+  dl->hash_valid = true;
+  return true;
+}
+
+__hot __noinline page_t *dpl_find(const MDBX_txn *txn, pgno_t pgno) {
+  tASSERT(txn, (txn->flags & MDBX_TXN_RDONLY) == 0);
+  tASSERT(txn, (txn->flags & MDBX_WRITEMAP) == 0 || MDBX_AVOID_MSYNC);
+
+  dpl_t *const dl = txn->wr.dirtylist;
+  if (MDBX_DPL_HASH_THRESHOLD &&
+      (dl->hash_valid || (dl->length >= MDBX_DPL_HASH_THRESHOLD && dpl_hash_rebuild(dl)))) {
+    page_t *ptr = nullptr;
+    for (size_t i = dpl_hash_slot(dl, pgno); dl->hash[i].pgno; i = (i + 1) & dl->hash_mask)
+      if (dl->hash[i].pgno == pgno) {
+        ptr = dl->hash[i].ptr;
+        tASSERT(txn, ptr->pgno == pgno);
+        break;
+      }
+    tASSERT(txn, !AUDIT_ENABLED() || ptr == debug_dpl_find(txn, pgno));
+    return ptr;
+  }
+
+  const size_t i = dpl_search(txn, pgno);
+  tASSERT(txn, (intptr_t)i > 0);
+  return (dl->items[i].pgno == pgno) ? dl->items[i].ptr : nullptr;
+}
+
 const page_t *debug_dpl_find(const MDBX_txn *txn, const pgno_t pgno) {
   tASSERT(txn, (txn->flags & MDBX_TXN_RDONLY) == 0);
   const dpl_t *dl = txn->wr.dirtylist;
@@ -204,6 +311,8 @@ void dpl_remove_ex(const MDBX_txn *txn, size_t i, size_t npages) {
   assert((intptr_t)i > 0 && i <= dl->length);
   assert(dl->items[0].pgno == 0 && dl->items[dl->length + 1].pgno == P_INVALID);
   dl->pages_including_loose -= npages;
+  if (dl->hash_valid)
+    dpl_hash_del(dl, dl->items[i].pgno);
   dl->sorted -= dl->sorted >= i;
   dl->length -= 1;
   memmove(dl->items + i, dl->items + i + 1, (dl->length - i + 2) * sizeof(dl->items[0]));
@@ -215,8 +324,9 @@ int __must_check_result dpl_append(MDBX_txn *txn, pgno_t pgno, page_t *page, siz
   tASSERT(txn, (txn->flags & MDBX_WRITEMAP) == 0 || MDBX_AVOID_MSYNC);
   const dp_t dp = {page, pgno, (pgno_t)npages};
   if ((txn->flags & MDBX_WRITEMAP) == 0) {
-    size_t *const ptr = ptr_disp(page, -(ptrdiff_t)sizeof(size_t));
-    *ptr = txn->wr.dirtylru;
+    dp_label_t *const label = dpl_label(page);
+    label->lru = txn->wr.dirtylru;
+    label->hits = 0;
   }
 
   dpl_t *dl = txn->wr.dirtylist;
@@ -289,7 +399,7 @@ int __must_check_result dpl_append(MDBX_txn *txn, pgno_t pgno, page_t *page, siz
 #if !defined(__GNUC__) /* пытаемся избежать вызова memmove() */
       i[1] = *i;
 #elif MDBX_WORDBITS == 64 && (defined(__SIZEOF_INT128__) || (defined(_INTEGRAL_MAX_BITS) && _INTEGRAL_MAX_BITS >= 128))
-      STATIC_ASSERT(sizeof(dp) == sizeof(__uint128_t));
+      STATIC_ASSERT(sizeof(dp) == sizeof(__uint128_t) && offsetof(dpl_t, items) % sizeof(__uint128_t) == 0);
       ((__uint128_t *)i)[1] = *(volatile __uint128_t *)i;
 #else
     i[1].ptr = i->ptr;
@@ -310,6 +420,12 @@ int __must_check_result dpl_append(MDBX_txn *txn, pgno_t pgno, page_t *page, siz
   i[1] = dp;
   assert(dl->items[0].pgno == 0 && dl->items[dl->length + 1].pgno == P_INVALID);
   assert(dl->sorted <= dl->length);
+  if (dl->hash_valid) {
+    if (likely(dl->length * 2 <= dl->hash_mask))
+      dpl_hash_put(dl, dp);
+    else
+      dpl_hash_rebuild(dl);
+  }
   return MDBX_SUCCESS;
 }
 
@@ -391,6 +507,14 @@ __cold bool dpl_check(MDBX_txn *txn) {
       return false;
   }
 
+  /* отложенно возвращенные страницы, см. gc_reclaim_deferred() */
+  for (size_t i = 1; txn->wr.repnl_deferred && i <= pnl_size(txn->wr.repnl_deferred); ++i) {
+    const page_t *const dp = debug_dpl_find(txn, txn->wr.repnl_deferred[i]);
+    tASSERT(txn, !dp);
+    if (unlikely(dp))
+      return false;
+  }
+
   return true;
 }
 
@@ -403,8 +527,7 @@ __noinline void dpl_lru_reduce(MDBX_txn *txn) {
     txn->wr.dirtylru >>= 1;
     dpl_t *dl = txn->wr.dirtylist;
     for (size_t i = 1; i <= dl->length; ++i) {
-      size_t *const ptr = ptr_disp(dl->items[i].ptr, -(ptrdiff_t)sizeof(size_t));
-      *ptr >>= 1;
+      dpl_label(dl->items[i].ptr)->lru >>= 1;
     }
     txn = txn->parent;
   } while (txn);
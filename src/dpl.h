@@ -12,6 +12,8 @@ static inline size_t dpl_setlen(dpl_t *dl, size_t len) {
                                         {0},
                                         /* pgno */ ~(pgno_t)0};
   assert(dpl_stub_pageE.flags == P_BAD && dpl_stub_pageE.pgno == P_INVALID);
+  /* список изменяется целиком, хеш-индекс будет перестроен при необходимости */
+  dl->hash_valid = false;
   dl->length = len;
   dl->items[len + 1].ptr = (page_t *)&dpl_stub_pageE;
   dl->items[len + 1].pgno = P_INVALID;
@@ -55,6 +57,8 @@ static inline dpl_t *dpl_sort(const MDBX_txn *txn) {
 
 MDBX_NOTHROW_PURE_FUNCTION MDBX_INTERNAL __noinline size_t dpl_search(const MDBX_txn *txn, pgno_t pgno);
 
+MDBX_INTERNAL __noinline page_t *dpl_find(const MDBX_txn *txn, pgno_t pgno);
+
 MDBX_MAYBE_UNUSED MDBX_INTERNAL const page_t *debug_dpl_find(const MDBX_txn *txn, const pgno_t pgno);
 
 MDBX_NOTHROW_PURE_FUNCTION static inline unsigned dpl_npages(const dpl_t *dl, size_t i) {
@@ -112,12 +116,15 @@ MDBX_INTERNAL int __must_check_result dpl_append(MDBX_txn *txn, pgno_t pgno, pag
 
 MDBX_MAYBE_UNUSED MDBX_INTERNAL bool dpl_check(MDBX_txn *txn);
 
+MDBX_NOTHROW_CONST_FUNCTION static inline dp_label_t *dpl_label(const page_t *dp) {
+  return ptr_disp(dp, -(ptrdiff_t)sizeof(dp_label_t));
+}
+
 MDBX_NOTHROW_PURE_FUNCTION static inline uint32_t dpl_age(const MDBX_txn *txn, size_t i) {
   tASSERT(txn, (txn->flags & (MDBX_TXN_RDONLY | MDBX_WRITEMAP)) == 0);
   const dpl_t *dl = txn->wr.dirtylist;
   assert((intptr_t)i > 0 && i <= dl->length);
-  size_t *const ptr = ptr_disp(dl->items[i].ptr, -(ptrdiff_t)sizeof(size_t));
-  return txn->wr.dirtylru - (uint32_t)*ptr;
+  return txn->wr.dirtylru - dpl_label(dl->items[i].ptr)->lru;
 }
 
 MDBX_INTERNAL void dpl_lru_reduce(MDBX_txn *txn);
@@ -16,6 +16,8 @@ __cold int dxb_read_header(MDBX_env *env, meta_t *dest, const int lck_exclusive,
   unsigned loop_limit = NUM_METAS * 2;
   /* We don't know the page size on first time. So, just guess it. */
   unsigned guess_pagesize = 0;
+  /* Количество обнулённых мета-страниц блочного устройства. */
+  unsigned blank = 0;
   for (unsigned loop_count = 0; loop_count < loop_limit; ++loop_count) {
     const unsigned meta_number = loop_count % NUM_METAS;
     const unsigned offset = (guess_pagesize             ? guess_pagesize
@@ -76,6 +78,9 @@ __cold int dxb_read_header(MDBX_env *env, meta_t *dest, const int lck_exclusive,
       continue;
     }
 
+    if (env->blockdev && buffer[0] == 0 && memcmp(buffer, buffer + 1, MDBX_MIN_PAGESIZE - 1) == 0)
+      blank += 1;
+
     page_t *const page = (page_t *)buffer;
     meta_t *const meta = page_meta(page);
     rc = meta_validate(env, meta, page, meta_number, &guess_pagesize);
@@ -99,6 +104,14 @@ __cold int dxb_read_header(MDBX_env *env, meta_t *dest, const int lck_exclusive,
     }
   }
 
+  if (env->blockdev && blank == loop_limit && mode_bits /* non-zero for DB creation */ != 0) {
+    /* Чистое (обнулённое) блочное устройство аналогично пустому файлу. При этом обнулёнными должны быть все
+     * мета-страницы, включая прочитанные с шагом как системной страницы, так и заданного размера страницы БД,
+     * иначе повреждение одной из них приведёт к потере всех данных вместо восстановления по остальным. */
+    NOTICE("read meta: %s", "blank block device");
+    return MDBX_ENODATA;
+  }
+
   if (dest->pagesize == 0 ||
       (env->stuck_meta < 0 && !(meta_is_steady(dest) || meta_weak_acceptable(env, dest, lck_exclusive)))) {
     ERROR("%s", "no usable meta-pages, database is corrupted");
@@ -269,6 +282,8 @@ __cold int dxb_resize(MDBX_env *const env, const pgno_t used_pgno, const pgno_t
       env->lck->discarded_tail.weak = size_pgno;
   }
 
+  if (size_bytes < env->dxb_mmap.filesize)
+    dxb_preallocate_shrink(env, size_bytes);
   rc = osal_mresize(mresize_flags, &env->dxb_mmap, size_bytes, limit_bytes);
   eASSERT(env, env->dxb_mmap.limit >= env->dxb_mmap.current);
 
@@ -326,9 +341,9 @@ bailout:
     }
     if (!env->dxb_mmap.base) {
       env->flags |= ENV_FATAL_ERROR;
-      if (env->txn)
-        env->txn->flags |= MDBX_TXN_ERROR;
       rc = MDBX_PANIC;
+      if (env->txn)
+        txn_poison(env->txn, rc);
     }
   }
 
@@ -503,6 +518,231 @@ __cold int dxb_set_readahead(const MDBX_env *env, const pgno_t edge, const bool
   return err;
 }
 
+/* Большие страницы используются только когда изменения не записываются через
+ * отображение, иначе изменение одной страницы БД пометит грязной всю большую
+ * страницу и многократно увеличит объем записи на диск. */
+bool dxb_hugepages(const MDBX_env *env) {
+  return env->options.dxb_hugepages && ((env->flags & MDBX_RDONLY) || !(env->flags & MDBX_WRITEMAP));
+}
+
+/* Разбор /proc/self/smaps относительно дорогой, поэтому при частых вызовах
+ * mdbx_env_info_ex() используется полученный ранее результат, если с момента
+ * его получения прошло не более секунды. */
+uint64_t dxb_hugepages_resident(const MDBX_env *env) {
+  const uint64_t now = osal_monotime();
+  const uint64_t stamp = atomic_load64(&env->hugepages_resident.monotime, mo_AcquireRelease);
+  if (stamp && now - stamp < osal_16dot16_to_monotime(65536))
+    return atomic_load64(&env->hugepages_resident.bytes, mo_Relaxed);
+
+  MDBX_env *const mutable_env = (MDBX_env *)env;
+  const uint64_t bytes = osal_mmap_hugepages_resident(&env->dxb_mmap);
+  atomic_store64(&mutable_env->hugepages_resident.bytes, bytes, mo_Relaxed);
+  atomic_store64(&mutable_env->hugepages_resident.monotime, now, mo_AcquireRelease);
+  return bytes;
+}
+
+#if DXB_PREALLOCATE
+/* Фоновое резервирование места в файле БД.
+ *
+ * Вспомогательный поток заранее резервирует место под следующий шаг
+ * приращения посредством fallocate(FALLOC_FL_KEEP_SIZE), т.е. за концом
+ * файла без изменения его размера. Поэтому при последующем увеличении файла
+ * внутри транзакции osal_fsetsize() обнаруживает уже выделенные блоки и
+ * сводится к ftruncate(), а отображение уже покрывает верхний предел.
+ *
+ * Поток создается при первой потребности и работает до закрытия БД,
+ * а при ошибке резервирования прекращает работу до закрытия БД.
+ *
+ * Перед уменьшением файла незавершенное резервирование отменяется с
+ * ожиданием выполняемого fallocate(), иначе блоки могли бы остаться
+ * выделенными за новым концом файла после его усечения. */
+typedef struct dxb_prealloc {
+  osal_condpair_t condpair;
+  osal_thread_t thread;
+  uint64_t filesize /* размер файла на момент последней фиксации */;
+  uint64_t done /* до какого смещения место уже зарезервировано */;
+  uint64_t target /* до какого смещения требуется резервирование */;
+  bool started, stop, failed;
+  bool busy /* выполняется fallocate() без захвата блокировки */;
+  unsigned shrinks /* счетчик отмен резервирования при уменьшении файла */;
+} dxb_prealloc_t;
+
+/* Резервирование порциями, чтобы не задерживать закрытие БД. */
+#define DXB_PREALLOCATE_CHUNK (UINT64_C(64) << 20)
+
+static THREAD_RESULT THREAD_CALL dxb_preallocate_thread(void *arg) {
+  MDBX_env *const env = arg;
+  dxb_prealloc_t *const pa = env->prealloc;
+  osal_condpair_lock(&pa->condpair);
+  while (!pa->stop) {
+    if (pa->done >= pa->target) {
+      osal_condpair_wait(&pa->condpair, false);
+      continue;
+    }
+
+    const uint64_t offset = pa->done;
+    const uint64_t length = (pa->target - offset < DXB_PREALLOCATE_CHUNK) ? pa->target - offset : DXB_PREALLOCATE_CHUNK;
+    const uint64_t filesize = pa->filesize;
+    const unsigned shrinks = pa->shrinks;
+    pa->busy = true;
+    osal_condpair_unlock(&pa->condpair);
+    /* файл может быть уменьшен другим процессом, тогда резервирование
+     * откладывается до следующей фиксации в этом процессе */
+    uint64_t current;
+    int err = osal_filesize(env->lazy_fd, &current);
+    if (likely(err == MDBX_SUCCESS) && current >= filesize)
+      err = fallocate(env->lazy_fd, FALLOC_FL_KEEP_SIZE, offset, length) ? errno : MDBX_SUCCESS;
+    else if (err == MDBX_SUCCESS)
+      err = MDBX_RESULT_TRUE;
+    osal_condpair_lock(&pa->condpair);
+    pa->busy = false;
+    osal_condpair_signal(&pa->condpair, true);
+    if (unlikely(err == MDBX_RESULT_TRUE)) {
+      if (pa->shrinks == shrinks)
+        pa->target = pa->done;
+      continue;
+    }
+    if (unlikely(err != MDBX_SUCCESS)) {
+      NOTICE("preallocation of %" PRIu64 " bytes at %" PRIu64 " failed, err %d, disabled", length, offset, err);
+      pa->failed = true;
+      break;
+    }
+    /* положение могло быть сброшено пока выполнялось резервирование */
+    if (pa->done == offset && pa->shrinks == shrinks)
+      pa->done = offset + length;
+  }
+  osal_condpair_unlock(&pa->condpair);
+  return (THREAD_RESULT)0;
+}
+
+void dxb_preallocate(MDBX_env *env, const geo_t *geo) {
+  const pgno_t watermark = env->options.dxb_preallocate;
+  if (likely(!watermark) || geo->now - geo->first_unallocated >= watermark || geo->now >= geo->upper ||
+      !geo->grow_pv)
+    return;
+
+  dxb_prealloc_t *pa = env->prealloc;
+  if (unlikely(!pa)) {
+    pa = osal_calloc(1, sizeof(dxb_prealloc_t));
+    if (unlikely(!pa))
+      return;
+    env->prealloc = pa;
+    pa->failed = osal_condpair_init(&pa->condpair) != MDBX_SUCCESS;
+    if (likely(!pa->failed)) {
+      pa->started = osal_thread_create(&pa->thread, dxb_preallocate_thread, env) == MDBX_SUCCESS;
+      pa->failed = !pa->started;
+      if (unlikely(pa->failed))
+        osal_condpair_destroy(&pa->condpair);
+    }
+  }
+  if (unlikely(pa->failed))
+    return;
+
+  /* следующий шаг приращения, аналогично gc_alloc_ex() */
+  const size_t next = geo->now + 1;
+  const size_t grow_step = pv2pages(geo->grow_pv);
+  size_t aligned = pgno_ceil2sp_pgno(env, (pgno_t)(next + grow_step - next % grow_step));
+  if (aligned > geo->upper)
+    aligned = geo->upper;
+
+  const uint64_t filesize = pgno2bytes(env, geo->now);
+  osal_condpair_lock(&pa->condpair);
+  /* после уменьшения файла место за его концом освобождено */
+  if (pa->done < filesize || filesize < pa->filesize)
+    pa->done = filesize;
+  pa->filesize = filesize;
+  pa->target = pgno2bytes(env, aligned);
+  if (pa->done < pa->target)
+    osal_condpair_signal(&pa->condpair, false);
+  osal_condpair_unlock(&pa->condpair);
+}
+
+void dxb_preallocate_shrink(MDBX_env *env, uint64_t filesize) {
+  dxb_prealloc_t *const pa = env->prealloc;
+  if (!pa || !pa->started)
+    return;
+  osal_condpair_lock(&pa->condpair);
+  pa->filesize = filesize;
+  pa->done = pa->target = filesize;
+  pa->shrinks += 1;
+  while (pa->busy)
+    osal_condpair_wait(&pa->condpair, true);
+  osal_condpair_unlock(&pa->condpair);
+}
+
+void dxb_preallocate_stop(MDBX_env *env, bool resurrect_after_fork) {
+  dxb_prealloc_t *const pa = env->prealloc;
+  if (!pa)
+    return;
+  env->prealloc = nullptr;
+  /* после fork() поток родительского процесса отсутствует */
+  if (pa->started && !resurrect_after_fork) {
+    osal_condpair_lock(&pa->condpair);
+    pa->stop = true;
+    osal_condpair_signal(&pa->condpair, false);
+    osal_condpair_unlock(&pa->condpair);
+    osal_thread_join(pa->thread);
+    osal_condpair_destroy(&pa->condpair);
+  }
+  osal_free(pa);
+}
+#endif /* DXB_PREALLOCATE */
+
+/* Hint the OS to read-in the given pages in advance. Errors are ignored. */
+void dxb_prefetch(const MDBX_env *env, const pgno_t pgno, const size_t npages) {
+  const size_t current = env->dxb_mmap.current;
+  const size_t offset = floor_powerof2(pgno2bytes(env, pgno), globals.sys_pagesize);
+  size_t length = ceil_powerof2(pgno2bytes(env, pgno + npages), globals.sys_pagesize);
+  length = (length < current) ? length : current;
+  if (unlikely(offset >= length))
+    return;
+  length -= offset;
+
+  void *const ptr = ptr_disp(env->dxb_mmap.base, offset);
+#if defined(F_RDADVISE)
+  /* NOTE: MADV_WILLNEED with offset != 0 may cause SIGBUS on Darwin,
+   * see the note inside dxb_set_readahead(). */
+  (void)ptr;
+  struct radvisory hint;
+  hint.ra_offset = offset;
+  hint.ra_count = unlikely(length > INT_MAX && sizeof(length) > sizeof(hint.ra_count)) ? INT_MAX : (int)length;
+  (void)fcntl(env->lazy_fd, F_RDADVISE, &hint);
+#elif defined(MADV_WILLNEED)
+  (void)madvise(ptr, length, MADV_WILLNEED);
+#elif defined(POSIX_MADV_WILLNEED)
+  (void)posix_madvise(ptr, length, POSIX_MADV_WILLNEED);
+#elif defined(_WIN32) || defined(_WIN64)
+  if (imports.PrefetchVirtualMemory) {
+    WIN32_MEMORY_RANGE_ENTRY hint;
+    hint.VirtualAddress = ptr;
+    hint.NumberOfBytes = length;
+    (void)imports.PrefetchVirtualMemory(GetCurrentProcess(), 1, &hint, 0);
+  }
+#elif defined(POSIX_FADV_WILLNEED)
+  (void)ptr;
+  (void)posix_fadvise(env->lazy_fd, offset, length, POSIX_FADV_WILLNEED);
+#else
+  (void)ptr;
+#endif
+}
+
+/* Размер БД на блочном устройстве определяется его ёмкостью, поэтому геометрия
+ * фиксируется без приращения и уменьшения, а osal_fsetsize() не изменяет размер. */
+__cold static int dxb_blockdev_geometry(MDBX_env *env, const size_t pagesize) {
+  uint64_t capacity;
+  int err = osal_filesize(env->lazy_fd, &capacity);
+  if (unlikely(err != MDBX_SUCCESS))
+    return err;
+
+  uint64_t limit = pagesize * (uint64_t)(MAX_PAGENO + 1);
+  if (limit > MAX_MAPSIZE)
+    limit = MAX_MAPSIZE;
+  const size_t size = floor_powerof2((size_t)((capacity < limit) ? capacity : limit), MDBX_MAX_PAGESIZE);
+  NOTICE("block device capacity %" PRIu64 " bytes, use fixed geometry %" PRIuSIZE " bytes", capacity, size);
+  err = mdbx_env_set_geometry(env, size, size, size, 0, 0, pagesize);
+  return (err == MDBX_EINVAL) ? MDBX_TOO_LARGE : err;
+}
+
 __cold int dxb_setup(MDBX_env *env, const int lck_rc, const mdbx_mode_t mode_bits) {
   meta_t header;
   eASSERT(env, !(env->flags & ENV_ACTIVE));
@@ -516,7 +756,11 @@ __cold int dxb_setup(MDBX_env *env, const int lck_rc, const mdbx_mode_t mode_bit
     DEBUG("%s", "create new database");
     rc = /* new database */ MDBX_RESULT_TRUE;
 
-    if (!env->geo_in_bytes.now) {
+    if (env->blockdev) {
+      err = dxb_blockdev_geometry(env, env->ps);
+      if (unlikely(err != MDBX_SUCCESS))
+        return err;
+    } else if (!env->geo_in_bytes.now) {
       /* set defaults if not configured */
       err = mdbx_env_set_geometry(env, 0, -1, -1, -1, -1, -1);
       if (unlikely(err != MDBX_SUCCESS))
@@ -568,6 +812,14 @@ __cold int dxb_setup(MDBX_env *env, const int lck_rc, const mdbx_mode_t mode_bit
       return err;
   }
 
+  if (env->blockdev && rc != /* new database */ MDBX_RESULT_TRUE && lck_rc == /* lck exclusive */ MDBX_RESULT_TRUE &&
+      (env->flags & MDBX_RDONLY) == 0 && /* not recovery mode */ env->stuck_meta < 0) {
+    /* геометрия следует за ёмкостью устройства, в том числе после её изменения */
+    err = dxb_blockdev_geometry(env, header.pagesize);
+    if (unlikely(err != MDBX_SUCCESS))
+      return err;
+  }
+
   size_t expected_filesize = 0;
   const size_t used_bytes = pgno2bytes(env, header.geometry.first_unallocated);
   const size_t used_aligned2os_bytes = ceil_powerof2(used_bytes, globals.sys_allocation_granularity);
@@ -681,7 +933,9 @@ __cold int dxb_setup(MDBX_env *env, const int lck_rc, const mdbx_mode_t mode_bit
       !(env->flags & MDBX_NORDAHEAD) && mdbx_is_readahead_reasonable(used_bytes, 0) == MDBX_RESULT_TRUE;
 
   err = osal_mmap(env->flags, &env->dxb_mmap, env->geo_in_bytes.now, env->geo_in_bytes.upper,
-                  (lck_rc && env->stuck_meta < 0) ? MMAP_OPTION_SETLENGTH : 0, env->pathname.dxb);
+                  ((lck_rc && env->stuck_meta < 0) ? MMAP_OPTION_SETLENGTH : 0) |
+                      (dxb_hugepages(env) ? MMAP_OPTION_HUGEPAGES : 0),
+                  env->pathname.dxb);
   if (unlikely(err != MDBX_SUCCESS))
     return err;
 
@@ -792,6 +1046,61 @@ __cold int dxb_setup(MDBX_env *env, const int lck_rc, const mdbx_mode_t mode_bit
         goto purge_meta_head;
       }
 
+      /* Последняя фиксация могла выполняться с однократным сбросом на диск,
+       * тогда её мета-страница записана слабой и становится устойчивой только
+       * после проверки всех записанных страниц по описи. */
+      err = prefer_steady.is_steady ? meta_check_manifest(env, recent.ptr_c) : MDBX_NOTFOUND;
+      if (err == MDBX_SUCCESS) {
+        if (env->flags & MDBX_RDONLY) {
+          NOTICE("%s, single-flush commit %" PRIaTXN " is verified by the manifest%s",
+                 "opening after an unclean shutdown", recent.txnid, ", but unable to make it steady in read-only mode");
+          header = clone;
+          break;
+        }
+        NOTICE("%s, single-flush commit %" PRIaTXN " is verified by the manifest: make meta[%u] steady",
+               "opening after an unclean shutdown", recent.txnid, pgno);
+        meta_troika_dump(env, &troika);
+        err = meta_override(env, pgno, recent.txnid, recent.ptr_c);
+        if (err) {
+          ERROR("steady-sync: overwrite meta[%u] with txnid %" PRIaTXN ", error %d", pgno, recent.txnid, err);
+          return err;
+        }
+        troika = meta_tap(env);
+        ENSURE(env, 0 == meta_eq_mask(&troika));
+        header = clone;
+        continue;
+      }
+      if (err == MDBX_RESULT_TRUE) {
+        if (env->flags & MDBX_RDONLY) {
+          ERROR("%s and rollback needed: (torn single-flush commit %" PRIaTXN ")%s",
+                "opening after an unclean shutdown", recent.txnid, ", but unable in read-only mode");
+          meta_troika_dump(env, &troika);
+          return MDBX_WANNA_RECOVERY;
+        }
+        NOTICE("%s and doing automatic rollback: purge meta[%u] of torn single-flush commit %" PRIaTXN,
+               "opening after an unclean shutdown", pgno, recent.txnid);
+        meta_troika_dump(env, &troika);
+        err = meta_override(env, pgno, 0, recent.ptr_c);
+        if (err) {
+          ERROR("rollback: overwrite meta[%u] with txnid %" PRIaTXN ", error %d", pgno, recent.txnid, err);
+          return err;
+        }
+        troika = meta_tap(env);
+        ENSURE(env, 0 == meta_txnid(recent.ptr_v));
+        ENSURE(env, 0 == meta_eq_mask(&troika));
+        /* заголовок мог быть прочитан из отброшенной мета-страницы при совпадении boot-id */
+        err = meta_validate_copy(env, meta_recent(env, &troika).ptr_c, &header);
+        if (unlikely(err != MDBX_SUCCESS)) {
+          ERROR("%s for open or automatic rollback, %s", "there are no suitable meta-pages",
+                "manual recovery is required");
+          meta_troika_dump(env, &troika);
+          return MDBX_CORRUPTED;
+        }
+        continue;
+      }
+      if (unlikely(err != MDBX_NOTFOUND))
+        return err;
+
       if (meta_bootid_match(recent.ptr_c)) {
         if (env->flags & MDBX_RDONLY) {
           ERROR("%s, but boot-id(%016" PRIx64 "-%016" PRIx64 ") is MATCH: "
@@ -903,7 +1212,7 @@ __cold int dxb_setup(MDBX_env *env, const int lck_rc, const mdbx_mode_t mode_bit
         (globals.runtime_flags & MDBX_DBG_DONT_UPGRADE) == 0) {
       for (unsigned n = 0; n < NUM_METAS; ++n) {
         meta_t *const meta = METAPAGE(env, n);
-        if (unlikely(unaligned_peek_u64(4, &meta->magic_and_version) != MDBX_DATA_MAGIC) ||
+        if (unlikely(!meta_format_actual(unaligned_peek_u64(4, &meta->magic_and_version))) ||
             (meta->dxbid.x | meta->dxbid.y) == 0 || (meta->gc_flags & ~DB_PERSISTENT_FLAGS)) {
           const txnid_t txnid = meta_is_used(&troika, n) ? constmeta_txnid(meta) : 0;
           NOTICE("%s %s"
@@ -929,7 +1238,8 @@ __cold int dxb_setup(MDBX_env *env, const int lck_rc, const mdbx_mode_t mode_bit
   if (used_aligned2os_bytes < env->dxb_mmap.current) {
 #if defined(MADV_REMOVE)
     if (lck_rc && (env->flags & MDBX_WRITEMAP) != 0 &&
-        /* not recovery mode */ env->stuck_meta < 0) {
+        /* not recovery mode */ env->stuck_meta < 0 &&
+        /* для блочного устройства это обнуление всего остатка */ !env->blockdev) {
       NOTICE("open-MADV_%s %u..%u", "REMOVE (deallocate file space)", env->lck->discarded_tail.weak,
              bytes2pgno(env, env->dxb_mmap.current));
       err = madvise(ptr_disp(env->dxb_mmap.base, used_aligned2os_bytes), env->dxb_mmap.current - used_aligned2os_bytes,
@@ -1099,6 +1409,16 @@ int dxb_sync_locked(MDBX_env *env, unsigned flags, meta_t *const pending, troika
     }
   }
 
+  /* Фиксация с однократным сбросом на диск, если для этой транзакции
+   * была сформирована опись записанных страниц (см. txn_manifest). */
+  manifest_t *const manifest = (env->manifest && (flags & (MDBX_WRITEMAP | MDBX_SAFE_NOSYNC | MDBX_NOMETASYNC)) == 0)
+                                   ? meta_manifest(env->manifest)
+                                   : nullptr;
+  const bool single_flush = manifest && manifest->magic == MANIFEST_MAGIC &&
+                            unaligned_peek_u64(4, manifest->txnid) == pending->unsafe_txnid &&
+                            head.txnid != pending->unsafe_txnid;
+  enum osal_syncmode_bits single_flush_mode = MDBX_SYNC_DATA | MDBX_SYNC_IODQ;
+
   /* LY: step#1 - sync previously written/updated data-pages */
   rc = MDBX_RESULT_FALSE /* carry steady */;
   if (atomic_load64(&env->lck->unsynced_pages, mo_Relaxed)) {
@@ -1114,7 +1434,11 @@ int dxb_sync_locked(MDBX_env *env, unsigned flags, meta_t *const pending, troika
         mode_bits |= MDBX_SYNC_IODQ;
     } else if (unlikely(env->incore))
       goto skip_incore_sync;
-    if (flags & MDBX_WRITEMAP) {
+    if (single_flush) {
+      /* данные будут сброшены на диск вместе с мета-страницей */
+      single_flush_mode |= mode_bits;
+      rc = MDBX_SUCCESS;
+    } else if (flags & MDBX_WRITEMAP) {
 #if MDBX_ENABLE_PGOP_STAT
       env->lck->pgops.msync.weak += sync_op;
 #else
@@ -1248,6 +1572,7 @@ int dxb_sync_locked(MDBX_env *env, unsigned flags, meta_t *const pending, troika
       } else {
 #if MDBX_ENABLE_PGOP_STAT
         env->lck->pgops.wops.weak += 1;
+        env->dsync_stat.writes.weak += env->fd4meta == env->dsync_fd;
 #endif /* MDBX_ENABLE_PGOP_STAT */
         const page_t *page = payload2page(target);
         rc = osal_pwrite(env->fd4meta, page, env->ps, ptr_dist(page, env->dxb_mmap.base));
@@ -1265,31 +1590,58 @@ int dxb_sync_locked(MDBX_env *env, unsigned flags, meta_t *const pending, troika
         goto fail;
     }
   } else {
-#if MDBX_ENABLE_PGOP_STAT
-    env->lck->pgops.wops.weak += 1;
-#endif /* MDBX_ENABLE_PGOP_STAT */
     const meta_t undo_meta = *target;
     eASSERT(env, pending->trees.gc.flags == MDBX_INTEGERKEY);
     eASSERT(env, check_table_flags(pending->trees.main.flags));
-    rc = osal_pwrite(env->fd4meta, pending, sizeof(meta_t), ptr_dist(target, env->dxb_mmap.base));
+    const mdbx_filehandle_t fd4meta = single_flush ? env->lazy_fd : env->fd4meta;
+#if MDBX_ENABLE_PGOP_STAT
+    env->lck->pgops.wops.weak += 1;
+    env->dsync_stat.writes.weak += fd4meta == env->dsync_fd;
+#endif /* MDBX_ENABLE_PGOP_STAT */
+    if (single_flush) {
+      /* Мета-страница записывается вместе с описью страниц транзакции, но со
+       * слабой сигнатурой, так как данные ещё не сброшены на диск. Поэтому
+       * после сбоя такая фиксация либо проверяется по описи, либо откатывается
+       * как любая слабая, в том числе версиями без поддержки описи. */
+      eASSERT(env, meta_is_steady(pending) && manifest == meta_manifest(env->manifest));
+      *env->manifest = *pending;
+      unaligned_poke_u64(4, env->manifest->sign, DATASIGN_WEAK);
+      rc = osal_pwrite(fd4meta, env->manifest,
+                       ptr_dist(&manifest->extents[manifest->count], env->manifest),
+                       ptr_dist(target, env->dxb_mmap.base));
+      manifest->magic = 0;
+    } else
+      rc = osal_pwrite(fd4meta, pending, sizeof(meta_t), ptr_dist(target, env->dxb_mmap.base));
     if (unlikely(rc != MDBX_SUCCESS)) {
     undo:
       DEBUG("%s", "write failed, disk error?");
       /* On a failure, the pagecache still contains the new data.
        * Try write some old data back, to prevent it from being used. */
-      osal_pwrite(env->fd4meta, &undo_meta, sizeof(meta_t), ptr_dist(target, env->dxb_mmap.base));
+      osal_pwrite(fd4meta, &undo_meta, sizeof(meta_t), ptr_dist(target, env->dxb_mmap.base));
       goto fail;
     }
     osal_flush_incoherent_mmap(target, sizeof(meta_t), globals.sys_pagesize);
     /* sync meta-pages */
-    if ((flags & MDBX_NOMETASYNC) == 0 && env->fd4meta == env->lazy_fd && !env->incore) {
+    if ((flags & MDBX_NOMETASYNC) == 0 && fd4meta == env->lazy_fd && !env->incore) {
 #if MDBX_ENABLE_PGOP_STAT
       env->lck->pgops.fsync.weak += 1;
 #endif /* MDBX_ENABLE_PGOP_STAT */
-      rc = osal_fsync(env->lazy_fd, MDBX_SYNC_DATA | MDBX_SYNC_IODQ);
+      rc = osal_fsync(env->lazy_fd, single_flush ? single_flush_mode : MDBX_SYNC_DATA | MDBX_SYNC_IODQ);
       if (rc != MDBX_SUCCESS)
         goto undo;
     }
+    if (single_flush) {
+      /* Данные и мета-страница уже сброшены на диск, поэтому теперь записывается
+       * устойчивая сигнатура. Её сброс на диск выполнится при следующей фиксации
+       * или при закрытии БД, а до этого после сбоя фиксация проверяется по описи. */
+#if MDBX_ENABLE_PGOP_STAT
+      env->lck->pgops.wops.weak += 1;
+#endif /* MDBX_ENABLE_PGOP_STAT */
+      rc = osal_pwrite(env->lazy_fd, pending->sign, sizeof(pending->sign), ptr_dist(target->sign, env->dxb_mmap.base));
+      if (unlikely(rc != MDBX_SUCCESS))
+        goto undo;
+      osal_flush_incoherent_mmap(target, sizeof(meta_t), globals.sys_pagesize);
+    }
   }
 
   uint64_t timestamp = 0;
@@ -1303,7 +1655,8 @@ int dxb_sync_locked(MDBX_env *env, unsigned flags, meta_t *const pending, troika
       goto fail;
   }
 
-  const uint32_t sync_txnid_dist = ((flags & MDBX_NOMETASYNC) == 0)                     ? 0
+  /* устойчивая сигнатура после однократного сброса записана "лениво", как и при MDBX_NOMETASYNC */
+  const uint32_t sync_txnid_dist = ((flags & MDBX_NOMETASYNC) == 0 && !single_flush)    ? 0
                                    : ((flags & MDBX_WRITEMAP) == 0 || MDBX_AVOID_MSYNC) ? MDBX_NOMETASYNC_LAZY_FD
                                                                                         : MDBX_NOMETASYNC_LAZY_WRITEMAP;
   env->lck->meta_sync_txnid.weak = pending->txnid_a[__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__].weak - sync_txnid_dist;
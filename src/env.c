@@ -75,6 +75,9 @@ retry:;
     rc = (flags & ENV_FATAL_ERROR) ? MDBX_PANIC : MDBX_EPERM;
     goto bailout;
   }
+  if (env->anonymous)
+    /* данные анонимной БД существуют только в памяти */
+    goto bailout;
 
   const troika_t troika = (txn_owned || should_unlock) ? env->basal_txn->wr.troika : meta_tap(env);
   const meta_ptr_t head = meta_recent(env, &troika);
@@ -292,8 +295,15 @@ __cold int env_open(MDBX_env *env, mdbx_mode_t mode) {
   if (unlikely(rc != MDBX_SUCCESS))
     return rc;
 
+  rc = osal_is_blockdev(env->lazy_fd);
+  if (unlikely(MDBX_IS_ERROR(rc)))
+    return rc;
+  env->blockdev = rc == MDBX_RESULT_TRUE;
+  if (env->blockdev)
+    NOTICE("%s", "raw block device");
+
 #if MDBX_LOCKING == MDBX_LOCKING_SYSV
-  env->me_sysv_ipc.key = ftok(env->pathname.dxb, 42);
+  env->me_sysv_ipc.key = env->anonymous ? IPC_PRIVATE : ftok(env->pathname.dxb, 42);
   if (unlikely(env->me_sysv_ipc.key == -1))
     return errno;
 #endif /* MDBX_LOCKING */
@@ -457,7 +467,8 @@ __cold int env_open(MDBX_env *env, mdbx_mode_t mode) {
   if (MDBX_IS_ERROR(dxb_rc))
     return dxb_rc;
 
-  rc = osal_check_fs_incore(env->lazy_fd);
+  /* fstatfs() для узла устройства возвращает сведения о devtmpfs */
+  rc = env->blockdev ? MDBX_RESULT_FALSE : osal_check_fs_incore(env->lazy_fd);
   env->incore = false;
   if (rc == MDBX_RESULT_TRUE) {
     env->incore = true;
@@ -494,11 +505,29 @@ __cold int env_open(MDBX_env *env, mdbx_mode_t mode) {
     }
   }
 
+#if !(defined(_WIN32) || defined(_WIN64))
+  mdbx_filehandle_t direct_fd = INVALID_HANDLE_VALUE;
+#if defined(O_DIRECT)
+  if (env->options.dxb_direct_write && !(env->flags & (MDBX_RDONLY | MDBX_WRITEMAP)) && !env->incore &&
+      !env->anonymous && env->ps >= globals.sys_pagesize) {
+    rc = osal_openfile(MDBX_OPEN_DXB_DIRECT, env, env->pathname.dxb, &direct_fd, 0);
+    if (rc == EINVAL || rc == EAFNOSUPPORT) {
+      NOTICE("O_DIRECT is not supported for the %s, the commit writes will be buffered", "DXB");
+      direct_fd = INVALID_HANDLE_VALUE;
+    } else if (unlikely(rc != MDBX_SUCCESS))
+      return rc;
+  }
+#endif /* O_DIRECT */
+#endif /* !Windows */
+
   rc = (env->flags & MDBX_RDONLY) ? MDBX_SUCCESS
                                   : osal_ioring_create(&env->ioring
 #if defined(_WIN32) || defined(_WIN64)
                                                        ,
                                                        ior_direct, env->ioring.overlapped_fd
+#else
+                                                       ,
+                                                       direct_fd
 #endif /* Windows */
                                     );
   return rc;
@@ -527,6 +556,7 @@ __cold int env_close(MDBX_env *env, bool resurrect_after_fork) {
   env->defer_free = nullptr;
 #endif /* MDBX_ENABLE_DBI_LOCKFREE */
 
+  dxb_preallocate_stop(env, resurrect_after_fork);
   if ((env->flags & MDBX_RDONLY) == 0)
     osal_ioring_destroy(&env->ioring);
 
@@ -587,6 +617,10 @@ __cold int env_close(MDBX_env *env, bool resurrect_after_fork) {
       osal_memalign_free(env->page_auxbuf);
       env->page_auxbuf = nullptr;
     }
+    if (env->manifest) {
+      osal_free(env->manifest);
+      env->manifest = nullptr;
+    }
     if (env->dbi_seqs) {
       osal_free(env->dbi_seqs);
       env->dbi_seqs = nullptr;
@@ -587,11 +587,182 @@ static inline bool is_reclaimable(MDBX_txn *txn, const MDBX_cursor *mc, const ui
   return true;
 }
 
+/*------------------------------------------------------------------------------
+ * Индекс последовательностей страниц в repnl, упорядоченный по длине.
+ *
+ * Для длинных списков линейный поиск последовательности заданной длины
+ * становится доминирующей частью стоимости размещения больших/multi-page
+ * значений, особенно когда подходящей последовательности нет и всё равно
+ * приходится использовать неразмещенное пространство или увеличивать файл БД.
+ * Поэтому при длине repnl от MDBX_GC_EXTENTS_THRESHOLD строится индекс
+ * последовательностей длиной от 2-х страниц, отсортированный по длине
+ * и затем по номеру первой страницы. Это позволяет бинарным поиском находить
+ * наиболее короткую из подходящих последовательностей (best-fit),
+ * а среди равных по длине — с наименьшими номерами страниц.
+ *
+ * Индекс поддерживается при выделении страниц внутри gc_alloc_ex(),
+ * а при прочих изменениях repnl сбрасывается посредством gc_extents_reset()
+ * и лениво перестраивается при следующем поиске. Каждый найденный кандидат
+ * сверяется с repnl, поэтому корректность не зависит от актуальности индекса. */
+
+#ifndef MDBX_GC_EXTENTS_THRESHOLD
+#define MDBX_GC_EXTENTS_THRESHOLD 1024
+#endif /* MDBX_GC_EXTENTS_THRESHOLD, 0 = disabled */
+
+typedef struct gc_extent gc_extent_t;
+
+#define EXTENT_ORDER(a, b) ((a).len < (b).len || ((a).len == (b).len && (a).pgno < (b).pgno))
+SORT_IMPL(extent_sort, false, gc_extent_t, EXTENT_ORDER)
+SEARCH_IMPL(extent_bsearch, gc_extent_t, gc_extent_t, EXTENT_ORDER)
+
+static inline bool repnl_adjacent(const pgno_t prev, const pgno_t next) {
+  return MDBX_PNL_ASCENDING ? next == prev + 1 : prev == next + 1;
+}
+
+static bool gc_extents_build(MDBX_txn *txn) {
+  const pnl_t pnl = txn->wr.repnl;
+  const size_t len = pnl_size(pnl);
+  if (txn->wr.extents.allocated < len / 2) {
+    const size_t wanna = len / 2 + len / 8;
+    void *const ptr = osal_realloc(txn->wr.extents.runs, wanna * sizeof(gc_extent_t));
+    if (unlikely(!ptr))
+      return false;
+    txn->wr.extents.runs = ptr;
+    txn->wr.extents.allocated = wanna;
+  }
+
+  gc_extent_t *const runs = txn->wr.extents.runs;
+  size_t count = 0;
+  for (size_t i = 1; i < len;) {
+    size_t j = i;
+    while (j < len && repnl_adjacent(pnl[j], pnl[j + 1]))
+      ++j;
+    if (j > i) {
+      runs[count].pgno = MDBX_PNL_ASCENDING ? pnl[i] : pnl[j];
+      runs[count].len = (pgno_t)(j - i + 1);
+      ++count;
+    }
+    i = j + 1;
+  }
+  assert(count <= txn->wr.extents.allocated);
+  extent_sort(runs, runs + count);
+  txn->wr.extents.count = count;
+  txn->wr.extents.basis = len;
+#if MDBX_ENABLE_PGOP_STAT
+  txn->env->gc_seq_stat.rebuilds.weak += 1;
+#endif /* MDBX_ENABLE_PGOP_STAT */
+  return true;
+}
+
+/* Обновляет индекс после вырезания из repnl первых num страниц
+ * последовательности, соответствующей элементу индекса в позиции i. */
+static void gc_extents_consume(MDBX_txn *txn, const size_t i, const size_t num) {
+  gc_extent_t *const runs = txn->wr.extents.runs;
+  const gc_extent_t rest = {.pgno = runs[i].pgno + (pgno_t)num, .len = runs[i].len - (pgno_t)num};
+  if (rest.len < 2) {
+    txn->wr.extents.count -= 1;
+    memmove(runs + i, runs + i + 1, (txn->wr.extents.count - i) * sizeof(gc_extent_t));
+  } else {
+    /* остаток короче, поэтому перемещается только в сторону начала индекса */
+    const size_t j = extent_bsearch(runs, i, rest) - runs;
+    memmove(runs + j + 1, runs + j, (i - j) * sizeof(gc_extent_t));
+    runs[j] = rest;
+  }
+  txn->wr.extents.basis -= num;
+}
+
+/* Вырезает из repnl последовательность num страниц начиная с target,
+ * где target указывает на элемент с наименьшим номером страницы. */
+static inline pgno_t repnl_cut_sequence(MDBX_txn *txn, pgno_t *target, const size_t num) {
+  const size_t len = pnl_size(txn->wr.repnl);
+  const pgno_t pgno = *target;
+  pnl_setsize(txn->wr.repnl, len - num);
+#if MDBX_PNL_ASCENDING
+  for (const pgno_t *const end = txn->wr.repnl + len - num; target <= end; ++target)
+    *target = target[num];
+#else
+  for (const pgno_t *const end = txn->wr.repnl + len; ++target <= end;)
+    target[-(ptrdiff_t)num] = *target;
+#endif
+  return pgno;
+}
+
+/* Возвращает указатель на элемент repnl с наименьшим номером страницы
+ * последовательности из num страниц начиная с pgno, либо nullptr если
+ * такой последовательности в repnl нет. */
+static pgno_t *repnl_locate_sequence(MDBX_txn *txn, const pgno_t pgno, const size_t num) {
+  if (unlikely(pgno < NUM_METAS || pgno + num > txn->geo.first_unallocated))
+    return nullptr;
+  const pnl_t pnl = txn->wr.repnl;
+  const size_t len = pnl_size(pnl), seq = num - 1;
+  const size_t i = pnl_search(pnl, pgno, txn->geo.first_unallocated);
+  if (unlikely(i > len || pnl[i] != pgno))
+    return nullptr;
+#if MDBX_PNL_ASCENDING
+  if (unlikely(i + seq > len || pnl[i + seq] != pgno + seq))
+    return nullptr;
+#else
+  if (unlikely(i <= seq || pnl[i - seq] != pgno + seq))
+    return nullptr;
+#endif
+  return pnl + i;
+}
+
+/* Возвращает false если индекс недоступен и следует использовать линейный поиск. */
+static bool repnl_get_sequence_indexed(MDBX_txn *txn, const size_t num, uint8_t flags, pgno_t *pgno) {
+  bool fresh = false;
+  /* совпадение размеров не гарантирует актуальность индекса, поэтому он
+   * считается согласованным только до явного сброса */
+  tASSERT(txn, !txn->wr.extents.basis || txn->wr.extents.basis == pnl_size(txn->wr.repnl));
+  if (!txn->wr.extents.basis) {
+  rebuild:
+    if (unlikely(!gc_extents_build(txn)))
+      return false;
+    fresh = true;
+  }
+
+  gc_extent_t *const runs = txn->wr.extents.runs;
+  const size_t count = txn->wr.extents.count;
+  const gc_extent_t wanna = {.pgno = 0, .len = (pgno_t)num};
+  const size_t i = extent_bsearch(runs, count, wanna) - runs;
+#if MDBX_ENABLE_PGOP_STAT
+  size_t steps = 1;
+  for (size_t n = count; n > 1; n >>= 1)
+    ++steps;
+  txn->env->gc_seq_stat.steps.weak += steps;
+#endif /* MDBX_ENABLE_PGOP_STAT */
+  *pgno = 0;
+  if (i == count)
+    return true;
+
+  pgno_t *const target = repnl_locate_sequence(txn, runs[i].pgno, num);
+  if (unlikely(!target)) {
+    /* индекс рассогласован с repnl, такого быть не должно */
+    WARNING("gc-extents index is incoherent with the reclaimed list (run %" PRIaPGNO "+%" PRIaPGNO "), rebuild",
+            runs[i].pgno, runs[i].len);
+    if (fresh)
+      return false;
+    goto rebuild;
+  }
+
+  if (unlikely(flags & ALLOC_RESERVE))
+    *pgno = P_INVALID;
+  else {
+    gc_extents_consume(txn, i, num);
+    *pgno = repnl_cut_sequence(txn, target, num);
+  }
+  return true;
+}
+
 __hot static pgno_t repnl_get_single(MDBX_txn *txn) {
   const size_t len = pnl_size(txn->wr.repnl);
   assert(len > 0);
   pgno_t *target = MDBX_PNL_EDGE(txn->wr.repnl);
   const ptrdiff_t dir = MDBX_PNL_ASCENDING ? 1 : -1;
+  tASSERT(txn, !txn->wr.extents.basis || txn->wr.extents.basis == len);
+  if (txn->wr.extents.basis)
+    /* индекс остаётся актуальным, если изымается не входящая в последовательность страница */
+    txn->wr.extents.basis = (len > 1 && target[dir] == *target + 1) ? 0 : len - 1;
 
   /* Есть ТРИ потенциально выигрышные, но противо-направленные тактики:
    *
@@ -685,9 +856,21 @@ __hot static pgno_t repnl_get_sequence(MDBX_txn *txn, const size_t num, uint8_t
   const size_t len = pnl_size(txn->wr.repnl);
   pgno_t *edge = MDBX_PNL_EDGE(txn->wr.repnl);
   assert(len >= num && num > 1);
+#if MDBX_ENABLE_PGOP_STAT
+  txn->env->gc_seq_stat.searches.weak += 1;
+#endif /* MDBX_ENABLE_PGOP_STAT */
+  pgno_t pgno;
+  if (MDBX_GC_EXTENTS_THRESHOLD && len >= MDBX_GC_EXTENTS_THRESHOLD &&
+      likely(repnl_get_sequence_indexed(txn, num, flags, &pgno)))
+    return pgno;
+
+  gc_extents_reset(txn);
   const size_t seq = num - 1;
 #if !MDBX_PNL_ASCENDING
   if (edge[-(ptrdiff_t)seq] - *edge == seq) {
+#if MDBX_ENABLE_PGOP_STAT
+    txn->env->gc_seq_stat.steps.weak += 1;
+#endif /* MDBX_ENABLE_PGOP_STAT */
     if (unlikely(flags & ALLOC_RESERVE))
       return P_INVALID;
     assert(edge == scan4range_checker(txn->wr.repnl, seq));
@@ -698,24 +881,65 @@ __hot static pgno_t repnl_get_sequence(MDBX_txn *txn, const size_t num, uint8_t
 #endif
   pgno_t *target = scan4seq_impl(edge, len, seq);
   assert(target == scan4range_checker(txn->wr.repnl, seq));
+#if MDBX_ENABLE_PGOP_STAT
+  txn->env->gc_seq_stat.steps.weak += target ? (size_t)(MDBX_PNL_ASCENDING ? target - edge : edge - target) + 1 : len;
+#endif /* MDBX_ENABLE_PGOP_STAT */
   if (target) {
     if (unlikely(flags & ALLOC_RESERVE))
       return P_INVALID;
-    const pgno_t pgno = *target;
     /* вырезаем найденную последовательность с перемещением хвоста */
-    pnl_setsize(txn->wr.repnl, len - num);
-#if MDBX_PNL_ASCENDING
-    for (const pgno_t *const end = txn->wr.repnl + len - num; target <= end; ++target)
-      *target = target[num];
-#else
-    for (const pgno_t *const end = txn->wr.repnl + len; ++target <= end;)
-      target[-(ptrdiff_t)num] = *target;
-#endif
-    return pgno;
+    return repnl_cut_sequence(txn, target, num);
   }
   return 0;
 }
 
+/*------------------------------------------------------------------------------
+ * Отложенный возврат в repnl освобождаемых грязных страниц.
+ *
+ * Ранее освобождаемые в текущей транзакции грязные страницы сразу вставлялись
+ * в repnl с перемещением части списка, поэтому удаление большого количества
+ * страниц (больших значений, таблиц целиком и т.п.) имело квадратичную
+ * стоимость. Теперь такие страницы накапливаются в несортированном списке
+ * txn->wr.repnl_deferred и затем вливаются в repnl однократной сортировкой
+ * и слиянием перед ближайшим использованием repnl, т.е. при выделении страниц,
+ * обновлении GC, запуске или фиксации вложенной транзакции. */
+
+int gc_reclaim_deferred(MDBX_txn *txn, pgno_t pgno, size_t npages) {
+  if (unlikely(!txn->wr.repnl_deferred)) {
+    txn->wr.repnl_deferred = pnl_alloc(MDBX_PNL_INITIAL);
+    if (unlikely(!txn->wr.repnl_deferred))
+      return MDBX_ENOMEM;
+  }
+  return pnl_append_span(&txn->wr.repnl_deferred, pgno, npages);
+}
+
+int gc_merge_deferred_slowpath(MDBX_txn *txn) {
+  const pnl_t deferred = txn->wr.repnl_deferred;
+  tASSERT(txn, pnl_size(deferred) > 0);
+  int err = pnl_need(&txn->wr.repnl, pnl_size(deferred));
+  if (unlikely(err != MDBX_SUCCESS))
+    return err;
+
+#if MDBX_ENABLE_PROFGC
+  const uint64_t merge_begin = osal_monotime();
+#endif /* MDBX_ENABLE_PROFGC */
+  pnl_sort(deferred, txn->geo.first_unallocated);
+  pnl_merge(txn->wr.repnl, deferred);
+  pnl_setsize(deferred, 0);
+  gc_extents_reset(txn);
+  if (MDBX_ENABLE_REFUND && MDBX_PNL_MOST(txn->wr.repnl) == txn->geo.first_unallocated - 1)
+    /* пока страницы ожидали слияния, могли быть возвращены в нераспределенный "хвост" вышестоящие страницы */
+    txn_refund(txn);
+#if MDBX_ENABLE_PROFGC
+  gc_prof_stat_t *const prof = &txn->env->lck->pgops.gc_prof.work;
+  prof->pnl_merge.calls += 1;
+  prof->pnl_merge.volume += pnl_size(txn->wr.repnl);
+  prof->pnl_merge.time += osal_monotime() - merge_begin;
+#endif /* MDBX_ENABLE_PROFGC */
+  tASSERT(txn, pnl_check_allocated(txn->wr.repnl, txn->geo.first_unallocated - MDBX_ENABLE_REFUND));
+  return MDBX_SUCCESS;
+}
+
 bool gc_repnl_has_span(const MDBX_txn *txn, const size_t num) {
   return (num > 1) ? repnl_get_sequence((MDBX_txn *)txn, num, ALLOC_RESERVE) != 0 : !MDBX_PNL_IS_EMPTY(txn->wr.repnl);
 }
@@ -821,6 +1045,8 @@ static inline pgr_t page_alloc_finalize(MDBX_env *const env, MDBX_txn *const txn
   }
 
   ret.err = page_dirty(txn, ret.page, (pgno_t)num);
+  if (unlikely(txn->wr.undo) && likely(ret.err == MDBX_SUCCESS))
+    ret.err = savepoint_allocated(txn, pgno, num);
 bailout:
   tASSERT(txn, pnl_check_allocated(txn->wr.repnl, txn->geo.first_unallocated - MDBX_ENABLE_REFUND));
 #if MDBX_ENABLE_PROFGC
@@ -849,6 +1075,12 @@ pgr_t gc_alloc_ex(const MDBX_cursor *const mc, const size_t num, uint8_t flags)
    *   3. num > 1 — требуется последовательность страниц для сохранения retired-страниц
    *      при выключенном MDBX_ENABLE_BIGFOOT. */
   eASSERT(env, num > 0 || (flags & ALLOC_RESERVE));
+  ret.err = gc_merge_deferred(txn);
+  if (unlikely(ret.err != MDBX_SUCCESS)) {
+    txn_poison(txn, ret.err);
+    ret.page = nullptr;
+    return ret;
+  }
   eASSERT(env, pnl_check_allocated(txn->wr.repnl, txn->geo.first_unallocated - MDBX_ENABLE_REFUND));
 
   size_t newnext;
@@ -984,23 +1216,23 @@ next_gc:
     goto fail;
 
   pgno_t *gc_pnl = (pgno_t *)data.iov_base;
-  if (unlikely(data.iov_len % sizeof(pgno_t) || data.iov_len < MDBX_PNL_SIZEOF(gc_pnl) ||
-               !pnl_check(gc_pnl, txn->geo.first_unallocated))) {
+  if (unlikely(data.iov_len % sizeof(pgno_t) || !pnl_packed_check(gc_pnl, data.iov_len, txn->geo.first_unallocated))) {
     ERROR("%s/%d: %s", "MDBX_CORRUPTED", MDBX_CORRUPTED, "invalid GC value-length");
     ret.err = MDBX_CORRUPTED;
     goto fail;
   }
 
-  const size_t gc_len = pnl_size(gc_pnl);
+  /* для упакованной записи (см. MDBX_opt_gc_extents) длина в страницах больше количества её элементов */
+  const size_t gc_len = pnl_packed_npages(gc_pnl), gc_words = pnl_packed_len(gc_pnl);
   TRACE("gc-read: id #%" PRIaTXN " len %zu, re-list will %zu ", id, gc_len, gc_len + pnl_size(txn->wr.repnl));
 
   if (unlikely(!num)) {
     /* TODO: Проверка критериев пункта 2 сформулированного в gc_provide_slots().
      * Сейчас тут сильно упрощенная и не совсем верная проверка, так как пока недоступна информация о кол-ве имеющихся
      * слотов и их дефиците для возврата wr.repl. */
-    if (gc_len > env->maxgc_large1page / 4 * 3
+    if (gc_words > env->maxgc_large1page / 4 * 3
         /* если запись достаточно длинная, то переработка слота не особо увеличит место для возврата wr.repl, и т.п. */
-        && pnl_size(txn->wr.repnl) + gc_len > env->maxgc_large1page /* не помещается в хвост */) {
+        && pnl_size(txn->wr.repnl) + gc_words > env->maxgc_large1page /* не помещается в хвост */) {
       DEBUG("avoid reclaiming %" PRIaTXN " slot, since it is too long (%zu)", id, gc_len);
       ret.err = MDBX_NOTFOUND;
       goto reserve_done;
@@ -1045,10 +1277,18 @@ next_gc:
   }
 
   /* Append PNL from GC record to wr.repnl */
-  ret.err = pnl_need(&txn->wr.repnl, gc_len);
+  ret.err = pnl_need(&txn->wr.repnl, pnl_is_packed(gc_pnl) ? 2 * gc_len + 2 : gc_len);
   if (unlikely(ret.err != MDBX_SUCCESS))
     goto fail;
 
+  if (pnl_is_packed(gc_pnl)) {
+    /* Распаковываем запись в конец выделенного для wr.repnl участка, аналогично gc_merge_loose() */
+    pnl_t unpacked = txn->wr.repnl + pnl_alloclen(txn->wr.repnl) - gc_len - 1;
+    pnl_setsize(unpacked, pnl_unpack(MDBX_PNL_BEGIN(unpacked), gc_pnl));
+    eASSERT(env, pnl_size(unpacked) == gc_len && pnl_check(unpacked, txn->geo.first_unallocated));
+    gc_pnl = unpacked;
+  }
+
   if (LOG_ENABLED(MDBX_LOG_EXTRA)) {
     DEBUG_EXTRA("readed GC-pnl txn %" PRIaTXN " root %" PRIaPGNO " len %zu, PNL", id, txn->dbs[FREE_DBI].root, gc_len);
     for (size_t i = gc_len; i; i--)
@@ -1061,6 +1301,7 @@ next_gc:
   const uint64_t merge_begin = osal_monotime();
 #endif /* MDBX_ENABLE_PROFGC */
   pnl_merge(txn->wr.repnl, gc_pnl);
+  gc_extents_reset(txn);
 #if MDBX_ENABLE_PROFGC
   prof->pnl_merge.calls += 1;
   prof->pnl_merge.volume += pnl_size(txn->wr.repnl);
@@ -1270,7 +1511,10 @@ no_gc:
   eASSERT(env, aligned >= newnext);
 
   VERBOSE("try growth datafile to %zu pages (+%zu)", aligned, aligned - txn->geo.end_pgno);
+  const uint64_t resize_started = osal_monotime();
   ret.err = dxb_resize(env, txn->geo.first_unallocated, (pgno_t)aligned, txn->geo.upper, implicit_grow);
+  txn->wr.resize_stat.time += osal_monotime() - resize_started;
+  txn->wr.resize_stat.count += 1;
   if (ret.err != MDBX_SUCCESS) {
     ERROR("unable growth datafile to %zu pages (+%zu), errcode %d", aligned, aligned - txn->geo.end_pgno, ret.err);
     goto fail;
@@ -1287,6 +1531,10 @@ done:
       eASSERT(env, pgno + num <= txn->geo.first_unallocated && pgno >= NUM_METAS);
       eASSERT(env, pnl_check_allocated(txn->wr.repnl, txn->geo.first_unallocated - MDBX_ENABLE_REFUND));
     } else {
+#if MDBX_ENABLE_PGOP_STAT
+      if (num > 1)
+        env->gc_seq_stat.growths.weak += 1;
+#endif /* MDBX_ENABLE_PGOP_STAT */
       pgno = txn->geo.first_unallocated;
       txn->geo.first_unallocated += (pgno_t)num;
       eASSERT(env, txn->geo.first_unallocated <= txn->geo.end_pgno);
@@ -1304,7 +1552,7 @@ done:
       else if (flags & ALLOC_RESERVE)
         level = MDBX_LOG_NOTICE;
       else {
-        txn->flags |= MDBX_TXN_ERROR;
+        txn_poison(txn, ret.err);
         level = MDBX_LOG_ERROR;
       }
       if (LOG_ENABLED(level)) {
@@ -1368,9 +1616,17 @@ __hot pgr_t gc_alloc_single(const MDBX_cursor *const mc) {
     VALGRIND_MAKE_MEM_UNDEFINED(page2payload(lp), page_space(txn->env));
     lp->txnid = txn->front_txnid;
     pgr_t ret = {lp, MDBX_SUCCESS};
+    if (unlikely(txn->wr.undo))
+      ret.err = savepoint_allocated(txn, lp->pgno, 1);
     return ret;
   }
 
+  int err = gc_merge_deferred(txn);
+  if (unlikely(err != MDBX_SUCCESS)) {
+    txn_poison(txn, err);
+    pgr_t ret = {nullptr, err};
+    return ret;
+  }
   if (likely(pnl_size(txn->wr.repnl) > 0))
     return page_alloc_finalize(txn->env, txn, mc, repnl_get_single(txn), 1);
 
@@ -41,6 +41,31 @@ MDBX_NOTHROW_PURE_FUNCTION static bool is_lifo(const MDBX_txn *txn) {
   return (txn->env->flags & MDBX_LIFORECLAIM) != 0;
 }
 
+/* упакованные записи помещаются в GC только после пометки всех мета-страниц соответствующим форматом */
+MDBX_NOTHROW_PURE_FUNCTION static bool gc_packed(const MDBX_txn *txn) {
+  return txn->env->options.gc_extents && meta_gc_extents_marked(txn->env);
+}
+
+/* Объём возвращаемых в GC страниц в элементах записей. При упаковке последовательностей смежных страниц учитывается
+ * по одному элементу запаса на каждый зарезервированный слот, так как последовательности не разрезаются между
+ * записями. Вычисляется за O(кол-во последовательностей), а не O(кол-во страниц). */
+static size_t gc_return_amount(const MDBX_txn *txn) {
+  const size_t pages = pnl_size(txn->wr.repnl);
+  if (!gc_packed(txn) || !pages)
+    return pages;
+  return pnl_packed_size(MDBX_PNL_BEGIN(txn->wr.repnl), MDBX_PNL_END(txn->wr.repnl)) + rkl_len(&txn->wr.gc.comeback);
+}
+
+/* Объём ещё не сохранённой в GC части retired-списка в элементах записей. */
+static size_t gc_retired_left(const MDBX_txn *txn, const gcu_t *ctx) {
+  const size_t left = pnl_size(txn->wr.retired_pages) - ctx->retired_stored;
+  if (!gc_packed(txn) || !left)
+    return left;
+  const pgno_t *const begin =
+      MDBX_PNL_BEGIN(txn->wr.retired_pages) + ((is_lifo(txn) == MDBX_PNL_ASCENDING) ? 0 : ctx->retired_stored);
+  return pnl_packed_size(begin, begin + left);
+}
+
 MDBX_NOTHROW_PURE_FUNCTION MDBX_MAYBE_UNUSED static inline const char *dbg_prefix(const gcu_t *ctx) {
   return is_lifo(ctx->cursor.txn) ? "    lifo" : "    fifo";
 }
@@ -276,11 +301,13 @@ static int gc_prepare_stockpile4retired(MDBX_txn *txn, gcu_t *ctx) {
     }
     if (MDBX_ENABLE_BIGFOOT) {
       const size_t per_branch_page = txn->env->maxgc_per_branch;
-      for_retired += (retired_left + ctx->goodchunk - 1) / ctx->goodchunk;
+      for_retired += (gc_retired_left(txn, ctx) + ctx->goodchunk - 1) / ctx->goodchunk;
       for (size_t entries = for_retired; entries > 1; for_retired += entries)
         entries = (entries + per_branch_page - 1) / per_branch_page;
     } else
-      for_retired += largechunk_npages(txn->env, retired_whole);
+      for_retired += largechunk_npages(txn->env, gc_packed(txn) ? pnl_packed_size(MDBX_PNL_BEGIN(txn->wr.retired_pages),
+                                                                                  MDBX_PNL_END(txn->wr.retired_pages))
+                                                                : retired_whole);
   }
 
   return gc_prepare_stockpile(txn, ctx, for_retired);
@@ -319,6 +346,7 @@ static int gc_merge_loose(MDBX_txn *txn, gcu_t *ctx) {
     pnl_setsize(loose, count);
     pnl_sort(loose, txn->geo.first_unallocated);
     pnl_merge(txn->wr.repnl, loose);
+    gc_extents_reset(txn);
   }
 
   /* filter-out list of dirty-pages from loose-pages */
@@ -361,6 +389,16 @@ static int gc_merge_loose(MDBX_txn *txn, gcu_t *ctx) {
   return MDBX_SUCCESS;
 }
 
+#if !MDBX_ENABLE_BIGFOOT
+/* Размер записи для всего retired-списка в элементах, при упаковке список предварительно сортируется. */
+static size_t gc_retired_words(MDBX_txn *txn) {
+  if (!gc_packed(txn))
+    return pnl_size(txn->wr.retired_pages);
+  pnl_sort(txn->wr.retired_pages, txn->geo.first_unallocated);
+  return pnl_packed_size(MDBX_PNL_BEGIN(txn->wr.retired_pages), MDBX_PNL_END(txn->wr.retired_pages));
+}
+#endif /* !MDBX_ENABLE_BIGFOOT */
+
 static int gc_store_retired(MDBX_txn *txn, gcu_t *ctx) {
   int err;
   MDBX_val key, data;
@@ -394,9 +432,11 @@ static int gc_store_retired(MDBX_txn *txn, gcu_t *ctx) {
       key.iov_len = sizeof(txnid_t);
       key.iov_base = &ctx->bigfoot;
       const size_t left_before = retired_before - ctx->retired_stored;
-      const size_t chunk_hi = ((left_before | 3) > ctx->goodchunk && ctx->bigfoot < (MAX_TXNID - UINT32_MAX))
+      /* при упаковке размер куска считается в элементах записи, а не в страницах */
+      const size_t left_words = gc_packed(txn) ? gc_retired_left(txn, ctx) : left_before;
+      const size_t chunk_hi = ((left_words | 3) > ctx->goodchunk && ctx->bigfoot < (MAX_TXNID - UINT32_MAX))
                                   ? ctx->goodchunk
-                                  : (left_before | 3);
+                                  : (left_words | 3);
       data.iov_len = gc_chunk_bytes(chunk_hi);
       err = cursor_put(&ctx->cursor, &key, &data, MDBX_RESERVE);
       if (unlikely(err != MDBX_SUCCESS))
@@ -411,23 +451,44 @@ static int gc_store_retired(MDBX_txn *txn, gcu_t *ctx) {
 
       const size_t retired_after = pnl_size(txn->wr.retired_pages);
       const size_t left_after = retired_after - ctx->retired_stored;
-      const size_t chunk = (left_after < chunk_hi) ? left_after : chunk_hi;
-      should_retry = retired_before != retired_after && chunk < retired_after;
-      if (likely(!should_retry)) {
-        const size_t at = (is_lifo(txn) == MDBX_PNL_ASCENDING) ? left_before - chunk : ctx->retired_stored;
-        pgno_t *const begin = txn->wr.retired_pages + at;
-        /* MDBX_PNL_ASCENDING == false && LIFO == false:
-         *  - the larger pgno is at the beginning of retired list
-         *    and should be placed with the larger txnid.
-         * MDBX_PNL_ASCENDING == true && LIFO == true:
-         *  - the larger pgno is at the ending of retired list
-         *    and should be placed with the smaller txnid. */
-        const pgno_t save = *begin;
-        *begin = (pgno_t)chunk;
-        memcpy(data.iov_base, begin, data.iov_len);
-        *begin = save;
-        TRACE("%s: put-retired/bigfoot @ %" PRIaTXN " (slice #%u) #%zu [%zu..%zu] of %zu", dbg_prefix(ctx),
-              ctx->bigfoot, (unsigned)(ctx->bigfoot - txn->txnid), chunk, at, at + chunk, retired_before);
+      size_t chunk = (left_after < chunk_hi) ? left_after : chunk_hi;
+      if (gc_packed(txn)) {
+        /* добавленные в retired-список страницы нарушают порядок, а упаковка требует упорядоченного списка */
+        should_retry = retired_before != retired_after;
+        if (unlikely(should_retry)) {
+          ctx->retired_stored += chunk;
+          break;
+        }
+        const bool backward = is_lifo(txn) == MDBX_PNL_ASCENDING;
+        const pgno_t *const begin = MDBX_PNL_BEGIN(txn->wr.retired_pages) + (backward ? 0 : ctx->retired_stored);
+        size_t words;
+        chunk = pnl_pack_fit(begin, begin + left_before, chunk_hi, backward, &words);
+        const pgno_t *const from = backward ? begin + left_before - chunk : begin;
+        const size_t packed = pnl_pack(data.iov_base, from, from + chunk);
+        tASSERT(txn, chunk > 0 && packed == words && words <= chunk_hi);
+        memset(ptr_disp(data.iov_base, gc_chunk_bytes(packed)), 0, data.iov_len - gc_chunk_bytes(packed));
+        TRACE("%s: put-retired/bigfoot @ %" PRIaTXN " (slice #%u) #%zu in %zu words [%zu..%zu] of %zu", dbg_prefix(ctx),
+              ctx->bigfoot, (unsigned)(ctx->bigfoot - txn->txnid), chunk, words,
+              from - MDBX_PNL_BEGIN(txn->wr.retired_pages), from - MDBX_PNL_BEGIN(txn->wr.retired_pages) + chunk,
+              retired_before);
+      } else {
+        should_retry = retired_before != retired_after && chunk < retired_after;
+        if (likely(!should_retry)) {
+          const size_t at = (is_lifo(txn) == MDBX_PNL_ASCENDING) ? left_before - chunk : ctx->retired_stored;
+          pgno_t *const begin = txn->wr.retired_pages + at;
+          /* MDBX_PNL_ASCENDING == false && LIFO == false:
+           *  - the larger pgno is at the beginning of retired list
+           *    and should be placed with the larger txnid.
+           * MDBX_PNL_ASCENDING == true && LIFO == true:
+           *  - the larger pgno is at the ending of retired list
+           *    and should be placed with the smaller txnid. */
+          const pgno_t save = *begin;
+          *begin = (pgno_t)chunk;
+          memcpy(data.iov_base, begin, data.iov_len);
+          *begin = save;
+          TRACE("%s: put-retired/bigfoot @ %" PRIaTXN " (slice #%u) #%zu [%zu..%zu] of %zu", dbg_prefix(ctx),
+                ctx->bigfoot, (unsigned)(ctx->bigfoot - txn->txnid), chunk, at, at + chunk, retired_before);
+        }
       }
       ctx->retired_stored += chunk;
     } while (ctx->retired_stored < pnl_size(txn->wr.retired_pages) && (++ctx->bigfoot, true));
@@ -438,7 +499,7 @@ static int gc_store_retired(MDBX_txn *txn, gcu_t *ctx) {
   key.iov_base = &txn->txnid;
   do {
     gc_prepare_stockpile4retired(txn, ctx);
-    data.iov_len = MDBX_PNL_SIZEOF(txn->wr.retired_pages);
+    data.iov_len = gc_chunk_bytes(gc_retired_words(txn));
     err = cursor_put(&ctx->cursor, &key, &data, MDBX_RESERVE);
     if (unlikely(err != MDBX_SUCCESS))
       return err;
@@ -452,12 +513,18 @@ static int gc_store_retired(MDBX_txn *txn, gcu_t *ctx) {
 #endif /* MDBX_DEBUG && (ENABLE_MEMCHECK || __SANITIZE_ADDRESS__) */
 
     /* Retry if wr.retired_pages[] grew during the Put() */
-  } while (data.iov_len < MDBX_PNL_SIZEOF(txn->wr.retired_pages));
+  } while (data.iov_len < gc_chunk_bytes(gc_retired_words(txn)));
 
   ctx->retired_stored = pnl_size(txn->wr.retired_pages);
   pnl_sort(txn->wr.retired_pages, txn->geo.first_unallocated);
-  tASSERT(txn, data.iov_len == MDBX_PNL_SIZEOF(txn->wr.retired_pages));
-  memcpy(data.iov_base, txn->wr.retired_pages, data.iov_len);
+  if (gc_packed(txn)) {
+    const size_t packed =
+        pnl_pack(data.iov_base, MDBX_PNL_BEGIN(txn->wr.retired_pages), MDBX_PNL_END(txn->wr.retired_pages));
+    memset(ptr_disp(data.iov_base, gc_chunk_bytes(packed)), 0, data.iov_len - gc_chunk_bytes(packed));
+  } else {
+    tASSERT(txn, data.iov_len == MDBX_PNL_SIZEOF(txn->wr.retired_pages));
+    memcpy(data.iov_base, txn->wr.retired_pages, data.iov_len);
+  }
 
   TRACE("%s: put-retired #%zu @ %" PRIaTXN, dbg_prefix(ctx), ctx->retired_stored, txn->txnid);
 #endif /* MDBX_ENABLE_BIGFOOT */
@@ -1068,12 +1135,12 @@ static int gc_handle_dense(MDBX_txn *txn, gcu_t *ctx, size_t left_min, size_t le
           size_t chunk_lo = chunk_hi - txn->env->maxgc_large1page + ctx->goodchunk;
           TRACE("%s: dense-chunk (seq-len %zu, %d of %d) %zu...%zu, gc-per-ovpage %u", dbg_prefix(ctx), i, n + 1,
                 solution.array[i - 1], chunk_lo, chunk_hi, txn->env->maxgc_large1page);
-          size_t amount = pnl_size(txn->wr.repnl);
+          size_t amount = gc_return_amount(txn);
           err = gc_reserve4return(txn, ctx, chunk_lo, chunk_hi);
           if (unlikely(err != MDBX_SUCCESS))
             return err;
 
-          const size_t now = pnl_size(txn->wr.repnl);
+          const size_t now = gc_return_amount(txn);
           if (span < amount - now - txn->dbs[FREE_DBI].height || span > amount - now + txn->dbs[FREE_DBI].height)
             TRACE("dense-%s-reservation: miss %zu (expected) != %zi (got)", "solve", span, amount - now);
           amount = now;
@@ -1098,7 +1165,7 @@ static int gc_handle_dense(MDBX_txn *txn, gcu_t *ctx, size_t left_min, size_t le
     }
 
     const size_t per_page = txn->env->ps / sizeof(pgno_t);
-    size_t amount = pnl_size(txn->wr.repnl);
+    size_t amount = gc_return_amount(txn);
     do {
       if (rkl_empty(&txn->wr.gc.ready4reuse)) {
         NOTICE("%s: restart since no slot(s) available (reserved %zu...%zu of %zu)", dbg_prefix(ctx),
@@ -1123,7 +1190,7 @@ static int gc_handle_dense(MDBX_txn *txn, gcu_t *ctx, size_t left_min, size_t le
       err = gc_reserve4return(txn, ctx, chunk_lo, chunk_hi);
       if (unlikely(err != MDBX_SUCCESS))
         return err;
-      const size_t now = pnl_size(txn->wr.repnl);
+      const size_t now = gc_return_amount(txn);
       if (base - adjusted + txn->dbs[FREE_DBI].height < amount - now ||
           base - adjusted > amount - now + txn->dbs[FREE_DBI].height)
         TRACE("dense-%s-reservation: miss %zu (expected) != %zi (got)", "unsolve", base - adjusted, amount - now);
@@ -1152,7 +1219,7 @@ static int gc_rerere(MDBX_txn *txn, gcu_t *ctx) {
   // gc_solve_test(txn, ctx);
 
   tASSERT(txn, rkl_empty(&txn->wr.gc.reclaimed));
-  const size_t amount = pnl_size(txn->wr.repnl);
+  const size_t amount = gc_return_amount(txn);
   if (ctx->return_reserved_hi >= amount) {
     if (unlikely(ctx->dense)) {
       ctx->dense = false;
@@ -1243,6 +1310,47 @@ static int gc_rerere(MDBX_txn *txn, gcu_t *ctx) {
   return gc_reserve4return(txn, ctx, chunk_lo, chunk_hi);
 }
 
+/* Заполняет зарезервированные записи упакованными номерами возвращаемых в GC страниц. Последовательности смежных
+ * страниц не разрезаются между записями, поэтому записи заполняются целыми последовательностями насколько позволяет
+ * их размер, а недобор (не более элемента на запись) покрывается запасом, учтённым в gc_return_amount(). */
+static int gc_fill_returned_packed(MDBX_txn *txn, gcu_t *ctx) {
+  tASSERT(txn, gc_return_amount(txn) <= ctx->return_reserved_hi && !rkl_empty(&txn->wr.gc.comeback));
+  const size_t slots = rkl_len(&txn->wr.gc.comeback);
+  rkl_iter_t iter = rkl_iterator(&txn->wr.gc.comeback, is_lifo(txn));
+  size_t left = pnl_size(txn->wr.repnl);
+  do {
+    txnid_t id = rkl_turn(&iter, is_lifo(txn));
+    if (unlikely(!id)) {
+      ERROR("reserve depleted (used %zu slots, left %zu pages, loop %u)", slots, left, ctx->loop);
+      return MDBX_PROBLEM;
+    }
+    MDBX_val key = {.iov_base = &id, .iov_len = sizeof(id)};
+    MDBX_val data = {.iov_base = nullptr, .iov_len = 0};
+    const int err = cursor_seek(&ctx->cursor, &key, &data, MDBX_SET_KEY).err;
+    if (unlikely(err != MDBX_SUCCESS))
+      return err;
+
+    tASSERT(txn, data.iov_len >= sizeof(pgno_t) * 2);
+    const size_t chunk_hi = data.iov_len / sizeof(pgno_t) - 1;
+    const pgno_t *const begin = MDBX_PNL_BEGIN(txn->wr.repnl);
+    size_t words;
+    const size_t chunk = pnl_pack_fit(begin, begin + left, chunk_hi, true, &words);
+    const pgno_t *const from = begin + left - chunk;
+    if (unlikely(slots == 1 && data.iov_len - gc_chunk_bytes(words) >= txn->env->ps * 2)) {
+      NOTICE("too long %s-comeback-reserve @%" PRIaTXN ", have %zu bytes, need %zu bytes", "packed", id, data.iov_len,
+             gc_chunk_bytes(words));
+      return MDBX_RESULT_TRUE;
+    }
+    TRACE("%s: fill +%zu in %zu words [ %zu:%" PRIaPGNO "...%zu:%" PRIaPGNO "] @%" PRIaTXN " (%s)", dbg_prefix(ctx),
+          chunk, words, from - txn->wr.repnl, chunk ? from[0] : 0, from + chunk - txn->wr.repnl,
+          chunk ? from[chunk - 1] : 0, id, "packed");
+    /* резерв заполнен нулями, поэтому остаток записи после упакованных элементов не требует очистки */
+    pnl_pack(data.iov_base, from, from + chunk);
+    left -= chunk;
+  } while (left);
+  return MDBX_SUCCESS;
+}
+
 /* Заполняет зарезервированные записи номерами возвращаемых в GC страниц. */
 static int gc_fill_returned(MDBX_txn *txn, gcu_t *ctx) {
   tASSERT(txn, pnl_check_allocated(txn->wr.repnl, txn->geo.first_unallocated - MDBX_ENABLE_REFUND));
@@ -1262,6 +1370,9 @@ static int gc_fill_returned(MDBX_txn *txn, gcu_t *ctx) {
    * Если считать что резерва достаточно и имеющийся избыток допустим, то задача заполнения сводится
    * к распределению излишков резерва по записям с учётом их размера, а далее просто к записи данных.
    * При этом желательно обойтись без каких-то сложных операций типа деления и т.п. */
+  if (gc_packed(txn))
+    return gc_fill_returned_packed(txn, ctx);
+
   const size_t amount = pnl_size(txn->wr.repnl);
   tASSERT(txn, amount > 0 && amount <= ctx->return_reserved_hi && !rkl_empty(&txn->wr.gc.comeback));
   const size_t slots = rkl_len(&txn->wr.gc.comeback);
@@ -1363,6 +1474,10 @@ int gc_update(MDBX_txn *txn, gcu_t *ctx) {
   if (unlikely(!txn->env->gc.detent))
     txn_gc_detent(txn);
 
+  err = gc_merge_deferred(txn);
+  if (unlikely(err != MDBX_SUCCESS))
+    goto bailout;
+
   if (AUDIT_ENABLED()) {
     err = audit_ex(txn, 0, false);
     if (unlikely(err != MDBX_SUCCESS))
@@ -1450,17 +1565,17 @@ retry:
         goto bailout;
     }
 
-    if (unlikely(pnl_size(txn->wr.repnl) + env->maxgc_large1page <= ctx->return_reserved_lo) && !ctx->dense) {
+    const size_t amount = gc_return_amount(txn);
+    if (unlikely(amount + env->maxgc_large1page <= ctx->return_reserved_lo) && !ctx->dense) {
       /* после резервирования было израсходованно слишком много страниц и получилось слишком много резерва */
-      TRACE("%s: reclaimed-list %zu < reversed %zu, retry", dbg_prefix(ctx), pnl_size(txn->wr.repnl),
-            ctx->return_reserved_lo);
+      TRACE("%s: reclaimed-list %zu < reversed %zu, retry", dbg_prefix(ctx), amount, ctx->return_reserved_lo);
       goto retry;
     }
 
-    if (ctx->return_reserved_hi < pnl_size(txn->wr.repnl)) {
+    if (ctx->return_reserved_hi < amount) {
       /* верхней границы резерва НЕ хватает, продолжаем резервирование */
       TRACE(">> %s, %zu...%zu, %s %zu", "reserving", ctx->return_reserved_lo, ctx->return_reserved_hi, "return-left",
-            pnl_size(txn->wr.repnl) - ctx->return_reserved_hi);
+            amount - ctx->return_reserved_hi);
       err = gc_rerere(txn, ctx);
       if (unlikely(err != MDBX_SUCCESS)) {
         if (err == MDBX_RESULT_TRUE)
@@ -1471,8 +1586,8 @@ retry:
     }
 
     if (pnl_size(txn->wr.repnl) > 0) {
-      TRACE(">> %s, %s %zu -> %zu...%zu", "filling", "return-reserved", pnl_size(txn->wr.repnl),
-            ctx->return_reserved_lo, ctx->return_reserved_hi);
+      TRACE(">> %s, %s %zu -> %zu...%zu", "filling", "return-reserved", amount, ctx->return_reserved_lo,
+            ctx->return_reserved_hi);
       err = gc_fill_returned(txn, ctx);
       if (unlikely(err != MDBX_SUCCESS)) {
         if (err == MDBX_RESULT_TRUE)
@@ -1498,6 +1613,7 @@ bailout:
   txn->cursors[FREE_DBI] = ctx->cursor.next;
 
   pnl_setsize(txn->wr.repnl, 0);
+  gc_extents_reset(txn);
 #if MDBX_ENABLE_PROFGC
   env->lck->pgops.gc_prof.wloops += (uint32_t)ctx->loop;
 #endif /* MDBX_ENABLE_PROFGC */
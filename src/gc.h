@@ -65,12 +65,37 @@ MDBX_NOTHROW_PURE_FUNCTION static inline size_t gc_stockpile(const MDBX_txn *txn
   return pnl_size(txn->wr.repnl) + txn->wr.loose_count;
 }
 
+/* Количество страниц в repnl, включая отложенно возвращенные, см. gc_reclaim_deferred() */
+MDBX_NOTHROW_PURE_FUNCTION static inline size_t gc_repnl_npages(const MDBX_txn *txn) {
+  return pnl_size(txn->wr.repnl) + (txn->wr.repnl_deferred ? pnl_size(txn->wr.repnl_deferred) : 0);
+}
+
 MDBX_NOTHROW_PURE_FUNCTION static inline size_t gc_chunk_bytes(const size_t chunk) {
   return (chunk + 1) * sizeof(pgno_t);
 }
 
 MDBX_INTERNAL bool gc_repnl_has_span(const MDBX_txn *txn, const size_t num);
 
+/* Сбрасывает индекс последовательностей, должна вызываться при любых изменениях
+ * txn->wr.repnl, кроме выполняемых внутри gc_alloc_ex(). */
+static inline void gc_extents_reset(MDBX_txn *txn) { txn->wr.extents.basis = 0; }
+
+MDBX_INTERNAL int gc_reclaim_deferred(MDBX_txn *txn, pgno_t pgno, size_t npages);
+MDBX_INTERNAL int gc_merge_deferred_slowpath(MDBX_txn *txn);
+
+/* Вливает в repnl отложенно возвращенные страницы, должна вызываться
+ * перед любым использованием txn->wr.repnl вне gc_update(). */
+static inline int gc_merge_deferred(MDBX_txn *txn) {
+  return likely(!txn->wr.repnl_deferred || MDBX_PNL_IS_EMPTY(txn->wr.repnl_deferred)) ? MDBX_SUCCESS
+                                                                                      : gc_merge_deferred_slowpath(txn);
+}
+
+static inline void gc_extents_free(MDBX_txn *txn) {
+  osal_free(txn->wr.extents.runs);
+  txn->wr.extents.runs = nullptr;
+  txn->wr.extents.basis = txn->wr.extents.count = txn->wr.extents.allocated = 0;
+}
+
 static inline bool gc_is_reclaimed(const MDBX_txn *txn, const txnid_t id) {
   return rkl_contain(&txn->wr.gc.reclaimed, id) || rkl_contain(&txn->wr.gc.comeback, id);
 }
@@ -16,6 +16,7 @@ typedef struct meta_ptr meta_ptr_t;
 typedef struct inner_cursor subcur_t;
 typedef struct cursor_couple cursor_couple_t;
 typedef struct defer_free_item defer_free_item_t;
+typedef struct undo undo_t;
 
 typedef struct troika {
   uint8_t fsm, recent, prefer_steady, tail_and_flags;
@@ -44,6 +45,13 @@ typedef struct bind_reader_slot_result {
   reader_slot_t *slot;
 } bsr_t;
 
+/* Фоновое резервирование места в файле БД, см MDBX_opt_dxb_preallocate. */
+#if (defined(__linux__) || defined(__gnu_linux__)) && MDBX_USE_FALLOCATE && defined(FALLOC_FL_KEEP_SIZE)
+#define DXB_PREALLOCATE 1
+#else
+#define DXB_PREALLOCATE 0
+#endif
+
 #include "atomics-ops.h"
 #include "proto.h"
 #include "rkl.h"
@@ -69,6 +77,13 @@ struct dp {
   pgno_t pgno, npages;
 };
 
+/* The LRU-label and the access counter which are placed just before
+ * a shadow copy of each dirty page, see dpl_label() and spill_prio(). */
+typedef struct dp_label {
+  uint32_t lru;
+  uint32_t hits;
+} dp_label_t;
+
 enum dpl_rules {
   dpl_gap_edging = 2,
   dpl_gap_mergesort = 16,
@@ -84,6 +99,10 @@ struct dpl {
   size_t pages_including_loose;
   /* allocated size excluding the dpl_reserve_gap */
   size_t detent;
+  /* optional hash-index by pgno for huge lists, see dpl_find() */
+  dp_t *hash;
+  uint32_t hash_mask;
+  bool hash_valid;
   /* dynamic size with holes at zero and after the last */
   dp_t items[dpl_reserve_gap];
 };
@@ -213,6 +232,16 @@ struct MDBX_txn {
     struct {
       troika_t troika;
       pnl_t __restrict repnl; /* Reclaimed GC pages */
+      /* Index of page sequences within repnl, ordered by length and pgno */
+      struct {
+        size_t basis; /* pnl_size(repnl) while the index is coherent, zeroed by gc_extents_reset() */
+        size_t count, allocated;
+        struct gc_extent {
+          pgno_t pgno, len;
+        } *runs;
+      } extents;
+      /* Reclaimed dirty pages which are not merged into repnl yet, unsorted */
+      pnl_t __restrict repnl_deferred;
       struct {
         rkl_t reclaimed;   /* The list of reclaimed txn-ids from GC, but not cleared/deleted */
         rkl_t ready4reuse; /* The list of reclaimed txn-ids from GC, and cleared/deleted */
@@ -225,6 +254,17 @@ struct MDBX_txn {
 #endif /* MDBX_ENABLE_REFUND */
       /* a sequence to spilling dirty page with LRU policy */
       unsigned dirtylru;
+      /* spilling statistics including nested txns, see MDBX_commit_latency */
+      struct {
+        uint32_t spilled, unspilled, rounds;
+      } spill_stat;
+      /* datafile resizing statistics including nested txns, see MDBX_commit_latency */
+      struct {
+        uint64_t time;
+        uint32_t count;
+      } resize_stat;
+      /* number of entries spilled since the last aging of dp_label_t::hits */
+      size_t spill_clock;
       /* dirtylist room: Dirty array size - dirty pages visible to this txn.
        * Includes ancestor txns' dirty pages not hidden by other txns'
        * dirty/spilled pages. Thus commit(nested txn) has room to merge
@@ -239,6 +279,8 @@ struct MDBX_txn {
       page_t *__restrict loose_pages;
       /* Number of loose pages (wr.loose_pages) */
       size_t loose_count;
+      /* The undo log of savepoints, see mdbx_txn_savepoint() */
+      undo_t *undo;
       union {
         struct {
           size_t least_removed;
@@ -287,7 +329,9 @@ struct MDBX_cursor {
   };
   /* флаги проверки, в том числе биты для проверки типа листовых страниц. */
   uint8_t checking;
-  uint8_t pad;
+  /* длина серии последовательных переходов между листовыми страницами,
+   * старший бит задает направление, см. cursor_prefetch() */
+  uint8_t scan;
 
   /* Указывает на txn->dbi_state[] для DBI этого курсора.
    * Модификатор __restrict тут полезен и безопасен в текущем понимании,
@@ -376,6 +420,7 @@ struct MDBX_env {
     void *buffer;
   } pathname;
   void *page_auxbuf;              /* scratch area for DUPSORT put() */
+  meta_t *manifest;               /* meta with the manifest for single-flush commit */
   MDBX_txn *basal_txn;            /* preallocated write transaction */
   kvx_t *kvs;                     /* array of auxiliary key-value properties */
   uint8_t *__restrict dbs_flags;  /* array of flags from tree_t.flags */
@@ -386,6 +431,9 @@ struct MDBX_env {
   void *userctx;                  /* User-settable context */
   MDBX_hsr_func *hsr_callback;    /* Callback for kicking laggard readers */
   size_t madv_threshold;
+#if DXB_PREALLOCATE
+  struct dxb_prealloc *prealloc; /* helper thread for preallocation */
+#endif /* DXB_PREALLOCATE */
 
   struct {
     unsigned dp_reserve_limit;
@@ -405,6 +453,14 @@ struct MDBX_env {
     bool prefer_waf_insteadof_balance; /* Strive to minimize WAF instead of
                                           balancing pages fullment */
     bool need_dp_limit_adjust;
+    unsigned prefetch_window;
+    uint8_t dp_slab;
+    uint8_t spill_policy;
+    uint8_t dxb_hugepages;
+    pgno_t dxb_preallocate;
+    uint8_t dxb_direct_write;
+    uint8_t single_flush;
+    uint8_t gc_extents;
     struct {
       uint16_t limit;
       uint16_t room_threshold;
@@ -441,6 +497,8 @@ struct MDBX_env {
   } me_sysv_ipc;
 #endif /* MDBX_LOCKING == MDBX_LOCKING_SYSV */
   bool incore;
+  bool anonymous; /* files are memfd, see mdbx_env_open_anonymous() */
+  bool blockdev;  /* DXB is a raw block device with the fixed size */
 
 #if MDBX_ENABLE_DBI_LOCKFREE
   defer_free_item_t *defer_free;
@@ -476,6 +534,42 @@ struct MDBX_env {
 
   unsigned shadow_reserve_len;
   page_t *__restrict shadow_reserve; /* list of malloc'ed blocks for re-use */
+  struct {
+    /* blocks with free slots (partially used first) and fully used ones */
+    struct shadow_chunk *avail, *full;
+    /* counters for mdbx_env_info_ex(), which reads them without the lock */
+    mdbx_atomic_uint64_t chunks, bytes, used, hugetlb;
+    /* slots of entirely unused blocks, which are retained for re-use */
+    size_t spare;
+  } shadow_slab;
+
+  /* cached size of the mapping backed by huge pages, see dxb_hugepages_resident() */
+  struct {
+    mdbx_atomic_uint64_t bytes, monotime;
+  } hugepages_resident;
+
+#if MDBX_ENABLE_PGOP_STAT
+  /* Statistics of prefetching for sequential scans within this process */
+  struct {
+    mdbx_atomic_uint64_t issued, hits, misses;
+  } prefetch_stat;
+  /* Statistics of finger search within this process */
+  struct {
+    mdbx_atomic_uint64_t searches, levels_saved;
+  } finger_stat;
+  /* Statistics of mdbx_cache_get() within this process */
+  struct {
+    mdbx_atomic_uint64_t hits, misses, invalidations;
+  } cache_stat;
+  /* Statistics of searching page sequences within GC/repnl */
+  struct {
+    mdbx_atomic_uint64_t searches, steps, rebuilds, growths;
+  } gc_seq_stat;
+  /* Statistics of writes through the O_DSYNC descriptor within this process */
+  struct {
+    mdbx_atomic_uint64_t writes;
+  } dsync_stat;
+#endif /* MDBX_ENABLE_PGOP_STAT */
 
   osal_ioring_t ioring;
 
@@ -581,6 +675,8 @@ MDBX_MAYBE_UNUSED static void static_checks(void) {
 
 #include "spill.h"
 
+#include "savepoint.h"
+
 #include "page-ops.h"
 
 #include "tls.h"
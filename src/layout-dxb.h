@@ -20,6 +20,9 @@
 #define MDBX_DATA_MAGIC ((MDBX_MAGIC << 8) + MDBX_PNL_ASCENDING * 64 + MDBX_DATA_VERSION)
 #define MDBX_DATA_MAGIC_LEGACY_COMPAT ((MDBX_MAGIC << 8) + MDBX_PNL_ASCENDING * 64 + 2)
 #define MDBX_DATA_MAGIC_LEGACY_DEVEL ((MDBX_MAGIC << 8) + 255)
+/* The format with packed GC records (see MDBX_opt_gc_extents),
+ * which is refused by older versions with MDBX_VERSION_MISMATCH. */
+#define MDBX_DATA_MAGIC_GC_EXTENTS ((MDBX_MAGIC << 8) + MDBX_PNL_ASCENDING * 64 + 4)
 
 /* handle for the DB used to track free pages. */
 #define FREE_DBI 0
@@ -152,6 +155,22 @@ typedef struct meta {
   bin128_t dxbid;
 } meta_t;
 
+/* Опись страниц, записанных при фиксации транзакции с однократным сбросом
+ * на диск (см. MDBX_opt_single_flush). Размещается в мета-странице следом
+ * за meta_t и относится к ней только при совпадении txnid. Контрольная сумма
+ * охватывает содержимое всех перечисленных страниц, что позволяет при
+ * открытии БД обнаружить фиксацию, которая не была полностью сброшена. */
+typedef struct manifest {
+#define MANIFEST_MAGIC UINT32_C(0x46534D58) /* "XMSF" */
+  uint32_t magic;
+  uint32_t count; /* number of extents */
+  uint32_t txnid[2];
+  uint32_t checksum[2];
+  struct {
+    pgno_t pgno, npages;
+  } extents[];
+} manifest_t;
+
 #pragma pack(1)
 
 typedef enum page_type {
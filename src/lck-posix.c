@@ -225,6 +225,8 @@ int lck_ipclock_destroy(osal_ipclock_t *ipc) {
 
 static int check_fstat(MDBX_env *env) {
   struct stat st;
+  /* у файлов анонимной БД нет имени и ссылок на них в файловой системе */
+  const nlink_t nlink_min = env->anonymous ? 0 : 1;
 
   int rc = MDBX_SUCCESS;
   if (fstat(env->lazy_fd, &st)) {
@@ -233,17 +235,18 @@ static int check_fstat(MDBX_env *env) {
     return rc;
   }
 
-  if (!S_ISREG(st.st_mode) || st.st_nlink < 1) {
+  if (!(S_ISREG(st.st_mode) || (S_ISBLK(st.st_mode) && env->blockdev)) || st.st_nlink < nlink_min) {
 #ifdef EBADFD
     rc = EBADFD;
 #else
     rc = EPERM;
 #endif
-    ERROR("%s %s, err %d", "DXB", (st.st_nlink < 1) ? "file was removed" : "not a regular file", rc);
+    ERROR("%s %s, err %d", "DXB", (st.st_nlink < nlink_min) ? "file was removed" : "not a regular file", rc);
     return rc;
   }
 
-  if (st.st_size < (off_t)(MDBX_MIN_PAGESIZE * NUM_METAS)) {
+  /* ёмкость блочного устройства не отражается в st_size */
+  if (!env->blockdev && st.st_size < (off_t)(MDBX_MIN_PAGESIZE * NUM_METAS)) {
     VERBOSE("dxb-file is too short (%u), exclusive-lock needed", (unsigned)st.st_size);
     rc = MDBX_RESULT_TRUE;
   }
@@ -256,13 +259,13 @@ static int check_fstat(MDBX_env *env) {
     return rc;
   }
 
-  if (!S_ISREG(st.st_mode) || st.st_nlink < 1) {
+  if (!S_ISREG(st.st_mode) || st.st_nlink < nlink_min) {
 #ifdef EBADFD
     rc = EBADFD;
 #else
     rc = EPERM;
 #endif
-    ERROR("%s %s, err %d", "LCK", (st.st_nlink < 1) ? "file was removed" : "not a regular file", rc);
+    ERROR("%s %s, err %d", "LCK", (st.st_nlink < nlink_min) ? "file was removed" : "not a regular file", rc);
     return rc;
   }
 
@@ -450,7 +453,7 @@ __cold int lck_destroy(MDBX_env *env, MDBX_env *inprocess_neighbor, const uint32
       /* try get exclusive access */
       lck_op(env->lck_mmap.fd, op_setlk, F_WRLCK, 0, OFF_T_MAX) == 0 &&
       /* if LCK was not removed */
-      fstat(env->lck_mmap.fd, &lck_info) == 0 && lck_info.st_nlink > 0 &&
+      fstat(env->lck_mmap.fd, &lck_info) == 0 && (lck_info.st_nlink > 0 || env->anonymous) &&
       lck_op(env->lazy_fd, op_setlk, (env->flags & MDBX_RDONLY) ? F_RDLCK : F_WRLCK, 0, OFF_T_MAX) == 0) {
 
     VERBOSE("%p got exclusive, drown ipc-locks", (void *)env);
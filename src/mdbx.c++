@@ -26,6 +26,7 @@
 #include <atomic>
 #include <cctype> // for isxdigit(), etc
 #include <system_error>
+#include <thread>
 
 namespace {
 
@@ -1491,6 +1492,14 @@ void txn_managed::commit(commit_latency *latency) {
     MDBX_CXX20_UNLIKELY err.throw_exception();
 }
 
+void txn_managed::commit(commit_latency *latency, commit_stat *stat) {
+  const error err = static_cast<MDBX_error_t>(::mdbx_txn_commit_ex2(handle_, latency, stat, sizeof(commit_stat)));
+  if (MDBX_LIKELY(err.code() != MDBX_THREAD_MISMATCH))
+    MDBX_CXX20_LIKELY handle_ = nullptr;
+  if (MDBX_UNLIKELY(err.code() != MDBX_SUCCESS))
+    MDBX_CXX20_UNLIKELY err.throw_exception();
+}
+
 void txn_managed::commit_embark_read() {
   auto env = this->env();
   commit();
@@ -1605,6 +1614,52 @@ __cold bool txn::rename_map(const ::std::string &old_name, const ::std::string &
   return rename_map(::mdbx::slice(old_name), ::mdbx::slice(new_name), throw_if_absent);
 }
 
+::std::vector<txn::key_range> txn::partition(map_handle map, size_t parts, const slice &from, const slice &to) const {
+  ::std::vector<MDBX_val> boundaries(parts ? parts - 1 : 0);
+  ::std::vector<ptrdiff_t> estimated(parts);
+  size_t count = 0;
+  error::success_or_throw(::mdbx_dbi_partition(handle_, map.dbi, from.is_valid() ? &from : nullptr,
+                                               to.is_valid() ? &to : nullptr, parts, boundaries.data(),
+                                               estimated.data(), &count));
+  ::std::vector<key_range> result(count);
+  for (size_t i = 0; i < count; ++i) {
+    result[i].from = i ? slice(boundaries[i - 1]) : from;
+    result[i].to = (i + 1 < count) ? slice(boundaries[i]) : to;
+    result[i].approximate_quantity = estimated[i];
+  }
+  return result;
+}
+
+void env::run_in_parallel(size_t tasks, unsigned threads, void (*worker)(void *context, size_t task), void *context) {
+  if (!threads)
+    threads = ::std::max(1u, ::std::thread::hardware_concurrency());
+  if (threads > tasks)
+    threads = unsigned(tasks);
+
+  ::std::atomic<size_t> next(0);
+  ::std::atomic<bool> failed(false);
+  ::std::exception_ptr exception;
+  auto loop = [&]() {
+    for (size_t task; !failed.load() && (task = next++) < tasks;) {
+      try {
+        worker(context, task);
+      } catch (...) {
+        if (!failed.exchange(true))
+          exception = ::std::current_exception();
+      }
+    }
+  };
+
+  ::std::vector<::std::thread> pool;
+  pool.reserve(threads);
+  for (unsigned i = 0; i < threads; ++i)
+    pool.emplace_back(loop);
+  for (auto &thread : pool)
+    thread.join();
+  if (exception)
+    ::std::rethrow_exception(exception);
+}
+
 //------------------------------------------------------------------------------
 
 __cold ::std::ostream &operator<<(::std::ostream &out, const slice &it) {
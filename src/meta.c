@@ -220,6 +220,7 @@ static int meta_unsteady(MDBX_env *env, const txnid_t inclusive_upto, const pgno
 
 #if MDBX_ENABLE_PGOP_STAT
   env->lck->pgops.wops.weak += 1;
+  env->dsync_stat.writes.weak += env->fd4meta == env->dsync_fd;
 #endif /* MDBX_ENABLE_PGOP_STAT */
   int err = osal_pwrite(env->fd4meta, ptr, bytes, offset);
   return likely(err == MDBX_SUCCESS) ? MDBX_RESULT_TRUE : err;
@@ -258,6 +259,66 @@ __cold int meta_wipe_steady(MDBX_env *env, txnid_t inclusive_upto) {
   return err;
 }
 
+/* Помечает мета-страницы форматом с упакованными записями GC (см. MDBX_opt_gc_extents), после чего прежние версии
+ * отказываются открывать БД. Мета-страницы помечаются в порядке возрастания txnid со сбросом каждой на диск, поэтому
+ * при сбое непомеченными остаются только более новые. Иначе прежние версии могли бы откатиться к старой мета-странице,
+ * страницы снимка которой уже переиспользованы. */
+__cold int meta_mark_gc_extents(MDBX_env *env) {
+  const troika_t troika = meta_tap(env);
+  unsigned order[NUM_METAS] = {0, 1, 2};
+  for (size_t i = 1; i < NUM_METAS; ++i)
+    for (size_t j = i; j > 0 && troika.txnid[order[j - 1]] > troika.txnid[order[j]]; --j) {
+      const unsigned t = order[j];
+      order[j] = order[j - 1];
+      order[j - 1] = t;
+    }
+
+  for (size_t i = 0; i < NUM_METAS; ++i) {
+    meta_t *const meta = METAPAGE(env, order[i]);
+    if (meta_gc_extents(meta))
+      continue;
+
+    NOTICE("mark meta[%u], txnid %" PRIaTXN " with the %s format", order[i], troika.txnid[order[i]], "gc-extents");
+    const uint64_t magic_and_version = MDBX_DATA_MAGIC_GC_EXTENTS;
+    int err;
+    if (env->flags & MDBX_WRITEMAP) {
+      unaligned_poke_u64(4, meta->magic_and_version, magic_and_version);
+      osal_flush_incoherent_cpu_writeback();
+      if (!MDBX_AVOID_MSYNC) {
+#if MDBX_ENABLE_PGOP_STAT
+        env->lck->pgops.msync.weak += 1;
+#endif /* MDBX_ENABLE_PGOP_STAT */
+        err = osal_msync(&env->dxb_mmap, 0, pgno_ceil2sp_bytes(env, NUM_METAS), MDBX_SYNC_DATA | MDBX_SYNC_IODQ);
+      } else {
+        const page_t *const page = payload2page(meta);
+#if MDBX_ENABLE_PGOP_STAT
+        env->lck->pgops.wops.weak += 1;
+        env->dsync_stat.writes.weak += env->fd4meta == env->dsync_fd;
+#endif /* MDBX_ENABLE_PGOP_STAT */
+        err = osal_pwrite(env->fd4meta, page, env->ps, ptr_dist(page, env->dxb_mmap.base));
+      }
+    } else {
+#if MDBX_ENABLE_PGOP_STAT
+      env->lck->pgops.wops.weak += 1;
+      env->dsync_stat.writes.weak += env->fd4meta == env->dsync_fd;
+#endif /* MDBX_ENABLE_PGOP_STAT */
+      err = osal_pwrite(env->fd4meta, &magic_and_version, sizeof(magic_and_version),
+                        ptr_dist(meta->magic_and_version, env->dxb_mmap.base));
+      osal_flush_incoherent_mmap(meta, sizeof(meta_t), globals.sys_pagesize);
+    }
+    if (likely(err == MDBX_SUCCESS) && env->fd4meta == env->lazy_fd &&
+        ((env->flags & MDBX_WRITEMAP) == 0 || MDBX_AVOID_MSYNC)) {
+#if MDBX_ENABLE_PGOP_STAT
+      env->lck->pgops.fsync.weak += 1;
+#endif /* MDBX_ENABLE_PGOP_STAT */
+      err = osal_fsync(env->lazy_fd, MDBX_SYNC_DATA | MDBX_SYNC_IODQ);
+    }
+    if (unlikely(err != MDBX_SUCCESS))
+      return err;
+  }
+  return MDBX_SUCCESS;
+}
+
 int meta_sync(const MDBX_env *env, const meta_ptr_t head) {
   eASSERT(env, atomic_load32(&env->lck->meta_sync_txnid, mo_Relaxed) != (uint32_t)head.txnid);
   /* Функция может вызываться (в том числе) при (env->flags &
@@ -362,7 +423,7 @@ __cold int __must_check_result meta_override(MDBX_env *env, size_t target, txnid
             target, "pre", constmeta_txnid(shape));
       return MDBX_PROBLEM;
     }
-    if (globals.runtime_flags & MDBX_DBG_DONT_UPGRADE)
+    if ((globals.runtime_flags & MDBX_DBG_DONT_UPGRADE) || meta_gc_extents(shape))
       memcpy(&model->magic_and_version, &shape->magic_and_version, sizeof(model->magic_and_version));
     model->reserve16 = shape->reserve16;
     model->validator_id = shape->validator_id;
@@ -421,6 +482,7 @@ __cold int __must_check_result meta_override(MDBX_env *env, size_t target, txnid
   } else {
 #if MDBX_ENABLE_PGOP_STAT
     env->lck->pgops.wops.weak += 1;
+    env->dsync_stat.writes.weak += env->fd4meta == env->dsync_fd;
 #endif /* MDBX_ENABLE_PGOP_STAT */
     rc = osal_pwrite(env->fd4meta, page, env->ps, pgno2bytes(env, target));
     if (rc == MDBX_SUCCESS && env->fd4meta == env->lazy_fd) {
@@ -439,7 +501,7 @@ __cold int __must_check_result meta_override(MDBX_env *env, size_t target, txnid
 __cold int meta_validate(MDBX_env *env, meta_t *const meta, const page_t *const page, const unsigned meta_number,
                          unsigned *guess_pagesize) {
   const uint64_t magic_and_version = unaligned_peek_u64(4, &meta->magic_and_version);
-  if (unlikely(magic_and_version != MDBX_DATA_MAGIC && magic_and_version != MDBX_DATA_MAGIC_LEGACY_COMPAT &&
+  if (unlikely(!meta_format_actual(magic_and_version) && magic_and_version != MDBX_DATA_MAGIC_LEGACY_COMPAT &&
                magic_and_version != MDBX_DATA_MAGIC_LEGACY_DEVEL)) {
     ERROR("meta[%u] has invalid magic/version %" PRIx64, meta_number, magic_and_version);
     return ((magic_and_version >> 8) != MDBX_MAGIC) ? MDBX_INVALID : MDBX_VERSION_MISMATCH;
@@ -482,7 +544,7 @@ __cold int meta_validate(MDBX_env *env, meta_t *const meta, const page_t *const
   }
 
   if (unlikely(meta->trees.gc.flags != MDBX_INTEGERKEY) &&
-      ((meta->trees.gc.flags & DB_PERSISTENT_FLAGS) != MDBX_INTEGERKEY || magic_and_version == MDBX_DATA_MAGIC)) {
+      ((meta->trees.gc.flags & DB_PERSISTENT_FLAGS) != MDBX_INTEGERKEY || meta_format_actual(magic_and_version))) {
     WARNING("meta[%u] has invalid %s flags 0x%x, skip it", meta_number, "GC/FreeDB", meta->trees.gc.flags);
     return MDBX_INCOMPATIBLE;
   }
@@ -650,6 +712,50 @@ __cold int meta_validate(MDBX_env *env, meta_t *const meta, const page_t *const
   return MDBX_SUCCESS;
 }
 
+uint64_t manifest_checksum(const manifest_t *manifest, uint64_t checksum) {
+  /* экстенты учитываются после содержимого страниц, так как при формировании
+   * описи смежные страницы объединяются по мере их перебора */
+  for (size_t i = 0; i < manifest->count; ++i)
+    checksum = rrxmrrxmsx_0(checksum ^ ((uint64_t)manifest->extents[i].pgno << 32 | manifest->extents[i].npages));
+  return checksum;
+}
+
+/* Проверяет страницы фиксации с однократным сбросом на диск по описи в её
+ * мета-странице. Возвращает MDBX_SUCCESS если все страницы соответствуют
+ * описи, MDBX_RESULT_TRUE если фиксация не была полностью сброшена на диск,
+ * либо MDBX_NOTFOUND если мета-страница не содержит описи. */
+__cold int meta_check_manifest(const MDBX_env *env, const meta_t *meta) {
+  const manifest_t *const manifest = meta_manifest(meta);
+  const txnid_t txnid = constmeta_txnid(meta);
+  if (!manifest_capacity(env) || manifest->magic != MANIFEST_MAGIC || unaligned_peek_u64(4, manifest->txnid) != txnid)
+    /* фиксация выполнялась без описи */
+    return MDBX_NOTFOUND;
+
+  const unsigned meta_number = bytes2pgno(env, ptr_dist(meta, env->dxb_mmap.base));
+  if (unlikely(manifest->count > manifest_capacity(env))) {
+    WARNING("meta[%u] has invalid manifest (%u extents)", meta_number, manifest->count);
+    return MDBX_RESULT_TRUE;
+  }
+
+  uint64_t checksum = txnid;
+  for (size_t i = 0; i < manifest->count; ++i) {
+    const pgno_t pgno = manifest->extents[i].pgno, npages = manifest->extents[i].npages;
+    if (unlikely(pgno < NUM_METAS || !npages || npages > meta->geometry.first_unallocated - pgno)) {
+      WARNING("meta[%u] has invalid manifest extent %" PRIaPGNO "+%" PRIaPGNO, meta_number, pgno, npages);
+      return MDBX_RESULT_TRUE;
+    }
+    for (size_t n = 0; n < npages; ++n)
+      checksum = checksum64(checksum, pgno2page(env, pgno + n), env->ps);
+  }
+  checksum = manifest_checksum(manifest, checksum);
+  if (unlikely(checksum != unaligned_peek_u64(4, manifest->checksum))) {
+    WARNING("meta[%u] with txnid %" PRIaTXN " refers to torn pages (checksum 0x%" PRIx64 " != 0x%" PRIx64 ")",
+            meta_number, txnid, checksum, unaligned_peek_u64(4, manifest->checksum));
+    return MDBX_RESULT_TRUE;
+  }
+  return MDBX_SUCCESS;
+}
+
 __cold int meta_validate_copy(MDBX_env *env, const meta_t *meta, meta_t *dest) {
   *dest = *meta;
   return meta_validate(env, dest, payload2page(meta), bytes2pgno(env, ptr_dist(meta, env->dxb_mmap.base)), nullptr);
@@ -22,6 +22,15 @@ static inline void meta_sign_as_steady(meta_t *meta) { unaligned_poke_u64(4, met
 
 static inline bool meta_is_steady(const volatile meta_t *meta) { return SIGN_IS_STEADY(meta_sign_get(meta)); }
 
+/* Текущий формат БД, в том числе с упакованными записями GC (см. MDBX_opt_gc_extents) */
+static inline bool meta_format_actual(const uint64_t magic_and_version) {
+  return magic_and_version == MDBX_DATA_MAGIC || magic_and_version == MDBX_DATA_MAGIC_GC_EXTENTS;
+}
+
+static inline bool meta_gc_extents(const volatile meta_t *meta) {
+  return unaligned_peek_u64_volatile(4, meta->magic_and_version) == MDBX_DATA_MAGIC_GC_EXTENTS;
+}
+
 MDBX_INTERNAL troika_t meta_tap(const MDBX_env *env);
 MDBX_INTERNAL unsigned meta_eq_mask(const troika_t *troika);
 MDBX_INTERNAL bool meta_should_retry(const MDBX_env *env, troika_t *troika);
@@ -47,6 +56,11 @@ MDBX_INTERNAL void meta_troika_dump(const MDBX_env *env, const troika_t *troika)
 #define METAPAGE(env, n) page_meta(pgno2page(env, n))
 #define METAPAGE_END(env) METAPAGE(env, NUM_METAS)
 
+/* Все мета-страницы помечены форматом с упакованными записями GC, см. meta_mark_gc_extents() */
+static inline bool meta_gc_extents_marked(const MDBX_env *env) {
+  return meta_gc_extents(METAPAGE(env, 0)) && meta_gc_extents(METAPAGE(env, 1)) && meta_gc_extents(METAPAGE(env, 2));
+}
+
 static inline meta_ptr_t meta_recent(const MDBX_env *env, const troika_t *troika) {
   meta_ptr_t r;
   r.txnid = troika->txnid[troika->recent];
@@ -166,3 +180,16 @@ MDBX_INTERNAL int __must_check_result meta_validate_copy(MDBX_env *env, const me
 MDBX_INTERNAL int __must_check_result meta_override(MDBX_env *env, size_t target, txnid_t txnid, const meta_t *shape);
 
 MDBX_INTERNAL int meta_wipe_steady(MDBX_env *env, txnid_t inclusive_upto);
+
+MDBX_INTERNAL int meta_mark_gc_extents(MDBX_env *env);
+
+static inline manifest_t *meta_manifest(const meta_t *meta) { return ptr_disp(meta, sizeof(meta_t)); }
+
+/* Количество экстентов, умещающихся в описи после meta_t в мета-странице */
+static inline size_t manifest_capacity(const MDBX_env *env) {
+  const size_t used = PAGEHDRSZ + sizeof(meta_t) + sizeof(manifest_t);
+  return (env->ps > used) ? (env->ps - used) / sizeof(((manifest_t *)nullptr)->extents[0]) : 0;
+}
+
+MDBX_INTERNAL uint64_t manifest_checksum(const manifest_t *manifest, uint64_t checksum);
+MDBX_INTERNAL int meta_check_manifest(const MDBX_env *env, const meta_t *meta);
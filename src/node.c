@@ -24,8 +24,7 @@ __hot int __must_check_result node_add_dupfix(MDBX_cursor *mc, size_t indx, cons
   const intptr_t lower = mp->lower + sizeof(indx_t);
   const intptr_t upper = mp->upper - (ksize - sizeof(indx_t));
   if (unlikely(lower > upper)) {
-    mc->txn->flags |= MDBX_TXN_ERROR;
-    return MDBX_PAGE_FULL;
+    return txn_poison(mc->txn, MDBX_PAGE_FULL);
   }
   mp->lower = (indx_t)lower;
   mp->upper = (indx_t)upper;
@@ -58,8 +57,7 @@ int __must_check_result node_add_branch(MDBX_cursor *mc, size_t indx, const MDBX
   const intptr_t lower = mp->lower + sizeof(indx_t);
   const intptr_t upper = mp->upper - (branch_bytes - sizeof(indx_t));
   if (unlikely(lower > upper)) {
-    mc->txn->flags |= MDBX_TXN_ERROR;
-    return MDBX_PAGE_FULL;
+    return txn_poison(mc->txn, MDBX_PAGE_FULL);
   }
 
   /* Move higher pointers up one slot. */
@@ -140,8 +138,7 @@ __hot int __must_check_result node_add_leaf(MDBX_cursor *mc, size_t indx, const
   const intptr_t lower = mp->lower + sizeof(indx_t);
   const intptr_t upper = mp->upper - (node_bytes - sizeof(indx_t));
   if (unlikely(lower > upper)) {
-    mc->txn->flags |= MDBX_TXN_ERROR;
-    return MDBX_PAGE_FULL;
+    return txn_poison(mc->txn, MDBX_PAGE_FULL);
   }
   mp->lower = (indx_t)lower;
   mp->entries[indx] = mp->upper = (indx_t)upper;
@@ -205,6 +205,13 @@
 #error MDBX_ENVCOPY_WRITEBUF must be defined in range 65536..1073741824 and be multiple of 65536
 #endif /* MDBX_ENVCOPY_WRITEBUF */
 
+/** Maximum number of threads used by mdbx_dbi_warmup(), including the calling one. */
+#ifndef MDBX_WARMUP_THREADS_MAX
+#define MDBX_WARMUP_THREADS_MAX 64u
+#elif MDBX_WARMUP_THREADS_MAX < 1u || MDBX_WARMUP_THREADS_MAX > 1024u
+#error MDBX_WARMUP_THREADS_MAX must be defined in range 1..1024
+#endif /* MDBX_WARMUP_THREADS_MAX */
+
 /** Forces assertion checking. */
 #ifndef MDBX_FORCE_ASSERTIONS
 #define MDBX_FORCE_ASSERTIONS 0
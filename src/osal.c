@@ -333,6 +333,63 @@ void osal_memalign_free(void *ptr) {
 }
 #endif /* osal_memalign_free */
 
+/* Выделяет анонимную память размером кратным 2 МиБ, выровненную по 2 МиБ
+ * границе для возможности использования Transparent Huge Pages.
+ * При hugetlb = true сначала пробует явные большие страницы (MAP_HUGETLB или
+ * MEM_LARGE_PAGES), которые могут быть недоступны из-за настроек системы. */
+void *osal_hugepage_alloc(size_t bytes, bool hugetlb, bool *is_hugetlb) {
+  const size_t huge = 2 << 20;
+  assert(bytes > 0 && bytes % huge == 0);
+  *is_hugetlb = false;
+#if defined(_WIN32) || defined(_WIN64)
+  if (hugetlb) {
+    const size_t large = GetLargePageMinimum();
+    if (large && bytes % large == 0) {
+      void *ptr = VirtualAlloc(nullptr, bytes, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, PAGE_READWRITE);
+      if (ptr) {
+        *is_hugetlb = true;
+        return ptr;
+      }
+    }
+  }
+  return VirtualAlloc(nullptr, bytes, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+#else
+#ifdef MAP_HUGETLB
+  if (hugetlb) {
+    void *ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (ptr != MAP_FAILED) {
+      *is_hugetlb = true;
+      return ptr;
+    }
+  }
+#else
+  (void)hugetlb;
+#endif /* MAP_HUGETLB */
+  /* выделяем с запасом и обрезаем до выравнивания */
+  char *const ptr = mmap(nullptr, bytes + huge, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (ptr == MAP_FAILED)
+    return nullptr;
+  char *const aligned = (char *)ceil_powerof2((uintptr_t)ptr, huge);
+  if (aligned > ptr)
+    munmap(ptr, aligned - ptr);
+  if (aligned + bytes < ptr + bytes + huge)
+    munmap(aligned + bytes, ptr + huge - aligned);
+#if defined(MADV_HUGEPAGE)
+  (void)madvise(aligned, bytes, MADV_HUGEPAGE);
+#endif /* MADV_HUGEPAGE */
+  return aligned;
+#endif
+}
+
+void osal_hugepage_free(void *ptr, size_t bytes) {
+#if defined(_WIN32) || defined(_WIN64)
+  (void)bytes;
+  VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+  munmap(ptr, bytes);
+#endif
+}
+
 #ifndef osal_strdup
 char *osal_strdup(const char *str) {
   if (!str)
@@ -567,10 +624,15 @@ static size_t osal_iov_max;
 #undef OSAL_IOV_MAX
 #endif /* OSAL_IOV_MAX */
 
+#define IOR_BOUNCE_SIZE ((size_t)2 << 20)
+
 int osal_ioring_create(osal_ioring_t *ior
 #if defined(_WIN32) || defined(_WIN64)
                        ,
                        bool enable_direct, mdbx_filehandle_t overlapped_fd
+#else
+                       ,
+                       mdbx_filehandle_t direct_fd
 #endif /* Windows */
 ) {
   memset(ior, 0, sizeof(osal_ioring_t));
@@ -589,6 +651,18 @@ int osal_ioring_create(osal_ioring_t *ior
   assert(osal_iov_max > 0);
 #endif /* MDBX_HAVE_PWRITEV && _SC_IOV_MAX */
 
+#if !(defined(_WIN32) || defined(_WIN64))
+  ior->direct_fd = direct_fd;
+  if (direct_fd != INVALID_HANDLE_VALUE) {
+    int err = osal_memalign_alloc(globals.sys_pagesize, IOR_BOUNCE_SIZE, &ior->bounce);
+    if (unlikely(err != MDBX_SUCCESS)) {
+      ior->bounce = nullptr;
+      osal_closefile(direct_fd);
+      return err;
+    }
+  }
+#endif /* !Windows */
+
   ior->boundary = ptr_disp(ior->pool, ior->allocated);
   return MDBX_SUCCESS;
 }
@@ -767,6 +841,59 @@ void osal_ioring_walk(osal_ioring_t *ior, iov_ctx_t *ctx,
   }
 }
 
+#if !(defined(_WIN32) || defined(_WIN64))
+/* Запись через O_DIRECT требует выравнивания адресов, смещений и размеров на
+ * границу блока устройства. Выровненные теневые страницы из slab (см
+ * shadow_slab_alloc()) записываются непосредственно, а прочие порциями
+ * копируются в выровненный буфер. Это заметно дешевле двойной буферизации
+ * в страничном кэше ОС, а главное длительность фиксации не зависит от
+ * фоновой записи грязных страниц ядром. */
+static int ior_flush_bounce(osal_ioring_t *ior, size_t *filled, uint64_t *offset, unsigned *wops) {
+  *wops += 1;
+  int err = osal_pwrite(ior->direct_fd, ior->bounce, *filled, *offset);
+  *offset += *filled;
+  *filled = 0;
+  return err;
+}
+
+static int ior_write_direct(osal_ioring_t *ior, const struct iovec *sgv, size_t sgvcnt, uint64_t offset,
+                            unsigned *wops) {
+  int err = MDBX_SUCCESS;
+  size_t filled = 0;
+  for (size_t i = 0; i < sgvcnt && err == MDBX_SUCCESS;) {
+    size_t n = 0, bytes = 0;
+    while (i + n < sgvcnt && ((uintptr_t)sgv[i + n].iov_base & (globals.sys_pagesize - 1)) == 0)
+      bytes += sgv[i + n++].iov_len;
+    if (n) {
+      if (filled && unlikely((err = ior_flush_bounce(ior, &filled, &offset, wops)) != MDBX_SUCCESS))
+        break;
+      *wops += 1;
+      err = (n > 1) ? osal_pwritev(ior->direct_fd, (struct iovec *)sgv + i, n, offset)
+                    : osal_pwrite(ior->direct_fd, sgv[i].iov_base, bytes, offset);
+      offset += bytes;
+      i += n;
+      continue;
+    }
+
+    const char *src = sgv[i].iov_base;
+    size_t left = sgv[i].iov_len;
+    while (left && err == MDBX_SUCCESS) {
+      const size_t chunk = (left < IOR_BOUNCE_SIZE - filled) ? left : IOR_BOUNCE_SIZE - filled;
+      memcpy(ptr_disp(ior->bounce, filled), src, chunk);
+      src += chunk;
+      left -= chunk;
+      filled += chunk;
+      if (filled == IOR_BOUNCE_SIZE)
+        err = ior_flush_bounce(ior, &filled, &offset, wops);
+    }
+    i += 1;
+  }
+  if (filled && err == MDBX_SUCCESS)
+    err = ior_flush_bounce(ior, &filled, &offset, wops);
+  return err;
+}
+#endif /* !Windows */
+
 osal_ioring_write_result_t osal_ioring_write(osal_ioring_t *ior, mdbx_filehandle_t fd) {
   osal_ioring_write_result_t r = {MDBX_SUCCESS, 0};
 
@@ -960,10 +1087,13 @@ osal_ioring_write_result_t osal_ioring_write(osal_ioring_t *ior, mdbx_filehandle
 
 #else
   STATIC_ASSERT_MSG(sizeof(off_t) >= sizeof(size_t), "libmdbx requires 64-bit file I/O on 64-bit systems");
+  const bool direct = ior->bounce && fd == ior->direct_fd;
   for (ior_item_t *item = ior->pool; item <= ior->last;) {
 #if MDBX_HAVE_PWRITEV
     assert(item->sgvcnt > 0);
-    if (item->sgvcnt == 1)
+    if (unlikely(direct))
+      r.err = ior_write_direct(ior, item->sgv, item->sgvcnt, item->offset, &r.wops);
+    else if (item->sgvcnt == 1)
       r.err = osal_pwrite(fd, item->sgv[0].iov_base, item->sgv[0].iov_len, item->offset);
     else
       r.err = osal_pwritev(fd, item->sgv, item->sgvcnt, item->offset);
@@ -972,10 +1102,11 @@ osal_ioring_write_result_t osal_ioring_write(osal_ioring_t *ior, mdbx_filehandle
 
     item = ior_next(item, item->sgvcnt);
 #else
-    r.err = osal_pwrite(fd, item->single.iov_base, item->single.iov_len, item->offset);
+    r.err = unlikely(direct) ? ior_write_direct(ior, &item->single, 1, item->offset, &r.wops)
+                             : osal_pwrite(fd, item->single.iov_base, item->single.iov_len, item->offset);
     item = ior_next(item, 1);
 #endif
-    r.wops += 1;
+    r.wops += direct ? 0 : 1;
     if (unlikely(r.err != MDBX_SUCCESS))
       break;
   }
@@ -1093,6 +1224,10 @@ void osal_ioring_destroy(osal_ioring_t *ior) {
     CloseHandle(ior->overlapped_fd);
 #else
   osal_free(ior->pool);
+  if (ior->bounce) {
+    osal_memalign_free(ior->bounce);
+    osal_closefile(ior->direct_fd);
+  }
 #endif
   memset(ior, 0, sizeof(osal_ioring_t));
 }
@@ -1249,6 +1384,11 @@ int osal_openfile(const enum osal_openfile_purpose purpose, const MDBX_env *env,
   case MDBX_OPEN_DXB_LAZY:
     flags |= O_RDWR;
     break;
+#if defined(O_DIRECT)
+  case MDBX_OPEN_DXB_DIRECT:
+    flags |= O_WRONLY | O_DIRECT;
+    break;
+#endif /* O_DIRECT */
   case MDBX_OPEN_DXB_DSYNC:
     flags |= O_WRONLY;
 #if defined(O_DSYNC)
@@ -1303,9 +1443,16 @@ int osal_openfile(const enum osal_openfile_purpose purpose, const MDBX_env *env,
 #error "Unexpected or unsupported UNIX or POSIX system"
 #endif /* STDIN_FILENO == 0 && STDERR_FILENO == 2 */
 
-  *fd = open(pathname, flags, unix_mode_bits);
+#if defined(MFD_CLOEXEC)
+  if (env->anonymous && (purpose == MDBX_OPEN_DXB_LAZY || purpose == MDBX_OPEN_LCK))
+    /* файлы анонимной БД существуют только в памяти процесса */
+    *fd = memfd_create(pathname, MFD_CLOEXEC);
+  else
+#endif /* MFD_CLOEXEC */
+    *fd = open(pathname, flags, unix_mode_bits);
 #if defined(O_DIRECT)
-  if (*fd < 0 && (flags & O_DIRECT) && (errno == EINVAL || errno == EAFNOSUPPORT)) {
+  if (*fd < 0 && (flags & O_DIRECT) && purpose != MDBX_OPEN_DXB_DIRECT &&
+      (errno == EINVAL || errno == EAFNOSUPPORT)) {
     flags &= ~(O_DIRECT | O_EXCL);
     *fd = open(pathname, flags, unix_mode_bits);
   }
@@ -1534,6 +1681,10 @@ int osal_fsync(mdbx_filehandle_t fd, enum osal_syncmode_bits mode_bits) {
 #endif
 }
 
+#if defined(__linux__) || defined(__gnu_linux__)
+#include <sys/mount.h> /* BLKGETSIZE64 */
+#endif /* Linux */
+
 int osal_filesize(mdbx_filehandle_t fd, uint64_t *length) {
 #if defined(_WIN32) || defined(_WIN64)
   BY_HANDLE_FILE_INFORMATION info;
@@ -1548,6 +1699,11 @@ int osal_filesize(mdbx_filehandle_t fd, uint64_t *length) {
     return errno;
 
   *length = st.st_size;
+#if defined(BLKGETSIZE64)
+  /* размер блочного устройства определяется его ёмкостью */
+  if (S_ISBLK(st.st_mode) && ioctl(fd, BLKGETSIZE64, length))
+    return errno;
+#endif /* BLKGETSIZE64 */
 #endif
   return MDBX_SUCCESS;
 }
@@ -1583,6 +1739,26 @@ int osal_is_pipe(mdbx_filehandle_t fd) {
 #endif
 }
 
+int osal_is_blockdev(mdbx_filehandle_t fd) {
+#if defined(_WIN32) || defined(_WIN64)
+  (void)fd;
+  return MDBX_RESULT_FALSE;
+#else
+  struct stat info;
+  if (fstat(fd, &info))
+    return errno;
+  if (!S_ISBLK(info.st_mode))
+    return MDBX_RESULT_FALSE;
+#if defined(BLKGETSIZE64)
+  return MDBX_RESULT_TRUE;
+#else
+  /* Размещение БД на блочном устройстве поддерживается только в Linux, где ёмкость устройства определяется
+   * посредством BLKGETSIZE64, а отображение устройства в память работает также как для обычного файла. */
+  return MDBX_ENOSYS;
+#endif /* BLKGETSIZE64 */
+#endif
+}
+
 int osal_fsetsize(mdbx_filehandle_t fd, const uint64_t length) {
 #if defined(_WIN32) || defined(_WIN64)
   if (imports.SetFileInformationByHandle) {
@@ -1599,10 +1775,23 @@ int osal_fsetsize(mdbx_filehandle_t fd, const uint64_t length) {
 #else
   STATIC_ASSERT_MSG(sizeof(off_t) >= sizeof(size_t), "libmdbx requires 64-bit file I/O on 64-bit systems");
 
-#if MDBX_USE_FALLOCATE
+#if MDBX_USE_FALLOCATE || defined(BLKGETSIZE64)
   struct stat info;
   if (unlikely(fstat(fd, &info)))
     return errno;
+#endif /* MDBX_USE_FALLOCATE || BLKGETSIZE64 */
+
+#if defined(BLKGETSIZE64)
+  if (S_ISBLK(info.st_mode)) {
+    /* размер блочного устройства не изменяется, достаточно чтобы хватило ёмкости */
+    uint64_t capacity;
+    if (unlikely(ioctl(fd, BLKGETSIZE64, &capacity)))
+      return errno;
+    return (length <= capacity) ? MDBX_SUCCESS : ENOSPC;
+  }
+#endif /* BLKGETSIZE64 */
+
+#if MDBX_USE_FALLOCATE
 
   const uint64_t allocated = UINT64_C(512) * info.st_blocks;
   if (length > allocated) {
@@ -2063,6 +2252,25 @@ static int check_mmap_limit(const size_t limit) {
   return MDBX_SUCCESS;
 }
 
+#if !(defined(_WIN32) || defined(_WIN64))
+/* Для использования больших страниц начало отображения должно быть
+ * выровнено на их размер, так же как и смещения в файле. Поэтому
+ * адресное пространство резервируется с запасом, от которого остается
+ * только выровненная часть, а затем поверх нее отображается файл. */
+static char *mmap_reserve_hugealigned(size_t limit) {
+  const size_t huge = 2 << 20;
+  char *const reserved = mmap(nullptr, limit + huge, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (reserved == MAP_FAILED)
+    return nullptr;
+  char *const aligned = (char *)ceil_powerof2((uintptr_t)reserved, huge);
+  if (aligned > reserved)
+    munmap(reserved, aligned - reserved);
+  if (aligned < reserved + huge)
+    munmap(aligned + limit, reserved + huge - aligned);
+  return aligned;
+}
+#endif /* !Windows */
+
 int osal_mmap(const int flags, osal_mmap_t *map, size_t size, const size_t limit, const unsigned options,
               const pathchar_t *pathname4logging) {
   assert(size <= limit);
@@ -2187,10 +2395,18 @@ int osal_mmap(const int flags, osal_mmap_t *map, size_t size, const size_t limit
 #define MAP_NORESERVE 0
 #endif
 
-  map->base = mmap(nullptr, limit, (flags & MDBX_WRITEMAP) ? PROT_READ | PROT_WRITE : PROT_READ,
+  char *const aligned = (options & MMAP_OPTION_HUGEPAGES) ? mmap_reserve_hugealigned(limit) : nullptr;
+  map->base = mmap(aligned, limit, (flags & MDBX_WRITEMAP) ? PROT_READ | PROT_WRITE : PROT_READ,
                    MAP_SHARED | MAP_FILE | MAP_NORESERVE | (F_ISSET(flags, MDBX_UTTERLY_NOSYNC) ? MAP_NOSYNC : 0) |
-                       ((options & MMAP_OPTION_SEMAPHORE) ? MAP_HASSEMAPHORE | MAP_NOSYNC : MAP_CONCEAL),
+                       ((options & MMAP_OPTION_SEMAPHORE) ? MAP_HASSEMAPHORE | MAP_NOSYNC : MAP_CONCEAL) |
+                       (aligned ? MAP_FIXED : 0),
                    map->fd, 0);
+  if (aligned && map->base == MAP_FAILED) {
+    const int mmap_errno = errno;
+    munmap(aligned, limit);
+    errno = mmap_errno;
+  }
+  map->hugepages = (options & MMAP_OPTION_HUGEPAGES) != 0;
 
   if (unlikely(map->base == MAP_FAILED)) {
     map->limit = 0;
@@ -2206,7 +2422,7 @@ int osal_mmap(const int flags, osal_mmap_t *map, size_t size, const size_t limit
     return errno;
 #endif /* MADV_DONTFORK */
 #ifdef MADV_NOHUGEPAGE
-  (void)madvise(map->base, map->limit, MADV_NOHUGEPAGE);
+  (void)madvise(map->base, map->limit, (options & MMAP_OPTION_HUGEPAGES) ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
 #endif /* MADV_NOHUGEPAGE */
 
 #endif /* ! Windows */
@@ -2474,11 +2690,28 @@ retry_mapview:;
   void *ptr = MAP_FAILED;
 
 #if (defined(__linux__) || defined(__gnu_linux__)) && defined(_GNU_SOURCE)
-  ptr = mremap(map->base, map->limit, limit,
+#if defined(MREMAP_MAYMOVE) && defined(MREMAP_FIXED)
+  if (map->hugepages && (flags & MDBX_MRESIZE_MAY_MOVE)) {
+    /* при перемещении выравнивание на 2 МиБ было бы утрачено, поэтому
+     * сначала пробуем расширить отображение на месте, а иначе перемещаем
+     * его в выровненный резерв */
+    ptr = mremap(map->base, map->limit, limit, 0);
+    char *const aligned = (ptr == MAP_FAILED && errno == ENOMEM) ? mmap_reserve_hugealigned(limit) : nullptr;
+    if (aligned) {
+      ptr = mremap(map->base, map->limit, limit, MREMAP_MAYMOVE | MREMAP_FIXED, aligned);
+      if (ptr == MAP_FAILED) {
+        const int mremap_errno = errno;
+        munmap(aligned, limit);
+        errno = mremap_errno;
+      }
+    }
+  } else
+#endif /* MREMAP_MAYMOVE && MREMAP_FIXED */
+    ptr = mremap(map->base, map->limit, limit,
 #if defined(MREMAP_MAYMOVE)
-               (flags & MDBX_MRESIZE_MAY_MOVE) ? MREMAP_MAYMOVE :
+                 (flags & MDBX_MRESIZE_MAY_MOVE) ? MREMAP_MAYMOVE :
 #endif /* MREMAP_MAYMOVE */
-                                               0);
+                                                 0);
   if (ptr == MAP_FAILED) {
     err = errno;
     assert(err != 0);
@@ -2543,11 +2776,18 @@ retry_mapview:;
       return errno;
     }
 
-    // coverity[pass_freed_arg : FALSE]
-    ptr = mmap(map->base, limit, mmap_prot,
-               (flags & MDBX_MRESIZE_MAY_MOVE) ? mmap_flags
-                                               : mmap_flags | (MAP_FIXED_NOREPLACE ? MAP_FIXED_NOREPLACE : MAP_FIXED),
-               map->fd, 0);
+    char *const aligned =
+        (map->hugepages && (flags & MDBX_MRESIZE_MAY_MOVE)) ? mmap_reserve_hugealigned(limit) : nullptr;
+    if (aligned) {
+      ptr = mmap(aligned, limit, mmap_prot, mmap_flags | MAP_FIXED, map->fd, 0);
+      if (ptr == MAP_FAILED)
+        munmap(aligned, limit);
+    } else
+      // coverity[pass_freed_arg : FALSE]
+      ptr = mmap(map->base, limit, mmap_prot,
+                 (flags & MDBX_MRESIZE_MAY_MOVE) ? mmap_flags
+                                                 : mmap_flags | (MAP_FIXED_NOREPLACE ? MAP_FIXED_NOREPLACE : MAP_FIXED),
+                 map->fd, 0);
     if (MAP_FIXED_NOREPLACE != 0 && MAP_FIXED_NOREPLACE != MAP_FIXED && unlikely(ptr == MAP_FAILED) &&
         !(flags & MDBX_MRESIZE_MAY_MOVE) && errno == /* kernel don't support MAP_FIXED_NOREPLACE */ EINVAL)
       // coverity[pass_freed_arg : FALSE]
@@ -2607,7 +2847,7 @@ retry_mapview:;
   }
 #endif /* MADV_DONTFORK */
 #ifdef MADV_NOHUGEPAGE
-  (void)madvise(map->base, map->limit, MADV_NOHUGEPAGE);
+  (void)madvise(map->base, map->limit, map->hugepages ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
 #endif /* MADV_NOHUGEPAGE */
 
 #endif /* POSIX / Windows */
@@ -2619,6 +2859,32 @@ retry_mapview:;
   return rc;
 }
 
+size_t osal_mmap_hugepages_resident(const osal_mmap_t *map) {
+  size_t bytes = 0;
+#if defined(__linux__) || defined(__gnu_linux__)
+  FILE *const smaps = fopen("/proc/self/smaps", "r");
+  if (smaps) {
+    const uintptr_t begin = (uintptr_t)map->base, end = begin + map->limit;
+    bool inside = false;
+    char line[512];
+    while (fgets(line, sizeof(line), smaps)) {
+      unsigned long long lo, hi, kb;
+      /* заголовок каждой области содержит ее адреса, далее следуют
+       * строки со счетчиками, из которых нужны отображенные через PMD */
+      if (sscanf(line, "%llx-%llx ", &lo, &hi) == 2)
+        inside = lo < end && hi > begin;
+      else if (inside && (sscanf(line, "FilePmdMapped: %llu kB", &kb) == 1 ||
+                          sscanf(line, "ShmemPmdMapped: %llu kB", &kb) == 1))
+        bytes += (size_t)kb << 10;
+    }
+    fclose(smaps);
+  }
+#else
+  (void)map;
+#endif /* Linux */
+  return bytes;
+}
+
 /*----------------------------------------------------------------------------*/
 
 __cold void osal_jitter(bool tiny) {
@@ -198,6 +198,8 @@ typedef struct osal_mmap {
   uint64_t filesize /* in-process cache of a file size */;
 #if defined(_WIN32) || defined(_WIN64)
   HANDLE section; /* memory-mapped section handle */
+#else
+  bool hugepages; /* the mapping is aligned and advised for huge pages */
 #endif
 } osal_mmap_t;
 
@@ -301,6 +303,11 @@ typedef struct osal_ioring {
 #else
 #define ior_last_sgvcnt(ior, item) (1)
 #define ior_last_bytes(ior, item) (item)->single.iov_len
+#endif /* !Windows */
+#if !(defined(_WIN32) || defined(_WIN64))
+  /* дескриптор открытый с O_DIRECT и выровненный буфер для записи через него */
+  mdbx_filehandle_t direct_fd;
+  void *bounce;
 #endif /* !Windows */
   ior_item_t *last;
   ior_item_t *pool;
@@ -312,6 +319,9 @@ MDBX_INTERNAL int osal_ioring_create(osal_ioring_t *
 #if defined(_WIN32) || defined(_WIN64)
                                      ,
                                      bool enable_direct, mdbx_filehandle_t overlapped_fd
+#else
+                                     ,
+                                     mdbx_filehandle_t direct_fd
 #endif /* Windows */
 );
 MDBX_INTERNAL int osal_ioring_resize(osal_ioring_t *, size_t items);
@@ -324,6 +334,17 @@ typedef struct osal_ioring_write_result {
 } osal_ioring_write_result_t;
 MDBX_INTERNAL osal_ioring_write_result_t osal_ioring_write(osal_ioring_t *ior, mdbx_filehandle_t fd);
 
+/* Буферы записываемые через O_DIRECT без копирования должны быть выровнены
+ * на границу системной страницы, см ior_write_direct(). */
+static inline bool osal_ioring_direct(const osal_ioring_t *ior) {
+#if defined(_WIN32) || defined(_WIN64)
+  (void)ior;
+  return false;
+#else
+  return ior->bounce != nullptr;
+#endif /* Windows */
+}
+
 MDBX_INTERNAL void osal_ioring_walk(osal_ioring_t *ior, iov_ctx_t *ctx,
                                     void (*callback)(iov_ctx_t *ctx, size_t offset, void *data, size_t bytes));
 
@@ -435,6 +456,8 @@ MDBX_INTERNAL int osal_memalign_alloc(size_t alignment, size_t bytes, void **res
 #ifndef osal_memalign_free
 MDBX_INTERNAL void osal_memalign_free(void *ptr);
 #endif
+MDBX_INTERNAL void *osal_hugepage_alloc(size_t bytes, bool hugetlb, bool *is_hugetlb);
+MDBX_INTERNAL void osal_hugepage_free(void *ptr, size_t bytes);
 
 MDBX_INTERNAL int osal_condpair_init(osal_condpair_t *condpair);
 MDBX_INTERNAL int osal_condpair_lock(osal_condpair_t *condpair);
@@ -477,6 +500,8 @@ enum osal_openfile_purpose {
 #if defined(_WIN32) || defined(_WIN64)
   MDBX_OPEN_DXB_OVERLAPPED,
   MDBX_OPEN_DXB_OVERLAPPED_DIRECT,
+#else
+  MDBX_OPEN_DXB_DIRECT,
 #endif /* Windows */
   MDBX_OPEN_LCK,
   MDBX_OPEN_DELETE,
@@ -502,16 +527,19 @@ MDBX_INTERNAL int osal_closefile(mdbx_filehandle_t fd);
 MDBX_INTERNAL int osal_removefile(const pathchar_t *pathname);
 MDBX_INTERNAL int osal_removedirectory(const pathchar_t *pathname);
 MDBX_INTERNAL int osal_is_pipe(mdbx_filehandle_t fd);
+MDBX_INTERNAL int osal_is_blockdev(mdbx_filehandle_t fd);
 MDBX_INTERNAL int osal_lockfile(mdbx_filehandle_t fd, bool wait);
 
 #define MMAP_OPTION_SETLENGTH 1
 #define MMAP_OPTION_SEMAPHORE 2
+#define MMAP_OPTION_HUGEPAGES 4
 MDBX_INTERNAL int osal_mmap(const int flags, osal_mmap_t *map, size_t size, const size_t limit, const unsigned options,
                             const pathchar_t *pathname4logging);
 MDBX_INTERNAL int osal_munmap(osal_mmap_t *map);
 #define MDBX_MRESIZE_MAY_MOVE 0x00000100
 #define MDBX_MRESIZE_MAY_UNMAP 0x00000200
 MDBX_INTERNAL int osal_mresize(const int flags, osal_mmap_t *map, size_t size, size_t limit);
+MDBX_INTERNAL size_t osal_mmap_hugepages_resident(const osal_mmap_t *map);
 #if defined(_WIN32) || defined(_WIN64)
 typedef struct {
   unsigned limit, count;
@@ -410,7 +410,7 @@ __cold static __noinline pgr_t check_page_complete(const uint16_t ILL, page_t *p
   if (likely(r.err == MDBX_SUCCESS))
     r.err = page_check(mc, page);
   if (unlikely(r.err != MDBX_SUCCESS))
-    mc->txn->flags |= MDBX_TXN_ERROR;
+    txn_poison(mc->txn, r.err);
   return r;
 }
 
@@ -425,7 +425,7 @@ static __always_inline pgr_t page_get_inline(const uint16_t ILL, const MDBX_curs
     r.page = nullptr;
     r.err = MDBX_PAGE_NOTFOUND;
   bailout:
-    txn->flags |= MDBX_TXN_ERROR;
+    txn_poison(txn, r.err);
     return r;
   }
 
@@ -441,10 +441,9 @@ static __always_inline pgr_t page_get_inline(const uint16_t ILL, const MDBX_curs
       if (unlikely(spiller->flags & MDBX_TXN_SPILLS) && spill_search(spiller, pgno))
         break;
 
-      const size_t i = dpl_search(spiller, pgno);
-      tASSERT(txn, (intptr_t)i > 0);
-      if (spiller->wr.dirtylist->items[i].pgno == pgno) {
-        r.page = spiller->wr.dirtylist->items[i].ptr;
+      page_t *const dp = dpl_find(spiller, pgno);
+      if (dp) {
+        r.page = dp;
         break;
       }
 
@@ -130,6 +130,8 @@ int iov_write(iov_ctx_t *ctx) {
   osal_ioring_write_result_t r = osal_ioring_write(ctx->ior, ctx->fd);
 #if MDBX_ENABLE_PGOP_STAT
   ctx->env->lck->pgops.wops.weak += r.wops;
+  if (ctx->fd == ctx->env->dsync_fd)
+    ctx->env->dsync_stat.writes.weak += r.wops;
 #endif /* MDBX_ENABLE_PGOP_STAT */
   ctx->err = r.err;
   if (unlikely(ctx->err != MDBX_SUCCESS))
@@ -127,11 +127,18 @@ __cold pgr_t __must_check_result page_unspill(MDBX_txn *const txn, const page_t
     ret.err = page_dirty(txn, ret.page, npages);
     if (unlikely(ret.err != MDBX_SUCCESS))
       return ret;
+    txn->wr.spill_stat.unspilled += npages;
+    if (txn->env->options.spill_policy)
+      /* повторное обращение к вытесненной странице (аналог "призрачной"
+       * очереди в 2Q/CLOCK-Pro) переводит её в категорию "горячих" */
+      dpl_label(ret.page)->hits = SPILL_HOT_HITS;
 #if MDBX_ENABLE_PGOP_STAT
     txn->env->lck->pgops.unspill.weak += npages;
 #endif /* MDBX_ENABLE_PGOP_STAT */
     ret.page->flags |= (scan == txn) ? 0 : P_SPILLED;
     ret.err = MDBX_SUCCESS;
+    if (unlikely(txn->wr.undo))
+      ret.err = (scan == txn) ? savepoint_touch(txn, ret.page) : savepoint_cloned(txn, mp->pgno, npages);
     return ret;
   } while (likely((scan = scan->parent) != nullptr && (scan->flags & MDBX_TXN_SPILLS) != 0));
   ERROR("Page %" PRIaPGNO " mod-txnid %" PRIaTXN " not found in the spill-list(s), current txn %" PRIaTXN
@@ -148,10 +155,9 @@ __hot int page_touch_modifable(MDBX_txn *txn, const page_t *const mp) {
   tASSERT(txn, !is_largepage(mp) && !is_subpage(mp));
   tASSERT(txn, (txn->flags & MDBX_WRITEMAP) == 0 || MDBX_AVOID_MSYNC);
 
-  const size_t n = dpl_search(txn, mp->pgno);
-  if (MDBX_AVOID_MSYNC && unlikely(txn->wr.dirtylist->items[n].pgno != mp->pgno)) {
+  page_t *const dp = dpl_find(txn, mp->pgno);
+  if (MDBX_AVOID_MSYNC && unlikely(!dp)) {
     tASSERT(txn, (txn->flags & MDBX_WRITEMAP));
-    tASSERT(txn, n > 0 && n <= txn->wr.dirtylist->length + 1);
     VERBOSE("unspill page %" PRIaPGNO, mp->pgno);
 #if MDBX_ENABLE_PGOP_STAT
     txn->env->lck->pgops.unspill.weak += 1;
@@ -159,11 +165,15 @@ __hot int page_touch_modifable(MDBX_txn *txn, const page_t *const mp) {
     return page_dirty(txn, (page_t *)mp, 1);
   }
 
-  tASSERT(txn, n > 0 && n <= txn->wr.dirtylist->length);
-  tASSERT(txn, txn->wr.dirtylist->items[n].pgno == mp->pgno && txn->wr.dirtylist->items[n].ptr == mp);
+  tASSERT(txn, dp == mp);
   if (!MDBX_AVOID_MSYNC || (txn->flags & MDBX_WRITEMAP) == 0) {
-    size_t *const ptr = ptr_disp(txn->wr.dirtylist->items[n].ptr, -(ptrdiff_t)sizeof(size_t));
-    *ptr = txn->wr.dirtylru;
+    dp_label_t *const label = dpl_label(dp);
+    /* Подобно 2Q коррелированные обращения, следующие друг за другом при
+     * последовательных изменениях одной страницы, не считаются повторными.
+     * Окно корреляции пропорционально размеру списка грязных страниц. */
+    const uint32_t age = txn->wr.dirtylru - label->lru;
+    label->hits += age > (txn->wr.dirtylist->length >> 2) && label->hits < UINT8_MAX;
+    label->lru = txn->wr.dirtylru;
   }
   return MDBX_SUCCESS;
 }
@@ -243,6 +253,13 @@ __hot int page_touch_unmodifable(MDBX_txn *txn, MDBX_cursor *mc, const page_t *c
     rc = page_dirty(txn, np, 1);
     if (unlikely(rc != MDBX_SUCCESS))
       goto fail;
+    if (unlikely(txn->wr.undo)) {
+      rc = savepoint_cloned(txn, np->pgno, 1);
+      if (unlikely(rc != MDBX_SUCCESS))
+        goto fail;
+    }
+    if ((txn->flags & MDBX_WRITEMAP) == 0)
+      dpl_label(np)->hits = dpl_label(mp)->hits;
 
 #if MDBX_ENABLE_PGOP_STAT
     txn->env->lck->pgops.clone.weak += 1;
@@ -275,30 +292,206 @@ done:
   return MDBX_SUCCESS;
 
 fail:
-  txn->flags |= MDBX_TXN_ERROR;
-  return rc;
+  return txn_poison(txn, rc);
+}
+
+/* Теневые копии страниц предваряются указателем на блок slab, из которого
+ * выделена страница (nullptr при выделении посредством malloc), и меткой
+ * dp_label_t, которая используется при выборе страниц для выталкивания.
+ *
+ * При включенной опции MDBX_opt_dp_slab одиночные страницы выделяются из
+ * блоков по 2 МиБ, которые отображаются в память с использованием больших
+ * страниц (MAP_HUGETLB либо Transparent Huge Pages). Это снижает накладные
+ * расходы malloc/free и промахи TLB при больших транзакциях. Многостраничные
+ * буферы для больших значений по-прежнему выделяются посредством malloc,
+ * так как их размер не ограничен, а время жизни как правило коротко.
+ *
+ * Префикс должен непосредственно предварять страницу, поэтому при записи
+ * через O_DIRECT (MDBX_opt_dxb_direct_write) шаг слотов округляется до
+ * системной страницы. Тогда страницы из slab выровнены и записываются без
+ * копирования в промежуточный буфер, ценой неиспользуемого зазора между
+ * ними. Иначе слоты следуют вплотную с выравниванием на строку кэша. */
+#define SHADOW_CHUNK_SIZE ((size_t)2 << 20)
+#define SHADOW_SLOT_PREFIX 64
+#define SHADOW_PREFIX (sizeof(uint64_t) + sizeof(dp_label_t))
+
+typedef struct shadow_chunk {
+  struct shadow_chunk *next, *prev;
+  void *free;
+  size_t used, total, carved, stride, first /* смещение первой страницы */;
+  bool hugetlb;
+} shadow_chunk_t;
+
+static inline shadow_chunk_t **shadow_tag(const page_t *dp) {
+  STATIC_ASSERT(sizeof(shadow_chunk_t *) <= sizeof(uint64_t) && SHADOW_PREFIX % sizeof(uint64_t) == 0);
+  return ptr_disp(dp, -(ptrdiff_t)SHADOW_PREFIX);
+}
+
+static void shadow_chunk_unlink(shadow_chunk_t **list, shadow_chunk_t *chunk) {
+  if (chunk->prev)
+    chunk->prev->next = chunk->next;
+  else
+    *list = chunk->next;
+  if (chunk->next)
+    chunk->next->prev = chunk->prev;
+  chunk->next = chunk->prev = nullptr;
+}
+
+static void shadow_chunk_push(shadow_chunk_t **list, shadow_chunk_t *chunk) {
+  chunk->prev = nullptr;
+  chunk->next = *list;
+  if (chunk->next)
+    chunk->next->prev = chunk;
+  *list = chunk;
+}
+
+static void shadow_chunk_destroy(MDBX_env *env, shadow_chunk_t *chunk) {
+  env->shadow_slab.chunks.weak -= 1;
+  env->shadow_slab.bytes.weak -= SHADOW_CHUNK_SIZE;
+  env->shadow_slab.hugetlb.weak -= chunk->hugetlb;
+  env->shadow_slab.used.weak -= chunk->used;
+  if (chunk->used == 0)
+    env->shadow_slab.spare -= chunk->total;
+  MDBX_ASAN_UNPOISON_MEMORY_REGION(chunk, SHADOW_CHUNK_SIZE);
+  osal_hugepage_free(chunk, SHADOW_CHUNK_SIZE);
+}
+
+static page_t *shadow_slab_alloc(MDBX_env *env) {
+  shadow_chunk_t *chunk = env->shadow_slab.avail;
+  if (unlikely(!chunk)) {
+    bool hugetlb;
+    chunk = osal_hugepage_alloc(SHADOW_CHUNK_SIZE, env->options.dp_slab > 1, &hugetlb);
+    if (unlikely(!chunk))
+      return nullptr;
+    chunk->next = chunk->prev = nullptr;
+    chunk->free = nullptr;
+    chunk->used = chunk->carved = 0;
+    chunk->stride = env->ps + SHADOW_SLOT_PREFIX;
+    chunk->first = ceil_powerof2(sizeof(shadow_chunk_t), SHADOW_SLOT_PREFIX) + SHADOW_SLOT_PREFIX;
+    if (osal_ioring_direct(&env->ioring)) {
+      chunk->stride = ceil_powerof2(chunk->stride, globals.sys_pagesize);
+      chunk->first = ceil_powerof2(chunk->first, globals.sys_pagesize);
+    }
+    chunk->total = (SHADOW_CHUNK_SIZE - chunk->first - env->ps) / chunk->stride + 1;
+    chunk->hugetlb = hugetlb;
+    env->shadow_slab.avail = chunk;
+    env->shadow_slab.chunks.weak += 1;
+    env->shadow_slab.bytes.weak += SHADOW_CHUNK_SIZE;
+    env->shadow_slab.hugetlb.weak += hugetlb;
+    env->shadow_slab.spare += chunk->total;
+  }
+
+  void *slot = chunk->free;
+  if (slot)
+    chunk->free = *(void **)slot;
+  else
+    slot = ptr_disp(chunk, chunk->first - SHADOW_SLOT_PREFIX + chunk->stride * chunk->carved++);
+  if (chunk->used++ == 0)
+    env->shadow_slab.spare -= chunk->total;
+  env->shadow_slab.used.weak += 1;
+  if (chunk->used == chunk->total) {
+    shadow_chunk_unlink(&env->shadow_slab.avail, chunk);
+    shadow_chunk_push(&env->shadow_slab.full, chunk);
+  }
+
+  page_t *const np = ptr_disp(slot, SHADOW_SLOT_PREFIX);
+  MDBX_ASAN_UNPOISON_MEMORY_REGION(np, env->ps);
+  *shadow_tag(np) = chunk;
+  return np;
+}
+
+static void shadow_slab_free(MDBX_env *env, shadow_chunk_t *chunk, page_t *dp) {
+  eASSERT(env, chunk->used > 0 && env->shadow_slab.used.weak > 0);
+  MDBX_ASAN_POISON_MEMORY_REGION(dp, env->ps);
+  void *const slot = ptr_disp(dp, -SHADOW_SLOT_PREFIX);
+  *(void **)slot = chunk->free;
+  chunk->free = slot;
+  env->shadow_slab.used.weak -= 1;
+  if (chunk->used-- == chunk->total) {
+    shadow_chunk_unlink(&env->shadow_slab.full, chunk);
+    /* частично занятые блоки используются в первую очередь */
+    shadow_chunk_push(&env->shadow_slab.avail, chunk);
+  }
+  if (chunk->used == 0) {
+    /* один пустой блок сохраняется всегда, чтобы избежать отображения и
+     * освобождения памяти при каждой небольшой транзакции, остальные пока
+     * их суммарная емкость не превышает MDBX_opt_dp_reserve_limit */
+    if (!env->options.dp_slab ||
+        (env->shadow_slab.spare && env->shadow_slab.spare + chunk->total > env->options.dp_reserve_limit)) {
+      shadow_chunk_unlink(&env->shadow_slab.avail, chunk);
+      env->shadow_slab.spare += chunk->total;
+      shadow_chunk_destroy(env, chunk);
+      return;
+    }
+    env->shadow_slab.spare += chunk->total;
+    if (chunk->next) {
+      /* пустые блоки в конец списка */
+      shadow_chunk_t *tail = chunk->next;
+      while (tail->next)
+        tail = tail->next;
+      shadow_chunk_unlink(&env->shadow_slab.avail, chunk);
+      tail->next = chunk;
+      chunk->prev = tail;
+    }
+  }
+}
+
+void page_shadow_trim(MDBX_env *env, bool all) {
+  while (env->shadow_reserve_len > (all ? 0 : env->options.dp_reserve_limit)) {
+    page_t *const dp = env->shadow_reserve;
+    eASSERT(env, dp != nullptr);
+    MDBX_ASAN_UNPOISON_MEMORY_REGION(dp, env->ps);
+    VALGRIND_MAKE_MEM_DEFINED(&page_next(dp), sizeof(page_t *));
+    env->shadow_reserve = page_next(dp);
+    env->shadow_reserve_len -= 1;
+    osal_free(shadow_tag(dp));
+  }
+
+  shadow_chunk_t *chunk = env->shadow_slab.avail;
+  while (chunk) {
+    shadow_chunk_t *const next = chunk->next;
+    if (chunk->used == 0 && (all || !env->options.dp_slab ||
+                             (env->shadow_slab.spare > chunk->total &&
+                              env->shadow_slab.spare > env->options.dp_reserve_limit))) {
+      shadow_chunk_unlink(&env->shadow_slab.avail, chunk);
+      shadow_chunk_destroy(env, chunk);
+    }
+    chunk = next;
+  }
+  while (all && (chunk = env->shadow_slab.avail) != nullptr) {
+    shadow_chunk_unlink(&env->shadow_slab.avail, chunk);
+    shadow_chunk_destroy(env, chunk);
+  }
+  while (all && (chunk = env->shadow_slab.full) != nullptr) {
+    shadow_chunk_unlink(&env->shadow_slab.full, chunk);
+    shadow_chunk_destroy(env, chunk);
+  }
 }
 
 page_t *page_shadow_alloc(MDBX_txn *txn, size_t num) {
   MDBX_env *env = txn->env;
   page_t *np = env->shadow_reserve;
   size_t size = env->ps;
+  const size_t prefix = SHADOW_PREFIX;
   if (likely(num == 1 && np)) {
     eASSERT(env, env->shadow_reserve_len > 0);
     MDBX_ASAN_UNPOISON_MEMORY_REGION(np, size);
-    VALGRIND_MEMPOOL_ALLOC(env, ptr_disp(np, -(ptrdiff_t)sizeof(size_t)), size + sizeof(size_t));
+    VALGRIND_MEMPOOL_ALLOC(env, ptr_disp(np, -(ptrdiff_t)prefix), size + prefix);
     VALGRIND_MAKE_MEM_DEFINED(&page_next(np), sizeof(page_t *));
     env->shadow_reserve = page_next(np);
     env->shadow_reserve_len -= 1;
+  } else if (num == 1 && env->options.dp_slab && (np = shadow_slab_alloc(env)) != nullptr) {
+    VALGRIND_MEMPOOL_ALLOC(env, ptr_disp(np, -(ptrdiff_t)prefix), size + prefix);
   } else {
     size = pgno2bytes(env, num);
-    void *const ptr = osal_malloc(size + sizeof(size_t));
+    void *const ptr = osal_malloc(size + prefix);
     if (unlikely(!ptr)) {
-      txn->flags |= MDBX_TXN_ERROR;
+      txn_poison(txn, MDBX_ENOMEM);
       return nullptr;
     }
-    VALGRIND_MEMPOOL_ALLOC(env, ptr, size + sizeof(size_t));
-    np = ptr_disp(ptr, sizeof(size_t));
+    VALGRIND_MEMPOOL_ALLOC(env, ptr, size + prefix);
+    np = ptr_disp(ptr, prefix);
+    *shadow_tag(np) = nullptr;
   }
 
   if ((env->flags & MDBX_NOMEMINIT) == 0) {
@@ -324,17 +517,21 @@ void page_shadow_release(MDBX_env *env, page_t *dp, size_t npages) {
   MDBX_ASAN_UNPOISON_MEMORY_REGION(dp, pgno2bytes(env, npages));
   if (unlikely(env->flags & MDBX_PAGEPERTURB))
     memset(dp, -1, pgno2bytes(env, npages));
-  if (likely(npages == 1 && env->shadow_reserve_len < env->options.dp_reserve_limit)) {
+  void *const ptr = shadow_tag(dp);
+  shadow_chunk_t *const chunk = *shadow_tag(dp);
+  VALGRIND_MEMPOOL_FREE(env, ptr);
+  if (chunk) {
+    eASSERT(env, npages == 1);
+    shadow_slab_free(env, chunk, dp);
+  } else if (likely(npages == 1 && !env->options.dp_slab &&
+                    env->shadow_reserve_len < env->options.dp_reserve_limit)) {
     MDBX_ASAN_POISON_MEMORY_REGION(dp, env->ps);
     MDBX_ASAN_UNPOISON_MEMORY_REGION(&page_next(dp), sizeof(page_t *));
     page_next(dp) = env->shadow_reserve;
-    VALGRIND_MEMPOOL_FREE(env, ptr_disp(dp, -(ptrdiff_t)sizeof(size_t)));
     env->shadow_reserve = dp;
     env->shadow_reserve_len += 1;
   } else {
     /* large pages just get freed directly */
-    void *const ptr = ptr_disp(dp, -(ptrdiff_t)sizeof(size_t));
-    VALGRIND_MEMPOOL_FREE(env, ptr);
     osal_free(ptr);
   }
 }
@@ -437,7 +634,7 @@ int page_retire_ex(MDBX_cursor *mc, const pgno_t pgno, page_t *mp /* maybe null
         goto status_done;
       }
       for (MDBX_txn *parent = txn->parent; parent; parent = parent->parent) {
-        if (dpl_exist(parent, pgno)) {
+        if (dpl_find(parent, pgno)) {
           status = shadowed;
           goto status_done;
         }
@@ -504,6 +701,16 @@ status_done:
     mc->tree->large_pages -= (pgno_t)npages;
   }
 
+  if (unlikely(txn->wr.undo) && status != frozen) {
+    /* Пока активны точки сохранения, существовавшие до них страницы нельзя
+     * использовать повторно, поэтому они помещаются в retired-список. */
+    rc = savepoint_retire(mc, pgno, mp, npages, di, si, status == modifable);
+    if (rc == MDBX_SUCCESS)
+      goto retire;
+    if (unlikely(rc != MDBX_RESULT_TRUE))
+      return rc;
+  }
+
   if (status == frozen) {
   retire:
     DEBUG("retire %zu page %" PRIaPGNO, npages, pgno);
@@ -612,7 +819,13 @@ status_done:
 
   reclaim:
     DEBUG("reclaim %zu %s page %" PRIaPGNO, npages, "dirty", pgno);
-    rc = pnl_insert_span(&txn->wr.repnl, pgno, npages);
+    if (likely(cursor_dbi(mc) != FREE_DBI))
+      /* вливание в repnl откладывается до следующего использования, см. gc_merge_deferred() */
+      rc = gc_reclaim_deferred(txn, pgno, npages);
+    else {
+      rc = pnl_insert_span(&txn->wr.repnl, pgno, npages);
+      gc_extents_reset(txn);
+    }
     tASSERT(txn, pnl_check_allocated(txn->wr.repnl, txn->geo.first_unallocated - MDBX_ENABLE_REFUND));
     tASSERT(txn, dpl_check(txn));
     return rc;
@@ -627,7 +840,7 @@ status_done:
      * пролита в этой транзакции, тогда её необходимо поместить в
      * retired-список для последующей фильтрации при коммите. */
     for (MDBX_txn *parent = txn->parent; parent; parent = parent->parent) {
-      if (dpl_exist(parent, pgno))
+      if (dpl_find(parent, pgno))
         goto retire;
     }
     /* Страница точно была выделена в этой транзакции
@@ -686,6 +899,7 @@ __hot int __must_check_result page_dirty(MDBX_txn *txn, page_t *mp, size_t npage
       rc = pnl_insert_span(&txn->wr.repnl, lp->pgno, 1);
       if (unlikely(rc != MDBX_SUCCESS))
         goto bailout;
+      gc_extents_reset(txn);
       size_t di = dpl_search(txn, lp->pgno);
       tASSERT(txn, txn->wr.dirtylist->items[di].ptr == lp);
       dpl_remove(txn, di);
@@ -707,8 +921,7 @@ __hot int __must_check_result page_dirty(MDBX_txn *txn, page_t *mp, size_t npage
   rc = dpl_append(txn, mp->pgno, mp, npages);
   if (unlikely(rc != MDBX_SUCCESS)) {
   bailout:
-    txn->flags |= MDBX_TXN_ERROR;
-    return rc;
+    return txn_poison(txn, rc);
   }
   txn->wr.dirtyroom--;
   tASSERT(txn, dpl_check(txn));
@@ -15,6 +15,7 @@ enum page_search_flags {
   Z_LAST = 8,
 };
 MDBX_INTERNAL int __must_check_result tree_search(MDBX_cursor *mc, const MDBX_val *key, int flags);
+MDBX_INTERNAL int __must_check_result tree_search_finger(MDBX_cursor *mc, const MDBX_val *key, const bool rightward);
 
 #define MDBX_SPLIT_REPLACE MDBX_APPENDDUP /* newkey is not new */
 MDBX_INTERNAL int __must_check_result page_split(MDBX_cursor *mc, const MDBX_val *const newkey, MDBX_val *const newdata,
@@ -88,6 +89,11 @@ static inline int page_touch(MDBX_cursor *mc) {
   }
 
   if (is_modifable(txn, mp)) {
+    if (unlikely(txn->wr.undo) && !is_subpage(mp)) {
+      const int err = savepoint_touch(txn, mp);
+      if (unlikely(err != MDBX_SUCCESS))
+        return err;
+    }
     if (!txn->wr.dirtylist) {
       tASSERT(txn, (txn->flags & MDBX_WRITEMAP) && !MDBX_AVOID_MSYNC);
       return MDBX_SUCCESS;
@@ -104,6 +110,8 @@ MDBX_INTERNAL page_t *page_shadow_alloc(MDBX_txn *txn, size_t num);
 
 MDBX_INTERNAL void page_shadow_release(MDBX_env *env, page_t *dp, size_t npages);
 
+MDBX_INTERNAL void page_shadow_trim(MDBX_env *env, bool all);
+
 MDBX_INTERNAL int page_retire_ex(MDBX_cursor *mc, const pgno_t pgno, page_t *mp /* maybe null */,
                                  unsigned pageflags /* maybe unknown/zero */);
 
@@ -256,3 +256,115 @@ size_t pnl_maxspan(const pnl_t pnl) {
   }
   return len;
 }
+
+/* Проверяет, что страница item отстоит от edge на i позиций в направлении step по упорядоченному PNL. */
+static inline bool pnl_adjacent(const pgno_t *edge, const ptrdiff_t step, const size_t i) {
+  const pgno_t expect = (MDBX_PNL_ASCENDING == (step > 0)) ? edge[0] + (pgno_t)i : edge[0] - (pgno_t)i;
+  return edge[step * (ptrdiff_t)i] == expect;
+}
+
+/* Длина последовательности смежных страниц от edge в направлении step, но не более avail. Для упорядоченного PNL
+ * смежность i-го элемента означает смежность всех предыдущих, поэтому используется экспоненциальный и затем
+ * бинарный поиск, т.е. O(log(длина)) вместо O(длина). */
+static size_t pnl_run(const pgno_t *edge, const ptrdiff_t step, const size_t avail) {
+  size_t good = 0, probe = 1;
+  while (probe < avail && pnl_adjacent(edge, step, probe)) {
+    good = probe;
+    probe += probe;
+  }
+  size_t bad = (probe < avail) ? probe : avail;
+  while (bad - good > 1) {
+    const size_t middle = (good + bad) >> 1;
+    if (pnl_adjacent(edge, step, middle))
+      good = middle;
+    else
+      bad = middle;
+  }
+  return good + 1;
+}
+
+static inline size_t pnl_run_words(const size_t run) { return (run < MDBX_PNL_PACKED_MINRUN) ? run : 2; }
+
+__hot size_t pnl_packed_size(const pgno_t *begin, const pgno_t *end) {
+  size_t words = 0;
+  while (begin < end) {
+    const size_t run = pnl_run(begin, 1, end - begin);
+    words += pnl_run_words(run);
+    begin += run;
+  }
+  return words;
+}
+
+size_t pnl_pack(pgno_t *dst, const pgno_t *begin, const pgno_t *end) {
+  size_t w = 0;
+  bool packed = false;
+  while (begin < end) {
+    const size_t run = pnl_run(begin, 1, end - begin);
+    if (run < MDBX_PNL_PACKED_MINRUN) {
+      for (size_t i = 0; i < run; ++i)
+        dst[++w] = begin[i];
+    } else {
+      dst[++w] = begin[0];
+      dst[++w] = MDBX_PNL_PACKED | (pgno_t)(run - 1);
+      packed = true;
+    }
+    begin += run;
+  }
+  dst[0] = packed ? MDBX_PNL_PACKED | (pgno_t)w : (pgno_t)w;
+  return w;
+}
+
+size_t pnl_pack_fit(const pgno_t *begin, const pgno_t *end, const size_t limit, const bool backward,
+                    size_t *words) {
+  const ptrdiff_t step = backward ? -1 : 1;
+  const pgno_t *edge = backward ? end - 1 : begin;
+  size_t pages = 0, used = 0, avail = end - begin;
+  while (avail) {
+    const size_t run = pnl_run(edge, step, avail);
+    const size_t cost = pnl_run_words(run);
+    if (used + cost > limit) {
+      if (run < MDBX_PNL_PACKED_MINRUN) {
+        /* короткую последовательность можно разделить без дополнительных расходов */
+        pages += limit - used;
+        used = limit;
+      }
+      break;
+    }
+    pages += run;
+    used += cost;
+    avail -= run;
+    edge += step * (ptrdiff_t)run;
+  }
+  *words = used;
+  return pages;
+}
+
+__hot bool pnl_packed_check(const const_pnl_t pnl, const size_t bytes, const size_t limit) {
+  assert(limit >= MIN_PAGENO - MDBX_ENABLE_REFUND);
+  if (unlikely(bytes < sizeof(pgno_t) || (pnl_packed_len(pnl) + 1) * sizeof(pgno_t) > bytes))
+    return false;
+  if (!pnl_is_packed(pnl))
+    return pnl_check(pnl, limit);
+
+  const size_t len = pnl_packed_len(pnl);
+  size_t npages = 0;
+  pgno_t last = 0;
+  for (size_t i = 1; i <= len; ++i) {
+    const pgno_t item = pnl[i];
+    if (item & MDBX_PNL_PACKED) {
+      const size_t span = item & ~MDBX_PNL_PACKED;
+      if (unlikely(i == 1 || (pnl[i - 1] & MDBX_PNL_PACKED) || span < MDBX_PNL_PACKED_MINRUN - 1))
+        return false;
+      if (MDBX_PNL_ASCENDING ? last + span >= limit : last < MIN_PAGENO + span)
+        return false;
+      last = MDBX_PNL_ASCENDING ? last + (pgno_t)span : last - (pgno_t)span;
+      npages += span;
+    } else {
+      if (unlikely(item < MIN_PAGENO || item >= limit || (i > 1 && !MDBX_PNL_ORDERED(last, item))))
+        return false;
+      last = item;
+      npages += 1;
+    }
+  }
+  return npages <= PAGELIST_LIMIT;
+}
@@ -160,3 +160,77 @@ MDBX_NOTHROW_PURE_FUNCTION MDBX_MAYBE_UNUSED static inline size_t pnl_search(con
 MDBX_INTERNAL size_t pnl_merge(pnl_t dst, const pnl_t src);
 
 MDBX_MAYBE_UNUSED MDBX_NOTHROW_PURE_FUNCTION MDBX_INTERNAL size_t pnl_maxspan(const pnl_t pnl);
+
+/* Упакованный PNL для записей GC (при включенной опции MDBX_opt_gc_extents).
+ *
+ * Если в первом элементе установлен бит MDBX_PNL_PACKED, то младшие биты задают количество последующих элементов,
+ * а последовательность из L >= MDBX_PNL_PACKED_MINRUN смежных страниц представлена парой элементов: номером первой
+ * страницы и MDBX_PNL_PACKED | (L - 1). Остальные номера страниц хранятся как есть, в порядке сортировки PNL.
+ * Номера страниц не превышают MAX_PAGENO, поэтому старший бит в них не бывает установлен. Записи без
+ * последовательностей не упаковываются. Упакованные записи помещаются в GC только после пометки всех мета-страниц
+ * форматом MDBX_DATA_MAGIC_GC_EXTENTS, с которым прежние версии отказываются открывать БД. */
+#define MDBX_PNL_PACKED UINT32_C(0x80000000)
+#define MDBX_PNL_PACKED_MINRUN 3
+
+MDBX_MAYBE_UNUSED MDBX_NOTHROW_PURE_FUNCTION static inline bool pnl_is_packed(const_pnl_t pnl) {
+  return (pnl[0] & MDBX_PNL_PACKED) != 0;
+}
+
+/* Количество элементов после заголовка, как для упакованного, так и для обычного PNL. */
+MDBX_MAYBE_UNUSED MDBX_NOTHROW_PURE_FUNCTION static inline size_t pnl_packed_len(const_pnl_t pnl) {
+  return pnl[0] & ~MDBX_PNL_PACKED;
+}
+
+MDBX_MAYBE_UNUSED MDBX_NOTHROW_PURE_FUNCTION static inline size_t pnl_packed_npages(const_pnl_t pnl) {
+  const size_t len = pnl_packed_len(pnl);
+  size_t npages = len;
+  if (pnl_is_packed(pnl)) {
+    for (size_t i = 1; i <= len; ++i)
+      if (pnl[i] & MDBX_PNL_PACKED)
+        npages += (pnl[i] & ~MDBX_PNL_PACKED) - 1;
+  }
+  return npages;
+}
+
+/* Распаковывает номера страниц в dst, которого должно хватать для pnl_packed_npages() элементов. */
+MDBX_MAYBE_UNUSED static inline size_t pnl_unpack(pgno_t *dst, const_pnl_t pnl) {
+  const size_t len = pnl_packed_len(pnl);
+  if (!pnl_is_packed(pnl)) {
+    memcpy(dst, pnl + 1, len * sizeof(pgno_t));
+    return len;
+  }
+  pgno_t *w = dst;
+  for (size_t i = 1; i <= len; ++i) {
+    if ((pnl[i] & MDBX_PNL_PACKED) == 0)
+      *w++ = pnl[i];
+    else if (likely(w > dst)) {
+      const pgno_t first = w[-1], span = pnl[i] & ~MDBX_PNL_PACKED;
+      for (pgno_t n = 1; n <= span; ++n)
+        *w++ = MDBX_PNL_ASCENDING ? first + n : first - n;
+    }
+  }
+  return w - dst;
+}
+
+MDBX_MAYBE_UNUSED MDBX_NOTHROW_PURE_FUNCTION static inline pgno_t pnl_packed_most(const_pnl_t pnl) {
+  assert(pnl_packed_len(pnl) > 0);
+#if MDBX_PNL_ASCENDING
+  const size_t len = pnl_packed_len(pnl);
+  return (pnl[len] & MDBX_PNL_PACKED) ? pnl[len - 1] + (pnl[len] & ~MDBX_PNL_PACKED) : pnl[len];
+#else
+  return pnl[1];
+#endif
+}
+
+MDBX_NOTHROW_PURE_FUNCTION MDBX_INTERNAL bool pnl_packed_check(const const_pnl_t pnl, const size_t bytes,
+                                                               const size_t limit);
+
+/* Количество элементов упакованного представления упорядоченного участка PNL. */
+MDBX_NOTHROW_PURE_FUNCTION MDBX_INTERNAL size_t pnl_packed_size(const pgno_t *begin, const pgno_t *end);
+
+MDBX_INTERNAL size_t pnl_pack(pgno_t *dst, const pgno_t *begin, const pgno_t *end);
+
+/* Возвращает количество страниц с начала (либо с конца при backward) участка PNL, упакованное представление которых
+ * помещается в limit элементов. Последовательности не разрезаются, поэтому недобор составляет не более элемента. */
+MDBX_INTERNAL size_t pnl_pack_fit(const pgno_t *begin, const pgno_t *end, const size_t limit, const bool backward,
+                                  size_t *words);
@@ -368,6 +368,7 @@
 
 #if defined(__linux__) || defined(__gnu_linux__)
 #include <sched.h>
+#include <sys/ioctl.h>
 #include <sys/sendfile.h>
 #include <sys/statfs.h>
 #endif /* Linux */
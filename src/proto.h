@@ -26,6 +26,27 @@ enum resize_mode { implicit_grow, impilict_shrink, explicit_resize };
 MDBX_INTERNAL int __must_check_result dxb_resize(MDBX_env *const env, const pgno_t used_pgno, const pgno_t size_pgno,
                                                  pgno_t limit_pgno, const enum resize_mode mode);
 MDBX_INTERNAL int dxb_set_readahead(const MDBX_env *env, const pgno_t edge, const bool enable, const bool force_whole);
+MDBX_INTERNAL void dxb_prefetch(const MDBX_env *env, const pgno_t pgno, const size_t npages);
+MDBX_INTERNAL bool dxb_hugepages(const MDBX_env *env);
+MDBX_INTERNAL uint64_t dxb_hugepages_resident(const MDBX_env *env);
+#if DXB_PREALLOCATE
+MDBX_INTERNAL void dxb_preallocate(MDBX_env *env, const geo_t *geo);
+MDBX_INTERNAL void dxb_preallocate_shrink(MDBX_env *env, uint64_t filesize);
+MDBX_INTERNAL void dxb_preallocate_stop(MDBX_env *env, bool resurrect_after_fork);
+#else
+static inline void dxb_preallocate(MDBX_env *env, const geo_t *geo) {
+  (void)env;
+  (void)geo;
+}
+static inline void dxb_preallocate_shrink(MDBX_env *env, uint64_t filesize) {
+  (void)env;
+  (void)filesize;
+}
+static inline void dxb_preallocate_stop(MDBX_env *env, bool resurrect_after_fork) {
+  (void)env;
+  (void)resurrect_after_fork;
+}
+#endif /* DXB_PREALLOCATE */
 MDBX_INTERNAL int __must_check_result dxb_sync_locked(MDBX_env *env, unsigned flags, meta_t *const pending,
                                                       troika_t *const troika);
 #if defined(ENABLE_MEMCHECK) || defined(__SANITIZE_ADDRESS__)
@@ -63,6 +84,7 @@ struct commit_timestamp {
 MDBX_INTERNAL bool txn_refund(MDBX_txn *txn);
 MDBX_INTERNAL bool txn_gc_detent(const MDBX_txn *const txn);
 MDBX_INTERNAL int txn_check_badbits_parked(const MDBX_txn *txn, int bad_bits);
+MDBX_INTERNAL int txn_poison(MDBX_txn *txn, int err);
 MDBX_INTERNAL void txn_done_cursors(MDBX_txn *txn);
 MDBX_INTERNAL int txn_shadow_cursors(const MDBX_txn *parent, const size_t dbi);
 
@@ -0,0 +1,534 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+/// \author Леонид Юрьев aka Leonid Yuriev <leo@yuriev.ru> \date 2015-2025
+
+#include "internals.h"
+
+/*------------------------------------------------------------------------------
+ * Точки сохранения внутри пишущей транзакции.
+ *
+ * Вложенная транзакция позволяет отменить часть изменений, но при старте
+ * копирует состояние родителя и теневые курсоры, а при фиксации сливает
+ * списки страниц в txn_merge(). Для частого сценария "попробовать и, возможно,
+ * откатить" это слишком дорого, поэтому точка сохранения запоминает только
+ * записи таблиц (корни и счетчики страниц), а далее ведется журнал отката:
+ *  - undo_allocated: страница выделена после точки сохранения,
+ *    при откате она возвращается в repnl;
+ *  - undo_cloned: во вложенной транзакции создана копия грязной страницы
+ *    родителя, при откате копия просто удаляется;
+ *  - undo_preimage: впервые после точки сохранения изменяется грязная
+ *    страница, поэтому сохраняется её прежнее содержимое.
+ *
+ * Страницы, которые не были свободны в момент создания точки сохранения, пока
+ * она активна не используются повторно, а помещаются в retired-список, который
+ * при откате усекается. Поэтому при отсутствии отката расходы сводятся к учету
+ * первого изменения каждой грязной страницы и поиску в хеш-индексе журнала.
+ *
+ * Не отменяются изменения размера файла БД, закрытие хендлов таблиц и т.п.,
+ * а все курсоры транзакции при откате сбрасываются в неустановленное
+ * состояние. Удаление и переименование таблиц, а также запуск вложенных
+ * транзакций, при наличии точек сохранения не допускаются. */
+
+enum undo_kind { undo_allocated, undo_cloned, undo_preimage };
+
+typedef struct undo_item {
+  pgno_t pgno, npages;
+  unsigned kind;
+  page_t *preimage;
+} undo_item_t;
+
+typedef struct savepoint {
+  size_t start;   /* первый относящийся к точке элемент журнала */
+  size_t retired; /* длина retired-списка */
+  size_t n_dbi;
+  MDBX_canary canary;
+  tree_t *dbs; /* далее размещаются копии dbi_seqs[] и dbi_state[] */
+} savepoint_t;
+
+struct undo {
+  size_t depth, limit;
+  savepoint_t *stack;
+  size_t count, allocated;
+  undo_item_t *items;
+  /* последний элемент журнала для каждой страницы, номер элемента + 1 */
+  uint32_t *index;
+  size_t index_mask;
+  bool broken;
+  /* ошибка, из-за которой транзакция помечена MDBX_TXN_ERROR */
+  int poison;
+};
+
+static inline size_t undo_slot(const undo_t *undo, pgno_t pgno) {
+  return (size_t)((pgno * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & undo->index_mask;
+}
+
+static undo_item_t *undo_lookup(const undo_t *undo, pgno_t pgno) {
+  if (likely(undo->index))
+    for (size_t i = undo_slot(undo, pgno); undo->index[i]; i = (i + 1) & undo->index_mask) {
+      undo_item_t *const item = undo->items + undo->index[i] - 1;
+      if (item->pgno == pgno)
+        return item;
+    }
+  return nullptr;
+}
+
+static void undo_index_put(undo_t *undo, size_t n) {
+  const pgno_t pgno = undo->items[n].pgno;
+  size_t i = undo_slot(undo, pgno);
+  while (undo->index[i] && undo->items[undo->index[i] - 1].pgno != pgno)
+    i = (i + 1) & undo->index_mask;
+  undo->index[i] = (uint32_t)n + 1;
+}
+
+static int undo_index_rebuild(undo_t *undo, size_t wanna) {
+  size_t capacity = 256;
+  while (capacity < wanna * 2)
+    capacity <<= 1;
+  if (!undo->index || capacity != undo->index_mask + 1) {
+    uint32_t *const index = osal_malloc(capacity * sizeof(uint32_t));
+    if (unlikely(!index))
+      return MDBX_ENOMEM;
+    osal_free(undo->index);
+    undo->index = index;
+    undo->index_mask = capacity - 1;
+  }
+  memset(undo->index, 0, capacity * sizeof(uint32_t));
+  for (size_t n = 0; n < undo->count; ++n)
+    undo_index_put(undo, n);
+  return MDBX_SUCCESS;
+}
+
+/* Элемент журнала относится к последней (текущей) точке сохранения */
+static inline bool undo_recent(const undo_t *undo, const undo_item_t *item) {
+  return item && (size_t)(item - undo->items) >= undo->stack[undo->depth - 1].start;
+}
+
+/* После этих ошибок состояние транзакции не нарушено и полностью
+ * восстанавливается откатом к точке сохранения. */
+static inline bool undo_recoverable(int err) {
+  return err == MDBX_MAP_FULL || err == MDBX_TXN_FULL || err == MDBX_KEYEXIST;
+}
+
+static int undo_failed(MDBX_txn *txn, int err) {
+  txn->wr.undo->broken = true;
+  return txn_poison(txn, err);
+}
+
+static int undo_append(MDBX_txn *txn, pgno_t pgno, size_t npages, unsigned kind, page_t *preimage) {
+  undo_t *const undo = txn->wr.undo;
+  tASSERT(txn, undo->depth > 0 && !undo->broken);
+  if (unlikely(undo->count == undo->allocated)) {
+    const size_t allocated = undo->allocated ? undo->allocated * 2 : 256;
+    undo_item_t *const items = (allocated < UINT32_MAX) ? osal_realloc(undo->items, allocated * sizeof(undo_item_t))
+                                                        : nullptr;
+    if (unlikely(!items))
+      goto bailout;
+    undo->items = items;
+    undo->allocated = allocated;
+  }
+  if (unlikely((undo->count + 1) * 2 > undo->index_mask + 1) &&
+      unlikely(undo_index_rebuild(undo, undo->count + 1) != MDBX_SUCCESS))
+    goto bailout;
+
+  undo_item_t *const item = undo->items + undo->count;
+  item->pgno = pgno;
+  item->npages = (pgno_t)npages;
+  item->kind = kind;
+  item->preimage = preimage;
+  undo_index_put(undo, undo->count++);
+  return MDBX_SUCCESS;
+
+bailout:
+  if (preimage)
+    page_shadow_release(txn->env, preimage, npages);
+  return undo_failed(txn, MDBX_ENOMEM);
+}
+
+static int undo_preserve(MDBX_txn *txn, const page_t *mp, size_t npages) {
+  page_t *const preimage = page_shadow_alloc(txn, npages);
+  if (unlikely(!preimage))
+    return undo_failed(txn, MDBX_ENOMEM);
+  if (npages == 1)
+    page_copy(preimage, mp, txn->env->ps);
+  else
+    memcpy(preimage, mp, pgno2bytes(txn->env, npages));
+  return undo_append(txn, mp->pgno, npages, undo_preimage, preimage);
+}
+
+int savepoint_allocated(MDBX_txn *txn, pgno_t pgno, size_t npages) {
+  undo_item_t *const item = undo_lookup(txn->wr.undo, pgno);
+  if (undo_recent(txn->wr.undo, item) && item->kind == undo_allocated) {
+    /* страница повторно выделена после освобождения, важен только последний размер */
+    item->npages = (pgno_t)npages;
+    return MDBX_SUCCESS;
+  }
+  return undo_append(txn, pgno, npages, undo_allocated, nullptr);
+}
+
+int savepoint_cloned(MDBX_txn *txn, pgno_t pgno, size_t npages) {
+  return undo_append(txn, pgno, npages, undo_cloned, nullptr);
+}
+
+int savepoint_touch(MDBX_txn *txn, const page_t *mp) {
+  const undo_t *const undo = txn->wr.undo;
+  if (undo_recent(undo, undo_lookup(undo, mp->pgno)))
+    return MDBX_SUCCESS;
+  return undo_preserve(txn, mp, is_largepage(mp) ? mp->pages : 1);
+}
+
+int savepoint_retire(MDBX_cursor *mc, pgno_t pgno, page_t *mp, size_t npages, size_t di, size_t si,
+                     bool modifable) {
+  MDBX_txn *const txn = mc->txn;
+  const undo_t *const undo = txn->wr.undo;
+  const undo_item_t *const item = undo_lookup(undo, pgno);
+  if (undo_recent(undo, item) && item->kind == undo_allocated)
+    /* страница выделена после точки сохранения и может быть освобождена как обычно */
+    return MDBX_RESULT_TRUE;
+
+  if (modifable || si) {
+    if (!undo_recent(undo, item)) {
+      if (!mp) {
+        const pgr_t pg = page_get_any(mc, pgno, txn->front_txnid);
+        if (unlikely(pg.err != MDBX_SUCCESS))
+          return pg.err;
+        mp = pg.page;
+      }
+      const int err = undo_preserve(txn, mp, npages);
+      if (unlikely(err != MDBX_SUCCESS))
+        return err;
+    }
+    if (modifable)
+      page_wash(txn, di, mp, npages);
+    else
+      spill_remove(txn, si, npages);
+  }
+  return MDBX_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+#define UNDO_KEY_ORDER(a, b) ((a) < (b))
+SORT_IMPL(undo_key_sort, false, uint64_t, UNDO_KEY_ORDER)
+SEARCH_IMPL(undo_key_bsearch, uint64_t, uint64_t, UNDO_KEY_ORDER)
+
+static inline bool undo_repnl_contains(const MDBX_txn *txn, pgno_t pgno) {
+  const pnl_t pnl = txn->wr.repnl;
+  const size_t n = pnl_search(pnl, pgno, txn->geo.first_unallocated);
+  return n <= pnl_size(pnl) && pnl[n] == pgno;
+}
+
+/* Возвращает в repnl выделенные после точки сохранения страницы.
+ *
+ * Страницы обрабатываются в порядке возрастания номеров, поэтому многостраничный
+ * участок освобождается раньше вложенных в него страниц, которые могли выделяться
+ * и освобождаться ранее. Для каждой страницы используется последний размер. */
+static int undo_release_allocated(MDBX_txn *txn, uint64_t *keys, size_t *count) {
+  const undo_t *const undo = txn->wr.undo;
+  const dpl_t *const dl = txn->wr.dirtylist;
+  undo_key_sort(keys, keys + *count);
+
+  int err = MDBX_SUCCESS;
+  pgno_t covered = 0;
+  size_t w = 0;
+  for (size_t r = 0; r < *count; ++r) {
+    const pgno_t pgno = (pgno_t)(keys[r] >> 32);
+    if (r + 1 < *count && (pgno_t)(keys[r + 1] >> 32) == pgno)
+      continue;
+    size_t npages = undo->items[(uint32_t)keys[r]].npages;
+    keys[w++] = (uint64_t)pgno << 32;
+    if (pgno < covered || pgno >= txn->geo.first_unallocated || undo_repnl_contains(txn, pgno))
+      continue;
+
+    if (dl) {
+      const size_t di = dpl_exist(txn, pgno);
+      if (di) {
+        page_t *const dp = dl->items[di].ptr;
+        if (dp->flags == P_LOOSE)
+          continue;
+        npages = dpl_npages(dl, di);
+        page_wash(txn, di, dp, npages);
+        goto reclaim;
+      }
+    }
+    if (txn->flags & MDBX_WRITEMAP) {
+      page_t *const mp = pgno2page(txn->env, pgno);
+      if (mp->flags == P_LOOSE)
+        continue;
+      if (mp->txnid == txn->front_txnid)
+        page_wash(txn, 0, mp, npages);
+    } else {
+      const size_t si = spill_search(txn, pgno);
+      if (si)
+        spill_remove(txn, si, npages);
+    }
+    /* иначе страница была помещена в retired-список, который будет усечен */
+
+  reclaim:
+    covered = pgno + (pgno_t)npages;
+    err = gc_reclaim_deferred(txn, pgno, npages);
+    if (unlikely(err != MDBX_SUCCESS))
+      break;
+  }
+  *count = w;
+  return (err == MDBX_SUCCESS) ? gc_merge_deferred(txn) : err;
+}
+
+static void undo_uncloned(MDBX_txn *txn, const undo_item_t *item) {
+  tASSERT(txn, txn->parent && (txn->flags & MDBX_WRITEMAP) == 0);
+  dpl_t *const dl = txn->wr.dirtylist;
+  const size_t di = dpl_exist(txn, item->pgno);
+  if (di)
+    page_wash(txn, di, dl->items[di].ptr, dpl_npages(dl, di));
+  else {
+    const size_t si = spill_search(txn, item->pgno);
+    if (si)
+      spill_remove(txn, si, item->npages);
+  }
+}
+
+static int undo_restore(MDBX_txn *txn, undo_item_t *item) {
+  MDBX_env *const env = txn->env;
+  page_t *const preimage = item->preimage;
+  const size_t npages = item->npages;
+  item->preimage = nullptr;
+  preimage->txnid = txn->front_txnid;
+
+  if (txn->flags & MDBX_WRITEMAP) {
+    page_t *const dst = pgno2page(env, item->pgno);
+    const bool dirty = dst->txnid == txn->front_txnid;
+    MDBX_ASAN_UNPOISON_MEMORY_REGION(dst, pgno2bytes(env, npages));
+    VALGRIND_MAKE_MEM_DEFINED(dst, pgno2bytes(env, npages));
+    memcpy(dst, preimage, pgno2bytes(env, npages));
+    page_shadow_release(env, preimage, npages);
+    if (!dirty) {
+      if (txn->wr.dirtylist)
+        return page_dirty(txn, dst, npages);
+      txn->wr.writemap_dirty_npages += npages;
+    }
+    return MDBX_SUCCESS;
+  }
+
+  const size_t di = dpl_exist(txn, item->pgno);
+  if (di) {
+    page_t *const dst = txn->wr.dirtylist->items[di].ptr;
+    tASSERT(txn, dst->flags != P_LOOSE && dpl_npages(txn->wr.dirtylist, di) == npages);
+    if (npages == 1)
+      page_copy(dst, preimage, env->ps);
+    else
+      memcpy(dst, preimage, pgno2bytes(env, npages));
+    page_shadow_release(env, preimage, npages);
+    return MDBX_SUCCESS;
+  }
+
+  const size_t si = spill_search(txn, item->pgno);
+  if (si)
+    spill_remove(txn, si, npages);
+  if (!txn->wr.dirtyroom && !txn->wr.loose_pages) {
+    const int err = txn_spill(txn, nullptr, npages);
+    if (unlikely(err != MDBX_SUCCESS)) {
+      page_shadow_release(env, preimage, npages);
+      return err;
+    }
+  }
+  return page_dirty(txn, preimage, npages);
+}
+
+static int undo_restore_tables(MDBX_txn *txn, const savepoint_t *sp) {
+  const tree_t *const dbs = sp->dbs;
+  const uint32_t *const seqs = (const uint32_t *)(dbs + sp->n_dbi);
+  const uint8_t *const state = (const uint8_t *)(seqs + sp->n_dbi);
+
+  /* GC не изменяется до фиксации транзакции */
+  txn->dbs[MAIN_DBI] = dbs[MAIN_DBI];
+  txn->dbi_state[MAIN_DBI] = state[MAIN_DBI];
+  TXN_FOREACH_DBI_USER(txn, dbi) {
+    const uint8_t current = txn->dbi_state[dbi];
+    if (dbi < sp->n_dbi && (state[dbi] & DBI_VALID) && seqs[dbi] == txn->dbi_seqs[dbi]) {
+      txn->dbs[dbi] = dbs[dbi];
+      txn->dbi_state[dbi] = state[dbi];
+    } else if (dbi < sp->n_dbi && (state[dbi] & (DBI_VALID | DBI_DIRTY)) == (DBI_VALID | DBI_DIRTY)) {
+      ERROR("unable to restore the changed table %zu handle", dbi);
+      return MDBX_PROBLEM;
+    } else if (current & DBI_CREAT) {
+      /* таблица создана после точки сохранения, а её запись в MainDB отменена */
+      txn->dbi_state[dbi] = DBI_LINDO | DBI_OLDEN;
+      const int err = osal_fastmutex_acquire(&txn->env->dbi_lock);
+      if (unlikely(err != MDBX_SUCCESS))
+        return err;
+      dbi_close_release(txn->env, (MDBX_dbi)dbi);
+    } else if (current & DBI_VALID)
+      /* запись таблицы будет перечитана из восстановленной MainDB */
+      txn->dbi_state[dbi] = (current & ~DBI_DIRTY) | DBI_STALE;
+  }
+  return MDBX_SUCCESS;
+}
+
+static int undo_revert(MDBX_txn *txn, const savepoint_t *sp) {
+  undo_t *const undo = txn->wr.undo;
+
+  /* курсоры могут указывать на отменяемые страницы */
+  TXN_FOREACH_DBI_ALL(txn, dbi) {
+    for (MDBX_cursor *mc = txn->cursors[dbi]; mc; mc = mc->next)
+      be_poor(mc);
+  }
+
+  int err = gc_merge_deferred(txn);
+  if (unlikely(err != MDBX_SUCCESS))
+    return err;
+
+  size_t n_allocated = 0;
+  for (size_t i = sp->start; i < undo->count; ++i)
+    n_allocated += undo->items[i].kind == undo_allocated;
+  uint64_t *keys = nullptr;
+  if (n_allocated) {
+    keys = osal_malloc(n_allocated * sizeof(uint64_t));
+    if (unlikely(!keys))
+      return MDBX_ENOMEM;
+    n_allocated = 0;
+    for (size_t i = sp->start; i < undo->count; ++i)
+      if (undo->items[i].kind == undo_allocated)
+        keys[n_allocated++] = (uint64_t)undo->items[i].pgno << 32 | i;
+    err = undo_release_allocated(txn, keys, &n_allocated);
+  }
+
+  /* В обратном порядке, чтобы в итоге восстанавливалось самое раннее содержимое */
+  for (size_t i = undo->count; err == MDBX_SUCCESS && i > sp->start;) {
+    undo_item_t *const item = undo->items + --i;
+    if (item->kind == undo_cloned)
+      undo_uncloned(txn, item);
+    else if (item->kind == undo_preimage) {
+      const uint64_t key = (uint64_t)item->pgno << 32;
+      const uint64_t *const it = n_allocated ? undo_key_bsearch(keys, n_allocated, key) : nullptr;
+      if (it && it < keys + n_allocated && *it == key) {
+        /* страница была свободна в момент создания точки сохранения */
+        page_shadow_release(txn->env, item->preimage, item->npages);
+        item->preimage = nullptr;
+      } else
+        err = undo_restore(txn, item);
+    }
+    undo->count = i;
+  }
+  osal_free(keys);
+  if (unlikely(err != MDBX_SUCCESS))
+    return err;
+
+  if (txn->wr.retired_pages)
+    pnl_setsize(txn->wr.retired_pages, sp->retired);
+  txn->canary = sp->canary;
+  err = undo_restore_tables(txn, sp);
+  if (unlikely(err != MDBX_SUCCESS))
+    return err;
+
+  txn_refund(txn);
+  tASSERT(txn, dpl_check(txn));
+  tASSERT(txn, pnl_check_allocated(txn->wr.repnl, txn->geo.first_unallocated - MDBX_ENABLE_REFUND));
+  return undo_index_rebuild(undo, undo->count);
+}
+
+/*----------------------------------------------------------------------------*/
+
+int savepoint_create(MDBX_txn *txn, size_t *savepoint) {
+  undo_t *undo = txn->wr.undo;
+  if (!undo) {
+    undo = osal_calloc(1, sizeof(undo_t));
+    if (unlikely(!undo))
+      return MDBX_ENOMEM;
+    txn->wr.undo = undo;
+  } else if (unlikely(undo->broken))
+    return MDBX_BAD_TXN;
+
+  int err = MDBX_ENOMEM;
+  if (undo->depth == undo->limit) {
+    const size_t limit = undo->limit ? undo->limit * 2 : 8;
+    savepoint_t *const stack = osal_realloc(undo->stack, limit * sizeof(savepoint_t));
+    if (unlikely(!stack))
+      goto bailout;
+    undo->stack = stack;
+    undo->limit = limit;
+  }
+
+  const size_t n_dbi = txn->n_dbi;
+  tree_t *const dbs = osal_malloc(n_dbi * (sizeof(tree_t) + sizeof(uint32_t) + sizeof(uint8_t)));
+  if (unlikely(!dbs))
+    goto bailout;
+  uint32_t *const seqs = (uint32_t *)(dbs + n_dbi);
+  uint8_t *const state = (uint8_t *)(seqs + n_dbi);
+  for (size_t dbi = 0; dbi < n_dbi; ++dbi) {
+    state[dbi] = dbi_state(txn, dbi);
+    seqs[dbi] = txn->dbi_seqs[dbi];
+    if (state[dbi])
+      dbs[dbi] = txn->dbs[dbi];
+    else
+      memset(dbs + dbi, 0, sizeof(tree_t));
+  }
+
+  savepoint_t *const sp = undo->stack + undo->depth;
+  sp->start = undo->count;
+  sp->retired = txn->wr.retired_pages ? pnl_size(txn->wr.retired_pages) : 0;
+  sp->n_dbi = n_dbi;
+  sp->canary = txn->canary;
+  sp->dbs = dbs;
+  *savepoint = ++undo->depth;
+  return MDBX_SUCCESS;
+
+bailout:
+  if (!undo->depth)
+    savepoint_destroy(txn);
+  return err;
+}
+
+int savepoint_rollback(MDBX_txn *txn, size_t savepoint) {
+  undo_t *const undo = txn->wr.undo;
+  if (unlikely(!undo || savepoint < 1 || savepoint > undo->depth))
+    return MDBX_EINVAL;
+  if (unlikely(undo->broken))
+    return MDBX_BAD_TXN;
+  if (unlikely((txn->flags & MDBX_TXN_ERROR) && !undo_recoverable(undo->poison)))
+    return MDBX_BAD_TXN;
+
+  int err = undo_revert(txn, undo->stack + savepoint - 1);
+  if (unlikely(err != MDBX_SUCCESS)) {
+    ERROR("unable to rollback to the savepoint %zu, error %d", savepoint, err);
+    return undo_failed(txn, err);
+  }
+
+  while (undo->depth > savepoint)
+    osal_free(undo->stack[--undo->depth].dbs);
+  /* состояние транзакции полностью восстановлено, в том числе после устранимой ошибки */
+  txn->flags &= ~MDBX_TXN_ERROR;
+  undo->poison = MDBX_SUCCESS;
+  return MDBX_SUCCESS;
+}
+
+void savepoint_poisoned(MDBX_txn *txn, int err) {
+  undo_t *const undo = txn->wr.undo;
+  /* неустранимая ошибка не перекрывается последующей устранимой */
+  if ((txn->flags & MDBX_TXN_ERROR) == 0 || undo_recoverable(undo->poison))
+    undo->poison = err;
+}
+
+int savepoint_release(MDBX_txn *txn, size_t savepoint) {
+  undo_t *const undo = txn->wr.undo;
+  if (unlikely(!undo || savepoint < 1 || savepoint > undo->depth))
+    return MDBX_EINVAL;
+
+  /* записи журнала переходят к предыдущей точке сохранения */
+  while (undo->depth >= savepoint)
+    osal_free(undo->stack[--undo->depth].dbs);
+  if (!undo->depth)
+    savepoint_destroy(txn);
+  return MDBX_SUCCESS;
+}
+
+void savepoint_destroy(MDBX_txn *txn) {
+  undo_t *const undo = txn->wr.undo;
+  for (size_t i = 0; i < undo->count; ++i)
+    if (undo->items[i].preimage)
+      page_shadow_release(txn->env, undo->items[i].preimage, undo->items[i].npages);
+  while (undo->depth)
+    osal_free(undo->stack[--undo->depth].dbs);
+  osal_free(undo->stack);
+  osal_free(undo->items);
+  osal_free(undo->index);
+  osal_free(undo);
+  txn->wr.undo = nullptr;
+}
@@ -0,0 +1,19 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+/// \author Леонид Юрьев aka Leonid Yuriev <leo@yuriev.ru> \date 2015-2025
+
+#pragma once
+
+#include "essentials.h"
+
+MDBX_INTERNAL int savepoint_create(MDBX_txn *txn, size_t *savepoint);
+MDBX_INTERNAL int savepoint_rollback(MDBX_txn *txn, size_t savepoint);
+MDBX_INTERNAL int savepoint_release(MDBX_txn *txn, size_t savepoint);
+MDBX_INTERNAL void savepoint_destroy(MDBX_txn *txn);
+MDBX_INTERNAL void savepoint_poisoned(MDBX_txn *txn, int err);
+
+/* Функции ведения журнала отката, вызываются только при txn->wr.undo != nullptr */
+MDBX_INTERNAL int __must_check_result savepoint_allocated(MDBX_txn *txn, pgno_t pgno, size_t npages);
+MDBX_INTERNAL int __must_check_result savepoint_cloned(MDBX_txn *txn, pgno_t pgno, size_t npages);
+MDBX_INTERNAL int __must_check_result savepoint_touch(MDBX_txn *txn, const page_t *mp);
+MDBX_INTERNAL int __must_check_result savepoint_retire(MDBX_cursor *mc, pgno_t pgno, page_t *mp, size_t npages,
+                                                       size_t di, size_t si, bool modifable);
@@ -49,6 +49,7 @@ pnl_t spill_purge(MDBX_txn *txn) {
 
 static int spill_page(MDBX_txn *txn, iov_ctx_t *ctx, page_t *dp, const size_t npages) {
   tASSERT(txn, !(txn->flags & MDBX_WRITEMAP));
+  txn->wr.spill_stat.spilled += (uint32_t)npages;
 #if MDBX_ENABLE_PGOP_STAT
   txn->env->lck->pgops.spill.weak += npages;
 #endif /* MDBX_ENABLE_PGOP_STAT */
@@ -74,12 +75,10 @@ static size_t spill_cursor_keep(const MDBX_txn *const txn, const MDBX_cursor *mc
             __Wpedantic_format_voidptr(mp));
       tASSERT(txn, !is_subpage(mp));
       if (is_modifable(txn, mp)) {
-        size_t const n = dpl_search(txn, mp->pgno);
-        if (txn->wr.dirtylist->items[n].pgno == mp->pgno &&
-            /* не считаем дважды */ dpl_age(txn, n)) {
-          size_t *const ptr = ptr_disp(txn->wr.dirtylist->items[n].ptr, -(ptrdiff_t)sizeof(size_t));
-          *ptr = txn->wr.dirtylru;
-          tASSERT(txn, dpl_age(txn, n) == 0);
+        const page_t *const dp = dpl_find(txn, mp->pgno);
+        dp_label_t *const label = dp ? dpl_label(dp) : nullptr;
+        if (label && /* не считаем дважды */ label->lru != txn->wr.dirtylru) {
+          label->lru = txn->wr.dirtylru;
           ++keep;
           DEBUG("keep page %" PRIaPGNO " (%p), dbi %zu, %scursor %p[%zu]", mp->pgno, __Wpedantic_format_voidptr(mp),
                 cursor_dbi(mc), is_inner(mc) ? "sub-" : "", __Wpedantic_format_voidptr(mc), i);
@@ -148,6 +147,14 @@ MDBX_NOTHROW_PURE_FUNCTION static unsigned spill_prio(const MDBX_txn *txn, const
   tASSERT(txn, age * (uint64_t)reciprocal < UINT32_MAX);
   unsigned prio = age * reciprocal >> 24;
   tASSERT(txn, prio < 256);
+  if (txn->env->options.spill_policy) {
+    /* Подобно 2Q/CLOCK-Pro страницы без повторных обращений ("холодные")
+     * вытесняются раньше любых "горячих", а среди горячих учитывается
+     * как давность, так и частота обращений. */
+    const uint32_t hits = dpl_label(dp)->hits;
+    prio = hits ? (prio >> 1) >> (hits < 4 ? hits - 1 : 2) : 128 + (prio >> 1);
+    tASSERT(txn, prio < 256);
+  }
   if (likely(npages == 1))
     return prio = 256 - prio;
 
@@ -236,8 +243,7 @@ __cold int spill_slowpath(MDBX_txn *const txn, MDBX_cursor *const m0, const intp
     if (unlikely(!txn->wr.spilled.list)) {
       rc = MDBX_ENOMEM;
     bailout:
-      txn->flags |= MDBX_TXN_ERROR;
-      return rc;
+      return txn_poison(txn, rc);
     }
   } else {
     /* purge deleted slots */
@@ -305,9 +311,9 @@ __cold int spill_slowpath(MDBX_txn *const txn, MDBX_cursor *const m0, const intp
   const uint32_t reciprocal = (UINT32_C(255) << 24) / (age_max + 1);
   for (size_t i = 1; i <= dl->length; ++i) {
     const unsigned prio = spill_prio(txn, i, reciprocal);
-    size_t *const ptr = ptr_disp(dl->items[i].ptr, -(ptrdiff_t)sizeof(size_t));
-    TRACE("page %" PRIaPGNO ", lru %zu, is_multi %c, npages %u, age %u of %u, prio %u", dl->items[i].pgno, *ptr,
-          (dl->items[i].npages > 1) ? 'Y' : 'N', dpl_npages(dl, i), dpl_age(txn, i), age_max, prio);
+    TRACE("page %" PRIaPGNO ", lru %u, hits %u, is_multi %c, npages %u, age %u of %u, prio %u", dl->items[i].pgno,
+          dpl_label(dl->items[i].ptr)->lru, dpl_label(dl->items[i].ptr)->hits, (dl->items[i].npages > 1) ? 'Y' : 'N',
+          dpl_npages(dl, i), dpl_age(txn, i), age_max, prio);
     if (prio < 256) {
       radix_entries[prio] += 1;
       spillable_entries += 1;
@@ -392,7 +398,17 @@ __cold int spill_slowpath(MDBX_txn *const txn, MDBX_cursor *const m0, const intp
     dl->sorted = dpl_setlen(dl, w);
     txn->wr.dirtyroom += spilled_entries;
     txn->wr.dirtylist->pages_including_loose -= spilled_npages;
+    txn->wr.spill_stat.rounds += 1;
     tASSERT(txn, dpl_check(txn));
+    txn->wr.spill_clock += spilled_entries;
+    if (txn->env->options.spill_policy && txn->wr.spill_clock >= dl->length) {
+      /* Старение счетчиков обращений после вытеснения количества страниц
+       * равного размеру списка, аналогично сбросу бита обращения при полном
+       * обороте "часовой стрелки" в CLOCK. */
+      txn->wr.spill_clock = 0;
+      for (size_t i = 1; i <= dl->length; ++i)
+        dpl_label(dl->items[i].ptr)->hits >>= 1;
+    }
 
     if (!iov_empty(&ctx)) {
       tASSERT(txn, rc == MDBX_SUCCESS);
@@ -5,6 +5,10 @@
 
 #include "essentials.h"
 
+/* Значение счетчика обращений, присваиваемое странице при её возврате
+ * из вытесненных, см MDBX_opt_spill_policy. */
+#define SPILL_HOT_HITS 2
+
 MDBX_INTERNAL void spill_remove(MDBX_txn *txn, size_t idx, size_t npages);
 MDBX_INTERNAL pnl_t spill_purge(MDBX_txn *txn);
 MDBX_INTERNAL int spill_slowpath(MDBX_txn *const txn, MDBX_cursor *const m0, const intptr_t wanna_spill_entries,
@@ -341,7 +341,7 @@ int main(int argc, char *argv[]) {
     }
     print_stat(&mst);
 
-    size_t gc_pages = 0, *iptr;
+    size_t gc_pages = 0;
     size_t gc_reclaimable = 0;
     MDBX_val key, data;
     while (MDBX_SUCCESS == (rc = mdbx_cursor_get(cursor, &key, &data, MDBX_NEXT))) {
@@ -349,8 +349,19 @@ int main(int argc, char *argv[]) {
         rc = MDBX_EINTR;
         break;
       }
-      iptr = data.iov_base;
-      const pgno_t number = *iptr++;
+      /* упакованные записи (см. MDBX_opt_gc_extents) распаковываются */
+      const pgno_t *iptr = data.iov_base;
+      pgno_t *unpacked = nullptr;
+      pgno_t number = *iptr++;
+      if (pnl_is_packed(data.iov_base)) {
+        unpacked = malloc(pnl_packed_npages(data.iov_base) * sizeof(pgno_t));
+        if (!unpacked) {
+          rc = MDBX_ENOMEM;
+          break;
+        }
+        number = (pgno_t)pnl_unpack(unpacked, data.iov_base);
+        iptr = unpacked;
+      }
 
       gc_pages += number;
       if (envinfo && mei.mi_latter_reader_txnid > *(txnid_t *)key.iov_base)
@@ -384,6 +395,7 @@ int main(int argc, char *argv[]) {
           }
         }
       }
+      free(unpacked);
     }
     mdbx_cursor_close(cursor);
     cursor = nullptr;
@@ -130,7 +130,7 @@ int tree_drop(MDBX_cursor *mc, const bool may_have_tables) {
 bailout:
   be_poor(mc);
   if (unlikely(rc != MDBX_SUCCESS))
-    txn->flags |= MDBX_TXN_ERROR;
+    txn_poison(txn, rc);
   return rc;
 }
 
@@ -146,8 +146,7 @@ static int node_move(MDBX_cursor *csrc, MDBX_cursor *cdst, bool fromleft) {
   if (unlikely(page_type(psrc) != page_type(pdst))) {
   bailout:
     ERROR("Wrong or mismatch pages's types (src %d, dst %d) to move node", page_type(psrc), page_type(pdst));
-    csrc->txn->flags |= MDBX_TXN_ERROR;
-    return MDBX_PROBLEM;
+    return txn_poison(csrc->txn, MDBX_PROBLEM);
   }
 
   MDBX_val key4move;
@@ -1499,7 +1498,7 @@ done:
     page_shadow_release(env, tmp_ki_copy, 1);
 
   if (unlikely(rc != MDBX_SUCCESS))
-    mc->txn->flags |= MDBX_TXN_ERROR;
+    txn_poison(mc->txn, rc);
   else {
     if (AUDIT_ENABLED())
       rc = cursor_validate_updating(mc);
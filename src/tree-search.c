@@ -71,6 +71,7 @@ __hot int tree_search(MDBX_cursor *mc, const MDBX_val *key, int flags) {
   }
 
   mc->top = 0;
+  mc->scan = 0;
   mc->ki[0] = (flags & Z_LAST) ? page_numkeys(mc->pg[0]) - 1 : 0;
   DEBUG("db %d root page %" PRIaPGNO " has flags 0x%X", cursor_dbi_dbg(mc), root, mc->pg[0]->flags);
 
@@ -86,6 +87,52 @@ __hot int tree_search(MDBX_cursor *mc, const MDBX_val *key, int flags) {
   return tree_search_finalize(mc, key, flags);
 }
 
+/* Поиск "от пальца", т.е. от текущей позиции курсора.
+ *
+ * Вызывается когда искомый ключ вне диапазона ключей текущей листовой
+ * страницы: меньше первого (rightward == false) либо больше последнего
+ * (rightward == true). Вместо спуска от корня выполняется подъем по стеку
+ * курсора только до ближайшей страницы, в диапазон которой попадает искомый
+ * ключ, а затем обычный спуск от неё. Границы поддеревьев определяются по
+ * ключам-разделителям на branch-страницах в стеке курсора. */
+__hot int tree_search_finger(MDBX_cursor *mc, const MDBX_val *key, const bool rightward) {
+  cASSERT(mc, is_pointed(mc) && is_leaf(mc->pg[mc->top]));
+  if (unlikely(mc->txn->flags & MDBX_TXN_BLOCKED) || unlikely(*cursor_dbi_state(mc) & DBI_STALE) ||
+      unlikely(mc->pg[0]->pgno != mc->tree->root))
+    return tree_search(mc, key, 0);
+
+  intptr_t level = mc->top;
+  for (intptr_t i = mc->top - 1; i >= 0; --i) {
+    const page_t *const mp = mc->pg[i];
+    size_t ki = mc->ki[i];
+    if (rightward) {
+      if (++ki >= page_numkeys(mp))
+        /* правая граница поддерева определяется на уровнях выше */
+        continue;
+    } else if (ki == 0)
+      /* левая граница поддерева определяется на уровнях выше */
+      continue;
+
+    const MDBX_val separator = get_key(page_node(mp, ki));
+    const int cmp = mc->clc->k.cmp(key, &separator);
+    if (rightward ? cmp < 0 : cmp >= 0)
+      break;
+    level = i;
+  }
+
+#if MDBX_ENABLE_PGOP_STAT
+  MDBX_env *const env = mc->txn->env;
+  env->finger_stat.searches.weak += 1;
+  env->finger_stat.levels_saved.weak += level;
+#endif /* MDBX_ENABLE_PGOP_STAT */
+  if (level == mc->top)
+    /* ключ в промежутке между разделителем и краем текущей страницы */
+    return MDBX_SUCCESS;
+
+  mc->top = (int8_t)level;
+  return tree_search_finalize(mc, key, 0);
+}
+
 __hot __noinline int tree_search_finalize(MDBX_cursor *mc, const MDBX_val *key, int flags) {
   cASSERT(mc, !is_poor(mc));
   DKBUF_DEBUG;
@@ -26,7 +26,11 @@ static int txn_write(MDBX_txn *txn, iov_ctx_t *ctx) {
     rc = iov_write(ctx);
   }
 
-  if (likely(rc == MDBX_SUCCESS) && ctx->fd == txn->env->lazy_fd) {
+  if (likely(rc == MDBX_SUCCESS) && (ctx->fd == txn->env->lazy_fd
+#if !(defined(_WIN32) || defined(_WIN64))
+                                      || (txn->env->ioring.bounce && ctx->fd == txn->env->ioring.direct_fd)
+#endif /* !Windows */
+                                          )) {
     txn->env->lck->unsynced_pages.weak += total_npages;
     if (!txn->env->lck->eoos_timestamp.weak)
       txn->env->lck->eoos_timestamp.weak = osal_monotime();
@@ -91,12 +95,71 @@ __cold void txn_basal_destroy(MDBX_txn *txn) {
   pnl_free(txn->wr.retired_pages);
   pnl_free(txn->wr.spilled.list);
   pnl_free(txn->wr.repnl);
+  pnl_free(txn->wr.repnl_deferred);
+  gc_extents_free(txn);
   osal_free(txn);
 }
 
+#if !(defined(_WIN32) || defined(_WIN64))
+/* Формирует опись записываемых страниц для фиксации с однократным сбросом
+ * на диск, либо возвращает MDBX_RESULT_TRUE если такая фиксация невозможна. */
+static int txn_manifest(MDBX_txn *txn, txnid_t commit_txnid) {
+  MDBX_env *const env = txn->env;
+  const size_t capacity = manifest_capacity(env);
+  if (((env->flags | txn->flags) & (MDBX_WRITEMAP | MDBX_SAFE_NOSYNC | MDBX_NOMETASYNC)) || env->incore ||
+      !capacity || atomic_load64(&env->lck->unsynced_pages, mo_Relaxed))
+    return MDBX_RESULT_TRUE;
+
+  if (!env->manifest) {
+    env->manifest = osal_malloc(env->ps);
+    if (unlikely(!env->manifest))
+      return MDBX_ENOMEM;
+  }
+  manifest_t *const manifest = meta_manifest(env->manifest);
+  manifest->magic = 0;
+  manifest->count = 0;
+
+  dpl_t *const dl = dpl_sort(txn);
+  uint64_t checksum = commit_txnid;
+  for (size_t i = 1; i <= dl->length; ++i) {
+    page_t *const dp = dl->items[i].ptr;
+    if (dp->flags & P_LOOSE)
+      continue;
+    const pgno_t pgno = dl->items[i].pgno, npages = dpl_npages(dl, i);
+    if (manifest->count &&
+        manifest->extents[manifest->count - 1].pgno + manifest->extents[manifest->count - 1].npages == pgno)
+      manifest->extents[manifest->count - 1].npages += npages;
+    else if (manifest->count < capacity) {
+      manifest->extents[manifest->count].pgno = pgno;
+      manifest->extents[manifest->count].npages = npages;
+      manifest->count += 1;
+    } else
+      return MDBX_RESULT_TRUE;
+    /* в заголовке записываемой страницы txnid заменяется, см. iov_page() */
+    const txnid_t front_txnid = dp->txnid;
+    dp->txnid = txn->txnid;
+    for (size_t n = 0; n < npages; ++n)
+      checksum = checksum64(checksum, ptr_disp(dp, pgno2bytes(env, n)), env->ps);
+    dp->txnid = front_txnid;
+  }
+
+  unaligned_poke_u64(4, manifest->txnid, commit_txnid);
+  unaligned_poke_u64(4, manifest->checksum, manifest_checksum(manifest, checksum));
+  manifest->magic = MANIFEST_MAGIC;
+  return MDBX_SUCCESS;
+}
+#endif /* !Windows */
+
 int txn_basal_start(MDBX_txn *txn, unsigned flags) {
   MDBX_env *const env = txn->env;
 
+  /* мета-страницы помечаются до того, как транзакция может переиспользовать страницы прежних снимков */
+  if (unlikely(env->options.gc_extents) && !meta_gc_extents_marked(env)) {
+    int err = meta_mark_gc_extents(env);
+    if (unlikely(err != MDBX_SUCCESS))
+      return err;
+  }
+
   txn->wr.troika = meta_tap(env);
   const meta_ptr_t head = meta_recent(env, &txn->wr.troika);
   uint64_t timestamp = 0;
@@ -154,6 +217,9 @@ int txn_basal_end(MDBX_txn *txn, unsigned mode) {
   eASSERT(env, txn->parent == nullptr);
   pnl_shrink(&txn->wr.retired_pages);
   pnl_shrink(&txn->wr.repnl);
+  pnl_free(txn->wr.repnl_deferred);
+  txn->wr.repnl_deferred = nullptr;
+  gc_extents_free(txn);
   if (!(env->flags & MDBX_WRITEMAP))
     dpl_release_shadows(txn);
 
@@ -314,8 +380,17 @@ int txn_basal_commit(MDBX_txn *txn, struct commit_timestamp *ts) {
         (need_flush_for_nometasync || env->dsync_fd == INVALID_HANDLE_VALUE ||
          txn->wr.dirtylist->length > env->options.writethrough_threshold ||
          atomic_load64(&env->lck->unsynced_pages, mo_Relaxed))
-            ? env->lazy_fd
+            ? (env->ioring.bounce ? env->ioring.direct_fd : env->lazy_fd)
             : env->dsync_fd;
+    /* однократный сброс на диск охватывает и мета-страницу предыдущей фиксации */
+    if (env->options.single_flush) {
+      rc = txn_manifest(txn, commit_txnid);
+      if (unlikely(MDBX_IS_ERROR(rc)))
+        return rc;
+      if (rc == MDBX_SUCCESS)
+        /* данные и мета-страница будут сброшены на диск однократно */
+        fd = env->ioring.bounce ? env->ioring.direct_fd : env->lazy_fd;
+    }
 #endif /* Windows */
 
     iov_ctx_t write_ctx;
@@ -367,5 +442,6 @@ int txn_basal_commit(MDBX_txn *txn, struct commit_timestamp *ts) {
     return rc;
   }
 
+  dxb_preallocate(env, &meta.geometry);
   return MDBX_SUCCESS;
 }
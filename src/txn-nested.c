@@ -80,6 +80,7 @@ static void txn_merge(MDBX_txn *const parent, MDBX_txn *const txn, const size_t
     DEBUG("reclaim retired parent's %u -> %zu %s page %" PRIaPGNO, npages, l, kind, pgno);
     int err = pnl_insert_span(&parent->wr.repnl, pgno, l);
     ENSURE(txn->env, err == MDBX_SUCCESS);
+    gc_extents_reset(parent);
   }
   pnl_setsize(parent->wr.retired_pages, w);
 
@@ -334,10 +335,15 @@ static void txn_merge(MDBX_txn *const parent, MDBX_txn *const txn, const size_t
 }
 
 int txn_nested_create(MDBX_txn *parent, const MDBX_txn_flags_t flags) {
+  /* Слияние может вернуть страницы в нераспределенный "хвост" (refund),
+   * поэтому выполняется до копирования geo и списков родителя. */
+  int err = gc_merge_deferred(parent);
+  if (unlikely(err != MDBX_SUCCESS))
+    return LOG_IFERR(err);
+
   if (parent->env->options.spill_parent4child_denominator) {
     /* Spill dirty-pages of parent to provide dirtyroom for child txn */
-    int err =
-        txn_spill(parent, nullptr, parent->wr.dirtylist->length / parent->env->options.spill_parent4child_denominator);
+    err = txn_spill(parent, nullptr, parent->wr.dirtylist->length / parent->env->options.spill_parent4child_denominator);
     if (unlikely(err != MDBX_SUCCESS))
       return LOG_IFERR(err);
   }
@@ -364,10 +370,11 @@ int txn_nested_create(MDBX_txn *parent, const MDBX_txn_flags_t flags) {
   txn->dbi_seqs = parent->dbi_seqs;
   txn->geo = parent->geo;
 
-  int err = dpl_alloc(txn);
+  err = dpl_alloc(txn);
   if (unlikely(err != MDBX_SUCCESS))
     return LOG_IFERR(err);
 
+  tASSERT(parent, !parent->wr.repnl_deferred || MDBX_PNL_IS_EMPTY(parent->wr.repnl_deferred));
   const size_t len = pnl_size(parent->wr.repnl) + parent->wr.loose_count;
   txn->wr.repnl = pnl_alloc((len > MDBX_PNL_INITIAL) ? len : MDBX_PNL_INITIAL);
   if (unlikely(!txn->wr.repnl))
@@ -381,6 +388,7 @@ int txn_nested_create(MDBX_txn *parent, const MDBX_txn_flags_t flags) {
       err = pnl_insert_span(&parent->wr.repnl, lp->pgno, 1);
       if (unlikely(err != MDBX_SUCCESS))
         return LOG_IFERR(err);
+      gc_extents_reset(parent);
       MDBX_ASAN_UNPOISON_MEMORY_REGION(&page_next(lp), sizeof(page_t *));
       VALGRIND_MAKE_MEM_DEFINED(&page_next(lp), sizeof(page_t *));
       parent->wr.loose_pages = page_next(lp);
@@ -453,11 +461,20 @@ void txn_nested_abort(MDBX_txn *nested) {
     parent->wr.retired_pages = nested->wr.retired_pages;
   }
 
+  parent->wr.spill_stat.spilled += nested->wr.spill_stat.spilled;
+  parent->wr.spill_stat.unspilled += nested->wr.spill_stat.unspilled;
+  parent->wr.spill_stat.rounds += nested->wr.spill_stat.rounds;
+  parent->wr.resize_stat.time += nested->wr.resize_stat.time;
+  parent->wr.resize_stat.count += nested->wr.resize_stat.count;
+
   tASSERT(parent, dpl_check(parent));
   tASSERT(parent, audit_ex(parent, 0, false) == 0);
   dpl_release_shadows(nested);
   dpl_free(nested);
   pnl_free(nested->wr.repnl);
+  pnl_free(nested->wr.repnl_deferred);
+  pnl_free(nested->wr.spilled.list);
+  gc_extents_free(nested);
   osal_free(nested);
 }
 
@@ -470,6 +487,12 @@ int txn_nested_join(MDBX_txn *txn, struct commit_timestamp *ts) {
   eASSERT(env, parent->nested == txn && (parent->flags & MDBX_TXN_HAS_CHILD) != 0);
   eASSERT(env, dpl_check(txn));
 
+  parent->wr.spill_stat.spilled += txn->wr.spill_stat.spilled;
+  parent->wr.spill_stat.unspilled += txn->wr.spill_stat.unspilled;
+  parent->wr.spill_stat.rounds += txn->wr.spill_stat.rounds;
+  parent->wr.resize_stat.time += txn->wr.resize_stat.time;
+  parent->wr.resize_stat.count += txn->wr.resize_stat.count;
+
   if (txn->wr.dirtylist->length == 0 && !(txn->flags & MDBX_TXN_DIRTY) && parent->n_dbi == txn->n_dbi) {
     VERBOSE("fast-complete pure nested txn %" PRIaTXN, txn->txnid);
 
@@ -494,20 +517,25 @@ int txn_nested_join(MDBX_txn *txn, struct commit_timestamp *ts) {
     return txn_end(txn, TXN_END_PURE_COMMIT | TXN_END_SLOT | TXN_END_FREE);
   }
 
+  int err = gc_merge_deferred(txn);
+  if (unlikely(err != MDBX_SUCCESS))
+    return err;
+  tASSERT(parent, !parent->wr.repnl_deferred || MDBX_PNL_IS_EMPTY(parent->wr.repnl_deferred));
+
   /* Preserve space for spill list to avoid parent's state corruption
    * if allocation fails. */
   const size_t parent_retired_len = (uintptr_t)parent->wr.retired_pages;
   tASSERT(txn, parent_retired_len <= pnl_size(txn->wr.retired_pages));
   const size_t retired_delta = pnl_size(txn->wr.retired_pages) - parent_retired_len;
   if (retired_delta) {
-    int err = pnl_need(&txn->wr.repnl, retired_delta);
+    err = pnl_need(&txn->wr.repnl, retired_delta);
     if (unlikely(err != MDBX_SUCCESS))
       return err;
   }
 
   if (txn->wr.spilled.list) {
     if (parent->wr.spilled.list) {
-      int err = pnl_need(&parent->wr.spilled.list, pnl_size(txn->wr.spilled.list));
+      err = pnl_need(&parent->wr.spilled.list, pnl_size(txn->wr.spilled.list));
       if (unlikely(err != MDBX_SUCCESS))
         return err;
     }
@@ -527,6 +555,10 @@ int txn_nested_join(MDBX_txn *txn, struct commit_timestamp *ts) {
   pnl_free(parent->wr.repnl);
   parent->wr.repnl = txn->wr.repnl;
   txn->wr.repnl = nullptr;
+  gc_extents_reset(parent);
+  gc_extents_free(txn);
+  pnl_free(txn->wr.repnl_deferred);
+  txn->wr.repnl_deferred = nullptr;
   parent->wr.gc.spent = txn->wr.gc.spent;
   rkl_destructive_move(&txn->wr.gc.reclaimed, &parent->wr.gc.reclaimed);
   rkl_destructive_move(&txn->wr.gc.ready4reuse, &parent->wr.gc.ready4reuse);
@@ -12,6 +12,15 @@ __hot bool txn_gc_detent(const MDBX_txn *const txn) {
   return true;
 }
 
+/* Помечает транзакцию как ошибочную, при наличии точек сохранения причина
+ * запоминается для savepoint_rollback(). Возвращает переданный код ошибки. */
+__cold int txn_poison(MDBX_txn *txn, int err) {
+  if ((txn->flags & MDBX_TXN_RDONLY) == 0 && txn->wr.undo)
+    savepoint_poisoned(txn, err);
+  txn->flags |= MDBX_TXN_ERROR;
+  return err;
+}
+
 void txn_done_cursors(MDBX_txn *txn) {
   tASSERT(txn, txn->flags & txn_may_have_cursors);
 
@@ -48,8 +57,7 @@ int txn_shadow_cursors(const MDBX_txn *parent, const size_t dbi) {
     if (unlikely(err != MDBX_SUCCESS)) {
       /* не получилось забекапить курсоры */
       txn->dbi_state[dbi] = DBI_OLDEN | DBI_LINDO;
-      txn->flags |= MDBX_TXN_ERROR;
-      return err;
+      return txn_poison(txn, err);
     }
     cursor->next = txn->cursors[dbi];
     txn->cursors[dbi] = cursor;
@@ -315,6 +323,9 @@ int txn_renew(MDBX_txn *txn, unsigned flags) {
     }
     eASSERT(env, txn->wr.writemap_dirty_npages == 0);
     eASSERT(env, txn->wr.writemap_spilled_npages == 0);
+    memset(&txn->wr.spill_stat, 0, sizeof(txn->wr.spill_stat));
+    memset(&txn->wr.resize_stat, 0, sizeof(txn->wr.resize_stat));
+    txn->wr.spill_clock = 0;
 
     MDBX_cursor *const gc = ptr_disp(txn, sizeof(MDBX_txn));
     rc = cursor_init(gc, txn, FREE_DBI);
@@ -340,6 +351,8 @@ int txn_end(MDBX_txn *txn, unsigned mode) {
   tASSERT(txn, /* txn->signature == txn_signature && */ !txn->nested && !(txn->flags & MDBX_TXN_HAS_CHILD));
   if (txn->flags & txn_may_have_cursors)
     txn_done_cursors(txn);
+  if ((txn->flags & MDBX_TXN_RDONLY) == 0 && txn->wr.undo)
+    savepoint_destroy(txn);
 
   MDBX_env *const env = txn->env;
   MDBX_txn *const parent = txn->parent;
@@ -383,7 +396,7 @@ int txn_end(MDBX_txn *txn, unsigned mode) {
     } else if (unlikely(err != MDBX_SUCCESS)) {
       ERROR("error %d while undo resize performed by nested txn, fail the parent", err);
       mdbx_txn_break(env->basal_txn);
-      parent->flags |= MDBX_TXN_ERROR;
+      txn_poison(parent, err);
       if (!env->dxb_mmap.base)
         env->flags |= ENV_FATAL_ERROR;
       return err;
@@ -42,6 +42,22 @@ MDBX_NOTHROW_CONST_FUNCTION uint64_t rrxmrrxmsx_0(uint64_t v) {
   return v ^ v >> 28;
 }
 
+/* Быстрая контрольная сумма для обнаружения разрывов записи (не стойкая
+ * к намеренным коллизиям). Данные должны быть выровнены на 8 байт, а их
+ * размер кратен 32 байтам, что всегда верно для страниц БД. */
+MDBX_NOTHROW_PURE_FUNCTION uint64_t checksum64(uint64_t seed, const void *data, size_t bytes) {
+  assert(bytes % 32 == 0 && ((uintptr_t)data & 7) == 0);
+  const uint64_t prime1 = UINT64_C(0x9E3779B185EBCA87), prime2 = UINT64_C(0xC2B2AE3D27D4EB4F);
+  uint64_t a = seed + prime1, b = seed ^ prime2, c = ~seed, d = seed - prime1;
+  for (const uint64_t *w = data, *const end = ptr_disp(data, bytes); w < end; w += 4) {
+    a += w[0] * prime2, a = (a << 31 | a >> 33) * prime1;
+    b += w[1] * prime2, b = (b << 31 | b >> 33) * prime1;
+    c += w[2] * prime2, c = (c << 31 | c >> 33) * prime1;
+    d += w[3] * prime2, d = (d << 31 | d >> 33) * prime1;
+  }
+  return rrxmrrxmsx_0(a ^ (b << 7 | b >> 57) ^ (c << 12 | c >> 52) ^ (d << 18 | d >> 46) ^ bytes);
+}
+
 __cold char *ratio2digits(const uint64_t v, const uint64_t d, ratio2digits_buffer_t *const buffer, int precision) {
   assert(d > 0 && precision < 20);
   char *const dot = buffer->string + 21;
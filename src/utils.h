@@ -61,6 +61,7 @@ MDBX_NOTHROW_CONST_FUNCTION MDBX_MAYBE_UNUSED MDBX_INTERNAL unsigned log2n_power
 MDBX_NOTHROW_CONST_FUNCTION MDBX_MAYBE_UNUSED MDBX_INTERNAL unsigned ceil_log2n(size_t value_uintptr);
 
 MDBX_NOTHROW_CONST_FUNCTION MDBX_INTERNAL uint64_t rrxmrrxmsx_0(uint64_t v);
+MDBX_NOTHROW_PURE_FUNCTION MDBX_INTERNAL uint64_t checksum64(uint64_t seed, const void *data, size_t bytes);
 
 struct monotime_cache {
   uint64_t value;
@@ -29,6 +29,82 @@ static page_type_t walk_subpage_type(const page_t *sp) {
   }
 }
 
+/* Пул потоков для параллельного обхода дерева страниц.
+ *
+ * Поддеревья таблиц и ветвей передаются в общую очередь, которую разбирают
+ * рабочие потоки, при этом каждый поток использует собственный курсор.
+ * Таким образом параллельно выполняется чтение и проверка страниц, а вызовы
+ * visitor-функции сериализуются посредством мьютекса пула, чтобы не требовать
+ * потоко-безопасности от использующего кода. */
+typedef struct walk_task {
+  struct walk_task *next;
+  MDBX_val name;
+  tree_t tree;
+  pgno_t pgno, parent_pgno;
+  txnid_t parent_txnid;
+  int deep;
+} walk_task_t;
+
+typedef struct walk_pool {
+  osal_condpair_t condpair;
+  walk_task_t *queue;
+  size_t pending, running, limit;
+  int err;
+  MDBX_txn *txn;
+  void *userctx;
+  walk_func *visitor;
+  walk_options_t options;
+} walk_pool_t;
+
+static inline int walk_visit(walk_ctx_t *ctx, const size_t pgno, const unsigned number, const int deep,
+                             const walk_tbl_t *tbl, const size_t page_size, const page_type_t page_type,
+                             const MDBX_error_t err, const size_t nentries, const size_t payload_bytes,
+                             const size_t header_bytes, const size_t unused_bytes, const size_t parent_pgno) {
+  walk_pool_t *const pool = ctx->pool;
+  if (!pool)
+    return ctx->visitor(pgno, number, ctx->userctx, deep, tbl, page_size, page_type, err, nentries, payload_bytes,
+                        header_bytes, unused_bytes, parent_pgno);
+
+  osal_condpair_lock(&pool->condpair);
+  int rc = pool->err;
+  if (likely(rc == MDBX_SUCCESS))
+    rc = ctx->visitor(pgno, number, ctx->userctx, deep, tbl, page_size, page_type, err, nentries, payload_bytes,
+                      header_bytes, unused_bytes, parent_pgno);
+  osal_condpair_unlock(&pool->condpair);
+  return rc;
+}
+
+/* Передает обход поддерева в пул потоков, если там недостаточно работы.
+ * Возвращает MDBX_RESULT_TRUE если поддерево будет обработано другим потоком,
+ * иначе MDBX_RESULT_FALSE и обход должен продолжаться в текущем потоке. */
+static int walk_spawn(walk_ctx_t *ctx, const MDBX_val *name, const tree_t *tree, const pgno_t pgno,
+                      const txnid_t parent_txnid, const pgno_t parent_pgno, const int deep) {
+  walk_pool_t *const pool = ctx->pool;
+  if (!pool)
+    return MDBX_RESULT_FALSE;
+
+  osal_condpair_lock(&pool->condpair);
+  int rc = MDBX_RESULT_FALSE;
+  if (pool->pending < pool->limit) {
+    walk_task_t *const task = osal_malloc(sizeof(walk_task_t));
+    if (likely(task)) {
+      task->name = *name;
+      task->tree = *tree;
+      task->pgno = pgno;
+      task->parent_pgno = parent_pgno;
+      task->parent_txnid = parent_txnid;
+      task->deep = deep;
+      task->next = pool->queue;
+      pool->queue = task;
+      pool->pending += 1;
+      osal_condpair_signal(&pool->condpair, false);
+      rc = MDBX_RESULT_TRUE;
+    }
+  }
+  osal_condpair_unlock(&pool->condpair);
+  return rc;
+}
+
 /* Depth-first tree traversal. */
 __cold static int walk_pgno(walk_ctx_t *ctx, walk_tbl_t *tbl, const pgno_t pgno, txnid_t parent_txnid,
                             const pgno_t parent_pgno) {
@@ -79,8 +155,8 @@ __cold static int walk_pgno(walk_ctx_t *ctx, walk_tbl_t *tbl, const pgno_t pgno,
       const size_t npages = ((err = lp.err) == MDBX_SUCCESS) ? lp.page->pages : 1;
       const size_t pagesize = pgno2bytes(ctx->txn->env, npages);
       const size_t over_unused = pagesize - over_payload - over_header;
-      const int rc = ctx->visitor(large_pgno, npages, ctx->userctx, ctx->deep, tbl, pagesize, page_large, err, 1,
-                                  over_payload, over_header, over_unused, pgno);
+      const int rc = walk_visit(ctx, large_pgno, npages, ctx->deep, tbl, pagesize, page_large, err, 1, over_payload,
+                                over_header, over_unused, pgno);
       if (unlikely(rc != MDBX_SUCCESS))
         return (rc == MDBX_RESULT_TRUE) ? MDBX_SUCCESS : rc;
       payload_size += sizeof(pgno_t);
@@ -148,8 +224,8 @@ __cold static int walk_pgno(walk_ctx_t *ctx, walk_tbl_t *tbl, const pgno_t pgno,
         }
       }
 
-      const int rc = ctx->visitor(pgno, 0, ctx->userctx, ctx->deep + 1, tbl, node_data_size, subtype, err, nsubkeys,
-                                  subpayload_size, subheader_size, subunused_size + subalign_bytes, pgno);
+      const int rc = walk_visit(ctx, pgno, 0, ctx->deep + 1, tbl, node_data_size, subtype, err, nsubkeys,
+                                subpayload_size, subheader_size, subunused_size + subalign_bytes, pgno);
       if (unlikely(rc != MDBX_SUCCESS))
         return (rc == MDBX_RESULT_TRUE) ? MDBX_SUCCESS : rc;
       header_size += subheader_size;
@@ -165,8 +241,8 @@ __cold static int walk_pgno(walk_ctx_t *ctx, walk_tbl_t *tbl, const pgno_t pgno,
     }
   }
 
-  const int rc = ctx->visitor(pgno, 1, ctx->userctx, ctx->deep, tbl, ctx->txn->env->ps, type, err, nentries,
-                              payload_size, header_size, unused_size + align_bytes, parent_pgno);
+  const int rc = walk_visit(ctx, pgno, 1, ctx->deep, tbl, ctx->txn->env->ps, type, err, nentries, payload_size,
+                            header_size, unused_size + align_bytes, parent_pgno);
   if (unlikely(rc != MDBX_SUCCESS))
     return (rc == MDBX_RESULT_TRUE) ? MDBX_SUCCESS : rc;
 
@@ -177,6 +253,9 @@ __cold static int walk_pgno(walk_ctx_t *ctx, walk_tbl_t *tbl, const pgno_t pgno,
     node_t *node = page_node(mp, i);
     if (type == page_branch) {
       assert(err == MDBX_SUCCESS);
+      if (!tbl->nested && walk_spawn(ctx, &tbl->name, tbl->internal, node_pgno(node), mp->txnid, pgno,
+                                     ctx->deep + 1) == MDBX_RESULT_TRUE)
+        continue;
       ctx->deep += 1;
       err = walk_pgno(ctx, tbl, node_pgno(node), mp->txnid, pgno);
       ctx->deep -= 1;
@@ -204,6 +283,11 @@ __cold static int walk_pgno(walk_ctx_t *ctx, walk_tbl_t *tbl, const pgno_t pgno,
         walk_tbl_t table = {{node_key(node), node_ks(node)}, nullptr, nullptr};
         table.internal = &aligned_db;
         assert(err == MDBX_SUCCESS);
+        if (aligned_db.root == P_INVALID ||
+            walk_spawn(ctx, &table.name, &aligned_db, aligned_db.root,
+                       aligned_db.mod_txnid ? aligned_db.mod_txnid : ctx->txn->txnid, 0,
+                       ctx->deep + 1) == MDBX_RESULT_TRUE)
+          break;
         ctx->deep += 1;
         err = walk_tbl(ctx, &table);
         ctx->deep -= 1;
@@ -241,14 +325,11 @@ __cold static int walk_pgno(walk_ctx_t *ctx, walk_tbl_t *tbl, const pgno_t pgno,
   return MDBX_SUCCESS;
 }
 
-__cold int walk_tbl(walk_ctx_t *ctx, walk_tbl_t *tbl) {
-  tree_t *const db = tbl->internal;
-  if (unlikely(db->root == P_INVALID))
-    return MDBX_SUCCESS; /* empty db */
-
+static int walk_subtree(walk_ctx_t *ctx, walk_tbl_t *tbl, const pgno_t pgno, txnid_t parent_txnid,
+                        const pgno_t parent_pgno) {
   kvx_t kvx = {.clc = {.k = {.lmin = INT_MAX}, .v = {.lmin = INT_MAX}}};
   cursor_couple_t couple;
-  int rc = cursor_init4walk(&couple, ctx->txn, db, &kvx);
+  int rc = cursor_init4walk(&couple, ctx->txn, tbl->internal, &kvx);
   if (unlikely(rc != MDBX_SUCCESS))
     return rc;
 
@@ -258,16 +339,115 @@ __cold int walk_tbl(walk_ctx_t *ctx, walk_tbl_t *tbl) {
   couple.outer.next = ctx->cursor;
   couple.outer.top_and_flags = z_disable_tree_search_fastpath;
   ctx->cursor = &couple.outer;
-  rc = walk_pgno(ctx, tbl, db->root, db->mod_txnid ? db->mod_txnid : ctx->txn->txnid, 0);
+  rc = walk_pgno(ctx, tbl, pgno, parent_txnid, parent_pgno);
   ctx->cursor = couple.outer.next;
   return rc;
 }
 
-__cold int walk_pages(MDBX_txn *txn, walk_func *visitor, void *user, walk_options_t options) {
+__cold int walk_tbl(walk_ctx_t *ctx, walk_tbl_t *tbl) {
+  tree_t *const db = tbl->internal;
+  if (unlikely(db->root == P_INVALID))
+    return MDBX_SUCCESS; /* empty db */
+
+  return walk_subtree(ctx, tbl, db->root, db->mod_txnid ? db->mod_txnid : ctx->txn->txnid, 0);
+}
+
+__cold static THREAD_RESULT THREAD_CALL walk_worker(void *arg) {
+  walk_pool_t *const pool = arg;
+  walk_ctx_t ctx = {
+      .txn = pool->txn, .userctx = pool->userctx, .visitor = pool->visitor, .options = pool->options, .pool = pool};
+
+  osal_condpair_lock(&pool->condpair);
+  while (pool->err == MDBX_SUCCESS) {
+    walk_task_t *const task = pool->queue;
+    if (!task) {
+      if (!pool->running)
+        break;
+      osal_condpair_wait(&pool->condpair, false);
+      continue;
+    }
+    pool->queue = task->next;
+    pool->pending -= 1;
+    pool->running += 1;
+    osal_condpair_unlock(&pool->condpair);
+
+    walk_tbl_t tbl = {.name = task->name, .internal = &task->tree};
+    ctx.deep = task->deep;
+    const int err = walk_subtree(&ctx, &tbl, task->pgno, task->parent_txnid, task->parent_pgno);
+    osal_free(task);
+
+    osal_condpair_lock(&pool->condpair);
+    pool->running -= 1;
+    if (unlikely(err != MDBX_SUCCESS) && pool->err == MDBX_SUCCESS)
+      pool->err = err;
+  }
+  /* работы больше нет, будим следующий ожидающий поток по цепочке */
+  osal_condpair_signal(&pool->condpair, false);
+  osal_condpair_unlock(&pool->condpair);
+  return (THREAD_RESULT)0;
+}
+
+__cold static int walk_parallel(MDBX_txn *txn, walk_func *visitor, void *user, walk_options_t options,
+                                unsigned threads) {
+  osal_thread_t *const thread = osal_malloc(sizeof(osal_thread_t) * (threads - 1));
+  if (unlikely(!thread))
+    return MDBX_ENOMEM;
+
+  walk_pool_t pool = {
+      .limit = threads * 4, .txn = txn, .userctx = user, .visitor = visitor, .options = options};
+  int rc = osal_condpair_init(&pool.condpair);
+  if (unlikely(rc != MDBX_SUCCESS)) {
+    osal_free(thread);
+    return rc;
+  }
+
+  walk_ctx_t ctx = {.txn = txn, .userctx = user, .visitor = visitor, .options = options, .pool = &pool};
+  /* задачи извлекаются из очереди в обратном порядке, поэтому GC будет первой */
+  const MDBX_val names[CORE_DBS] = {{.iov_base = MDBX_CHK_GC}, {.iov_base = MDBX_CHK_MAIN}};
+  for (size_t dbi = CORE_DBS; dbi-- > 0;) {
+    const tree_t *const tree = &txn->dbs[dbi];
+    if (tree->root != P_INVALID &&
+        walk_spawn(&ctx, &names[dbi], tree, tree->root, tree->mod_txnid ? tree->mod_txnid : txn->txnid, 0, 0) !=
+            MDBX_RESULT_TRUE)
+      pool.err = MDBX_ENOMEM;
+  }
+
+  unsigned started = 0;
+  while (pool.err == MDBX_SUCCESS && started < threads - 1) {
+    rc = osal_thread_create(&thread[started], walk_worker, &pool);
+    if (unlikely(rc != MDBX_SUCCESS))
+      break;
+    started += 1;
+  }
+
+  /* текущий поток также участвует в обходе */
+  walk_worker(&pool);
+  while (started > 0) {
+    int err = osal_thread_join(thread[--started]);
+    if (unlikely(err != MDBX_SUCCESS) && rc == MDBX_SUCCESS)
+      rc = err;
+  }
+
+  while (pool.queue) {
+    walk_task_t *const task = pool.queue;
+    pool.queue = task->next;
+    osal_free(task);
+  }
+  osal_condpair_destroy(&pool.condpair);
+  osal_free(thread);
+  return (pool.err != MDBX_SUCCESS) ? pool.err : rc;
+}
+
+__cold int walk_pages(MDBX_txn *txn, walk_func *visitor, void *user, walk_options_t options, unsigned threads) {
   int rc = check_txn(txn, MDBX_TXN_BLOCKED);
   if (unlikely(rc != MDBX_SUCCESS))
     return rc;
 
+  /* в пишущей транзакции поиск грязных страниц может изменять внутренние
+   * структуры, поэтому параллельный обход допускается только для чтения */
+  if (threads > 1 && (txn->flags & MDBX_TXN_RDONLY))
+    return walk_parallel(txn, visitor, user, options, threads);
+
   walk_ctx_t ctx = {.txn = txn, .userctx = user, .visitor = visitor, .options = options};
   walk_tbl_t tbl = {.name = {.iov_base = MDBX_CHK_GC}, .internal = &txn->dbs[FREE_DBI]};
   rc = walk_tbl(&ctx, &tbl);
@@ -17,7 +17,8 @@ typedef int walk_func(const size_t pgno, const unsigned number, void *const ctx,
 
 typedef enum walk_options { dont_check_keys_ordering = 1 } walk_options_t;
 
-MDBX_INTERNAL int walk_pages(MDBX_txn *txn, walk_func *visitor, void *user, walk_options_t options);
+MDBX_INTERNAL int walk_pages(MDBX_txn *txn, walk_func *visitor, void *user, walk_options_t options,
+                             unsigned threads);
 
 typedef struct walk_ctx {
   void *userctx;
@@ -26,6 +27,7 @@ typedef struct walk_ctx {
   walk_func *visitor;
   MDBX_txn *txn;
   MDBX_cursor *cursor;
+  struct walk_pool *pool;
 } walk_ctx_t;
 
 MDBX_INTERNAL int walk_tbl(walk_ctx_t *ctx, walk_tbl_t *tbl);
@@ -0,0 +1,208 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+static uint64_t prng = 42;
+static uint64_t next() {
+  prng = prng * 6364136223846793005ull + 1442695040888963407ull;
+  return prng >> 33;
+}
+
+struct dataset {
+  const char *name;
+  MDBX_aggregate_encoding_t encoding;
+  buffer (*encode)(double);
+  /* the histogram bounds are chosen so that the buckets are computed exactly */
+  double histogram_lower, histogram_upper;
+};
+
+static const dataset signed64 = {"signed64", MDBX_AGGREGATE_SIGNED,
+                                 [](double x) { return buffer::key_from_i64(int64_t(x)); }, -512, 512};
+static const dataset unsigned32 = {"unsigned32", MDBX_AGGREGATE_UNSIGNED,
+                                   [](double x) { return buffer::key_from_u32(uint32_t(x)); }, 0, 1024};
+static const dataset double64 = {"double64", MDBX_AGGREGATE_FLOATING,
+                                 [](double x) { return buffer::key_from_double(x); }, -256, 256};
+static const dataset float32 = {"float32", MDBX_AGGREGATE_FLOATING,
+                                [](double x) { return buffer::key_from_float(float(x)); }, -128, 128};
+
+static MDBX_aggregate_value_t value_of(MDBX_aggregate_encoding_t encoding, double x) {
+  MDBX_aggregate_value_t value;
+  if (encoding == MDBX_AGGREGATE_UNSIGNED)
+    value.u = uint64_t(x);
+  else if (encoding == MDBX_AGGREGATE_SIGNED)
+    value.i = int64_t(x);
+  else
+    value.f = x;
+  return value;
+}
+
+static double as_double(MDBX_aggregate_encoding_t encoding, const MDBX_aggregate_value_t &value) {
+  return (encoding == MDBX_AGGREGATE_UNSIGNED) ? double(value.u)
+         : (encoding == MDBX_AGGREGATE_SIGNED) ? double(value.i)
+                                               : value.f;
+}
+
+/* aggregates the range [from, to) of sorted items and compares with the model,
+ * for a multi-value table the cursor is positioned to the key beforehand */
+static bool check(mdbx::cursor &cursor, const buffer *key, const dataset &set, const std::vector<double> &items,
+                  bool bounded, double from, double to) {
+  uint64_t histogram[8];
+  MDBX_aggregate_t result;
+  std::memset(&result, 0, sizeof(result));
+  result.histogram = histogram;
+  result.histogram_size = 8;
+  result.histogram_lower = value_of(set.encoding, set.histogram_lower);
+  result.histogram_upper = value_of(set.encoding, set.histogram_upper);
+
+  if (key)
+    cursor.seek(key->slice());
+  const buffer lower = set.encode(from), upper = set.encode(to);
+  int err = mdbx_cursor_aggregate(cursor, set.encoding, bounded ? &lower.slice() : nullptr,
+                                  bounded ? &upper.slice() : nullptr, &result);
+  if (err != MDBX_SUCCESS) {
+    std::cerr << "Fail: mdbx_cursor_aggregate() for " << set.name << ", err " << err << "\n";
+    return false;
+  }
+
+  uint64_t count = 0, expected_histogram[8] = {0};
+  double sum = 0, min = 0, max = 0;
+  for (const double x : items)
+    if (!bounded || (x >= from && x < to)) {
+      min = count ? min : x;
+      max = x;
+      sum += x;
+      count += 1;
+      const double bucket = (x - set.histogram_lower) * 8 / (set.histogram_upper - set.histogram_lower);
+      if (bucket >= 0 && bucket < 8)
+        expected_histogram[size_t(bucket)] += 1;
+    }
+
+  if (result.count != count || as_double(set.encoding, result.sum) != sum ||
+      (count && (as_double(set.encoding, result.min) != min || as_double(set.encoding, result.max) != max)) ||
+      std::memcmp(histogram, expected_histogram, sizeof(histogram)) != 0) {
+    std::cerr << "Fail: mismatch " << set.name << " [" << from << ", " << to << "), count " << result.count << "/"
+              << count << ", sum " << as_double(set.encoding, result.sum) << "/" << sum << "\n";
+    return false;
+  }
+
+  /* the cursor stays at the first item out of the range */
+  const auto beyond = std::lower_bound(items.begin(), items.end(), to);
+  if (bounded && beyond != items.end()) {
+    MDBX_val k, v;
+    err = mdbx_cursor_get(cursor, &k, &v, MDBX_GET_CURRENT);
+    if (err != MDBX_SUCCESS || mdbx::slice(key ? v : k) != set.encode(*beyond).slice()) {
+      std::cerr << "Fail: unexpected position of cursor for " << set.name << ", err " << err << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool check_ranges(mdbx::cursor &cursor, const buffer *key, const dataset &set, const std::vector<double> &items,
+                         double span) {
+  if (!check(cursor, key, set, items, false, 0, 0) ||
+      !check(cursor, key, set, items, true, items.front(), items.front()) ||
+      !check(cursor, key, set, items, true, items.back() + 1, items.back() + 2))
+    return false;
+  for (size_t i = 0; i < 42; ++i) {
+    double from = double(next() % uint64_t(span * 2)) - span, to = from + double(next() % uint64_t(span / 2));
+    if (set.encoding == MDBX_AGGREGATE_UNSIGNED)
+      from += span, to += span;
+    if (!check(cursor, key, set, items, true, from, to))
+      return false;
+  }
+  return true;
+}
+
+static int doit() {
+  mdbx::path db_filename = "test-aggregate";
+  mdbx::env_managed::remove(db_filename);
+  mdbx::env_managed env(db_filename, mdbx::env_managed::create_parameters(), mdbx::env::operate_parameters(8));
+
+  auto txn = env.start_write();
+  /* keys of tables with MDBX_INTEGERKEY are placed on many pages */
+  auto keys64 = txn.create_map("signed64", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  auto keys32 = txn.create_map("unsigned32", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  std::vector<double> signed_items, unsigned_items;
+  for (int64_t i = -30000; i < 30000; ++i)
+    if (next() % 3 == 0) {
+      txn.upsert(keys64, signed64.encode(double(i)), mdbx::slice("value"));
+      signed_items.push_back(double(i));
+      txn.upsert(keys32, unsigned32.encode(double(i + 30000)), mdbx::slice("value"));
+      unsigned_items.push_back(double(i + 30000));
+    }
+
+  /* multi-values are placed into the nested sub-trees, sub-pages and nodes */
+  auto doubles = txn.create_map("double64", mdbx::key_mode::usual, mdbx::value_mode::multi_ordinal);
+  auto floats = txn.create_map("float32", mdbx::key_mode::usual, mdbx::value_mode::multi_ordinal);
+  const buffer many("many"), few("few"), single("single");
+  std::vector<double> many_doubles, few_doubles, many_floats;
+  for (int64_t i = -20000; i < 20000; ++i)
+    if (next() % 2 == 0) {
+      txn.upsert(doubles, many, double64.encode(double(i) / 4));
+      many_doubles.push_back(double(i) / 4);
+      txn.upsert(floats, many, float32.encode(double(i) / 2));
+      many_floats.push_back(double(i) / 2);
+    }
+  for (const double x : {-7.5, -0.25, 0.0, 3.0, 100.75}) {
+    txn.upsert(doubles, few, double64.encode(x));
+    few_doubles.push_back(x);
+  }
+  txn.upsert(doubles, single, double64.encode(-42.5));
+  txn.upsert(floats, single, float32.encode(42.5));
+  auto plain = txn.create_map("plain");
+  txn.upsert(plain, buffer::key_from_u64(42), mdbx::slice("value"));
+  txn.commit();
+
+  txn = env.start_read();
+  auto cursor = txn.open_cursor(keys64);
+  if (!check_ranges(cursor, nullptr, signed64, signed_items, 30000))
+    return EXIT_FAILURE;
+  cursor.bind(txn, keys32);
+  if (!check_ranges(cursor, nullptr, unsigned32, unsigned_items, 30000))
+    return EXIT_FAILURE;
+  cursor.bind(txn, doubles);
+  if (!check_ranges(cursor, &many, double64, many_doubles, 5000) ||
+      !check_ranges(cursor, &few, double64, few_doubles, 200) ||
+      !check_ranges(cursor, &single, double64, {-42.5}, 100))
+    return EXIT_FAILURE;
+  cursor.bind(txn, floats);
+  if (!check_ranges(cursor, &many, float32, many_floats, 10000) ||
+      !check_ranges(cursor, &single, float32, {42.5}, 100))
+    return EXIT_FAILURE;
+
+  /* the unsuitable tables and unpositioned cursors are rejected */
+  MDBX_aggregate_t result;
+  std::memset(&result, 0, sizeof(result));
+  cursor.bind(txn, doubles);
+  if (mdbx_cursor_aggregate(cursor, MDBX_AGGREGATE_FLOATING, nullptr, nullptr, &result) != MDBX_ENODATA) {
+    std::cerr << "Fail: the unpositioned cursor is accepted\n";
+    return EXIT_FAILURE;
+  }
+  cursor.bind(txn, plain);
+  if (mdbx_cursor_aggregate(cursor, MDBX_AGGREGATE_UNSIGNED, nullptr, nullptr, &result) != MDBX_INCOMPATIBLE) {
+    std::cerr << "Fail: the table without MDBX_INTEGERKEY is accepted\n";
+    return EXIT_FAILURE;
+  }
+  txn.abort();
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,105 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <iostream>
+#include <vector>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+static bool lookup(mdbx::txn &txn, mdbx::map_handle map, std::vector<MDBX_cache_entry_t> &cache, uint64_t generation,
+                   const char *stage) {
+  for (uint64_t i = 0; i < cache.size(); ++i) {
+    const auto key = buffer::key_from_u64(i);
+    MDBX_val data;
+    const int err = mdbx_cache_get(txn, map.dbi, &key.slice(), &data, &cache[i]);
+    /* odd keys are absent */
+    const bool expected = i % 2 == 0;
+    if (err != (expected ? MDBX_SUCCESS : MDBX_NOTFOUND) ||
+        (expected && mdbx::slice(data).as_uint64() != i * 1000 + generation)) {
+      std::cerr << "Fail: mdbx_cache_get() mismatch for key " << i << " " << stage << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+static int doit() {
+  mdbx::path db_filename = "test-cache-get";
+  mdbx::env_managed::remove(db_filename);
+  mdbx::env_managed env(db_filename, mdbx::env_managed::create_parameters(), mdbx::env::operate_parameters(2));
+
+  const uint64_t total = 10000;
+  auto txn = env.start_write();
+  auto map = txn.create_map("cached", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  auto other = txn.create_map("other");
+  for (uint64_t i = 0; i < total; i += 2)
+    txn.append(map, buffer::key_from_u64(i), buffer::key_from_u64(i * 1000));
+  txn.commit();
+
+  std::vector<MDBX_cache_entry_t> cache(256);
+  for (auto &entry : cache)
+    mdbx_cache_init(&entry);
+
+  /* the statistics is available only if MDBX_ENABLE_PGOP_STAT is enabled */
+  const bool stat = env.get_info().mi_pgop_stat.newly != 0;
+  const auto before = env.get_info().mi_cache_stat;
+  txn = env.start_read();
+  if (!lookup(txn, map, cache, 0, "on the first pass") || !lookup(txn, map, cache, 0, "on the second pass"))
+    return EXIT_FAILURE;
+  txn.abort();
+
+  /* changes in another table don't affect the cache */
+  txn = env.start_write();
+  txn.upsert(other, buffer("key"), buffer("value"));
+  txn.commit();
+  txn = env.start_read();
+  if (!lookup(txn, map, cache, 0, "after commit into another table"))
+    return EXIT_FAILURE;
+  txn.abort();
+
+  const auto middle = env.get_info().mi_cache_stat;
+  if (stat && (middle.misses - before.misses != cache.size() || middle.hits - before.hits != cache.size() * 2 ||
+               middle.invalidations != before.invalidations)) {
+    std::cerr << "Fail: unexpected statistics " << middle.hits - before.hits << " hits, "
+              << middle.misses - before.misses << " misses\n";
+    return EXIT_FAILURE;
+  }
+
+  /* the entries are bypassed for a table modified within a write transaction */
+  txn = env.start_write();
+  if (!lookup(txn, map, cache, 0, "in a write transaction"))
+    return EXIT_FAILURE;
+  for (uint64_t i = 0; i < total; i += 2)
+    txn.update(map, buffer::key_from_u64(i), buffer::key_from_u64(i * 1000 + 1));
+  if (!lookup(txn, map, cache, 1, "after update in a write transaction"))
+    return EXIT_FAILURE;
+  txn.commit();
+
+  /* the entries are invalidated by the commit */
+  txn = env.start_read();
+  if (!lookup(txn, map, cache, 1, "after commit") || !lookup(txn, map, cache, 1, "after refresh"))
+    return EXIT_FAILURE;
+  txn.abort();
+
+  const auto after = env.get_info().mi_cache_stat;
+  if (stat &&
+      (after.invalidations - middle.invalidations != cache.size() || after.hits - middle.hits < cache.size() * 2)) {
+    std::cerr << "Fail: unexpected statistics " << after.invalidations - middle.invalidations
+              << " invalidations after commit\n";
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
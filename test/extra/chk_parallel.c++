@@ -0,0 +1,115 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+struct table_stat {
+  size_t payload_bytes, lost_bytes;
+  size_t all, empty, broken, branch, leaf, nested_branch, nested_leaf, nested_subleaf;
+  bool operator==(const table_stat &other) const { return std::memcmp(this, &other, sizeof(*this)) == 0; }
+};
+
+/* the ids are assigned in the order of visiting, so tables are matched by names */
+using chk_stat = std::map<std::string, table_stat>;
+
+static int table_conclude(MDBX_chk_context_t *ctx, const MDBX_chk_table_t *table, MDBX_cursor *, int err) {
+  chk_stat &stat = *static_cast<chk_stat *>(mdbx_env_get_userctx(ctx->env));
+  const bool pseudo = table->name.iov_base == MDBX_CHK_MAIN || table->name.iov_base == MDBX_CHK_GC ||
+                      table->name.iov_base == MDBX_CHK_META;
+  table_stat &item =
+      stat[pseudo ? "@" + std::to_string(table->id) : std::string(static_cast<const char *>(table->name.iov_base),
+                                                                   table->name.iov_len)];
+  std::memset(&item, 0, sizeof(item));
+  item.payload_bytes = table->payload_bytes;
+  item.lost_bytes = table->lost_bytes;
+  item.all = table->pages.all;
+  item.empty = table->pages.empty;
+  item.broken = table->pages.broken;
+  item.branch = table->pages.branch;
+  item.leaf = table->pages.leaf;
+  item.nested_branch = table->pages.nested_branch;
+  item.nested_leaf = table->pages.nested_leaf;
+  item.nested_subleaf = table->pages.nested_subleaf;
+  return err;
+}
+
+static bool chk(mdbx::env_managed &env, unsigned threads, chk_stat &stat, MDBX_chk_context_t &ctx) {
+  MDBX_chk_callbacks_t cb;
+  std::memset(&cb, 0, sizeof(cb));
+  cb.table_conclude = table_conclude;
+  std::memset(&ctx, 0, sizeof(ctx));
+  ctx.threads = threads;
+  mdbx::error::success_or_throw(mdbx_env_set_userctx(env, &stat));
+  mdbx::error::success_or_throw(mdbx_env_chk(env, &cb, &ctx, MDBX_chk_flags_t(0), MDBX_chk_error, 0));
+  mdbx::error::success_or_throw(mdbx_env_set_userctx(env, nullptr));
+  if (ctx.result.total_problems) {
+    std::cerr << "Fail: " << ctx.result.total_problems << " problem(s) with " << threads << " thread(s)\n";
+    return false;
+  }
+  return true;
+}
+
+static int doit() {
+  const char *const db_filename = "test-chk-parallel";
+  mdbx::env_managed::remove(db_filename);
+
+  mdbx::env_managed::create_parameters create;
+  create.geometry.make_dynamic(1 << 20, 1 << 30);
+  create.geometry.pagesize = 4096;
+  mdbx::env_managed env(db_filename, create, mdbx::env::operate_parameters(16));
+
+  /* several tables of different kinds, so the walk is spread over the workers */
+  auto txn = env.start_write();
+  for (unsigned n = 0; n < 8; ++n) {
+    auto plain = txn.create_map("plain-" + std::to_string(n), mdbx::key_mode::ordinal, mdbx::value_mode::single);
+    auto dups =
+        txn.create_map("dups-" + std::to_string(n), mdbx::key_mode::ordinal, mdbx::value_mode::multi_samelength);
+    for (uint64_t i = 0; i < 20000; ++i) {
+      txn.upsert(plain, buffer::key_from_u64(i), mdbx::slice(std::string(8 + i % 64, char('a' + i % 26))));
+      txn.upsert(dups, buffer::key_from_u64(i % 97), buffer::key_from_u64(i));
+    }
+    for (uint64_t i = 0; i < 20000; i += 3)
+      txn.erase(plain, buffer::key_from_u64(i));
+  }
+  txn.commit();
+
+  chk_stat sequential, parallel;
+  MDBX_chk_context_t seq_ctx, par_ctx;
+  if (!chk(env, 1, sequential, seq_ctx) || !chk(env, 4, parallel, par_ctx))
+    return EXIT_FAILURE;
+
+  if (sequential.size() != 18 || sequential != parallel) {
+    std::cerr << "Fail: per-table statistics of the parallel walk differ from the sequential one\n";
+    return EXIT_FAILURE;
+  }
+  if (seq_ctx.result.processed_pages != par_ctx.result.processed_pages ||
+      seq_ctx.result.total_payload_bytes != par_ctx.result.total_payload_bytes ||
+      seq_ctx.result.total_unused_bytes != par_ctx.result.total_unused_bytes ||
+      seq_ctx.result.unused_pages != par_ctx.result.unused_pages ||
+      seq_ctx.result.gc_pages != par_ctx.result.gc_pages || seq_ctx.result.alloc_pages != par_ctx.result.alloc_pages ||
+      seq_ctx.result.table_processed != par_ctx.result.table_processed) {
+    std::cerr << "Fail: totals of the parallel walk differ from the sequential one\n";
+    return EXIT_FAILURE;
+  }
+
+  env.close();
+  mdbx::env_managed::remove(db_filename);
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,114 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <iostream>
+#include <string>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+struct progress {
+  size_t calls, loaded, stop_after;
+};
+
+static int report(void *ctx, size_t loaded, size_t pending) noexcept {
+  progress *const state = static_cast<progress *>(ctx);
+  state->calls += 1;
+  state->loaded = loaded;
+  (void)pending;
+  return (state->stop_after && loaded >= state->stop_after) ? MDBX_RESULT_TRUE : MDBX_SUCCESS;
+}
+
+static bool check(mdbx::txn &txn, MDBX_dbi dbi, MDBX_warmup_tree_flags_t flags, unsigned levels, unsigned threads,
+                  size_t expected) {
+  progress state = {0, 0, 0};
+  const int err = mdbx_dbi_warmup(txn, dbi, flags, levels, threads, report, &state);
+  if (err != MDBX_SUCCESS || state.loaded != expected || state.calls < 1) {
+    std::cerr << "Fail: mdbx_dbi_warmup(dbi " << dbi << ", flags " << unsigned(flags) << ", levels " << levels
+              << ", threads " << threads << "), err " << err << ", loaded " << state.loaded << " instead of "
+              << expected << " pages\n";
+    return false;
+  }
+  return true;
+}
+
+static int doit() {
+  mdbx::path db_filename = "test-dbi-warmup";
+  mdbx::env_managed::remove(db_filename);
+  mdbx::env_managed env(db_filename, mdbx::env_managed::create_parameters(), mdbx::env::operate_parameters(4));
+
+  auto txn = env.start_write();
+  auto plain = txn.create_map("plain", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  auto multi = txn.create_map("multi", mdbx::key_mode::ordinal, mdbx::value_mode::multi);
+  const std::string large(env.get_pagesize() * 3, 'x');
+  for (uint64_t i = 0; i < 300000; ++i) {
+    /* a few long values are placed on large pages */
+    txn.upsert(plain, buffer::key_from_u64(i), (i % 1000) ? mdbx::slice("a short value") : mdbx::slice(large));
+    /* a few keys have many multi-values in the nested b-trees */
+    txn.upsert(multi, buffer::key_from_u64(i % 1000 ? i : 0), buffer::key_from_u64(i));
+  }
+  txn.commit();
+
+  txn = env.start_read();
+  const auto main_dbi = txn.open_map(nullptr).dbi;
+  const auto stat_main = txn.get_map_stat(mdbx::map_handle(main_dbi));
+  const auto stat_plain = txn.get_map_stat(plain), stat_multi = txn.get_map_stat(multi);
+  if (stat_plain.ms_depth < 3) {
+    std::cerr << "Fail: the b-tree is too shallow for the test\n";
+    return EXIT_FAILURE;
+  }
+
+  /* an excessive number of threads is clamped */
+  for (const unsigned threads : {1u, 4u, 100000u})
+    if (!check(txn, plain.dbi, MDBX_warmup_tree_branches, 0, threads, stat_plain.ms_branch_pages) ||
+        !check(txn, plain.dbi, MDBX_warmup_tree_branches, 1, threads, 1) ||
+        !check(txn, plain.dbi, MDBX_warmup_tree_leaves, 0, threads,
+               stat_plain.ms_branch_pages + stat_plain.ms_leaf_pages) ||
+        !check(txn, plain.dbi, MDBX_warmup_tree_large, 0, threads,
+               stat_plain.ms_branch_pages + stat_plain.ms_leaf_pages + stat_plain.ms_overflow_pages) ||
+        !check(txn, multi.dbi, MDBX_warmup_tree_nested | MDBX_warmup_tree_leaves, 0, threads,
+               stat_multi.ms_branch_pages + stat_multi.ms_leaf_pages) ||
+        /* the whole database by the single call */
+        !check(txn, main_dbi,
+               MDBX_warmup_tree_tables | MDBX_warmup_tree_leaves | MDBX_warmup_tree_large | MDBX_warmup_tree_nested, 0,
+               threads,
+               stat_main.ms_branch_pages + stat_main.ms_leaf_pages + stat_plain.ms_branch_pages +
+                   stat_plain.ms_leaf_pages + stat_plain.ms_overflow_pages + stat_multi.ms_branch_pages +
+                   stat_multi.ms_leaf_pages))
+      return EXIT_FAILURE;
+
+  /* the warming up is stopped by the callback */
+  progress state = {0, 0, 1};
+  int err = mdbx_dbi_warmup(txn, plain.dbi, MDBX_warmup_tree_leaves, 0, 4, report, &state);
+  if (err != MDBX_RESULT_TRUE || state.loaded >= stat_plain.ms_branch_pages + stat_plain.ms_leaf_pages) {
+    std::cerr << "Fail: the warming up is not stopped, err " << err << "\n";
+    return EXIT_FAILURE;
+  }
+  txn.abort();
+
+  /* a write transaction is handled by the calling thread, including dirty pages */
+  txn = env.start_write();
+  txn.upsert(plain, buffer::key_from_u64(42), mdbx::slice("dirty"));
+  const auto stat_dirty = txn.get_map_stat(plain);
+  if (!check(txn, plain.dbi, MDBX_warmup_tree_leaves, 0, 4, stat_dirty.ms_branch_pages + stat_dirty.ms_leaf_pages))
+    return EXIT_FAILURE;
+  err = mdbx_dbi_warmup(txn, plain.dbi, MDBX_warmup_tree_flags_t(MDBX_warmup_tree_tables << 1), 0, 1, nullptr, nullptr);
+  if (err != MDBX_EINVAL) {
+    std::cerr << "Fail: an unknown flag is accepted\n";
+    return EXIT_FAILURE;
+  }
+  txn.abort();
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,104 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <iostream>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+static void fill(mdbx::txn &txn, mdbx::map_handle map, uint64_t from, uint64_t to) {
+  const std::string large(4567, '*');
+  for (uint64_t i = from; i < to; ++i)
+    txn.upsert(map, buffer::key_from_u64(i * 7919 % 1000003),
+               (i % 1000) ? buffer::key_from_u64(i) : buffer(mdbx::slice(large.data(), large.size())));
+}
+
+static bool verify(mdbx::txn &txn, mdbx::map_handle map, uint64_t total) {
+  for (uint64_t i = 0; i < total; ++i) {
+    const auto data = txn.get(map, buffer::key_from_u64(i * 7919 % 1000003));
+    if ((i % 1000) ? data.as_uint64() != i : data.length() != 4567) {
+      std::cerr << "Fail: mismatch for item " << i << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+static int doit() {
+  mdbx::path db_filename = "test-dp-slab";
+  mdbx::env_managed::remove(db_filename);
+  mdbx::env_managed env(db_filename, mdbx::env_managed::create_parameters(),
+                        mdbx::env::operate_parameters(1, 0, mdbx::env::mode::write_file_io));
+
+  try {
+    env.set_extra_option(mdbx::env::extra_runtime_option::dp_slab, 3);
+    std::cerr << "Fail: invalid value of the slab option was accepted\n";
+    return EXIT_FAILURE;
+  } catch (const std::invalid_argument &) {
+  }
+
+  env.set_extra_option(mdbx::env::extra_runtime_option::dp_slab, 2);
+  if (env.extra_option(mdbx::env::extra_runtime_option::dp_slab) != 2) {
+    std::cerr << "Fail: slab option was not applied\n";
+    return EXIT_FAILURE;
+  }
+
+  const uint64_t total = 100000;
+  auto txn = env.start_write();
+  auto map = txn.create_map("slab", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  fill(txn, map, 0, total / 2);
+  auto info = env.get_info(txn);
+  if (!info.mi_dp_slab.chunks || !info.mi_dp_slab.used ||
+      info.mi_dp_slab.bytes < info.mi_dp_slab.used * env.get_pagesize()) {
+    std::cerr << "Fail: unexpected slab usage " << info.mi_dp_slab.used << " pages within " << info.mi_dp_slab.chunks
+              << " chunks\n";
+    return EXIT_FAILURE;
+  }
+
+  /* pages are returned into the slab by a nested transaction */
+  auto nested = txn.start_nested();
+  fill(nested, map, total / 2, total * 3 / 4);
+  nested.abort();
+  auto nested_commit = txn.start_nested();
+  fill(nested_commit, map, total / 2, total);
+  nested_commit.commit();
+  txn.commit();
+
+  info = env.get_info();
+  if (info.mi_dp_slab.used || !info.mi_dp_slab.chunks || info.mi_dp_slab.hugetlb > info.mi_dp_slab.chunks) {
+    std::cerr << "Fail: " << info.mi_dp_slab.used << " slab pages remain used after commit within "
+              << info.mi_dp_slab.chunks << " chunks\n";
+    return EXIT_FAILURE;
+  }
+
+  /* the slab can be disabled while pages are allocated from it */
+  txn = env.start_write();
+  fill(txn, map, 0, total / 4);
+  env.set_extra_option(mdbx::env::extra_runtime_option::dp_slab, 0);
+  fill(txn, map, total / 4, total / 2);
+  txn.commit();
+
+  info = env.get_info();
+  if (info.mi_dp_slab.chunks || info.mi_dp_slab.bytes || info.mi_dp_slab.used) {
+    std::cerr << "Fail: slab still has " << info.mi_dp_slab.chunks << " chunks after disabling\n";
+    return EXIT_FAILURE;
+  }
+
+  txn = env.start_read();
+  if (!verify(txn, map, total))
+    return EXIT_FAILURE;
+  txn.abort();
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
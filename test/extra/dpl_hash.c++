@@ -0,0 +1,106 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <iostream>
+#include <string>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+/* a record occupies about half of a page, so a few thousand of records
+ * make the dirty page list longer than MDBX_DPL_HASH_THRESHOLD */
+static std::string value(uint64_t i) { return std::string(1800 + i % 64, char('a' + i % 26)) + std::to_string(i); }
+
+static uint64_t key(uint64_t i) { return i * 7919 % 1000003; }
+
+static bool erased(uint64_t i) { return i % 3 == 0; }
+
+static void fill(mdbx::txn &txn, mdbx::map_handle map, uint64_t from, uint64_t to) {
+  for (uint64_t i = from; i < to; ++i)
+    txn.upsert(map, buffer::key_from_u64(key(i)), mdbx::slice(value(i)));
+}
+
+static void erase(mdbx::txn &txn, mdbx::map_handle map, uint64_t from, uint64_t to) {
+  for (uint64_t i = from; i < to; ++i)
+    if (erased(i) && !txn.erase(map, buffer::key_from_u64(key(i))))
+      throw std::logic_error("erase failed");
+}
+
+static bool verify(mdbx::txn &txn, mdbx::map_handle map, uint64_t from, uint64_t to, bool after_erase) {
+  for (uint64_t i = from; i < to; ++i) {
+    const auto data = txn.get(map, buffer::key_from_u64(key(i)), mdbx::slice::invalid());
+    if (after_erase && erased(i) ? data.is_valid() : data != mdbx::slice(value(i))) {
+      std::cerr << "Fail: mismatch for item " << i << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+/* MDBX_DPL_HASH_THRESHOLD is 4096 by default */
+static bool hashed(mdbx::txn &txn, const char *caption) {
+  if (txn.size_current() > 4096 * txn.env().get_pagesize())
+    return true;
+  std::cerr << "Fail: too few dirty pages within the " << caption << " transaction\n";
+  return false;
+}
+
+static int doit() {
+  mdbx::path db_filename = "test-dpl-hash";
+  mdbx::env_managed::remove(db_filename);
+  mdbx::env_managed::create_parameters create;
+  create.geometry.make_dynamic(1 << 20, 1 << 30);
+  create.geometry.pagesize = 4096;
+  mdbx::env_managed env(db_filename, create, mdbx::env::operate_parameters(1, 0, mdbx::env::mode::write_file_io));
+  /* the dirty pages are tracked only without MDBX_WRITEMAP,
+   * and the limit is above the threshold, so the spilling occurs with the hash index */
+  env.set_extra_option(mdbx::env::extra_runtime_option::dp_limit, 16384);
+
+  const uint64_t total = 24000;
+  auto txn = env.start_write();
+  auto map = txn.create_map("dpl", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  fill(txn, map, 0, total);
+  if (!hashed(txn, "parent") || !verify(txn, map, 0, total, false))
+    return EXIT_FAILURE;
+  erase(txn, map, 0, total);
+  if (!verify(txn, map, 0, total, true))
+    return EXIT_FAILURE;
+
+  /* the dirty pages of a nested transaction are merged into the parent's ones */
+  auto nested = txn.start_nested();
+  fill(nested, map, total, total + 12000);
+  if (!hashed(nested, "nested"))
+    return EXIT_FAILURE;
+  erase(nested, map, total, total + 12000);
+  if (!verify(nested, map, 0, total + 12000, true))
+    return EXIT_FAILURE;
+  nested.commit();
+  if (!verify(txn, map, 0, total + 12000, true))
+    return EXIT_FAILURE;
+
+  const auto stat = txn.commit_get_stat();
+  if (stat.spill.spilled == 0) {
+    std::cerr << "Fail: no pages were spilled\n";
+    return EXIT_FAILURE;
+  }
+
+  txn = env.start_read();
+  if (!verify(txn, map, 0, total + 12000, true))
+    return EXIT_FAILURE;
+  txn.abort();
+
+  env.close();
+  mdbx::env_managed::remove(db_filename);
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,152 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <set>
+#include <vector>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+enum class kind { u64, u32, bigendian, decimal };
+
+static buffer encode(kind k, uint64_t v) {
+  switch (k) {
+  case kind::u64:
+    return buffer::key_from_u64(v);
+  case kind::u32:
+    return buffer::key_from_u32(uint32_t(v));
+  case kind::bigendian: {
+    const char bytes[4] = {char(v >> 24), char(v >> 16), char(v >> 8), char(v)};
+    return buffer(mdbx::slice(bytes, sizeof(bytes)));
+  }
+  default: {
+    char text[16];
+    snprintf(text, sizeof(text), "%08u", unsigned(v));
+    return buffer(text);
+  }
+  }
+}
+
+static uint64_t decode(kind k, const MDBX_val &v) {
+  const mdbx::slice s(v);
+  switch (k) {
+  case kind::u64:
+    return s.as_uint64();
+  case kind::u32:
+    return s.as_uint32();
+  case kind::bigendian: {
+    const uint8_t *p = static_cast<const uint8_t *>(s.data());
+    return uint32_t(p[0]) << 24 | uint32_t(p[1]) << 16 | uint32_t(p[2]) << 8 | p[3];
+  }
+  default:
+    return std::stoul(std::string(s.char_ptr(), s.length()));
+  }
+}
+
+static const unsigned terms[] = {2, 3, 5, 997, 210 /* single value */};
+
+static std::vector<uint64_t> posting(unsigned term, uint64_t total) {
+  std::vector<uint64_t> list;
+  if (term == 210)
+    list.push_back(term);
+  else
+    for (uint64_t v = 0; v < total; v += term)
+      list.push_back(v);
+  return list;
+}
+
+static bool check(mdbx::txn &txn, mdbx::map_handle map, kind k, const std::vector<unsigned> &query,
+                  MDBX_merge_mode_t mode, size_t limit, uint64_t total) {
+  std::vector<uint64_t> expected = posting(query.front(), total);
+  for (size_t i = 1; i < query.size(); ++i) {
+    const auto other = posting(query[i], total);
+    std::vector<uint64_t> merged;
+    if (mode == MDBX_MERGE_INTERSECTION)
+      std::set_intersection(expected.begin(), expected.end(), other.begin(), other.end(), std::back_inserter(merged));
+    else
+      std::set_union(expected.begin(), expected.end(), other.begin(), other.end(), std::back_inserter(merged));
+    expected.swap(merged);
+  }
+
+  std::vector<mdbx::cursor_managed> cursors;
+  std::vector<MDBX_cursor *> handles;
+  for (const auto term : query) {
+    cursors.push_back(txn.open_cursor(map));
+    cursors.back().seek(buffer::key_from_u64(term));
+    handles.push_back(cursors.back());
+  }
+
+  std::vector<MDBX_val> values(limit);
+  std::vector<uint64_t> actual;
+  MDBX_val last;
+  int err;
+  do {
+    size_t count;
+    err = mdbx_cursor_merge_batch(handles.data(), handles.size(), mode, &count, values.data(), limit,
+                                  actual.empty() ? nullptr : &last);
+    if (err != MDBX_SUCCESS && err != MDBX_RESULT_TRUE)
+      mdbx::error::throw_exception(err);
+    for (size_t i = 0; i < count; ++i)
+      actual.push_back(decode(k, values[i]));
+    if (count)
+      last = values[count - 1];
+  } while (err == MDBX_SUCCESS);
+
+  if (actual != expected) {
+    std::cerr << "Fail: " << (mode == MDBX_MERGE_INTERSECTION ? "intersection" : "union") << " of " << query.size()
+              << " lists for kind " << int(k) << " with limit " << limit << " yields " << actual.size()
+              << " values instead of " << expected.size() << "\n";
+    return false;
+  }
+  return true;
+}
+
+static int doit() {
+  mdbx::path db_filename = "test-dupsort-merge";
+  mdbx::env_managed::remove(db_filename);
+  mdbx::env_managed env(db_filename, mdbx::env_managed::create_parameters(), mdbx::env::operate_parameters(4));
+
+  const uint64_t total = 65536;
+  const std::pair<kind, mdbx::value_mode> kinds[] = {{kind::u64, mdbx::value_mode::multi_ordinal},
+                                                      {kind::u32, mdbx::value_mode::multi_ordinal},
+                                                      {kind::bigendian, mdbx::value_mode::multi_samelength},
+                                                      {kind::decimal, mdbx::value_mode::multi}};
+
+  auto txn = env.start_write();
+  std::vector<mdbx::map_handle> maps;
+  for (const auto &k : kinds) {
+    maps.push_back(txn.create_map("merge-" + std::to_string(int(k.first)), mdbx::key_mode::ordinal, k.second));
+    for (const auto term : terms)
+      for (const auto v : posting(term, total))
+        txn.upsert(maps.back(), buffer::key_from_u64(term), encode(k.first, v));
+  }
+  txn.commit();
+
+  const std::vector<std::vector<unsigned>> queries = {{2}, {2, 3}, {2, 3, 5}, {3, 5, 997}, {2, 210}, {997, 5, 3, 2}};
+  for (const bool write : {false, true}) {
+    txn = write ? env.start_write() : env.start_read();
+    for (size_t i = 0; i < maps.size(); ++i)
+      for (const auto &query : queries)
+        for (const auto mode : {MDBX_MERGE_INTERSECTION, MDBX_MERGE_UNION})
+          for (const size_t limit : {1, 7, 4096})
+            if ((limit > 1 || query.size() > 2) && !check(txn, maps[i], kinds[i].first, query, mode, limit, total))
+              return EXIT_FAILURE;
+    txn.abort();
+  }
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,161 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+using model = std::map<uint64_t, std::set<std::string>>;
+
+static uint64_t prng = 42;
+static uint64_t next() {
+  prng = prng * 6364136223846793005ull + 1442695040888963407ull;
+  return prng >> 33;
+}
+
+static std::vector<std::string> make_values(size_t count, size_t max_length, const char *prefix = "") {
+  std::vector<std::string> values;
+  for (size_t i = 0; i < count; ++i) {
+    std::string value(prefix);
+    value += std::to_string(next());
+    value.append(next() % max_length, char('a' + i % 26));
+    values.push_back(value);
+  }
+  return values;
+}
+
+static std::vector<mdbx::slice> slices(const std::vector<std::string> &values) {
+  std::vector<mdbx::slice> result;
+  for (const auto &value : values)
+    result.emplace_back(value);
+  return result;
+}
+
+static bool verify(mdbx::txn &txn, mdbx::map_handle map, const model &expected, const char *stage) {
+  auto cursor = txn.open_cursor(map);
+  model actual;
+  for (auto data = cursor.to_first(false); data; data = cursor.to_next(false))
+    actual[data.key.as_uint64()].insert(std::string(data.value.char_ptr(), data.value.length()));
+  if (actual != expected) {
+    std::cerr << "Fail: mismatch " << stage << "\n";
+    return false;
+  }
+  if (txn.get_map_stat(map).ms_entries != [&] {
+        size_t total = 0;
+        for (const auto &item : expected)
+          total += item.second.size();
+        return total;
+      }()) {
+    std::cerr << "Fail: wrong number of items " << stage << "\n";
+    return false;
+  }
+  return true;
+}
+
+static int doit() {
+  mdbx::path db_filename = "test-dupsort-multiple";
+  mdbx::env_managed::remove(db_filename);
+  mdbx::env_managed env(db_filename, mdbx::env_managed::create_parameters(), mdbx::env::operate_parameters(4));
+
+  model expected;
+  auto txn = env.start_write();
+  auto map = txn.create_map("multiple", mdbx::key_mode::ordinal, mdbx::value_mode::multi);
+
+  /* batches of different sizes, unsorted and with duplicates, so both
+   * sub-pages and nested sub-trees are created and extended */
+  for (size_t round = 0; round < 300; ++round) {
+    const uint64_t key = next() % 50;
+    auto values = make_values(next() % (round % 3 ? 20 : 700) + 1, round % 7 ? 40 : 400);
+    if (round % 5 == 0)
+      values.push_back(values.front());
+    if (round % 2) {
+      const size_t done = txn.put_multiple(map, buffer::key_from_u64(key), slices(values).data(), values.size(),
+                                           mdbx::upsert);
+      if (done != values.size()) {
+        std::cerr << "Fail: unexpected count " << done << " of " << values.size() << " stored items\n";
+        return EXIT_FAILURE;
+      }
+    } else {
+      auto cursor = txn.open_cursor(map);
+      cursor.put_multiple(buffer::key_from_u64(key), slices(values), mdbx::upsert);
+    }
+    expected[key].insert(values.begin(), values.end());
+    if (round % 100 == 99) {
+      txn.commit();
+      txn = env.start_write();
+    }
+  }
+  if (!verify(txn, map, expected, "after upserts"))
+    return EXIT_FAILURE;
+
+  /* appending of sorted values which are greater than the existing ones */
+  for (auto &item : expected) {
+    auto values = make_values(next() % 100 + 1, 30, "~");
+    std::set<std::string> sorted(values.begin(), values.end());
+    values.assign(sorted.begin(), sorted.end());
+    txn.put_multiple(map, buffer::key_from_u64(item.first), slices(values).data(), values.size(),
+                     mdbx::put_mode(MDBX_APPENDDUP));
+    item.second.insert(values.begin(), values.end());
+  }
+
+  /* replacing all values of a key */
+  auto values = make_values(333, 50);
+  txn.put_multiple(map, buffer::key_from_u64(expected.begin()->first), slices(values).data(), values.size(),
+                   mdbx::put_mode(MDBX_ALLDUPS));
+  expected.begin()->second.clear();
+  expected.begin()->second.insert(values.begin(), values.end());
+  txn.commit();
+
+  txn = env.start_read();
+  if (!verify(txn, map, expected, "after commit"))
+    return EXIT_FAILURE;
+  txn.abort();
+
+  /* the batch is stopped at the existing value when it is not allowed */
+  txn = env.start_write();
+  const auto &first = *expected.rbegin();
+  values = make_values(3, 10, "!");
+  values.insert(values.begin() + 2, *first.second.begin());
+  const size_t done = txn.put_multiple(map, buffer::key_from_u64(first.first), slices(values).data(), values.size(),
+                                       mdbx::put_mode(MDBX_NODUPDATA), true);
+  if (done != 2) {
+    std::cerr << "Fail: unexpected count " << done << " of stored items before the existing one\n";
+    return EXIT_FAILURE;
+  }
+
+  /* too long values are rejected before any changes */
+  values.push_back(std::string(env.get_pagesize(), 'x'));
+  try {
+    txn.put_multiple(map, buffer::key_from_u64(first.first), slices(values).data(), values.size(), mdbx::upsert);
+    std::cerr << "Fail: the too long value is accepted\n";
+    return EXIT_FAILURE;
+  } catch (const mdbx::bad_value_size &) {
+  }
+
+  /* tables without multi-values are not supported */
+  auto single = txn.create_map("single");
+  try {
+    txn.put_multiple(single, buffer::key_from_u64(0), slices(values).data(), values.size(), mdbx::upsert);
+    std::cerr << "Fail: the table without multi-values is accepted\n";
+    return EXIT_FAILURE;
+  } catch (const mdbx::incompatible_operation &) {
+  }
+  txn.abort();
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,145 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__) || defined(__gnu_linux__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+/* the content of the given device will be destroyed, so it is taken only from the environment */
+static const char *blockdev() {
+  const char *const device = std::getenv("MDBX_TEST_BLOCKDEV");
+  struct stat st;
+  return (device && stat(device, &st) == 0 && S_ISBLK(st.st_mode)) ? device : nullptr;
+}
+
+static bool wipe(const char *device, size_t bytes = 1 << 20) {
+  const int fd = open(device, O_WRONLY);
+  if (fd < 0)
+    return false;
+  const std::vector<char> zeros(bytes, 0);
+  const bool ok = pwrite(fd, zeros.data(), zeros.size(), 0) == ssize_t(zeros.size()) && fdatasync(fd) == 0;
+  return close(fd) == 0 && ok;
+}
+
+static bool workload(const char *device, mdbx::env::mode mode) {
+  const char *const db_dirname = "test-dxb-blockdev";
+  const std::string db_filename = std::string(db_dirname) + "/mdbx.dat";
+  mdbx::env_managed::remove(db_dirname);
+  if (!wipe(device) || mkdir(db_dirname, 0755) || symlink(device, db_filename.c_str())) {
+    std::cerr << "Fail: could not prepare " << device << "\n";
+    return false;
+  }
+
+  const uint64_t total = 100000;
+  mdbx::env::geometry geometry;
+  /* the growth step and limits are ignored in favor of the device capacity */
+  geometry.make_dynamic(1 << 20, 1 << 30);
+  geometry.growth_step = 1 << 20;
+  geometry.pagesize = 4096;
+  {
+    mdbx::env_managed::create_parameters create;
+    create.geometry = geometry;
+    mdbx::env_managed env(db_dirname, create, mdbx::env::operate_parameters(4, 0, mode));
+    struct stat st;
+    if (stat((std::string(db_dirname) + "/mdbx.lck").c_str(), &st) || !S_ISREG(st.st_mode)) {
+      std::cerr << "Fail: the lock file is not beside the symlink to the device\n";
+      return false;
+    }
+
+    auto info = env.get_info();
+    if (info.mi_geo.lower != info.mi_geo.upper || info.mi_geo.current != info.mi_geo.upper ||
+        info.mi_geo.grow != 0 || info.mi_geo.shrink != 0) {
+      std::cerr << "Fail: the geometry is not fixed by the device capacity\n";
+      return false;
+    }
+    if (mdbx_env_set_geometry(env, -1, -1, info.mi_geo.upper / 2, -1, -1, -1) != MDBX_EPERM) {
+      std::cerr << "Fail: the geometry of the device is changed\n";
+      return false;
+    }
+
+    auto txn = env.start_write();
+    auto map = txn.create_map("blockdev", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+    for (uint64_t i = 0; i < total; ++i) {
+      txn.upsert(map, buffer::key_from_u64(i * 7919 % 1000003), buffer::key_from_u64(i));
+      if (i % 10000 == 9999)
+        txn.commit(), txn = env.start_write();
+    }
+    txn.commit();
+    /* the items are reachable from any of the meta-pages */
+    for (unsigned n = 0; n < 3; ++n) {
+      txn = env.start_write();
+      txn.upsert(txn.create_map("marker"), buffer::key_from_u64(n), buffer::key_from_u64(n));
+      txn.commit();
+    }
+    env.close();
+  }
+
+  /* the only zeroed meta-page is a damage rather than a blank device, so the database is not formatted again */
+  if (!wipe(device, geometry.pagesize)) {
+    std::cerr << "Fail: could not zero the first meta-page of " << device << "\n";
+    return false;
+  }
+  {
+    mdbx::env_managed::create_parameters create;
+    create.geometry = geometry;
+    mdbx::env_managed env(db_dirname, create, mdbx::env::operate_parameters(4, 0, mode));
+    env.close();
+  }
+
+  /* re-open the existing database on the device */
+  mdbx::env_managed env(db_dirname, mdbx::env::operate_parameters(4));
+  auto txn = env.start_read();
+  auto map = txn.open_map("blockdev", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  if (txn.get_map_stat(map).ms_entries != total) {
+    std::cerr << "Fail: unexpected number of items\n";
+    return false;
+  }
+  for (uint64_t i = 0; i < total; ++i)
+    if (txn.get(map, buffer::key_from_u64(i * 7919 % 1000003)).as_uint64() != i) {
+      std::cerr << "Fail: mismatch for item " << i << "\n";
+      return false;
+    }
+  txn.abort();
+  env.close();
+  return mdbx::env_managed::remove(db_dirname);
+}
+
+static int doit() {
+  const char *const device = blockdev();
+  if (!device) {
+    std::cout << "Skipped: no block device is given by MDBX_TEST_BLOCKDEV\n";
+    return EXIT_SUCCESS;
+  }
+
+  for (const auto mode : {mdbx::env::mode::write_file_io, mdbx::env::mode::write_mapped_io})
+    if (!workload(device, mode))
+      return EXIT_FAILURE;
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+#else
+static int doit() {
+  std::cout << "Skipped: raw block devices are supported only on Linux\n";
+  return EXIT_SUCCESS;
+}
+#endif /* Linux */
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,103 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <iostream>
+#include <memory>
+#include <string>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+/* the option is set through C API, so the handle is created by C API too */
+struct env_handle : public mdbx::env {
+  env_handle(MDBX_env *ptr) : mdbx::env(ptr) {}
+};
+
+/* large values are placed into multi-page buffers allocated by malloc,
+ * so the aligned pages from the slab are interleaved with unaligned ones */
+static buffer value(uint64_t i) {
+  return (i % 1000) ? buffer::key_from_u64(i) : buffer(mdbx::slice(std::string(4567 + i % 7, char('a' + i % 26))));
+}
+
+static bool workload(MDBX_env_flags_t flags, bool slab) {
+  const char *const db_filename = "test-dxb-direct-write";
+  mdbx::env_managed::remove(db_filename);
+
+  const uint64_t total = 100000;
+  {
+    MDBX_env *handle;
+    mdbx::error::success_or_throw(mdbx_env_create(&handle));
+    std::unique_ptr<MDBX_env, int (*)(MDBX_env *)> guard(handle, mdbx_env_close);
+    env_handle env(handle);
+    mdbx::error::success_or_throw(mdbx_env_set_geometry(env, -1, -1, 1 << 30, 1 << 20, -1, -1));
+    mdbx::error::success_or_throw(mdbx_env_set_option(env, MDBX_opt_max_db, 4));
+    mdbx::error::success_or_throw(mdbx_env_set_option(env, MDBX_opt_dp_slab, slab));
+    const int err = mdbx_env_set_option(env, MDBX_opt_dxb_direct_write, 1);
+    if (err == MDBX_ENOSYS) {
+      std::cout << "Skipped: the direct write is not supported\n";
+      return true;
+    }
+    mdbx::error::success_or_throw(err);
+    mdbx::error::success_or_throw(mdbx_env_open(env, db_filename, flags | MDBX_NOSUBDIR | MDBX_NORDAHEAD, 0664));
+    if (mdbx_env_set_option(env, MDBX_opt_dxb_direct_write, 0) != MDBX_EPERM) {
+      std::cerr << "Fail: the option is changed after open\n";
+      return false;
+    }
+
+    /* both large and small transactions, with reading back through the mapping in between */
+    auto txn = env.start_write();
+    auto map = txn.create_map("direct", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+    for (uint64_t i = 0; i < total; ++i) {
+      txn.upsert(map, buffer::key_from_u64(i * 7919 % 1000003), value(i));
+      if (i % 25000 == 24999 || (i > total / 2 && i % 100 == 99)) {
+        txn.commit();
+        auto reader = env.start_read();
+        if (reader.get(map, buffer::key_from_u64(i * 7919 % 1000003)) != value(i).slice()) {
+          std::cerr << "Fail: the committed item " << i << " is not visible\n";
+          return false;
+        }
+        reader.abort();
+        txn = env.start_write();
+      }
+    }
+    txn.commit();
+  }
+
+  /* re-open without the option to verify the datafile content */
+  mdbx::env_managed env(db_filename, mdbx::env::operate_parameters(4));
+  auto txn = env.start_read();
+  auto map = txn.open_map("direct", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  if (txn.get_map_stat(map).ms_entries != total) {
+    std::cerr << "Fail: unexpected number of items\n";
+    return false;
+  }
+  for (uint64_t i = 0; i < total; ++i)
+    if (txn.get(map, buffer::key_from_u64(i * 7919 % 1000003)) != value(i).slice()) {
+      std::cerr << "Fail: mismatch for item " << i << "\n";
+      return false;
+    }
+  txn.abort();
+  env.close();
+  return mdbx::env_managed::remove(db_filename);
+}
+
+static int doit() {
+  /* the option is ignored in the MDBX_WRITEMAP mode */
+  for (const auto flags : {MDBX_ENV_DEFAULTS, MDBX_SAFE_NOSYNC, MDBX_WRITEMAP})
+    for (const bool slab : {false, true})
+      if (!workload(flags, slab))
+        return EXIT_FAILURE;
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
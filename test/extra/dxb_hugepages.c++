@@ -0,0 +1,137 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <iostream>
+#include <memory>
+
+#if defined(__linux__)
+#include <cstdio>
+#include <cstring>
+#include <sys/mman.h>
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE 0
+#endif
+
+/* the address range of the database mapping is taken from /proc/self/maps */
+static bool mapping(const char *db_filename, uintptr_t &begin, uintptr_t &end) {
+  begin = UINTPTR_MAX;
+  end = 0;
+  FILE *const maps = fopen("/proc/self/maps", "r");
+  if (!maps)
+    return false;
+  const size_t length = strlen(db_filename);
+  char line[4096];
+  while (fgets(line, sizeof(line), maps)) {
+    unsigned long long lo, hi;
+    const char *const name = strrchr(line, '/');
+    if (name && strncmp(name + 1, db_filename, length) == 0 && name[length + 1] == '\n' &&
+        sscanf(line, "%llx-%llx ", &lo, &hi) == 2) {
+      begin = (lo < begin) ? uintptr_t(lo) : begin;
+      end = (hi > end) ? uintptr_t(hi) : end;
+    }
+  }
+  fclose(maps);
+  return begin < end;
+}
+#endif /* Linux */
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+/* the option should be set before opening, so the handle is created by C API */
+struct env_handle : public mdbx::env {
+  env_handle(MDBX_env *ptr) : mdbx::env(ptr) {}
+};
+
+static bool workload(MDBX_env_flags_t flags) {
+  const char *const db_filename = "test-dxb-hugepages";
+  mdbx::env_managed::remove(db_filename);
+
+  MDBX_env *handle;
+  mdbx::error::success_or_throw(mdbx_env_create(&handle));
+  std::unique_ptr<MDBX_env, int (*)(MDBX_env *)> guard(handle, mdbx_env_close);
+  env_handle env(handle);
+  mdbx::error::success_or_throw(mdbx_env_set_option(env, MDBX_opt_dxb_hugepages, 1));
+  mdbx::error::success_or_throw(mdbx_env_set_option(env, MDBX_opt_max_db, 4));
+  /* a small growth step for many remaps of the database */
+  mdbx::error::success_or_throw(mdbx_env_set_geometry(env, -1, -1, 1 << 30, 1 << 20, -1, -1));
+  mdbx::error::success_or_throw(mdbx_env_open(env, db_filename, flags | MDBX_NOSUBDIR, 0664));
+
+  if (mdbx_env_set_option(env, MDBX_opt_dxb_hugepages, 0) != MDBX_EPERM) {
+    std::cerr << "Fail: the huge pages option was changed for an opened database\n";
+    return false;
+  }
+
+  const uint64_t total = 100000;
+  auto txn = env.start_write();
+  auto map = txn.create_map("hugepages", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  for (uint64_t i = 0; i < total; ++i) {
+    txn.upsert(map, buffer::key_from_u64(i * 7919 % 1000003), buffer::key_from_u64(i));
+    if (i % 10000 == 9999)
+      txn.commit(), txn = env.start_write();
+  }
+  txn.commit();
+
+  txn = env.start_read();
+  for (uint64_t i = 0; i < total; ++i)
+    if (txn.get(map, buffer::key_from_u64(i * 7919 % 1000003)).as_uint64() != i) {
+      std::cerr << "Fail: mismatch for item " << i << "\n";
+      return false;
+    }
+  txn.abort();
+
+#if defined(__linux__)
+  /* the address space after the mapping is occupied, so growing the limit
+   * moves the mapping, which should stay aligned for huge pages */
+  uintptr_t begin, end;
+  if (!(flags & MDBX_WRITEMAP) && mapping(db_filename, begin, end)) {
+    const size_t huge = 2 << 20;
+    void *const guard =
+        mmap(reinterpret_cast<void *>(end), huge, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    mdbx::error::success_or_throw(mdbx_env_set_geometry(env, -1, -1, intptr_t(2) << 30, -1, -1, -1));
+    if (guard != MAP_FAILED)
+      munmap(guard, huge);
+    if (!mapping(db_filename, begin, end) || begin % huge) {
+      std::cerr << "Fail: the mapping is not aligned after the move\n";
+      return false;
+    }
+    txn = env.start_read();
+    for (uint64_t i = 0; i < total; i += 7)
+      if (txn.get(map, buffer::key_from_u64(i * 7919 % 1000003)).as_uint64() != i) {
+        std::cerr << "Fail: mismatch for item " << i << " after the move\n";
+        return false;
+      }
+    txn.abort();
+  }
+#endif /* Linux */
+
+  /* huge pages are not used when changes are written through the mapping */
+  const auto info = env.get_info();
+  const uint64_t expected = (flags & MDBX_WRITEMAP) ? 0 : info.mi_mapsize;
+  if (info.mi_dxb_hugepages.advised != expected || info.mi_dxb_hugepages.resident > info.mi_dxb_hugepages.advised) {
+    std::cerr << "Fail: unexpected huge pages usage " << info.mi_dxb_hugepages.resident << " of "
+              << info.mi_dxb_hugepages.advised << " bytes\n";
+    return false;
+  }
+  return true;
+}
+
+static int doit() {
+  for (const auto flags : {MDBX_ENV_DEFAULTS, MDBX_WRITEMAP})
+    if (!workload(flags))
+      return EXIT_FAILURE;
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
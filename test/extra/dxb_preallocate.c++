@@ -0,0 +1,129 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <iostream>
+#include <memory>
+
+#if !defined(_WIN32)
+#include <sys/stat.h>
+#endif
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+/* the option is set through C API, so the handle is created by C API too */
+struct env_handle : public mdbx::env {
+  env_handle(MDBX_env *ptr) : mdbx::env(ptr) {}
+};
+
+static bool workload(MDBX_env_flags_t flags) {
+  const char *const db_filename = "test-dxb-preallocate";
+  mdbx::env_managed::remove(db_filename);
+
+  MDBX_env *handle;
+  mdbx::error::success_or_throw(mdbx_env_create(&handle));
+  std::unique_ptr<MDBX_env, int (*)(MDBX_env *)> guard(handle, mdbx_env_close);
+  env_handle env(handle);
+  /* a small growth step for many resizes of the datafile */
+  mdbx::error::success_or_throw(mdbx_env_set_geometry(env, -1, -1, 1 << 30, 1 << 20, -1, 4096));
+  mdbx::error::success_or_throw(mdbx_env_set_option(env, MDBX_opt_max_db, 4));
+  const int err = mdbx_env_set_option(env, MDBX_opt_dxb_preallocate, 1024);
+  if (err == MDBX_ENOSYS) {
+    std::cout << "Skipped: the preallocation is not supported\n";
+    return true;
+  }
+  mdbx::error::success_or_throw(err);
+  mdbx::error::success_or_throw(mdbx_env_open(env, db_filename, flags | MDBX_NOSUBDIR, 0664));
+
+  uint64_t watermark = 0;
+  mdbx::error::success_or_throw(mdbx_env_get_option(env, MDBX_opt_dxb_preallocate, &watermark));
+  if (watermark != 1024) {
+    std::cerr << "Fail: unexpected watermark " << watermark << "\n";
+    return false;
+  }
+
+  const uint64_t total = 200000;
+  unsigned resizes = 0;
+  auto txn = env.start_write();
+  auto map = txn.create_map("preallocate", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  for (uint64_t i = 0; i < total; ++i) {
+    txn.upsert(map, buffer::key_from_u64(i * 7919 % 1000003), buffer::key_from_u64(i));
+    if (i % 5000 == 4999) {
+      const auto stat = txn.commit_get_stat();
+      if (stat.resize.count == 0 && stat.resize.time != 0) {
+        std::cerr << "Fail: the resize time without resizes\n";
+        return false;
+      }
+      resizes += stat.resize.count;
+      txn = env.start_write();
+    }
+  }
+  txn.commit();
+  if (resizes == 0) {
+    std::cerr << "Fail: the datafile resizes are not accounted\n";
+    return false;
+  }
+
+  txn = env.start_read();
+  for (uint64_t i = 0; i < total; ++i)
+    if (txn.get(map, buffer::key_from_u64(i * 7919 % 1000003)).as_uint64() != i) {
+      std::cerr << "Fail: mismatch for item " << i << "\n";
+      return false;
+    }
+  txn.abort();
+
+#if !defined(_WIN32)
+  /* the pending preallocation is cancelled when the datafile shrinks,
+   * so only the next growth step may be reserved beyond the new end */
+  MDBX_envinfo info;
+  mdbx::error::success_or_throw(mdbx_env_info_ex(env, nullptr, &info, sizeof(info)));
+  const intptr_t now = intptr_t(info.mi_geo.current);
+  mdbx::error::success_or_throw(mdbx_env_set_geometry(env, -1, now + (16 << 20), -1, -1, -1, -1));
+  struct stat before, after;
+  if (stat(db_filename, &before)) {
+    std::cerr << "Fail: stat() errno " << errno << "\n";
+    return false;
+  }
+  mdbx::error::success_or_throw(mdbx_env_set_geometry(env, -1, now, -1, -1, -1, -1));
+  if (stat(db_filename, &after)) {
+    std::cerr << "Fail: stat() errno " << errno << "\n";
+    return false;
+  }
+  if (after.st_size >= before.st_size) {
+    std::cerr << "Fail: the datafile is not shrunk\n";
+    return false;
+  }
+  if (uint64_t(after.st_blocks) * 512 > uint64_t(after.st_size) + (4 << 20)) {
+    std::cerr << "Fail: " << uint64_t(after.st_blocks) * 512 << " bytes allocated for the datafile of "
+              << after.st_size << " bytes after shrinking\n";
+    return false;
+  }
+#endif /* !Windows */
+
+  /* the preallocation is stopped at runtime */
+  mdbx::error::success_or_throw(mdbx_env_set_option(env, MDBX_opt_dxb_preallocate, 0));
+  txn = env.start_write();
+  for (uint64_t i = 0; i < total / 4; ++i)
+    txn.upsert(map, buffer::key_from_u64(i * 7919 % 1000003), buffer::key_from_u64(i));
+  txn.commit();
+  return true;
+}
+
+static int doit() {
+  for (const auto flags : {MDBX_ENV_DEFAULTS, MDBX_WRITEMAP})
+    if (!workload(flags))
+      return EXIT_FAILURE;
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,130 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+/* the anonymous environment is opened by C API, so the handle is created by C API too */
+struct env_handle : public mdbx::env {
+  env_handle(MDBX_env *ptr) : mdbx::env(ptr) {}
+};
+
+static bool workload(MDBX_env_flags_t flags) {
+  MDBX_env *handle;
+  mdbx::error::success_or_throw(mdbx_env_create(&handle));
+  std::unique_ptr<MDBX_env, int (*)(MDBX_env *)> guard(handle, mdbx_env_close);
+  env_handle env(handle);
+  mdbx::error::success_or_throw(mdbx_env_set_option(env, MDBX_opt_max_db, 4));
+  mdbx::error::success_or_throw(mdbx_env_set_geometry(env, -1, -1, 1 << 30, 1 << 20, -1, -1));
+  if (mdbx_env_open_anonymous(env, MDBX_RDONLY) != MDBX_EINVAL) {
+    std::cerr << "Fail: the read-only anonymous environment is accepted\n";
+    return false;
+  }
+  const int err = mdbx_env_open_anonymous(env, flags);
+  if (err == MDBX_ENOSYS) {
+    std::cout << "Skipped: the anonymous environment is not supported\n";
+    return true;
+  }
+  mdbx::error::success_or_throw(err);
+
+  const char *path = nullptr;
+  mdbx::error::success_or_throw(mdbx_env_get_path(env, &path));
+  if (!path || *path) {
+    std::cerr << "Fail: unexpected path of the anonymous environment\n";
+    return false;
+  }
+
+  const uint64_t total = 100000;
+  auto txn = env.start_write();
+  auto map = txn.create_map("anonymous", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  for (uint64_t i = 0; i < total; ++i)
+    txn.upsert(map, buffer::key_from_u64(i), buffer::key_from_u64(i));
+  txn.commit();
+
+  /* a reader keeps the snapshot while the writer and other readers run concurrently */
+  auto snapshot = env.start_read();
+  std::vector<std::thread> threads;
+  std::vector<int> succeed(5, false);
+  threads.emplace_back([&] {
+    try {
+      for (uint64_t round = 1; round < 4; ++round) {
+        auto writer = env.start_write();
+        for (uint64_t i = 0; i < total; ++i)
+          writer.update(map, buffer::key_from_u64(i), buffer::key_from_u64(i + total));
+        writer.commit();
+      }
+      succeed[0] = true;
+    } catch (const std::exception &ex) {
+      std::cerr << "Writer exception: " << ex.what() << "\n";
+    }
+  });
+  for (size_t n = 1; n < succeed.size(); ++n)
+    threads.emplace_back([&, n] {
+      auto reader = env.start_read();
+      bool ok = true;
+      for (uint64_t i = n; i < total; i += succeed.size()) {
+        const auto value = reader.get(map, buffer::key_from_u64(i)).as_uint64();
+        ok &= value == i || value == i + total;
+      }
+      succeed[n] = ok;
+    });
+  for (auto &thread : threads)
+    thread.join();
+  for (size_t n = 0; n < succeed.size(); ++n)
+    if (!succeed[n]) {
+      std::cerr << "Fail: the concurrent " << (n ? "reader" : "writer") << " " << n << " failed\n";
+      return false;
+    }
+  for (uint64_t i = 0; i < total; ++i)
+    if (snapshot.get(map, buffer::key_from_u64(i)).as_uint64() != i) {
+      std::cerr << "Fail: the snapshot is changed for item " << i << "\n";
+      return false;
+    }
+  snapshot.abort();
+
+  /* nothing to sync, the aborted changes are discarded */
+  if (mdbx_env_sync_ex(env, true, false) != MDBX_RESULT_TRUE) {
+    std::cerr << "Fail: the anonymous environment is synced\n";
+    return false;
+  }
+  txn = env.start_write();
+  txn.clear_map(map);
+  txn.abort();
+  txn = env.start_read();
+  if (txn.get_map_stat(map).ms_entries != total) {
+    std::cerr << "Fail: the aborted changes are visible\n";
+    return false;
+  }
+  txn.abort();
+
+  if (mdbx_env_warmup_save(env) != MDBX_EINVAL) {
+    std::cerr << "Fail: the warmup profile of the anonymous environment is saved\n";
+    return false;
+  }
+  return true;
+}
+
+static int doit() {
+  for (const auto flags : {MDBX_ENV_DEFAULTS, MDBX_WRITEMAP})
+    if (!workload(flags))
+      return EXIT_FAILURE;
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,168 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <iostream>
+#include <string>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+static const uint64_t total = 50000;
+static const uint64_t multi = 100;
+static const uint64_t large = 100;
+
+static std::string large_value(uint64_t i) { return std::string(10000 + i % large, char('a' + i % 26)); }
+
+static void fill(mdbx::env_managed &env, uint64_t base) {
+  auto txn = env.start_write();
+  auto plain = txn.create_map("plain", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  auto dups = txn.create_map("dups", mdbx::key_mode::ordinal, mdbx::value_mode::multi_ordinal);
+  auto bigs = txn.create_map("bigs", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  for (uint64_t i = base; i < base + total; ++i) {
+    txn.upsert(plain, buffer::key_from_u64(i), buffer::key_from_u64(i));
+    /* the nested b-trees of multi-values */
+    txn.upsert(dups, buffer::key_from_u64(base + i % multi), buffer::key_from_u64(i));
+  }
+  for (uint64_t i = base; i < base + large; ++i)
+    txn.upsert(bigs, buffer::key_from_u64(i), mdbx::slice(large_value(i)));
+  txn.commit();
+}
+
+static void erase(mdbx::env_managed &env, uint64_t base) {
+  auto txn = env.start_write();
+  auto plain = txn.open_map("plain", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  auto dups = txn.open_map("dups", mdbx::key_mode::ordinal, mdbx::value_mode::multi_ordinal);
+  auto bigs = txn.open_map("bigs", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  for (uint64_t i = base; i < base + total; ++i)
+    txn.erase(plain, buffer::key_from_u64(i));
+  for (uint64_t i = base; i < base + multi; ++i)
+    txn.erase(dups, buffer::key_from_u64(i));
+  for (uint64_t i = base; i < base + large; ++i)
+    txn.erase(bigs, buffer::key_from_u64(i));
+  txn.commit();
+}
+
+static bool verify(mdbx::txn_managed txn, uint64_t base) {
+  auto plain = txn.open_map("plain", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  auto dups = txn.open_map("dups", mdbx::key_mode::ordinal, mdbx::value_mode::multi_ordinal);
+  auto bigs = txn.open_map("bigs", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  if (txn.get_map_stat(plain).ms_entries != total || txn.get_map_stat(dups).ms_entries != total ||
+      txn.get_map_stat(bigs).ms_entries != large) {
+    std::cerr << "Fail: unexpected number of items\n";
+    return false;
+  }
+  for (uint64_t i = base; i < base + total; ++i)
+    if (txn.get(plain, buffer::key_from_u64(i)).as_uint64() != i) {
+      std::cerr << "Fail: mismatch for item " << i << "\n";
+      return false;
+    }
+  auto cursor = txn.open_cursor(dups);
+  for (uint64_t i = base; i < base + total; ++i)
+    if (!cursor.find_multivalue(buffer::key_from_u64(base + i % multi), buffer::key_from_u64(i), false)) {
+      std::cerr << "Fail: multi-value " << i << " is lost\n";
+      return false;
+    }
+  for (uint64_t i = base; i < base + large; ++i)
+    if (txn.get(bigs, buffer::key_from_u64(i)) != mdbx::slice(large_value(i))) {
+      std::cerr << "Fail: mismatch for large item " << i << "\n";
+      return false;
+    }
+  return true;
+}
+
+/* the pages freed by a step become reusable only after a subsequent commit, which is not forced by the
+ * defragmentation, so the commits of an application are emulated in between */
+static bool defrag(mdbx::env_managed &env, unsigned steps, const char *caption) {
+  while (!env.defrag(1000)) {
+    if (++steps > 10000) {
+      std::cerr << "Fail: the defragmentation " << caption << " is not completed\n";
+      return false;
+    }
+    auto txn = env.start_write();
+    txn.put_canary(mdbx::txn::canary{steps, 0, 0, 0});
+    txn.commit();
+  }
+  return true;
+}
+
+static int doit() {
+  const char *const db_filename = "test-env-defrag";
+  mdbx::env_managed::remove(db_filename);
+
+  mdbx::env_managed::create_parameters create;
+  create.geometry.make_dynamic(1 << 20, 1 << 30);
+  create.geometry.growth_step = 1 << 20;
+  create.geometry.shrink_threshold = 1 << 20;
+  create.geometry.pagesize = 4096;
+  mdbx::env::operate_parameters operate(8);
+  /* to run the defragmentation while a reader is opened by the same thread */
+  operate.options.no_sticky_threads = true;
+  mdbx::env_managed env(db_filename, create, operate);
+
+  /* the earlier data is erased, so the later one occupies the tail of the file */
+  fill(env, 0);
+  fill(env, total);
+  erase(env, 0);
+  const auto before = env.get_info().mi_geo.current;
+
+  /* a reader is not blocked and keeps its snapshot, which is taken after the erasing is committed, so the freed pages
+   * may be reused for relocation */
+  auto txn = env.start_write();
+  txn.create_map("marker");
+  txn.commit();
+  auto reader = env.start_read();
+  if (env.defrag(1000)) {
+    std::cerr << "Fail: nothing is relocated\n";
+    return EXIT_FAILURE;
+  }
+  if (!verify(std::move(reader), total))
+    return EXIT_FAILURE;
+
+  if (!defrag(env, 1, "with a reader"))
+    return EXIT_FAILURE;
+
+  const auto after = env.get_info().mi_geo.current;
+  if (after > before / 3 * 2) {
+    std::cerr << "Fail: the datafile is not shrunk, " << before << " before and " << after << " after\n";
+    return EXIT_FAILURE;
+  }
+  if (!verify(env.start_read(), total))
+    return EXIT_FAILURE;
+  env.close();
+
+  /* the relocated data survives re-opening */
+  mdbx::env_managed reopened(db_filename, mdbx::env::operate_parameters(8));
+  if (!verify(reopened.start_read(), total))
+    return EXIT_FAILURE;
+  fill(reopened, total * 2);
+  erase(reopened, total);
+  reopened.close();
+
+  /* with the single handle available, the tables are opened by the defragmentation itself and closed after */
+  mdbx::env_managed limited(db_filename, mdbx::env::operate_parameters(1));
+  if (!defrag(limited, 0, "with the tables opened internally"))
+    return EXIT_FAILURE;
+  auto extra = limited.start_write();
+  extra.create_map("extra");
+  extra.commit();
+  limited.close();
+
+  reopened = mdbx::env_managed(db_filename, mdbx::env::operate_parameters(8));
+  if (!verify(reopened.start_read(), total * 2))
+    return EXIT_FAILURE;
+  reopened.close();
+  mdbx::env_managed::remove(db_filename);
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,79 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <iostream>
+#include <random>
+
+static int doit() {
+  mdbx::path db_filename = "test-finger-search";
+  mdbx::env_managed::remove(db_filename);
+  mdbx::env_managed env(db_filename, mdbx::env_managed::create_parameters(), mdbx::env::operate_parameters(1));
+
+  using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+  /* only even keys are stored, so odd keys are absent */
+  const uint64_t total = 100000;
+  auto txn = env.start_write();
+  auto map = txn.create_map("finger", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  for (uint64_t i = 0; i < total; ++i)
+    txn.append(map, buffer::key_from_u64(i * 2), buffer::key_from_u64(i));
+  txn.commit();
+
+  std::mt19937_64 rng(42);
+  for (int pass = 0; pass < 2; ++pass) {
+    txn = pass ? env.start_write() : env.start_read();
+    auto cursor = txn.open_cursor(map);
+    uint64_t target = total;
+    for (size_t n = 0; n < 100000; ++n) {
+      /* mostly nearby jumps in both directions, sometimes far away */
+      const int64_t step = (n % 97) ? int64_t(rng() % 4001) - 2000 : int64_t(rng() % (total * 2)) - int64_t(total);
+      target = uint64_t((int64_t(target) + step + int64_t(total * 3)) % int64_t(total * 2 + 3));
+      const auto lower = cursor.lower_bound(buffer::key_from_u64(target), false);
+      const uint64_t expected = (target + 1) / 2 * 2;
+      if (expected >= total * 2 ? lower.done
+                                : (!lower.done || lower.key.as_uint64() != expected ||
+                                   lower.value.as_uint64() != expected / 2)) {
+        std::cerr << "Fail: lower_bound(" << target << ") mismatch on pass " << pass << "\n";
+        return EXIT_FAILURE;
+      }
+      if (cursor.seek(buffer::key_from_u64(target)) != (target % 2 == 0 && target < total * 2)) {
+        std::cerr << "Fail: seek(" << target << ") mismatch on pass " << pass << "\n";
+        return EXIT_FAILURE;
+      }
+    }
+    if (pass) {
+      /* modify the tree under the cursor and continue searching */
+      for (uint64_t i = 1; i < total; i += 7)
+        txn.upsert(map, buffer::key_from_u64(i * 2 + 1), buffer::key_from_u64(i));
+      for (uint64_t i = 0; i < total * 2 - 1; i += 97) {
+        const auto found = cursor.lower_bound(buffer::key_from_u64(i), false);
+        const uint64_t expected = (i % 2 == 0 || i / 2 % 7 == 1) ? i : i + 1;
+        if (!found.done || found.key.as_uint64() != expected) {
+          std::cerr << "Fail: lower_bound(" << i << ") mismatch after update\n";
+          return EXIT_FAILURE;
+        }
+      }
+    }
+    txn.abort();
+  }
+
+  const auto info = env.get_info();
+  if (info.mi_pgop_stat.newly && (!info.mi_finger_stat.searches || !info.mi_finger_stat.levels_saved)) {
+    std::cerr << "Fail: unexpected finger search stat: searches " << info.mi_finger_stat.searches
+              << ", levels saved " << info.mi_finger_stat.levels_saved << "\n";
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
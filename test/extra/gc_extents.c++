@@ -0,0 +1,104 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <iostream>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+static size_t pagesize;
+
+static buffer value(uint64_t key, size_t pages) {
+  std::string data(pages * pagesize - 256, char('a' + key % 23));
+  data.replace(0, 20, std::to_string(key));
+  return buffer(mdbx::slice(data.data(), data.size()));
+}
+
+static bool verify(mdbx::env &env, mdbx::map_handle map, uint64_t total, const char *stage) {
+  auto txn = env.start_read();
+  auto cursor = txn.open_cursor(map);
+  uint64_t n = 0;
+  for (auto data = cursor.to_first(false); data.done; data = cursor.to_next(false), ++n) {
+    const uint64_t key = data.key.as_uint64();
+    const size_t pages = key < total ? 3 : 2 + key % 5;
+    if (data.value != value(key, pages).slice()) {
+      std::cerr << "Fail: value mismatch for key " << key << " " << stage << "\n";
+      return false;
+    }
+  }
+  if (n != txn.get_map_stat(map).ms_entries) {
+    std::cerr << "Fail: " << n << " items " << stage << "\n";
+    return false;
+  }
+  return true;
+}
+
+static int doit() {
+  mdbx::path db_filename = "test-gc-extents";
+  mdbx::env_managed::remove(db_filename);
+  mdbx::env_managed env(db_filename, mdbx::env_managed::create_parameters(),
+                        mdbx::env::operate_parameters(1, 0, mdbx::env::mode::write_file_io));
+  pagesize = env.get_pagesize();
+
+  /* fill the database with values of 3 pages each */
+  const uint64_t total = 4000;
+  auto txn = env.start_write();
+  auto map = txn.create_map("extents", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  for (uint64_t i = 0; i < total; ++i)
+    txn.insert(map, buffer::key_from_u64(i), value(i, 3));
+  txn.commit();
+
+  /* make the GC fragmented by deleting every other value */
+  txn = env.start_write();
+  for (uint64_t i = 0; i < total; i += 2)
+    txn.erase(map, buffer::key_from_u64(i));
+  txn.commit();
+  if (!verify(env, map, total, "after deletion"))
+    return EXIT_FAILURE;
+
+  const bool stat = env.get_info().mi_pgop_stat.newly != 0;
+  const auto before = env.get_info().mi_gc_seq_stat;
+
+  /* allocate multi-page values of various lengths within the freed space,
+   * including within nested transactions */
+  for (uint64_t round = 0; round < 4; ++round) {
+    txn = env.start_write();
+    for (uint64_t i = 0; i < 300; ++i) {
+      const uint64_t key = total + round * 1000 + i;
+      if (i % 100 == 99) {
+        auto nested = txn.start_nested();
+        nested.insert(map, buffer::key_from_u64(key), value(key, 2 + key % 5));
+        if (i % 200 == 199)
+          nested.abort();
+        else
+          nested.commit();
+      } else
+        txn.insert(map, buffer::key_from_u64(key), value(key, 2 + key % 5));
+    }
+    for (uint64_t i = round * 2 + 1; i < total; i += 16)
+      txn.erase(map, buffer::key_from_u64(i));
+    txn.commit();
+    if (!verify(env, map, total, "after allocation"))
+      return EXIT_FAILURE;
+  }
+
+  const auto after = env.get_info().mi_gc_seq_stat;
+  if (stat && (after.searches == before.searches || after.rebuilds == before.rebuilds)) {
+    std::cerr << "Fail: the index of sequences is not used, " << after.searches - before.searches << " searches, "
+              << after.rebuilds - before.rebuilds << " rebuilds\n";
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,150 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+static buffer value(uint64_t key, size_t pages) {
+  std::string data(pages * 4096 - 256, char('a' + key % 23));
+  data.replace(0, 20, std::to_string(key));
+  return buffer(mdbx::slice(data.data(), data.size()));
+}
+
+/* the erased values are re-inserted shorter, so the remainders of the reclaimed extents are returned into the GC */
+static size_t shorter(size_t pages) { return pages > 3 ? pages / 2 + 1 : 2; }
+
+struct gc_cost {
+  size_t pages, entries; ///< size of the GC after the commit which frees the extents
+  uint32_t wallclock;    ///< MDBX_commit_latency::gc_wallclock of this commit
+  uint32_t wloops;       ///< MDBX_commit_latency::gc_prof.wloops, zero without MDBX_ENABLE_PROFGC
+};
+
+static bool verify(mdbx::env &env, mdbx::map_handle map, uint64_t count, size_t pages, const char *stage) {
+  auto txn = env.start_read();
+  for (uint64_t i = 0; i < count; ++i)
+    if (txn.get(map, buffer::key_from_u64(i)) != value(i, (i & 1) ? pages : shorter(pages)).slice()) {
+      std::cerr << "Fail: value mismatch for key " << i << " " << stage << "\n";
+      return false;
+    }
+  return true;
+}
+
+static bool chk(mdbx::env_managed &env, const char *caption) {
+  MDBX_chk_callbacks_t cb;
+  std::memset(&cb, 0, sizeof(cb));
+  MDBX_chk_context_t ctx;
+  std::memset(&ctx, 0, sizeof(ctx));
+  mdbx::error::success_or_throw(mdbx_env_chk(env, &cb, &ctx, MDBX_chk_flags_t(0), MDBX_chk_error, 0));
+  if (ctx.result.total_problems) {
+    std::cerr << "Fail: " << ctx.result.total_problems << " problem(s) " << caption << "\n";
+    return false;
+  }
+  return true;
+}
+
+/* count values of pages each, every other of them is erased, so the GC receives count/2 extents */
+static bool workload(bool packed, bool lifo, uint64_t count, size_t pages, gc_cost &cost) {
+  const char *const db_filename = "test-gc-layout";
+  mdbx::env_managed::remove(db_filename);
+  mdbx::env_managed::create_parameters create;
+  create.geometry.make_dynamic(1 << 20, 1 << 30);
+  create.geometry.pagesize = 4096;
+  mdbx::env::reclaiming_options reclaiming;
+  reclaiming.lifo = lifo;
+  mdbx::env_managed env(
+      db_filename, create,
+      mdbx::env::operate_parameters(4, 0, mdbx::env::mode::write_mapped_io,
+                                    mdbx::env::durability::robust_synchronous, reclaiming));
+  env.set_extra_option(mdbx::env::extra_runtime_option::gc_extents, packed);
+  const std::string caption = std::string(packed ? "packed" : "plain") + (lifo ? "-lifo " : " ") +
+                              std::to_string(count) + "x" + std::to_string(pages);
+
+  auto txn = env.start_write();
+  auto map = txn.create_map("layout", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  for (uint64_t i = 0; i < count; ++i)
+    txn.insert(map, buffer::key_from_u64(i), value(i, pages));
+  txn.commit();
+
+  txn = env.start_write();
+  for (uint64_t i = 0; i < count; i += 2)
+    txn.erase(map, buffer::key_from_u64(i));
+  const auto latency = txn.commit_get_latency();
+
+  txn = env.start_read();
+  const auto gc = txn.get_map_stat(mdbx::map_handle(0));
+  cost.pages = size_t(gc.ms_branch_pages + gc.ms_leaf_pages + gc.ms_overflow_pages);
+  cost.entries = size_t(gc.ms_entries);
+  cost.wallclock = latency.gc_wallclock;
+  cost.wloops = latency.gc_prof.wloops;
+  txn.abort();
+
+  /* the records are reclaimed partially and the remainders are returned back,
+   * then the returned records are reclaimed by the next transaction */
+  txn = env.start_write();
+  for (uint64_t i = 0; i < count; i += 2)
+    txn.insert(map, buffer::key_from_u64(i), value(i, shorter(pages)));
+  txn.commit();
+  txn = env.start_write();
+  auto spare = txn.create_map("spare", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  for (uint64_t i = 0; i < count / 4; ++i)
+    txn.insert(spare, buffer::key_from_u64(i), value(i, 1));
+  txn.commit();
+
+  if (!verify(env, map, count, pages, caption.c_str()) || !chk(env, caption.c_str()))
+    return false;
+  env.close();
+  mdbx::env_managed::remove(db_filename);
+  return true;
+}
+
+static int doit() {
+  /* the extents of the same number grow from 4 to 256 pages */
+  gc_cost base, cost;
+  if (!workload(true, false, 48, 4, base))
+    return EXIT_FAILURE;
+  for (const size_t pages : {32, 256}) {
+    if (!workload(true, false, 48, pages, cost))
+      return EXIT_FAILURE;
+    if (cost.pages > base.pages || cost.entries > base.entries) {
+      std::cerr << "Fail: GC grows with extents of " << pages << " pages (" << cost.pages << " pages, "
+                << cost.entries << " entries, instead of " << base.pages << " and " << base.entries << ")\n";
+      return EXIT_FAILURE;
+    }
+    if ((base.wloops && cost.wloops > base.wloops) || cost.wallclock > base.wallclock * 4 + 3277 /* 50 ms */) {
+      std::cerr << "Fail: gc_update cost grows with extents of " << pages << " pages (" << cost.wloops << " loops, "
+                << cost.wallclock << " wallclock, instead of " << base.wloops << " and " << base.wallclock << ")\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  /* the same extents stored as the plain page lists */
+  gc_cost plain;
+  if (!workload(false, false, 48, 256, plain))
+    return EXIT_FAILURE;
+  if (plain.pages <= cost.pages) {
+    std::cerr << "Fail: plain GC records take " << plain.pages << " pages, packed ones " << cost.pages << "\n";
+    return EXIT_FAILURE;
+  }
+
+  /* a lot of short extents, so the packed records are sliced in both reclaiming orders */
+  if (!workload(true, false, 6000, 3, cost) || !workload(true, true, 6000, 3, cost) ||
+      !workload(false, true, 48, 256, cost) || !workload(true, true, 48, 256, cost))
+    return EXIT_FAILURE;
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
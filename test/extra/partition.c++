@@ -0,0 +1,87 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <atomic>
+#include <iostream>
+
+static int doit() {
+  mdbx::path db_filename = "test-partition";
+  mdbx::env_managed::remove(db_filename);
+  mdbx::env_managed env(db_filename, mdbx::env_managed::create_parameters(), mdbx::env::operate_parameters(1));
+
+  using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+  const size_t total = 123456;
+  auto txn = env.start_write();
+  auto map = txn.create_map("partition", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  for (size_t i = 0; i < total; ++i)
+    txn.append(map, buffer::key_from_u64(i), buffer("payload-payload-payload"));
+  txn.commit();
+
+  txn = env.start_read();
+  for (size_t parts = 1; parts <= 64; parts += parts / 2 + 1) {
+    const auto ranges = txn.partition(map, parts);
+    if (ranges.empty() || ranges.size() > parts || ranges.front().from.is_valid() || ranges.back().to.is_valid()) {
+      std::cerr << "Fail: unexpected partitions count " << ranges.size() << " for " << parts << "\n";
+      return EXIT_FAILURE;
+    }
+    ptrdiff_t sum = 0;
+    for (size_t i = 0; i < ranges.size(); ++i) {
+      if (i > 0 && ranges[i - 1].from.is_valid() && ranges[i - 1].from.as_uint64() >= ranges[i].from.as_uint64()) {
+        std::cerr << "Fail: unordered boundaries\n";
+        return EXIT_FAILURE;
+      }
+      sum += ranges[i].approximate_quantity;
+      if (parts > 1 && ranges[i].approximate_quantity > ptrdiff_t(total / ranges.size() * 2)) {
+        std::cerr << "Fail: unbalanced partition " << i << " of " << ranges.size() << " with "
+                  << ranges[i].approximate_quantity << " items\n";
+        return EXIT_FAILURE;
+      }
+    }
+    if (sum < ptrdiff_t(total / 2) || sum > ptrdiff_t(total * 2)) {
+      std::cerr << "Fail: estimated " << sum << " items in total\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  const auto subrange = txn.partition(map, 7, buffer::key_from_u64(1000), buffer::key_from_u64(2000));
+  for (const auto &range : subrange)
+    if ((range.from.is_valid() && (range.from.as_uint64() < 1000 || range.from.as_uint64() >= 2000)) ||
+        (range.to.is_valid() && (range.to.as_uint64() <= 1000 || range.to.as_uint64() > 2000))) {
+      std::cerr << "Fail: boundary out of the range\n";
+      return EXIT_FAILURE;
+    }
+  txn.abort();
+
+  std::atomic<size_t> counted(0);
+  env.for_each_partition(map, 8, 4,
+                         [&](mdbx::txn &txn, mdbx::map_handle map, const mdbx::txn::key_range &range, size_t) {
+                           auto cursor = txn.open_cursor(map);
+                           size_t n = 0;
+                           auto data =
+                               range.from.is_valid() ? cursor.lower_bound(range.from, false) : cursor.to_first(false);
+                           while (data.done &&
+                                  (!range.to.is_valid() || data.key.as_uint64() < range.to.as_uint64())) {
+                             ++n;
+                             data = cursor.to_next(false);
+                           }
+                           counted += n;
+                         });
+  if (counted != total) {
+    std::cerr << "Fail: " << counted << " items visited by partitions instead of " << total << "\n";
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,58 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <iostream>
+
+static int doit() {
+  mdbx::path db_filename = "test-prefetch";
+  mdbx::env_managed::remove(db_filename);
+  mdbx::env_managed env(db_filename, mdbx::env_managed::create_parameters(), mdbx::env::operate_parameters(1));
+  env.set_extra_option(mdbx::env::extra_runtime_option::prefetch_window, 8);
+  if (env.extra_option(mdbx::env::extra_runtime_option::prefetch_window) != 8) {
+    std::cerr << "Fail: prefetch window option was not applied\n";
+    return EXIT_FAILURE;
+  }
+
+  using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+  const size_t total = 54321;
+  auto txn = env.start_write();
+  auto map = txn.create_map("prefetch", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  const std::string large(env.get_pagesize() * 3, '*');
+  for (size_t i = 0; i < total; ++i)
+    txn.append(map, buffer::key_from_u64(i),
+               (i % 1000) ? mdbx::slice("sequential-scan-payload") : mdbx::slice(large.data(), large.size()));
+  txn.commit();
+
+  txn = env.start_read();
+  auto cursor = txn.open_cursor(map);
+  size_t forward = 0, backward = 0;
+  for (auto data = cursor.to_first(false); data.done; data = cursor.to_next(false))
+    ++forward;
+  for (auto data = cursor.to_last(false); data.done; data = cursor.to_previous(false))
+    ++backward;
+  if (forward != total || backward != total) {
+    std::cerr << "Fail: scanned " << forward << "/" << backward << " items instead of " << total << "\n";
+    return EXIT_FAILURE;
+  }
+
+  const auto info = env.get_info(txn);
+  if (info.mi_pgop_stat.newly && (!info.mi_prefetch_stat.issued || !info.mi_prefetch_stat.hits)) {
+    std::cerr << "Fail: unexpected prefetch stat: issued " << info.mi_prefetch_stat.issued << ", hits "
+              << info.mi_prefetch_stat.hits << ", misses " << info.mi_prefetch_stat.misses << "\n";
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,219 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <iostream>
+#include <map>
+#include <vector>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+using model = std::map<uint64_t, uint64_t>;
+
+/* long values of some keys are placed on large/overflow pages */
+static buffer value_of(uint64_t key, uint64_t value) {
+  std::string result(reinterpret_cast<const char *>(&value), sizeof(value));
+  if (key % 61 == 0)
+    result.append(size_t(key % 3 + 1) * 4000, char('a' + key % 26));
+  return buffer(mdbx::slice(result));
+}
+
+static bool verify(mdbx::txn &txn, mdbx::map_handle map, const model &expected, const char *stage) {
+  auto cursor = txn.open_cursor(map);
+  auto it = expected.begin();
+  for (auto data = cursor.to_first(false); data; data = cursor.to_next(false), ++it)
+    if (it == expected.end() || data.key.as_uint64() != it->first ||
+        data.value != value_of(it->first, it->second).slice()) {
+      std::cerr << "Fail: mismatch " << stage << "\n";
+      return false;
+    }
+  if (it != expected.end()) {
+    std::cerr << "Fail: missing items " << stage << "\n";
+    return false;
+  }
+  return true;
+}
+
+static void random_changes(mdbx::txn &txn, mdbx::map_handle map, model &expected, uint64_t &prng, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    prng = prng * 6364136223846793005ull + 1442695040888963407ull;
+    const uint64_t key = (prng >> 33) % 20000, value = prng >> 40;
+    if ((prng >> 20) % 4 == 0) {
+      if (txn.erase(map, buffer::key_from_u64(key)))
+        expected.erase(key);
+    } else {
+      txn.upsert(map, buffer::key_from_u64(key), value_of(key, value));
+      expected[key] = value;
+    }
+  }
+}
+
+static bool workload(mdbx::env::mode mode) {
+  mdbx::path db_filename = "test-savepoint";
+  mdbx::env_managed::remove(db_filename);
+  mdbx::env_managed env(db_filename, mdbx::env_managed::create_parameters(), mdbx::env::operate_parameters(4, 0, mode));
+  /* a small limit of dirty pages to force spilling */
+  if (mode != mdbx::env::mode::write_mapped_io)
+    env.set_extra_option(mdbx::env::extra_runtime_option::dp_limit, 256);
+
+  model expected;
+  uint64_t prng = uint64_t(mode) + 42;
+  auto txn = env.start_write();
+  auto map = txn.create_map("savepoint", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  random_changes(txn, map, expected, prng, 20000);
+  txn.commit();
+
+  txn = env.start_write();
+  /* a rollback to the savepoint which is created in a clean transaction */
+  const model initial = expected;
+  const size_t first = txn.savepoint();
+  random_changes(txn, map, expected, prng, 5000);
+  txn.rollback_to(first);
+  expected = initial;
+  if (!verify(txn, map, expected, "after rollback of a clean transaction"))
+    return false;
+
+  /* nested savepoints with random rollbacks and releases */
+  std::vector<std::pair<size_t, model>> stack;
+  stack.emplace_back(first, expected);
+  for (size_t round = 0; round < 200; ++round) {
+    random_changes(txn, map, expected, prng, 10 + round % 7 * 100);
+    prng = prng * 6364136223846793005ull + 1442695040888963407ull;
+    switch ((prng >> 33) % 4) {
+    case 0:
+      stack.emplace_back(txn.savepoint(), expected);
+      if (stack.back().first != stack.size()) {
+        std::cerr << "Fail: unexpected savepoint number " << stack.back().first << "\n";
+        return false;
+      }
+      break;
+    case 1:
+      if (stack.size() > 1) {
+        txn.release_savepoint(stack.back().first);
+        stack.pop_back();
+      }
+      break;
+    default: {
+      const size_t target = (prng >> 40) % stack.size();
+      txn.rollback_to(stack[target].first);
+      stack.resize(target + 1);
+      expected = stack.back().second;
+      if (!verify(txn, map, expected, "after rollback"))
+        return false;
+    }
+    }
+  }
+
+  /* a table created after the savepoint is discarded by the rollback */
+  const size_t before_create = txn.savepoint();
+  const model saved = expected;
+  auto other = txn.create_map("other");
+  txn.upsert(other, buffer("key"), buffer("value"));
+  random_changes(txn, map, expected, prng, 1000);
+  txn.rollback_to(before_create);
+  expected = saved;
+  if (!verify(txn, map, expected, "after rollback of the table creation"))
+    return false;
+  try {
+    txn.open_map("other");
+    std::cerr << "Fail: the table created after the savepoint still exists\n";
+    return false;
+  } catch (const mdbx::not_found &) {
+  }
+
+  /* the nested transactions are not allowed while savepoints are active */
+  if (mode != mdbx::env::mode::write_mapped_io)
+    try {
+      txn.start_nested();
+      std::cerr << "Fail: a nested transaction started while savepoints are active\n";
+      return false;
+    } catch (const mdbx::bad_transaction &) {
+    }
+
+  /* the invalid savepoint is rejected */
+  try {
+    txn.rollback_to(before_create + 1);
+    std::cerr << "Fail: the rollback to an invalid savepoint succeeded\n";
+    return false;
+  } catch (const std::invalid_argument &) {
+  }
+
+  random_changes(txn, map, expected, prng, 3000);
+  txn.commit();
+
+  txn = env.start_read();
+  if (!verify(txn, map, expected, "after commit"))
+    return false;
+  txn.abort();
+
+  /* checks the database including the page accounting */
+  txn = env.start_write();
+  random_changes(txn, map, expected, prng, 1000);
+  txn.commit();
+  txn = env.start_read();
+  const bool ok = verify(txn, map, expected, "after the next commit");
+  txn.abort();
+  return ok;
+}
+
+/* the rollback recovers the transaction after MDBX_MAP_FULL, but not after an unrecoverable error */
+static bool poisoned(mdbx::env::mode mode) {
+  mdbx::path db_filename = "test-savepoint-poisoned";
+  mdbx::env_managed::remove(db_filename);
+  mdbx::env_managed::create_parameters create;
+  create.geometry.make_fixed(1 << 20);
+  mdbx::env_managed env(db_filename, create, mdbx::env::operate_parameters(4, 0, mode));
+
+  model expected;
+  uint64_t prng = uint64_t(mode) + 1;
+  auto txn = env.start_write();
+  auto map = txn.create_map("savepoint", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  random_changes(txn, map, expected, prng, 1000);
+  const model saved = expected;
+  const size_t savepoint = txn.savepoint();
+  try {
+    for (uint64_t key = 0;; ++key)
+      txn.upsert(map, buffer::key_from_u64(key), value_of(61, key));
+  } catch (const mdbx::db_full &) {
+  }
+  txn.rollback_to(savepoint);
+  expected = saved;
+  random_changes(txn, map, expected, prng, 100);
+  txn.commit();
+  txn = env.start_read();
+  if (!verify(txn, map, expected, "after recovery from MDBX_MAP_FULL"))
+    return false;
+  txn.abort();
+
+  txn = env.start_write();
+  txn.savepoint();
+  txn.make_broken();
+  try {
+    txn.rollback_to(1);
+    std::cerr << "Fail: the rollback cleared an unrecoverable error\n";
+    return false;
+  } catch (const mdbx::bad_transaction &) {
+  }
+  txn.abort();
+  env.close();
+  mdbx::env_managed::remove(db_filename);
+  return true;
+}
+
+static int doit() {
+  for (const auto mode : {mdbx::env::mode::write_file_io, mdbx::env::mode::write_mapped_io})
+    if (!workload(mode) || !poisoned(mode))
+      return EXIT_FAILURE;
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
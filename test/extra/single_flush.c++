@@ -0,0 +1,175 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+/* the option is set through C API, so the handle is created by C API too */
+struct env_handle : public mdbx::env {
+  env_handle(MDBX_env *ptr) : mdbx::env(ptr) {}
+};
+
+static const char *const db_filename = "test-single-flush";
+static const uint64_t total = 1000;
+static const size_t pagesize = 4096;
+
+static std::vector<char> read_file() {
+  std::ifstream file(db_filename, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static bool write_file(const std::vector<char> &content) {
+  std::ofstream file(db_filename, std::ios::binary | std::ios::trunc);
+  file.write(content.data(), content.size());
+  return file.good();
+}
+
+/* the DB file before and after the last commit, and the meta-page of the last commit */
+struct last_commit {
+  std::vector<char> before, after;
+  size_t meta;
+  uint64_t sign;
+};
+
+static uint64_t flushes(const mdbx::env::info &info) { return info.mi_pgop_stat.fsync + info.mi_dsync_stat.writes; }
+
+static bool workload(bool single_flush, uint64_t &flushes_per_commit, last_commit &last) {
+  MDBX_env *handle;
+  mdbx::error::success_or_throw(mdbx_env_create(&handle));
+  std::unique_ptr<MDBX_env, int (*)(MDBX_env *)> guard(handle, mdbx_env_close);
+  env_handle env(handle);
+  mdbx::error::success_or_throw(mdbx_env_set_geometry(env, -1, 1 << 20, 1 << 30, 1 << 20, -1, pagesize));
+  mdbx::error::success_or_throw(mdbx_env_set_option(env, MDBX_opt_max_db, 4));
+  const int err = mdbx_env_set_option(env, MDBX_opt_single_flush, single_flush);
+  if (err == MDBX_ENOSYS)
+    return false;
+  mdbx::error::success_or_throw(err);
+  mdbx::error::success_or_throw(mdbx_env_open(env, db_filename, MDBX_NOSUBDIR | MDBX_EXCLUSIVE, 0664));
+
+  auto txn = env.start_write();
+  auto map = txn.create_map("single-flush", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  txn.commit();
+
+  const uint64_t before = flushes(env.get_info());
+  for (uint64_t i = 0; i < total; ++i) {
+    if (i == total - 1)
+      last.before = read_file();
+    txn = env.start_write();
+    txn.upsert(map, buffer::key_from_u64(i), buffer::key_from_u64(i));
+    txn.commit();
+  }
+  const auto info = env.get_info();
+  flushes_per_commit = (flushes(info) - before) / total;
+  for (last.meta = 0; info.mi_meta_txnid[last.meta] != info.mi_recent_txnid; ++last.meta)
+    ;
+  last.sign = info.mi_meta_sign[last.meta];
+  guard.reset();
+  last.after = read_file();
+  return true;
+}
+
+/* emulate a crash after the single flush, but before the steady signature of the last commit has reached the disk */
+static bool weaken(std::vector<char> &content, const last_commit &last) {
+  if (last.sign <= 1)
+    return false;
+  const uint64_t weak = 1;
+  char *const meta = content.data() + last.meta * pagesize;
+  for (size_t offset = 0; offset + sizeof(last.sign) <= pagesize; ++offset)
+    if (std::memcmp(meta + offset, &last.sign, sizeof(last.sign)) == 0) {
+      std::memcpy(meta + offset, &weak, sizeof(weak));
+      return true;
+    }
+  return false;
+}
+
+/* emulate a torn write, when one of the pages of the last commit has not reached the disk */
+static bool tear(std::vector<char> &content, const last_commit &last) {
+  for (size_t offset = 3 * pagesize; offset + pagesize <= last.before.size(); offset += pagesize)
+    if (std::memcmp(content.data() + offset, last.before.data() + offset, pagesize) != 0) {
+      std::memcpy(content.data() + offset, last.before.data() + offset, pagesize);
+      return true;
+    }
+  return false;
+}
+
+static bool verify(uint64_t expected, const char *caption) {
+  mdbx::env_managed env(db_filename, mdbx::env::operate_parameters(4));
+  const auto info = env.get_info();
+  if (info.mi_meta_sign[info.mi_recent_txnid == info.mi_meta_txnid[0]   ? 0
+                        : info.mi_recent_txnid == info.mi_meta_txnid[1] ? 1
+                                                                        : 2] <= 1) {
+    std::cerr << "Fail: the recent commit is not steady " << caption << "\n";
+    return false;
+  }
+  auto txn = env.start_read();
+  auto map = txn.open_map("single-flush", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  if (txn.get_map_stat(map).ms_entries != expected) {
+    std::cerr << "Fail: " << txn.get_map_stat(map).ms_entries << " items instead of " << expected << " " << caption
+              << "\n";
+    return false;
+  }
+  for (uint64_t i = 0; i < expected; ++i)
+    if (txn.get(map, buffer::key_from_u64(i)).as_uint64() != i) {
+      std::cerr << "Fail: mismatch for item " << i << " " << caption << "\n";
+      return false;
+    }
+  return true;
+}
+
+static int doit() {
+  mdbx::env_managed::remove(db_filename);
+  uint64_t regular = 0, single = 0;
+  last_commit last;
+  if (!workload(false, regular, last) || (mdbx::env_managed::remove(db_filename), !workload(true, single, last))) {
+    std::cout << "Skipped: the single-flush commit is not supported\n";
+    return EXIT_SUCCESS;
+  }
+  /* a regular commit writes data and then the meta-page, each with a flush either by fsync or through O_DSYNC */
+  if (single != 1 || single >= regular) {
+    std::cerr << "Fail: " << single << " flush(es) per single-flush commit, but " << regular << " regular\n";
+    return EXIT_FAILURE;
+  }
+  if (last.sign <= 1) {
+    std::cerr << "Fail: the single-flush commit is not steady\n";
+    return EXIT_FAILURE;
+  }
+
+  /* the commit with the weak meta-page is verified by the manifest and becomes steady */
+  std::vector<char> content = last.after;
+  if (!weaken(content, last) || !write_file(content)) {
+    std::cerr << "Fail: the signature of the last commit is not found\n";
+    return EXIT_FAILURE;
+  }
+  if (!verify(total, "after the verification"))
+    return EXIT_FAILURE;
+
+  /* the torn commit should be rolled back */
+  content = last.after;
+  if (!weaken(content, last) || !tear(content, last) || !write_file(content)) {
+    std::cerr << "Fail: the pages of the last commit are not found\n";
+    return EXIT_FAILURE;
+  }
+  if (!verify(total - 1, "after the rollback"))
+    return EXIT_FAILURE;
+
+  mdbx::env_managed::remove(db_filename);
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
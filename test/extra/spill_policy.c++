@@ -0,0 +1,115 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <iostream>
+#include <vector>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+static const uint64_t total = 400000, hot = 100000, sparsity = 16;
+
+/* A sweep over all keys exceeds the dirty pages limit, while the hot
+ * subset of keys is updated randomly and rarely between the updates
+ * by the sweep, so the pure LRU spills the hot pages. */
+static bool workload(mdbx::env_managed &env, mdbx::map_handle map, unsigned policy, uint64_t generation,
+                     MDBX_commit_stat &stat) {
+  env.set_extra_option(mdbx::env::extra_runtime_option::spill_policy, policy);
+  if (env.extra_option(mdbx::env::extra_runtime_option::spill_policy) != policy) {
+    std::cerr << "Fail: spill policy option was not applied\n";
+    return false;
+  }
+
+  auto txn = env.start_write();
+  uint64_t prng = generation;
+  for (uint64_t i = 0; i < total; ++i) {
+    txn.update(map, buffer::key_from_u64(i), buffer::key_from_u64(i + generation));
+    if (i % sparsity)
+      continue;
+    prng = prng * 6364136223846793005ull + 1442695040888963407ull;
+    const uint64_t j = (prng >> 33) % hot;
+    txn.update(map, buffer::key_from_u64(j), buffer::key_from_u64(~(j + generation)));
+  }
+  stat = txn.commit_get_stat();
+
+  txn = env.start_read();
+  for (uint64_t i = 0; i < total; ++i) {
+    const uint64_t value = txn.get(map, buffer::key_from_u64(i)).as_uint64();
+    if (value != i + generation && (i >= hot || value != ~(i + generation))) {
+      std::cerr << "Fail: mismatch for item " << i << " with policy " << policy << "\n";
+      return false;
+    }
+  }
+  txn.abort();
+
+  if (!stat.spill.spilled || !stat.spill.rounds || stat.spill.unspilled > stat.spill.spilled) {
+    std::cerr << "Fail: unexpected spilling statistics with policy " << policy << ": spilled " << stat.spill.spilled
+              << ", unspilled " << stat.spill.unspilled << ", rounds " << stat.spill.rounds << "\n";
+    return false;
+  }
+  return true;
+}
+
+static int doit() {
+  mdbx::path db_filename = "test-spill-policy";
+  mdbx::env_managed::remove(db_filename);
+  mdbx::env_managed env(db_filename, mdbx::env_managed::create_parameters(),
+                        mdbx::env::operate_parameters(1, 0, mdbx::env::mode::write_file_io));
+  env.set_extra_option(mdbx::env::extra_runtime_option::dp_limit, 1024);
+
+  try {
+    env.set_extra_option(mdbx::env::extra_runtime_option::spill_policy, 2);
+    std::cerr << "Fail: invalid value of the spill policy option was accepted\n";
+    return EXIT_FAILURE;
+  } catch (const std::invalid_argument &) {
+  }
+
+  auto txn = env.start_write();
+  auto map = txn.create_map("spill", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  for (uint64_t i = 0; i < total; ++i)
+    txn.append(map, buffer::key_from_u64(i), buffer::key_from_u64(i));
+  txn.commit();
+
+  MDBX_commit_stat lru, frequency;
+  if (!workload(env, map, 0, 1, lru) || !workload(env, map, 1, 2, frequency))
+    return EXIT_FAILURE;
+  if (frequency.spill.unspilled > lru.spill.unspilled) {
+    std::cerr << "Fail: frequency-aware policy unspills " << frequency.spill.unspilled << " pages, but LRU only "
+              << lru.spill.unspilled << "\n";
+    return EXIT_FAILURE;
+  }
+
+  /* the size of the statistics is checked before the commit */
+  txn = env.start_write();
+  MDBX_commit_stat stub;
+  if (mdbx_txn_commit_ex2(txn, nullptr, &stub, sizeof(stub) + sizeof(uint32_t)) != MDBX_EINVAL) {
+    std::cerr << "Fail: unexpected size of the commit statistics was accepted\n";
+    return EXIT_FAILURE;
+  }
+  txn.abort();
+
+  /* the nested transactions are accounted by their parent */
+  txn = env.start_write();
+  auto nested = txn.start_nested();
+  for (uint64_t i = 0; i < total / 2; ++i)
+    nested.update(map, buffer::key_from_u64(i), buffer::key_from_u64(i));
+  nested.commit();
+  const auto stat = txn.commit_get_stat();
+  if (!stat.spill.spilled) {
+    std::cerr << "Fail: spilling by a nested transaction is not accounted\n";
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
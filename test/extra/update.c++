@@ -0,0 +1,163 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+/* counters are incremented in place, absent ones are inserted */
+static int increment(void *context, const MDBX_val *key, MDBX_val *value, bool exists) noexcept {
+  static uint64_t initial;
+  (void)context;
+  (void)key;
+  if (!exists) {
+    initial = 1;
+    value->iov_base = &initial;
+    value->iov_len = sizeof(initial);
+    return MDBX_SUCCESS;
+  }
+  if (value->iov_len != sizeof(uint64_t))
+    return MDBX_EINVAL;
+  uint64_t counter;
+  std::memcpy(&counter, value->iov_base, sizeof(counter));
+  ++counter;
+  std::memcpy(value->iov_base, &counter, sizeof(counter));
+  return MDBX_SUCCESS;
+}
+
+/* the counter reaching the limit is deleted */
+static int decrement(void *context, const MDBX_val *key, MDBX_val *value, bool exists) noexcept {
+  (void)context;
+  (void)key;
+  if (!exists)
+    return MDBX_RESULT_TRUE;
+  uint64_t counter;
+  std::memcpy(&counter, value->iov_base, sizeof(counter));
+  if (--counter == 0)
+    return MDBX_RESULT_TRUE;
+  std::memcpy(value->iov_base, &counter, sizeof(counter));
+  return MDBX_SUCCESS;
+}
+
+/* long values are appended, including placed on large/overflow pages */
+static int append(void *context, const MDBX_val *key, MDBX_val *value, bool exists) noexcept {
+  std::string &scratch = *static_cast<std::string *>(context);
+  (void)key;
+  scratch.assign(exists ? static_cast<const char *>(value->iov_base) : "", exists ? value->iov_len : 0);
+  if (scratch.size() < 3000) {
+    scratch.append(997, char('a' + scratch.size() % 26));
+    value->iov_base = const_cast<char *>(scratch.data());
+    value->iov_len = scratch.size();
+  } else
+    /* the same-size change of a large value is made in place */
+    std::memset(value->iov_base, 'z', 3);
+  return MDBX_SUCCESS;
+}
+
+static bool check(mdbx::txn &txn, mdbx::map_handle map, uint64_t total, uint64_t rounds, bool decremented,
+                  const char *stage) {
+  for (uint64_t i = 0; i < total; ++i) {
+    const auto value = txn.get(map, buffer::key_from_u64(i), mdbx::slice::invalid());
+    const uint64_t expected = decremented ? rounds - i % 4 : rounds;
+    if (expected == 0 ? value.is_valid() : !value.is_valid() || value.as_uint64() != expected) {
+      std::cerr << "Fail: unexpected value of counter " << i << " " << stage << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool workload(mdbx::env::mode mode) {
+  mdbx::path db_filename = "test-update";
+  mdbx::env_managed::remove(db_filename);
+  mdbx::env_managed env(db_filename, mdbx::env_managed::create_parameters(), mdbx::env::operate_parameters(4, 0, mode));
+
+  const uint64_t total = 30000, rounds = 3;
+  auto txn = env.start_write();
+  auto map = txn.create_map("counters", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  for (uint64_t round = 0; round < rounds; ++round) {
+    for (uint64_t i = 0; i < total; ++i)
+      mdbx::error::success_or_throw(mdbx_update(txn, map.dbi, &buffer::key_from_u64(i).slice(), increment, nullptr));
+    if (round == 0)
+      txn.commit(), txn = env.start_write();
+  }
+  /* the counters are updated both in the frozen and in the dirty pages */
+  if (!check(txn, map, total, rounds, false, "in the transaction"))
+    return false;
+  for (uint64_t i = 0; i < total; ++i)
+    for (uint64_t n = 0; n < i % 4; ++n)
+      mdbx::error::success_or_throw(mdbx_update(txn, map.dbi, &buffer::key_from_u64(i).slice(), decrement, nullptr));
+  txn.commit();
+
+  txn = env.start_read();
+  if (!check(txn, map, total, rounds, true, "after commit"))
+    return false;
+  txn.abort();
+
+  txn = env.start_write();
+  auto blobs = txn.create_map("blobs");
+  std::string scratch;
+  for (size_t round = 0; round < 6; ++round) {
+    for (size_t i = 0; i < 100; ++i)
+      mdbx::error::success_or_throw(mdbx_update(txn, blobs.dbi, &buffer::key_from_u64(i).slice(), append, &scratch));
+    if (round == 1 || round == 3)
+      txn.commit(), txn = env.start_write();
+  }
+  txn.commit();
+
+  txn = env.start_read();
+  for (size_t i = 0; i < 100; ++i) {
+    const auto value = txn.get(blobs, buffer::key_from_u64(i));
+    if (value.length() != 997 * 4 || value.as_string().compare(0, 3, "zzz") != 0) {
+      std::cerr << "Fail: unexpected blob " << i << " of " << value.length() << " bytes\n";
+      return false;
+    }
+  }
+  txn.abort();
+
+  if (mode != mdbx::env::mode::write_mapped_io) {
+    /* the pages dirtied by the parent are cloned into the nested transaction */
+    txn = env.start_write();
+    const auto key = buffer::key_from_u64(0);
+    mdbx::error::success_or_throw(mdbx_update(txn, map.dbi, &key.slice(), increment, nullptr));
+    auto nested = txn.start_nested();
+    mdbx::error::success_or_throw(mdbx_update(nested, map.dbi, &key.slice(), increment, nullptr));
+    nested.abort();
+    if (txn.get(map, key).as_uint64() != rounds + 1) {
+      std::cerr << "Fail: the nested transaction changes the parent's page\n";
+      return false;
+    }
+    txn.abort();
+  }
+
+  txn = env.start_write();
+  auto multi = txn.create_map("multi", mdbx::key_mode::usual, mdbx::value_mode::multi);
+  if (mdbx_update(txn, multi.dbi, &buffer::key_from_u64(0).slice(), increment, nullptr) != MDBX_INCOMPATIBLE) {
+    std::cerr << "Fail: mdbx_update() accepts a table with multi-values\n";
+    return false;
+  }
+  txn.abort();
+  return true;
+}
+
+static int doit() {
+  for (const auto mode : {mdbx::env::mode::write_file_io, mdbx::env::mode::write_mapped_io})
+    if (!workload(mode))
+      return EXIT_FAILURE;
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
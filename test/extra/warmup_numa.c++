@@ -0,0 +1,62 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <iostream>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+static int doit() {
+  mdbx::path db_filename = "test-warmup-numa";
+  mdbx::env_managed::remove(db_filename);
+  mdbx::env_managed env(db_filename, mdbx::env_managed::create_parameters(), mdbx::env::operate_parameters(4));
+
+  /* a database of several 2 MiB stripes and a partial one at the end */
+  const uint64_t total = 150000;
+  auto txn = env.start_write();
+  auto map = txn.create_map("numa", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  for (uint64_t i = 0; i < total; ++i)
+    txn.upsert(map, buffer::key_from_u64(i), mdbx::slice("the value to fill pages"));
+  txn.commit();
+
+  for (const auto flags : {MDBX_warmup_force | MDBX_warmup_numa,
+                           MDBX_warmup_force | MDBX_warmup_numa | MDBX_warmup_oomsafe}) {
+    const int err = mdbx_env_warmup(env, nullptr, flags, 0);
+    if (err != MDBX_SUCCESS) {
+      std::cerr << "Fail: mdbx_env_warmup(" << unsigned(flags) << "), err " << err << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  txn = env.start_read();
+  /* the timeout is checked by each of the warming threads */
+  const int err = mdbx_env_warmup(nullptr, txn, MDBX_warmup_force | MDBX_warmup_numa, 1);
+  if (err != MDBX_SUCCESS && err != MDBX_RESULT_TRUE) {
+    std::cerr << "Fail: mdbx_env_warmup() with timeout, err " << err << "\n";
+    return EXIT_FAILURE;
+  }
+  for (uint64_t i = 0; i < total; ++i)
+    if (txn.get(map, buffer::key_from_u64(i)) != mdbx::slice("the value to fill pages")) {
+      std::cerr << "Fail: mismatch for item " << i << "\n";
+      return EXIT_FAILURE;
+    }
+  txn.abort();
+
+  if (mdbx_env_warmup(env, nullptr, MDBX_warmup_flags_t(MDBX_warmup_profile << 1), 0) != MDBX_EINVAL) {
+    std::cerr << "Fail: an unknown warmup flag is accepted\n";
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,90 @@
+/// \copyright SPDX-License-Identifier: Apache-2.0
+
+#include "mdbx.h++"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using buffer = mdbx::buffer<mdbx::default_allocator, mdbx::default_capacity_policy>;
+
+static int doit() {
+  const std::string db_filename = "test-warmup-profile", profile_filename = db_filename + MDBX_WARMUP_SUFFIX;
+  mdbx::env_managed::remove(db_filename);
+  std::remove(profile_filename.c_str());
+  mdbx::env_managed env(db_filename, mdbx::env_managed::create_parameters(), mdbx::env::operate_parameters(4));
+
+  const std::string value(1000, 'v');
+  auto txn = env.start_write();
+  auto map = txn.create_map("profile", mdbx::key_mode::ordinal, mdbx::value_mode::single);
+  for (uint64_t i = 0; i < 20000; ++i)
+    txn.upsert(map, buffer::key_from_u64(i), mdbx::slice(value));
+  txn.commit();
+
+  int err = mdbx_env_warmup(env, nullptr, MDBX_warmup_profile, 0);
+  if (err == MDBX_ENOSYS) {
+    std::cout << "OK (skipped since mincore() is not available)\n";
+    return EXIT_SUCCESS;
+  }
+  if (err != MDBX_ENOFILE) {
+    std::cerr << "Fail: the absent profile is not reported, err " << err << "\n";
+    return EXIT_FAILURE;
+  }
+
+  /* the whole database is loaded, so the profile should not be empty */
+  mdbx::error::success_or_throw(mdbx_env_warmup(env, nullptr, MDBX_warmup_force, 0));
+  mdbx::error::success_or_throw(mdbx_env_warmup_save(env));
+  std::ifstream profile(profile_filename, std::ios::binary | std::ios::ate);
+  if (!profile || size_t(profile.tellg()) <= 16 || (size_t(profile.tellg()) - 16) % 8 != 0) {
+    std::cerr << "Fail: unexpected size of the profile\n";
+    return EXIT_FAILURE;
+  }
+  profile.close();
+
+  for (const auto flags : {MDBX_warmup_profile, MDBX_warmup_profile | MDBX_warmup_force,
+                           MDBX_warmup_profile | MDBX_warmup_force | MDBX_warmup_oomsafe}) {
+    err = mdbx_env_warmup(env, nullptr, flags, 0);
+    if (err != MDBX_SUCCESS) {
+      std::cerr << "Fail: replay the profile with flags " << unsigned(flags) << ", err " << err << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  /* the replay with a short timeout either completes or reports the timeout */
+  err = mdbx_env_warmup(env, nullptr, MDBX_warmup_profile, 1);
+  if (err != MDBX_SUCCESS && err != MDBX_RESULT_TRUE) {
+    std::cerr << "Fail: replay the profile with a timeout, err " << err << "\n";
+    return EXIT_FAILURE;
+  }
+
+  txn = env.start_read();
+  for (uint64_t i = 0; i < 20000; ++i)
+    if (txn.get(map, buffer::key_from_u64(i)) != mdbx::slice(value)) {
+      std::cerr << "Fail: mismatch for item " << i << "\n";
+      return EXIT_FAILURE;
+    }
+  txn.abort();
+
+  /* a profile of other database is rejected */
+  std::ofstream(profile_filename, std::ios::binary | std::ios::trunc) << "not a profile of this database";
+  err = mdbx_env_warmup(env, nullptr, MDBX_warmup_profile, 0);
+  if (err != MDBX_INVALID) {
+    std::cerr << "Fail: the invalid profile is accepted, err " << err << "\n";
+    return EXIT_FAILURE;
+  }
+  std::remove(profile_filename.c_str());
+
+  std::cout << "OK\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  try {
+    return doit();
+  } catch (const std::exception &ex) {
+    std::cerr << "Exception: " << ex.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}